@@ -0,0 +1,207 @@
+/** @file
+    @brief Header describing the binary format written by osvr_record: a
+   header, a table of the recorded paths, then fixed-size records appended as
+   reports arrive.
+
+    Records hold reports as raw structs, so a recording is meant to be read on
+   the same platform (and by a build from the same headers) that wrote it.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_RecordingFormat_h_GUID_BA632136_EA9B_4E25_B72F_7AAEA1BB4A3F
+#define INCLUDED_RecordingFormat_h_GUID_BA632136_EA9B_4E25_B72F_7AAEA1BB4A3F
+
+// Internal Includes
+#include <osvr/Util/ClientCallbackTypesC.h>
+#include <osvr/Util/ReportTypesX.h>
+#include <osvr/Util/StdInt.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/// @brief Identifies the report type of a record: zero marks the end of the
+/// records, such as the unwritten tail of a recording that was cut short.
+enum class RecordType : uint16_t {
+    None = 0,
+#define OSVR_X(TYPE) TYPE,
+    OSVR_INVOKE_REPORT_TYPES_XMACRO()
+#undef OSVR_X
+        Count
+};
+
+/// @brief Gets the name of a report type, or an empty string if invalid.
+inline const char *getRecordTypeName(RecordType type) {
+    switch (type) {
+#define OSVR_X(TYPE)                                                           \
+    case RecordType::TYPE:                                                     \
+        return #TYPE;
+        OSVR_INVOKE_REPORT_TYPES_XMACRO()
+#undef OSVR_X
+    default:
+        return "";
+    }
+}
+
+/// @brief Space in a record for the report itself.
+static const std::size_t RECORD_PAYLOAD_SIZE = 104;
+
+/// @brief One report, as stored in a recording.
+struct Record {
+    /// @brief Index of the report's path in the recording's path table.
+    uint32_t pathId;
+    RecordType type;
+    /// @brief Size of the report struct in the payload.
+    uint16_t payloadSize;
+    /// @brief The report's timestamp, as given to the callback.
+    int64_t seconds;
+    int32_t microseconds;
+    uint32_t reserved;
+    /// @brief The report struct, as given to the callback (except for image
+    /// data, which isn't recorded).
+    unsigned char payload[RECORD_PAYLOAD_SIZE];
+};
+
+static_assert(sizeof(Record) == 128, "Record layout should have no padding");
+
+#define OSVR_X(TYPE)                                                           \
+    static_assert(sizeof(OSVR_##TYPE##Report) <= RECORD_PAYLOAD_SIZE,          \
+                  "Report type " #TYPE " doesn't fit in a record");
+OSVR_INVOKE_REPORT_TYPES_XMACRO()
+#undef OSVR_X
+
+/// @brief Header at the start of a recording.
+struct RecordingHeader {
+    char magic[8];
+    uint32_t version;
+    /// @brief sizeof(Record) in the recording.
+    uint32_t recordSize;
+    /// @brief Number of entries in the path table.
+    uint32_t pathCount;
+    uint32_t reserved;
+    /// @brief File offset of the first record, which follows the path table
+    /// (a series of null-terminated strings) and is a multiple of the record
+    /// size.
+    uint64_t recordsOffset;
+};
+
+static const char RECORDING_MAGIC[8] = "OSVRREC";
+static const uint32_t RECORDING_VERSION = 1;
+
+/// @brief Serializes the header and path table of a recording.
+inline std::vector<char>
+makeRecordingPreamble(std::vector<std::string> const &paths) {
+    std::size_t size = sizeof(RecordingHeader);
+    for (auto const &path : paths) {
+        size += path.size() + 1;
+    }
+    size = (size + sizeof(Record) - 1) / sizeof(Record) * sizeof(Record);
+    std::vector<char> ret(size, '\0');
+
+    RecordingHeader header;
+    std::memcpy(header.magic, RECORDING_MAGIC, sizeof(header.magic));
+    header.version = RECORDING_VERSION;
+    header.recordSize = sizeof(Record);
+    header.pathCount = static_cast<uint32_t>(paths.size());
+    header.reserved = 0;
+    header.recordsOffset = size;
+    std::memcpy(ret.data(), &header, sizeof(header));
+
+    auto out = ret.data() + sizeof(header);
+    for (auto const &path : paths) {
+        std::memcpy(out, path.c_str(), path.size() + 1);
+        out += path.size() + 1;
+    }
+    return ret;
+}
+
+/// @brief Read-only view of a recording in memory.
+class RecordingView {
+  public:
+    /// @brief Parses the header and path table.
+    /// @throws std::runtime_error if they aren't valid.
+    RecordingView(const char *data, std::size_t size);
+
+    std::vector<std::string> const &getPaths() const { return m_paths; }
+
+    /// @brief Number of records in the recording, not counting any unwritten
+    /// tail.
+    std::size_t size() const { return m_size; }
+
+    Record const &operator[](std::size_t i) const { return m_records[i]; }
+
+  private:
+    std::vector<std::string> m_paths;
+    Record const *m_records;
+    std::size_t m_size;
+};
+
+inline RecordingView::RecordingView(const char *data, std::size_t size)
+    : m_records(nullptr), m_size(0) {
+    RecordingHeader header;
+    if (size < sizeof(header)) {
+        throw std::runtime_error("Too short to be a recording");
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, RECORDING_MAGIC, sizeof(header.magic)) !=
+        0) {
+        throw std::runtime_error("Not a recording");
+    }
+    if (header.version != RECORDING_VERSION ||
+        header.recordSize != sizeof(Record)) {
+        throw std::runtime_error("Recording made by an incompatible version");
+    }
+    // Records start after the header and are aligned as the writer made
+    // them, so that the table scan below stays within the preamble.
+    if (header.recordsOffset < sizeof(header) ||
+        header.recordsOffset % sizeof(Record) != 0) {
+        throw std::runtime_error("Recording has an invalid records offset");
+    }
+    if (header.recordsOffset > size) {
+        throw std::runtime_error("Recording is truncated");
+    }
+    auto table = data + sizeof(header);
+    auto tableEnd = data + header.recordsOffset;
+    for (uint32_t i = 0; i < header.pathCount; ++i) {
+        auto end = std::find(table, tableEnd, '\0');
+        if (end == tableEnd) {
+            throw std::runtime_error("Recording path table is truncated");
+        }
+        m_paths.emplace_back(table, end);
+        table = end + 1;
+    }
+
+    m_records = reinterpret_cast<Record const *>(tableEnd);
+    auto available = (size - header.recordsOffset) / sizeof(Record);
+    while (m_size < available && m_records[m_size].type != RecordType::None) {
+        ++m_size;
+    }
+}
+
+#endif // INCLUDED_RecordingFormat_h_GUID_BA632136_EA9B_4E25_B72F_7AAEA1BB4A3F
@@ -0,0 +1,130 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "RecordingWriter.h"
+
+// Library/third-party includes
+#include <boost/filesystem/operations.hpp>
+
+// Standard includes
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+/// @brief Size of the file chunks mapped at a time: a multiple of both the
+/// record size and any page size.
+static const uint64_t CHUNK_SIZE = 16 * 1024 * 1024;
+
+/// @brief Number of records the writer thread takes from the queue at once.
+static const std::size_t BATCH_SIZE = 256;
+
+/// @brief Creates the file with its header and path table, returning their
+/// size.
+static uint64_t createRecordingFile(std::string const &filename,
+                                    std::vector<std::string> const &paths) {
+    auto preamble = makeRecordingPreamble(paths);
+    std::ofstream file(filename, std::ios::out | std::ios::binary |
+                                     std::ios::trunc);
+    file.write(preamble.data(), preamble.size());
+    if (!file) {
+        throw std::runtime_error("Could not create recording file " +
+                                 filename);
+    }
+    return preamble.size();
+}
+
+RecordingWriter::RecordingWriter(std::string const &filename,
+                                 std::vector<std::string> const &paths)
+    : m_filename(filename), m_queue(QUEUE_CAPACITY), m_written(0),
+      m_running(true) {
+    m_offset = createRecordingFile(filename, paths);
+    m_file = boost::interprocess::file_mapping(
+        filename.c_str(), boost::interprocess::read_write);
+    m_mapChunkAt(m_offset);
+    m_thread = std::thread([&] { m_run(); });
+}
+
+RecordingWriter::~RecordingWriter() { stop(); }
+
+bool RecordingWriter::push(Record const &record) {
+    if (!m_queue.push(record)) {
+        ++m_dropped;
+        return false;
+    }
+    return true;
+}
+
+void RecordingWriter::stop() {
+    if (!m_thread.joinable()) {
+        return;
+    }
+    m_running = false;
+    m_thread.join();
+    m_region.flush();
+    m_region = boost::interprocess::mapped_region();
+    boost::filesystem::resize_file(m_filename, m_offset);
+}
+
+void RecordingWriter::m_run() {
+    Record batch[BATCH_SIZE];
+    while (true) {
+        // Check before popping, so that nothing queued before stop() is
+        // left behind.
+        bool running = m_running;
+        auto n = m_queue.pop(batch, BATCH_SIZE);
+        for (std::size_t i = 0; i < n; ++i) {
+            m_write(batch[i]);
+        }
+        if (n == 0) {
+            if (!running) {
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+void RecordingWriter::m_write(Record const &record) {
+    if (m_offset + sizeof(Record) > m_regionOffset + m_region.get_size()) {
+        m_mapChunkAt(m_offset);
+    }
+    std::memcpy(static_cast<char *>(m_region.get_address()) +
+                    (m_offset - m_regionOffset),
+                &record, sizeof(Record));
+    m_offset += sizeof(Record);
+    ++m_written;
+}
+
+void RecordingWriter::m_mapChunkAt(uint64_t offset) {
+    m_region = boost::interprocess::mapped_region();
+    auto chunkOffset = offset / CHUNK_SIZE * CHUNK_SIZE;
+    // The file grows a whole chunk at a time; the part past the last record
+    // reads as zeros, which marks the end of the records.
+    boost::filesystem::resize_file(m_filename, chunkOffset + CHUNK_SIZE);
+    m_region = boost::interprocess::mapped_region(
+        m_file, boost::interprocess::read_write, chunkOffset, CHUNK_SIZE);
+    m_regionOffset = chunkOffset;
+}
@@ -0,0 +1,99 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_RecordingWriter_h_GUID_73AC725F_774F_4A23_A84A_D04581CEE199
+#define INCLUDED_RecordingWriter_h_GUID_73AC725F_774F_4A23_A84A_D04581CEE199
+
+// Internal Includes
+#include "RecordingFormat.h"
+
+// Library/third-party includes
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/lockfree/spsc_queue.hpp>
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// @brief Appends records to a recording file from a background thread.
+///
+/// Records are handed over through a lock-free single-producer queue, so
+/// push() never waits on the disk: if the writer falls a whole queue behind,
+/// records are dropped (and counted) instead. The file is grown and
+/// memory-mapped a chunk at a time, so a recording cut short (by a crash, for
+/// instance) still holds everything written so far.
+class RecordingWriter : boost::noncopyable {
+  public:
+    /// @brief Number of records the queue holds.
+    static const std::size_t QUEUE_CAPACITY = 1 << 16;
+
+    /// @brief Creates (replacing) the file, writes its header and path table,
+    /// and starts the writer thread.
+    /// @throws std::exception if the file can't be created.
+    RecordingWriter(std::string const &filename,
+                    std::vector<std::string> const &paths);
+
+    /// @brief Calls stop() if needed.
+    ~RecordingWriter();
+
+    /// @brief Queues a record for writing. Call from only one thread.
+    ///
+    /// @return false if the queue was full and the record was dropped.
+    bool push(Record const &record);
+
+    /// @brief Writes out everything queued, stops the writer thread, and
+    /// trims the file to the records written.
+    void stop();
+
+    /// @brief Number of records written so far.
+    std::size_t getWritten() const { return m_written; }
+
+    /// @brief Number of records dropped because the queue was full.
+    std::size_t getDropped() const { return m_dropped; }
+
+  private:
+    void m_run();
+    void m_write(Record const &record);
+    void m_mapChunkAt(uint64_t offset);
+
+    std::string m_filename;
+    boost::lockfree::spsc_queue<Record> m_queue;
+    boost::interprocess::file_mapping m_file;
+    boost::interprocess::mapped_region m_region;
+    /// @brief File offset of the start of the mapped region.
+    uint64_t m_regionOffset = 0;
+    /// @brief File offset of the next record.
+    uint64_t m_offset = 0;
+    std::atomic<std::size_t> m_written;
+    std::size_t m_dropped = 0;
+    std::atomic<bool> m_running;
+    std::thread m_thread;
+};
+
+#endif // INCLUDED_RecordingWriter_h_GUID_73AC725F_774F_4A23_A84A_D04581CEE199
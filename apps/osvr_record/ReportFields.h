@@ -0,0 +1,178 @@
+/** @file
+    @brief Header for flattening the report structs kept in a recording into
+   named numeric fields, for conversion to text formats.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_ReportFields_h_GUID_C95767BB_0C16_4654_9877_ED2C67439F66
+#define INCLUDED_ReportFields_h_GUID_C95767BB_0C16_4654_9877_ED2C67439F66
+
+// Internal Includes
+#include "RecordingFormat.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstring>
+#include <string>
+
+namespace report_fields {
+/// @name Report states with an unusual member name
+/// @{
+inline OSVR_PoseState const &getState(OSVR_PoseReport const &r) {
+    return r.pose;
+}
+inline OSVR_PositionState const &getState(OSVR_PositionReport const &r) {
+    return r.xyz;
+}
+inline OSVR_OrientationState const &
+getState(OSVR_OrientationReport const &r) {
+    return r.rotation;
+}
+inline OSVR_Location2DState const &getState(OSVR_Location2DReport const &r) {
+    return r.location;
+}
+inline OSVR_DirectionState const &getState(OSVR_DirectionReport const &r) {
+    return r.direction;
+}
+/// @}
+template <typename ReportType>
+inline auto getState(ReportType const &r) -> decltype((r.state)) {
+    return r.state;
+}
+
+/// @brief Name for a field, given its prefix: a state that's a lone value
+/// has no prefix.
+inline std::string fieldName(std::string const &prefix) {
+    return prefix.empty() ? std::string("value") : prefix;
+}
+
+/// @name Flattening of the state types, calling f(name, value) for each field
+/// @{
+template <typename F>
+inline void visit(F &f, std::string const &prefix, double value) {
+    f(fieldName(prefix), value);
+}
+template <typename F>
+inline void visit(F &f, std::string const &prefix, uint8_t value) {
+    f(fieldName(prefix), double(value));
+}
+template <typename F>
+inline void visit(F &f, std::string const &prefix, OSVR_Vec2 const &v) {
+    f(prefix + "x", v.data[0]);
+    f(prefix + "y", v.data[1]);
+}
+template <typename F>
+inline void visit(F &f, std::string const &prefix, OSVR_Vec3 const &v) {
+    f(prefix + "x", v.data[0]);
+    f(prefix + "y", v.data[1]);
+    f(prefix + "z", v.data[2]);
+}
+template <typename F>
+inline void visit(F &f, std::string const &prefix, OSVR_Quaternion const &q) {
+    f(prefix + "qw", osvrQuatGetW(&q));
+    f(prefix + "qx", osvrQuatGetX(&q));
+    f(prefix + "qy", osvrQuatGetY(&q));
+    f(prefix + "qz", osvrQuatGetZ(&q));
+}
+template <typename F>
+inline void visit(F &f, std::string const &prefix,
+                  OSVR_IncrementalQuaternion const &q) {
+    visit(f, prefix, q.incrementalRotation);
+    f(prefix + "dt", q.dt);
+}
+template <typename F>
+inline void visit(F &f, std::string const &prefix, OSVR_PoseState const &p) {
+    visit(f, prefix, p.translation);
+    visit(f, prefix, p.rotation);
+}
+template <typename F>
+inline void visit(F &f, std::string const &prefix,
+                  OSVR_VelocityState const &s) {
+    visit(f, prefix + "linear.", s.linearVelocity);
+    visit(f, prefix + "linearValid", s.linearVelocityValid);
+    visit(f, prefix + "angular.", s.angularVelocity);
+    visit(f, prefix + "angularValid", s.angularVelocityValid);
+}
+template <typename F>
+inline void visit(F &f, std::string const &prefix,
+                  OSVR_AccelerationState const &s) {
+    visit(f, prefix + "linear.", s.linearAcceleration);
+    visit(f, prefix + "linearValid", s.linearAccelerationValid);
+    visit(f, prefix + "angular.", s.angularAcceleration);
+    visit(f, prefix + "angularValid", s.angularAccelerationValid);
+}
+template <typename F>
+inline void visit(F &f, std::string const &prefix,
+                  OSVR_EyeTracker3DState const &s) {
+    visit(f, prefix + "direction.", s.direction);
+    visit(f, prefix + "directionValid", s.directionValid);
+    visit(f, prefix + "basePoint.", s.basePoint);
+    visit(f, prefix + "basePointValid", s.basePointValid);
+}
+template <typename F>
+inline void visit(F &f, std::string const &prefix,
+                  OSVR_ImagingState const &s) {
+    f(prefix + "height", s.metadata.height);
+    f(prefix + "width", s.metadata.width);
+    f(prefix + "channels", s.metadata.channels);
+    f(prefix + "depth", s.metadata.depth);
+    f(prefix + "valueType", s.metadata.type);
+}
+/// @}
+
+template <typename ReportType, typename F>
+inline void visitReport(F &f, Record const &record) {
+    ReportType report;
+    std::memset(&report, 0, sizeof(report));
+    std::memcpy(&report, record.payload,
+                std::min<std::size_t>(record.payloadSize, sizeof(report)));
+    visit(f, "", getState(report));
+}
+} // namespace report_fields
+
+/// @brief Calls f(name, value) for each field of the state in a record.
+/// Field names don't include the sensor or the timestamp.
+template <typename F>
+inline void visitRecordFields(Record const &record, F &f) {
+    switch (record.type) {
+#define OSVR_X(TYPE)                                                           \
+    case RecordType::TYPE:                                                     \
+        report_fields::visitReport<OSVR_##TYPE##Report>(f, record);            \
+        break;
+        OSVR_INVOKE_REPORT_TYPES_XMACRO()
+#undef OSVR_X
+    default:
+        break;
+    }
+}
+
+/// @brief Gets the sensor of the report in a record.
+inline uint32_t getRecordSensor(Record const &record) {
+    // All report structs start with the sensor.
+    uint32_t sensor;
+    std::memcpy(&sensor, record.payload, sizeof(sensor));
+    return sensor;
+}
+
+#endif // INCLUDED_ReportFields_h_GUID_C95767BB_0C16_4654_9877_ED2C67439F66
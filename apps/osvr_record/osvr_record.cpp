@@ -0,0 +1,215 @@
+/** @file
+    @brief Implementation of a tool recording every report from some paths,
+   at full rate, to a compact binary file: see osvr_record_convert for turning
+   a recording into CSV or JSON.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "RecordingWriter.h"
+#include <osvr/ClientKit/Context.h>
+#include <osvr/ClientKit/ImagingC.h>
+#include <osvr/ClientKit/Interface.h>
+
+// Library/third-party includes
+#include <boost/program_options.hpp>
+
+// Standard includes
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+/// @brief What a report callback needs to know to record a report.
+struct PathRecorder {
+    RecordingWriter *writer;
+    OSVR_ClientContext ctx;
+    uint32_t pathId;
+};
+
+template <typename ReportType>
+inline void recordReport(PathRecorder &recorder, RecordType type,
+                         OSVR_TimeValue const &timestamp,
+                         ReportType const &report) {
+    Record record;
+    record.pathId = recorder.pathId;
+    record.type = type;
+    record.payloadSize = static_cast<uint16_t>(sizeof(report));
+    record.seconds = timestamp.seconds;
+    record.microseconds = timestamp.microseconds;
+    record.reserved = 0;
+    std::memcpy(record.payload, &report, sizeof(report));
+    std::memset(record.payload + sizeof(report), 0,
+                sizeof(record.payload) - sizeof(report));
+    recorder.writer->push(record);
+}
+
+/// @brief Images themselves aren't recorded, just their metadata: the buffer
+/// is freed right away.
+inline void recordReport(PathRecorder &recorder, RecordType type,
+                         OSVR_TimeValue const &timestamp,
+                         OSVR_ImagingReport const &report) {
+    OSVR_ImagingReport metadataOnly = report;
+    metadataOnly.state.data = nullptr;
+    recordReport<OSVR_ImagingReport>(recorder, type, timestamp, metadataOnly);
+    osvrClientFreeImage(recorder.ctx, report.state.data);
+}
+
+#define OSVR_X(TYPE)                                                           \
+    void record##TYPE(void *userdata, const OSVR_TimeValue *timestamp,         \
+                      const OSVR_##TYPE##Report *report) {                     \
+        recordReport(*static_cast<PathRecorder *>(userdata),                   \
+                     RecordType::TYPE, *timestamp, *report);                   \
+    }
+OSVR_INVOKE_REPORT_TYPES_XMACRO()
+#undef OSVR_X
+
+template <typename CallbackType>
+inline void registerRecording(osvr::clientkit::Interface &iface,
+                              CallbackType callback, void *userdata, bool) {
+    iface.registerCallback(callback, userdata);
+}
+
+/// @brief Receiving images is costly, so it's optional.
+inline void registerRecording(osvr::clientkit::Interface &iface,
+                              OSVR_ImagingCallback callback, void *userdata,
+                              bool images) {
+    if (images) {
+        iface.registerCallback(callback, userdata);
+    }
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+    std::string filename;
+    std::vector<std::string> paths;
+    double seconds;
+    bool images;
+    namespace po = boost::program_options;
+    // clang-format off
+    po::options_description desc("Options");
+    desc.add_options()
+        ("help,h", "produce help message")
+        ("output,o", po::value<std::string>(&filename)->default_value("osvrdata.osvrrec"), "recording file to write (replaced if it exists)")
+        ("seconds,s", po::value<double>(&seconds)->default_value(0), "stop after this many seconds, rather than when Enter is pressed")
+        ("images", po::bool_switch(&images), "receive images, to record their metadata")
+        ;
+    po::options_description hidden("Hidden options");
+    hidden.add_options()
+        ("path", po::value<std::vector<std::string>>(&paths), "path to record")
+        ;
+    // clang-format on
+    po::options_description all;
+    all.add(desc).add(hidden);
+    po::positional_options_description positional;
+    positional.add("path", -1);
+    po::variables_map vm;
+    bool usage = false;
+    try {
+        po::store(po::command_line_parser(argc, argv)
+                      .options(all)
+                      .positional(positional)
+                      .run(),
+                  vm);
+        po::notify(vm);
+    } catch (std::exception &e) {
+        std::cerr << "\nError parsing command line: " << e.what() << "\n\n";
+        usage = true;
+    }
+    if (usage || vm.count("help") || paths.empty()) {
+        std::cerr << "\nRecords every report from the given paths to a "
+                     "binary file, to be turned into\n"
+                     "CSV or JSON by osvr_record_convert.\n";
+        std::cerr << "Usage: " << argv[0] << " [options] path [path...]\n\n";
+        std::cerr << desc << "\n";
+        return 1;
+    }
+
+    osvr::clientkit::ClientContext context("org.osvr.tools.record");
+    RecordingWriter writer(filename, paths);
+
+    std::vector<PathRecorder> recorders(paths.size());
+    for (std::size_t i = 0; i < paths.size(); ++i) {
+        std::cerr << "Setting up recording for " << paths[i] << std::endl;
+        recorders[i].writer = &writer;
+        recorders[i].ctx = context.get();
+        recorders[i].pathId = static_cast<uint32_t>(i);
+        auto iface = context.getInterface(paths[i]);
+        auto userdata = static_cast<void *>(&recorders[i]);
+#define OSVR_X(TYPE) registerRecording(iface, &record##TYPE, userdata, images);
+        OSVR_INVOKE_REPORT_TYPES_XMACRO()
+#undef OSVR_X
+        // will just let the context free them on exit.
+    }
+
+    if (!context.checkStatus()) {
+        std::cerr << "Client context has not yet started up - waiting. Make "
+                     "sure the server is running."
+                  << std::endl;
+        do {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            context.update();
+        } while (!context.checkStatus());
+        std::cerr << "OK, client context ready. Proceeding." << std::endl;
+    }
+
+    std::atomic<bool> done(false);
+    std::thread waitForEnter;
+    if (seconds > 0) {
+        std::cerr << "Recording to " << filename << " for " << seconds
+                  << " seconds." << std::endl;
+    } else {
+        std::cerr << "Recording to " << filename << ": press Enter to stop."
+                  << std::endl;
+        waitForEnter = std::thread([&] {
+            std::string line;
+            std::getline(std::cin, line);
+            done = true;
+        });
+    }
+
+    using std::chrono::steady_clock;
+    auto deadline =
+        steady_clock::now() +
+        std::chrono::duration_cast<steady_clock::duration>(
+            std::chrono::duration<double>(seconds));
+    do {
+        context.update();
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    } while (!done && (seconds <= 0 || steady_clock::now() < deadline));
+    if (waitForEnter.joinable()) {
+        waitForEnter.join();
+    }
+
+    writer.stop();
+    std::cerr << "Recorded " << writer.getWritten() << " reports";
+    if (writer.getDropped() > 0) {
+        std::cerr << " (dropped " << writer.getDropped()
+                  << " the writer couldn't keep up with)";
+    }
+    std::cerr << "." << std::endl;
+    return 0;
+}
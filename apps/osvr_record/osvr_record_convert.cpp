@@ -0,0 +1,222 @@
+/** @file
+    @brief Implementation of a tool converting a recording made by osvr_record
+   into CSV (one row per report, one column per field) or JSON (an array with
+   one object per report).
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "RecordingFormat.h"
+#include "ReportFields.h"
+
+// Library/third-party includes
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/program_options.hpp>
+#include <json/value.h>
+#include <json/writer.h>
+
+// Standard includes
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+/// @brief Quotes a CSV cell if needed.
+std::string csvEscape(std::string const &s) {
+    if (s.find_first_of(",\"\n") == std::string::npos) {
+        return s;
+    }
+    std::string ret = "\"";
+    for (auto c : s) {
+        if (c == '"') {
+            ret += '"';
+        }
+        ret += c;
+    }
+    return ret + "\"";
+}
+
+/// @brief Writes one row per record, with a column for every field of every
+/// report type in the recording: fields a report doesn't have are left
+/// empty.
+void writeCSV(RecordingView const &recording, std::ostream &os) {
+    // First pass: find which report types are present, to know the columns.
+    std::vector<bool> present(std::size_t(RecordType::Count), false);
+    for (std::size_t i = 0; i < recording.size(); ++i) {
+        auto type = std::size_t(recording[i].type);
+        if (type < present.size()) {
+            present[type] = true;
+        }
+    }
+    std::vector<std::string> columns;
+    std::unordered_map<std::string, std::size_t> columnIndices;
+    auto addColumn = [&](std::string const &name, double) {
+        if (columnIndices.find(name) == end(columnIndices)) {
+            columnIndices[name] = columns.size();
+            columns.push_back(name);
+        }
+    };
+    for (std::size_t type = 1; type < present.size(); ++type) {
+        if (present[type]) {
+            Record empty = {};
+            empty.type = RecordType(type);
+            visitRecordFields(empty, addColumn);
+        }
+    }
+
+    os << "seconds,microseconds,path,type,sensor";
+    for (auto const &column : columns) {
+        os << "," << csvEscape(column);
+    }
+    os << "\n";
+
+    // Second pass: the rows.
+    std::vector<std::string> cells(columns.size());
+    std::ostringstream cell;
+    cell << std::setprecision(std::numeric_limits<double>::max_digits10);
+    auto setCell = [&](std::string const &name, double value) {
+        cell.str(std::string());
+        cell << value;
+        cells[columnIndices[name]] = cell.str();
+    };
+    auto const &paths = recording.getPaths();
+    for (std::size_t i = 0; i < recording.size(); ++i) {
+        auto const &record = recording[i];
+        for (auto &c : cells) {
+            c.clear();
+        }
+        visitRecordFields(record, setCell);
+        os << record.seconds << "," << record.microseconds << ","
+           << csvEscape(record.pathId < paths.size() ? paths[record.pathId]
+                                                    : std::string())
+           << "," << getRecordTypeName(record.type) << ","
+           << getRecordSensor(record);
+        for (auto const &c : cells) {
+            os << "," << c;
+        }
+        os << "\n";
+    }
+}
+
+/// @brief Writes an array with one object per record.
+void writeJSON(RecordingView const &recording, std::ostream &os) {
+    Json::FastWriter writer;
+    auto const &paths = recording.getPaths();
+    os << "[\n";
+    for (std::size_t i = 0; i < recording.size(); ++i) {
+        auto const &record = recording[i];
+        Json::Value val(Json::objectValue);
+        val["seconds"] = Json::Int64(record.seconds);
+        val["microseconds"] = record.microseconds;
+        val["path"] = record.pathId < paths.size() ? paths[record.pathId]
+                                                   : std::string();
+        val["type"] = getRecordTypeName(record.type);
+        val["sensor"] = getRecordSensor(record);
+        Json::Value &state = val["state"];
+        state = Json::Value(Json::objectValue);
+        auto setField = [&](std::string const &name, double value) {
+            state[name] = value;
+        };
+        visitRecordFields(record, setField);
+        // FastWriter ends each value with a newline already.
+        os << (i == 0 ? "" : ",") << writer.write(val);
+    }
+    os << "]\n";
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+    std::string input;
+    std::string output;
+    std::string format;
+    namespace po = boost::program_options;
+    // clang-format off
+    po::options_description desc("Options");
+    desc.add_options()
+        ("help,h", "produce help message")
+        ("format,f", po::value<std::string>(&format)->default_value("csv"), "output format: csv or json")
+        ("output,o", po::value<std::string>(&output), "file to write (standard output if not given)")
+        ;
+    po::options_description hidden("Hidden options");
+    hidden.add_options()
+        ("input", po::value<std::string>(&input), "recording to convert")
+        ;
+    // clang-format on
+    po::options_description all;
+    all.add(desc).add(hidden);
+    po::positional_options_description positional;
+    positional.add("input", 1);
+    po::variables_map vm;
+    bool usage = false;
+    try {
+        po::store(po::command_line_parser(argc, argv)
+                      .options(all)
+                      .positional(positional)
+                      .run(),
+                  vm);
+        po::notify(vm);
+    } catch (std::exception &e) {
+        std::cerr << "\nError parsing command line: " << e.what() << "\n\n";
+        usage = true;
+    }
+    if (usage || vm.count("help") || input.empty() ||
+        (format != "csv" && format != "json")) {
+        std::cerr << "\nConverts a recording made by osvr_record into CSV or "
+                     "JSON.\n";
+        std::cerr << "Usage: " << argv[0] << " [options] recording\n\n";
+        std::cerr << desc << "\n";
+        return 1;
+    }
+
+    try {
+        boost::interprocess::file_mapping file(input.c_str(),
+                                               boost::interprocess::read_only);
+        boost::interprocess::mapped_region region(
+            file, boost::interprocess::read_only);
+        RecordingView recording(static_cast<const char *>(region.get_address()),
+                                region.get_size());
+        std::cerr << "Converting " << recording.size() << " reports from "
+                  << recording.getPaths().size() << " paths." << std::endl;
+
+        std::ofstream outfile;
+        if (!output.empty()) {
+            outfile.open(output, std::ios::out | std::ios::binary);
+        }
+        std::ostream &os = output.empty() ? std::cout : outfile;
+        if (format == "csv") {
+            writeCSV(recording, os);
+        } else {
+            writeJSON(recording, os);
+        }
+    } catch (std::exception &e) {
+        std::cerr << "Could not convert " << input << ": " << e.what()
+                  << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,260 @@
+/** @file
+    @brief Benchmark measuring the error of pose prediction (extrapolation from
+   finite-difference velocity) against simply using the latest pose, on a
+   recorded tracker trace.
+
+   Usage: PosePredictionError [trace.csv [path]]
+
+   The trace is read from a CSV file as written by osvr_log_to_csv: if it has
+   more than one path in it, pass the one to use (such as /me/head). Without
+   a trace, a synthetic head-motion trace (with some sensor noise) is used.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Util/PosePrediction.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace pred = osvr::util::prediction;
+
+static const double PI = 3.14159265358979323846;
+
+/// @brief How far ahead to predict, in milliseconds.
+static const double HORIZONS[] = {10, 20, 33, 50};
+
+struct Sample {
+    double time;
+    Eigen::Vector3d position;
+    Eigen::Quaterniond orientation;
+};
+typedef std::vector<Sample> Trace;
+
+static std::vector<std::string> splitCSVLine(std::string const &line) {
+    std::vector<std::string> ret;
+    std::string cell;
+    std::istringstream is(line);
+    while (std::getline(is, cell, ',')) {
+        cell.erase(std::remove(cell.begin(), cell.end(), '"'), cell.end());
+        ret.push_back(cell);
+    }
+    return ret;
+}
+
+static bool loadTrace(std::string const &fn, std::string path, Trace &trace) {
+    std::ifstream is(fn);
+    std::string line;
+    if (!std::getline(is, line)) {
+        std::cerr << "Couldn't read " << fn << std::endl;
+        return false;
+    }
+    auto header = splitCSVLine(line);
+    if (path.empty()) {
+        for (auto const &col : header) {
+            if (col.size() > 2 && col.substr(col.size() - 2) == ":x") {
+                path = col.substr(0, col.size() - 2);
+                break;
+            }
+        }
+    }
+    auto findColumn = [&](std::string const &name) {
+        auto it = std::find(header.begin(), header.end(), name);
+        return it == header.end() ? -1 : int(it - header.begin());
+    };
+    const char *suffixes[] = {":x", ":y", ":z", ":qw", ":qx", ":qy", ":qz"};
+    int cols[9] = {findColumn("ts:seconds"), findColumn("ts:microseconds")};
+    for (int i = 0; i < 7; ++i) {
+        cols[i + 2] = findColumn(path + suffixes[i]);
+    }
+    if (std::find(std::begin(cols), std::end(cols), -1) != std::end(cols)) {
+        std::cerr << "Couldn't find timestamp and pose columns for path '"
+                  << path << "' in " << fn << std::endl;
+        return false;
+    }
+    std::cout << "Trace: " << fn << ", path " << path << std::endl;
+    while (std::getline(is, line)) {
+        auto cells = splitCSVLine(line);
+        double v[9];
+        bool complete = true;
+        for (int i = 0; i < 9; ++i) {
+            if (cols[i] >= int(cells.size()) || cells[cols[i]].empty()) {
+                complete = false;
+                break;
+            }
+            v[i] = std::atof(cells[cols[i]].c_str());
+        }
+        if (!complete) {
+            continue; // A row for another path.
+        }
+        Sample s;
+        s.time = v[0] + v[1] * 1.0e-6;
+        s.position = Eigen::Vector3d(v[2], v[3], v[4]);
+        s.orientation = Eigen::Quaterniond(v[5], v[6], v[7], v[8]).normalized();
+        if (!trace.empty() && s.time <= trace.back().time) {
+            continue;
+        }
+        trace.push_back(s);
+    }
+    return trace.size() > 2;
+}
+
+/// @brief Head motion made of a few sinusoids, sampled at 250 Hz with noise
+/// along the lines of an optical tracker's.
+static Trace makeSyntheticTrace() {
+    std::cout << "Trace: synthetic, 60 s at 250 Hz" << std::endl;
+    std::mt19937 gen(42);
+    std::normal_distribution<double> posNoise(0, 0.0002);
+    std::normal_distribution<double> angNoise(0, 0.05 * PI / 180);
+    Trace trace;
+    for (int i = 0; i < 60 * 250; ++i) {
+        double t = i / 250.;
+        double yaw =
+            0.8 * std::sin(2 * PI * 0.3 * t) + 0.2 * std::sin(2 * PI * 1.1 * t);
+        double pitch = 0.3 * std::sin(2 * PI * 0.5 * t + 1);
+        double roll = 0.1 * std::sin(2 * PI * 0.7 * t + 2);
+        Sample s;
+        s.time = t;
+        s.orientation =
+            Eigen::AngleAxisd(yaw, Eigen::Vector3d::UnitY()) *
+            Eigen::AngleAxisd(pitch, Eigen::Vector3d::UnitX()) *
+            Eigen::AngleAxisd(roll, Eigen::Vector3d::UnitZ()) *
+            pred::fromRotationVector(Eigen::Vector3d(
+                angNoise(gen), angNoise(gen), angNoise(gen)));
+        s.position =
+            Eigen::Vector3d(0.05 * std::sin(2 * PI * 0.4 * t) + posNoise(gen),
+                            1.6 + 0.02 * std::sin(2 * PI * 0.9 * t) +
+                                posNoise(gen),
+                            0.05 * std::sin(2 * PI * 0.25 * t) + posNoise(gen));
+        trace.push_back(s);
+    }
+    return trace;
+}
+
+/// @brief Interpolates the trace at the given time, if within it.
+static bool interpolate(Trace const &trace, double t, Sample &ret) {
+    auto it = std::lower_bound(
+        trace.begin(), trace.end(), t,
+        [](Sample const &s, double time) { return s.time < time; });
+    if (it == trace.begin() || it == trace.end()) {
+        return false;
+    }
+    auto const &after = *it;
+    auto const &before = *(it - 1);
+    auto alpha = (t - before.time) / (after.time - before.time);
+    ret.time = t;
+    ret.position = before.position + alpha * (after.position - before.position);
+    ret.orientation = before.orientation.slerp(alpha, after.orientation);
+    return true;
+}
+
+class ErrorStats {
+  public:
+    void add(Eigen::Vector3d const &posA, Eigen::Quaterniond const &oriA,
+             Eigen::Vector3d const &posB, Eigen::Quaterniond const &oriB) {
+        m_pos.push_back((posA - posB).norm() * 1000.);
+        m_ang.push_back(pred::toRotationVector(oriA * oriB.conjugate()).norm() *
+                        180. / PI);
+    }
+    void print(const char *label) {
+        std::cout << "  " << label << ": position mean " << mean(m_pos)
+                  << " mm, 95th " << percentile(m_pos, 95)
+                  << " mm; orientation mean " << mean(m_ang) << " deg, 95th "
+                  << percentile(m_ang, 95) << " deg" << std::endl;
+    }
+
+  private:
+    static double mean(std::vector<double> const &v) {
+        double total = 0;
+        for (auto x : v) {
+            total += x;
+        }
+        return v.empty() ? 0 : total / v.size();
+    }
+    static double percentile(std::vector<double> v, int p) {
+        if (v.empty()) {
+            return 0;
+        }
+        std::sort(v.begin(), v.end());
+        return v[v.size() * p / 100];
+    }
+    std::vector<double> m_pos;
+    std::vector<double> m_ang;
+};
+
+int main(int argc, char *argv[]) {
+    Trace trace;
+    if (argc > 1) {
+        if (!loadTrace(argv[1], argc > 2 ? argv[2] : "", trace)) {
+            return 1;
+        }
+    } else {
+        trace = makeSyntheticTrace();
+    }
+    std::cout << trace.size() << " samples over "
+              << trace.back().time - trace.front().time << " s" << std::endl;
+
+    for (auto horizonMs : HORIZONS) {
+        auto horizon = horizonMs / 1000.;
+        ErrorStats latest;
+        ErrorStats predicted;
+        for (std::size_t i = 1; i < trace.size(); ++i) {
+            auto const &prev = trace[i - 1];
+            auto const &cur = trace[i];
+            Sample truth;
+            if (!interpolate(trace, cur.time + horizon, truth)) {
+                continue;
+            }
+            auto dt = cur.time - prev.time;
+            Eigen::Isometry3d pose;
+            pose.fromPositionOrientationScale(cur.position, cur.orientation,
+                                              Eigen::Vector3d::Ones());
+            auto prediction = pred::predictPose(
+                pose,
+                pred::linearVelocityFromPositions(prev.position, cur.position,
+                                                  dt),
+                pred::angularVelocityFromOrientations(prev.orientation,
+                                                      cur.orientation, dt),
+                horizon);
+            latest.add(cur.position, cur.orientation, truth.position,
+                       truth.orientation);
+            predicted.add(prediction.translation(),
+                          Eigen::Quaterniond(prediction.rotation()),
+                          truth.position, truth.orientation);
+        }
+        std::cout << "Predicting " << horizonMs << " ms ahead:" << std::endl;
+        latest.print("latest pose");
+        predicted.print("predicted  ");
+    }
+    return 0;
+}
@@ -0,0 +1,178 @@
+/** @file
+    @brief Benchmark of the client-side cost of passing tracker reports on to
+   the handlers for a device, against the number of interfaces (one sensor
+   each) open on it: one vrpn_Tracker_Remote per interface, as the client used
+   to have, compared with the one remote per device shared through a
+   sensor-indexed table. Reports are sent over a loopback connection, so only
+   the dispatch is measured.
+
+   Usage: SensorDispatchCost [samples]
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "VRPNRemoteDispatchers.h"
+
+// Library/third-party includes
+#include <vrpn_Connection.h>
+#include <vrpn_Tracker.h>
+
+// Standard includes
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using osvr::client::TrackerPoseInfo;
+using osvr::client::TrackerRemoteDispatcher;
+using std::chrono::steady_clock;
+
+static const char DEVICE_NAME[] = "com_osvr_benchmark_SensorDispatchCost";
+
+namespace {
+/// @brief Stands in for a handler for one interface.
+struct Handler {
+    int sensor = 0;
+    std::size_t received = 0;
+    static void VRPN_CALLBACK handleVRPN(void *userdata, vrpn_TRACKERCB) {
+        ++static_cast<Handler *>(userdata)->received;
+    }
+    static void handleShared(void *userdata, TrackerPoseInfo const &) {
+        ++static_cast<Handler *>(userdata)->received;
+    }
+};
+
+struct Result {
+    double microsecondsPerSample;
+    std::size_t received;
+};
+
+/// @brief Sends a report for each sensor per sample, with updates as a
+/// client would make, returning the time per sample.
+template <typename F>
+Result run(int sensors, int samples, vrpn_Connection *conn,
+           std::vector<Handler> &handlers, F &&update) {
+    vrpn_Tracker_Server server(DEVICE_NAME, conn, sensors);
+    timeval now;
+    vrpn_float64 pos[3] = {0, 0, 0};
+    vrpn_float64 quat[4] = {0, 0, 0, 1};
+    auto start = steady_clock::now();
+    for (int i = 0; i < samples; ++i) {
+        vrpn_gettimeofday(&now, nullptr);
+        for (int sensor = 0; sensor < sensors; ++sensor) {
+            server.report_pose(sensor, now, pos, quat);
+        }
+        server.mainloop();
+        update();
+    }
+    auto elapsed = steady_clock::now() - start;
+    Result ret;
+    ret.microsecondsPerSample =
+        std::chrono::duration<double, std::micro>(elapsed).count() / samples;
+    ret.received = 0;
+    for (auto const &h : handlers) {
+        ret.received += h.received;
+    }
+    return ret;
+}
+
+/// @brief One remote per interface, each updated, and each getting (and
+/// filtering) every report.
+Result runSeparate(int sensors, int samples) {
+    vrpn_ConnectionPtr conn(vrpn_create_server_connection("loopback:"));
+    conn->removeReference(); // Remove extra reference.
+    std::vector<Handler> handlers(sensors);
+    std::vector<std::unique_ptr<vrpn_Tracker_Remote> > remotes;
+    for (int i = 0; i < sensors; ++i) {
+        handlers[i].sensor = i;
+        remotes.emplace_back(new vrpn_Tracker_Remote(DEVICE_NAME, conn.get()));
+        remotes.back()->register_change_handler(&handlers[i],
+                                                &Handler::handleVRPN, i);
+    }
+    auto ret = run(sensors, samples, conn.get(), handlers, [&] {
+        for (auto &remote : remotes) {
+            remote->mainloop();
+        }
+    });
+    for (int i = 0; i < sensors; ++i) {
+        remotes[i]->unregister_change_handler(&handlers[i],
+                                              &Handler::handleVRPN, i);
+    }
+    return ret;
+}
+
+/// @brief One remote for the device, updated once, passing each report to
+/// just the handler for its sensor.
+Result runShared(int sensors, int samples) {
+    vrpn_ConnectionPtr conn(vrpn_create_server_connection("loopback:"));
+    conn->removeReference(); // Remove extra reference.
+    std::vector<Handler> handlers(sensors);
+    TrackerRemoteDispatcher remote(conn, DEVICE_NAME);
+    for (int i = 0; i < sensors; ++i) {
+        handlers[i].sensor = i;
+        remote.poses().registerHandler(&Handler::handleShared, &handlers[i],
+                                       i);
+    }
+    auto ret =
+        run(sensors, samples, conn.get(), handlers, [&] { remote.update(); });
+    for (int i = 0; i < sensors; ++i) {
+        remote.poses().unregisterHandler(&Handler::handleShared, &handlers[i],
+                                         i);
+    }
+    return ret;
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+    int samples = argc > 1 ? std::atoi(argv[1]) : 2000;
+    if (samples <= 0) {
+        std::cerr << "Usage: SensorDispatchCost [samples]" << std::endl;
+        return 1;
+    }
+    std::cout << "Time per sample (one report per sensor), " << samples
+              << " samples" << std::endl;
+    std::cout << std::setw(12) << "interfaces" << std::setw(22)
+              << "remote each (us)" << std::setw(22) << "shared remote (us)"
+              << std::setw(12) << "speedup" << std::endl;
+    for (int sensors : {1, 5, 10, 20, 40, 80, 160}) {
+        auto separate = runSeparate(sensors, samples);
+        auto shared = runShared(sensors, samples);
+        auto expected = std::size_t(sensors) * samples;
+        if (separate.received != expected || shared.received != expected) {
+            std::cerr << "Expected " << expected << " reports, got "
+                      << separate.received << " with a remote each and "
+                      << shared.received << " with a shared remote"
+                      << std::endl;
+            return 1;
+        }
+        std::cout << std::setw(12) << sensors << std::setw(22)
+                  << separate.microsecondsPerSample << std::setw(22)
+                  << shared.microsecondsPerSample << std::setw(12)
+                  << separate.microsecondsPerSample /
+                         shared.microsecondsPerSample
+                  << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,175 @@
+/** @file
+    @brief Benchmark measuring the time from an async device sending a report
+   to a client receiving it, through a server running in its own thread, as
+   well as the CPU time the process uses meanwhile.
+
+   Usage: ServerLoopLatency [sleep microseconds] [reports per second] [seconds]
+   [poll]
+
+   A report rate of 0 measures an idle (but client-connected) server. Passing
+   "poll" registers a mainloop method, so the server has to run its loop every
+   time through, as it would with a sync device.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Connection/Connection.h>
+#include <osvr/Connection/DeviceInitObject.h>
+#include <osvr/Connection/DeviceToken.h>
+#include <osvr/Connection/MessageType.h>
+#include <osvr/Server/Server.h>
+#include <osvr/Util/TimeValue.h>
+#include <vrpn_Connection.h>
+#include <vrpn_ConnectionPtr.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const char DEVICE_NAME[] = "com_osvr_benchmark_ServerLoopLatency";
+static const char MESSAGE_NAME[] = "com_osvr_benchmark_ServerLoopLatency_report";
+
+namespace {
+class LatencyRecorder {
+  public:
+    LatencyRecorder() { m_latencies.reserve(100000); }
+    static int VRPN_CALLBACK handle(void *userdata, vrpn_HANDLERPARAM p) {
+        osvr::util::time::TimeValue now;
+        osvr::util::time::getNow(now);
+        auto sent = osvr::util::time::fromStructTimeval(p.msg_time);
+        auto self = static_cast<LatencyRecorder *>(userdata);
+        if (self->m_recording) {
+            self->m_latencies.push_back(
+                osvr::util::time::duration(now, sent) * 1.0e6);
+        }
+        return 0;
+    }
+    void startRecording() { m_recording = true; }
+    void stopRecording() { m_recording = false; }
+    std::vector<double> &get() { return m_latencies; }
+
+  private:
+    std::vector<double> m_latencies;
+    std::atomic<bool> m_recording{false};
+};
+} // namespace
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> args(argv + 1, argv + argc);
+    int sleepTime = args.size() > 0 ? std::atoi(args[0].c_str()) : 0;
+    int rate = args.size() > 1 ? std::atoi(args[1].c_str()) : 500;
+    int seconds = args.size() > 2 ? std::atoi(args[2].c_str()) : 5;
+    bool poll = args.size() > 3 && args[3] == "poll";
+
+    // Server side: an async device sending a small report at a fixed rate.
+    auto conn = osvr::connection::Connection::createLocalConnection();
+    OSVR_DeviceInitObject init(conn);
+    init.setName(DEVICE_NAME);
+    auto token = OSVR_DeviceTokenObject::createAsyncDevice(init);
+    auto msgType = conn->registerMessageType(MESSAGE_NAME);
+    std::atomic<bool> sending(false);
+    token->setUpdateCallback([&] {
+        if (rate <= 0 || !sending) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            return OSVR_RETURN_SUCCESS;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(1000000 / rate));
+        osvr::util::time::TimeValue now;
+        osvr::util::time::getNow(now);
+        const char payload[8] = {0};
+        token->sendData(now, msgType.get(), payload, sizeof(payload));
+        return OSVR_RETURN_SUCCESS;
+    });
+
+    auto server = osvr::server::Server::create(conn);
+    server->setSleepTime(sleepTime);
+    if (poll) {
+        server->registerMainloopMethod([] {});
+    }
+    server->start();
+
+    // Client side: a plain VRPN connection, waiting in select() for messages
+    // so it adds as little latency of its own as possible.
+    std::atomic<bool> clientRunning(true);
+    LatencyRecorder recorder;
+    std::thread clientThread([&] {
+        vrpn_ConnectionPtr client(vrpn_get_connection_by_name(
+            "localhost", nullptr, nullptr, nullptr, nullptr, nullptr, true));
+        client->removeReference(); // Remove extra reference.
+        client->register_handler(client->register_message_type(MESSAGE_NAME),
+                                 &LatencyRecorder::handle, &recorder,
+                                 client->register_sender(DEVICE_NAME));
+        while (clientRunning) {
+            timeval timeout = {0, 10000};
+            client->mainloop(&timeout);
+        }
+    });
+
+    // Let the client connect before we start measuring.
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    sending = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    recorder.startRecording();
+    auto cpuStart = std::clock();
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    auto cpuSeconds = double(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    recorder.stopRecording();
+
+    sending = false;
+    clientRunning = false;
+    clientThread.join();
+    server->stop();
+
+    std::cout << "Sleep time: " << sleepTime << " us, "
+              << (poll ? "polling" : "no polling required") << ", " << rate
+              << " reports/s for " << seconds << " s" << std::endl;
+    std::cout << "Process CPU: " << 100. * cpuSeconds / seconds
+              << "% of one core" << std::endl;
+    auto &latencies = recorder.get();
+    if (latencies.empty()) {
+        std::cout << "No reports received." << std::endl;
+        return 0;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    double total = 0;
+    for (auto l : latencies) {
+        total += l;
+    }
+    std::cout << "Report-to-receive latency over " << latencies.size()
+              << " reports: mean " << total / latencies.size()
+              << " us, median " << latencies[latencies.size() / 2]
+              << " us, 99th percentile "
+              << latencies[latencies.size() * 99 / 100] << " us, max "
+              << latencies.back() << " us" << std::endl;
+    return 0;
+}
@@ -0,0 +1,171 @@
+/** @file
+    @brief Multi-process contention benchmark for the IPC ring buffer's
+   synchronization modes: one producer putting camera-sized frames while
+   several reader processes (spawned copies of this executable) read them.
+
+   Usage: SharedMemoryContention [mutex|seqlock] [readers] [seconds]
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/IPCRingBuffer.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using osvr::common::IPCRingBuffer;
+using std::chrono::steady_clock;
+
+static const char BUFFER_NAME[] = "com.osvr.benchmark.contention";
+/// @brief One 8-bit 1080p frame.
+static const IPCRingBuffer::entry_size_type FRAME_SIZE = 1920 * 1080;
+/// @brief Simulated per-frame work done by readers while holding the frame.
+static const std::chrono::microseconds READER_WORK(2000);
+
+static IPCRingBuffer::Options makeOptions(std::string const &mode) {
+    auto syncMode = (mode == "seqlock")
+                        ? IPCRingBuffer::SyncMode::Seqlock
+                        : IPCRingBuffer::SyncMode::InterprocessMutex;
+    return IPCRingBuffer::Options(BUFFER_NAME)
+        .setEntrySize(FRAME_SIZE)
+        .setSyncMode(syncMode);
+}
+
+static double toMicroseconds(steady_clock::duration d) {
+    return std::chrono::duration<double, std::micro>(d).count();
+}
+
+static int runReader(std::string const &mode, int seconds) {
+    auto buf = IPCRingBuffer::find(makeOptions(mode));
+    if (!buf) {
+        std::cerr << "Reader: couldn't find the ring buffer." << std::endl;
+        return 1;
+    }
+    auto end = steady_clock::now() + std::chrono::seconds(seconds);
+    std::size_t frames = 0;
+    std::size_t misses = 0;
+    unsigned checksum = 0;
+    IPCRingBuffer::sequence_type lastSeq = 0;
+    while (steady_clock::now() < end) {
+        auto res = buf->getLatest();
+        if (!res) {
+            ++misses;
+            continue;
+        }
+        if (frames > 0 && res.getSequenceNumber() == lastSeq) {
+            std::this_thread::yield();
+            continue;
+        }
+        lastSeq = res.getSequenceNumber();
+        ++frames;
+        // Touch the frame and hold onto it, as an image-processing client
+        // would.
+        for (std::size_t i = 0; i < FRAME_SIZE; i += 4096) {
+            checksum += res.get()[i];
+        }
+        std::this_thread::sleep_for(READER_WORK);
+    }
+    std::ostringstream os;
+    os << "Reader: " << frames << " frames, " << misses
+       << " failed reads (checksum " << checksum << ")\n";
+    std::cout << os.str() << std::flush;
+    return 0;
+}
+
+static int runProducer(std::string const &argv0, std::string const &mode,
+                       int readers, int seconds) {
+    auto buf = IPCRingBuffer::create(makeOptions(mode));
+    if (!buf) {
+        std::cerr << "Couldn't create the ring buffer." << std::endl;
+        return 1;
+    }
+    std::cout << "Mode: " << mode << ", " << readers << " reader processes, "
+              << seconds << " seconds, " << buf->getEntries()
+              << " entries of " << buf->getEntrySize() << " bytes"
+              << std::endl;
+
+    std::vector<std::thread> readerThreads;
+    for (int i = 0; i < readers; ++i) {
+        std::ostringstream cmd;
+        cmd << "\"" << argv0 << "\" reader " << mode << " " << seconds;
+        auto cmdString = cmd.str();
+        readerThreads.emplace_back([cmdString] {
+            auto ret = std::system(cmdString.c_str());
+            (void)ret;
+        });
+    }
+
+    std::vector<double> putTimes;
+    std::vector<IPCRingBuffer::value_type> frame(FRAME_SIZE);
+    auto end = steady_clock::now() + std::chrono::seconds(seconds);
+    while (steady_clock::now() < end) {
+        std::fill(frame.begin(), frame.end(),
+                  IPCRingBuffer::value_type(putTimes.size()));
+        auto start = steady_clock::now();
+        buf->put(frame.data(), frame.size());
+        putTimes.push_back(toMicroseconds(steady_clock::now() - start));
+        // Roughly a 120 Hz camera.
+        std::this_thread::sleep_for(std::chrono::milliseconds(8));
+    }
+
+    for (auto &t : readerThreads) {
+        t.join();
+    }
+
+    if (putTimes.empty()) {
+        return 0;
+    }
+    std::sort(putTimes.begin(), putTimes.end());
+    double total = 0;
+    for (auto t : putTimes) {
+        total += t;
+    }
+    std::cout << "Producer: " << putTimes.size() << " puts, mean "
+              << total / putTimes.size() << " us, median "
+              << putTimes[putTimes.size() / 2] << " us, 99th percentile "
+              << putTimes[putTimes.size() * 99 / 100] << " us, max "
+              << putTimes.back() << " us" << std::endl;
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> args(argv + 1, argv + argc);
+    if (!args.empty() && args[0] == "reader") {
+        return runReader(args.size() > 1 ? args[1] : "mutex",
+                         args.size() > 2 ? std::atoi(args[2].c_str()) : 5);
+    }
+    std::string mode = args.size() > 0 ? args[0] : "mutex";
+    int readers = args.size() > 1 ? std::atoi(args[1].c_str()) : 4;
+    int seconds = args.size() > 2 ? std::atoi(args[2].c_str()) : 5;
+    return runProducer(argv[0], mode, readers, seconds);
+}
@@ -0,0 +1,227 @@
+/** @file
+    @brief Benchmark comparing how tracker reports reach a client on the same
+   host over the loopback VRPN connection and over the shared-memory report
+   channel: an async device in a server thread sends poses at a fixed rate,
+   while a client thread receives them one way or the other, recording the
+   latency from send to receipt and counting what arrives.
+
+   Usage: SharedReportLatency [socket|shm] [reports per second] [seconds]
+   [shm poll interval microseconds]
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include <osvr/Common/SharedReportChannel.h>
+#include <osvr/Connection/Connection.h>
+#include <osvr/Connection/ConnectionDevice.h>
+#include <osvr/Connection/DeviceInitObject.h>
+#include <osvr/Connection/DeviceToken.h>
+#include <osvr/Connection/TrackerServerInterface.h>
+#include <osvr/Server/Server.h>
+#include <osvr/Util/GuardInterface.h>
+#include <osvr/Util/TimeValue.h>
+#include <vrpn_Connection.h>
+#include <vrpn_ConnectionPtr.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const char DEVICE_NAME[] = "com_osvr_benchmark_SharedReportLatency";
+
+namespace {
+class LatencyRecorder {
+  public:
+    LatencyRecorder() { m_latencies.reserve(100000); }
+    static int VRPN_CALLBACK handle(void *userdata, vrpn_HANDLERPARAM p) {
+        static_cast<LatencyRecorder *>(userdata)->record(
+            osvr::util::time::fromStructTimeval(p.msg_time));
+        return 0;
+    }
+    void record(osvr::util::time::TimeValue const &sent) {
+        osvr::util::time::TimeValue now;
+        osvr::util::time::getNow(now);
+        if (m_recording) {
+            m_latencies.push_back(osvr::util::time::duration(now, sent) *
+                                  1.0e6);
+        }
+    }
+    void startRecording() { m_recording = true; }
+    void stopRecording() { m_recording = false; }
+    std::vector<double> &get() { return m_latencies; }
+
+  private:
+    std::vector<double> m_latencies;
+    std::atomic<bool> m_recording{false};
+};
+} // namespace
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> args(argv + 1, argv + argc);
+    bool shm = args.size() > 0 && args[0] == "shm";
+    int rate = args.size() > 1 ? std::atoi(args[1].c_str()) : 1000;
+    int seconds = args.size() > 2 ? std::atoi(args[2].c_str()) : 5;
+    int pollInterval = args.size() > 3 ? std::atoi(args[3].c_str()) : 100;
+    if (rate <= 0 || seconds <= 0 || pollInterval < 0) {
+        std::cerr << "Usage: SharedReportLatency [socket|shm] [reports per "
+                     "second] [seconds] [shm poll interval microseconds]"
+                  << std::endl;
+        return 1;
+    }
+
+    // Server side: an async device sending a pose at a fixed rate.
+    auto conn = osvr::connection::Connection::createLocalConnection();
+    OSVR_DeviceInitObject init(conn);
+    init.setName(DEVICE_NAME);
+    osvr::connection::TrackerServerInterface *tracker = nullptr;
+    init.setTracker(&tracker);
+    auto token = OSVR_DeviceTokenObject::createAsyncDevice(init);
+    std::atomic<bool> sending(false);
+    std::atomic<std::size_t> sent(0);
+    auto period = std::chrono::microseconds(1000000 / rate);
+    auto nextReport = std::chrono::steady_clock::now();
+    OSVR_PoseState pose;
+    osvrPose3SetIdentity(&pose);
+    token->setUpdateCallback([&] {
+        if (!sending) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            nextReport = std::chrono::steady_clock::now();
+            return OSVR_RETURN_SUCCESS;
+        }
+        nextReport += period;
+        std::this_thread::sleep_until(nextReport);
+        osvr::util::time::TimeValue now;
+        osvr::util::time::getNow(now);
+        auto guard = token->getSendGuard();
+        if (guard->lock()) {
+            tracker->sendReport(pose, 0, now);
+            ++sent;
+        }
+        return OSVR_RETURN_SUCCESS;
+    });
+
+    auto server = osvr::server::Server::create(conn);
+    server->start();
+    // What the server advertises in the device's path tree node.
+    auto channelName = conn->getDevices().front()->getSharedReportChannel();
+
+    // Client side: either a plain VRPN connection, waiting in select() for
+    // messages, or a reader polling the device's shared memory channel.
+    std::atomic<bool> clientRunning(true);
+    LatencyRecorder recorder;
+    std::size_t dropped = 0;
+    std::thread clientThread([&] {
+        if (shm) {
+            auto reports = osvr::common::SharedReportChannel::find(channelName);
+            if (!reports) {
+                std::cerr << "Could not open the shared memory channel!"
+                          << std::endl;
+                return;
+            }
+            osvr::common::SharedReportRecord records[64];
+            while (clientRunning) {
+                auto n = reports->poll(records, 64);
+                for (std::size_t i = 0; i < n; ++i) {
+                    recorder.record(records[i].timestamp);
+                }
+                if (n == 0) {
+                    std::this_thread::sleep_for(
+                        std::chrono::microseconds(pollInterval));
+                }
+            }
+            dropped = reports->getDropped();
+            return;
+        }
+        vrpn_ConnectionPtr client(vrpn_get_connection_by_name(
+            "localhost", nullptr, nullptr, nullptr, nullptr, nullptr, true));
+        client->removeReference(); // Remove extra reference.
+        client->register_handler(
+            client->register_message_type("vrpn_Tracker Pos_Quat"),
+            &LatencyRecorder::handle, &recorder,
+            client->register_sender(DEVICE_NAME));
+        while (clientRunning) {
+            timeval timeout = {0, 10000};
+            client->mainloop(&timeout);
+        }
+    });
+
+    // Let the client connect before we start measuring.
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    sending = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    recorder.startRecording();
+    auto sentBefore = sent.load();
+    auto cpuStart = std::clock();
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    auto cpuSeconds = double(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    auto sentDuring = sent.load() - sentBefore;
+    recorder.stopRecording();
+
+    sending = false;
+    clientRunning = false;
+    clientThread.join();
+    server->stop();
+
+    std::cout << (shm ? "Shared memory" : "Loopback socket") << ", " << rate
+              << " reports/s for " << seconds << " s";
+    if (shm) {
+        std::cout << ", polling every " << pollInterval << " us";
+    }
+    std::cout << std::endl;
+    std::cout << "Process CPU: " << 100. * cpuSeconds / seconds
+              << "% of one core" << std::endl;
+    auto &latencies = recorder.get();
+    std::cout << "Sent " << double(sentDuring) / seconds
+              << " reports/s, received " << double(latencies.size()) / seconds
+              << " reports/s";
+    if (shm) {
+        std::cout << " (" << dropped << " dropped by falling behind)";
+    }
+    std::cout << std::endl;
+    if (latencies.empty()) {
+        std::cout << "No reports received." << std::endl;
+        return 0;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    double total = 0;
+    for (auto l : latencies) {
+        total += l;
+    }
+    std::cout << "Report-to-receive latency: mean "
+              << total / latencies.size() << " us, median "
+              << latencies[latencies.size() / 2] << " us, 99th percentile "
+              << latencies[latencies.size() * 99 / 100] << " us, max "
+              << latencies.back() << " us" << std::endl;
+    return 0;
+}
@@ -0,0 +1,170 @@
+/** @file
+    @brief Microbenchmark for the registered string maps: how long it takes a
+   client to correlate a server's string map with thousands of names, and to
+   look up names already registered, compared with a linear search of the
+   entries as the maps used to do.
+
+   Usage: StringMapLookup [names] [repetitions]
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/RegisteredStringMap.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using osvr::common::CorrelatedStringMap;
+using osvr::common::RegisteredStringMap;
+using std::chrono::steady_clock;
+
+namespace {
+/// @brief The string map lookup as it was before the hash index: a linear
+/// search of the entries.
+class LinearStringMap {
+  public:
+    std::uint32_t getStringID(std::string const &str) {
+        auto entry = std::find(begin(m_entries), end(m_entries), str);
+        if (end(m_entries) != entry) {
+            return std::uint32_t(std::distance(begin(m_entries), entry));
+        }
+        m_entries.push_back(str);
+        return std::uint32_t(m_entries.size() - 1);
+    }
+
+  private:
+    std::vector<std::string> m_entries;
+};
+
+double toMicroseconds(steady_clock::duration d) {
+    return std::chrono::duration<double, std::micro>(d).count();
+}
+
+void report(std::string const &label, std::vector<double> &times) {
+    std::sort(times.begin(), times.end());
+    double total = 0;
+    for (auto t : times) {
+        total += t;
+    }
+    std::cout << label << ": mean " << total / times.size() << " us, median "
+              << times[times.size() / 2] << " us, 99th percentile "
+              << times[times.size() * 99 / 100] << " us, max " << times.back()
+              << " us" << std::endl;
+}
+
+/// @brief Times each of several runs of a function, in microseconds.
+template <typename F>
+std::vector<double> timeRepeatedly(int repetitions, F &&f) {
+    std::vector<double> times;
+    for (int i = 0; i < repetitions; ++i) {
+        auto start = steady_clock::now();
+        f();
+        times.push_back(toMicroseconds(steady_clock::now() - start));
+    }
+    return times;
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> args(argv + 1, argv + argc);
+    int names = args.size() > 0 ? std::atoi(args[0].c_str()) : 5000;
+    int repetitions = args.size() > 1 ? std::atoi(args[1].c_str()) : 20;
+    if (names <= 0 || repetitions <= 0) {
+        std::cerr << "Usage: StringMapLookup [names] [repetitions]"
+                  << std::endl;
+        return 1;
+    }
+
+    // Path-like names with a long shared prefix, as real ones have.
+    std::vector<std::string> peerEntries;
+    for (int i = 0; i < names; ++i) {
+        peerEntries.push_back("/com_osvr_Vendor/Device/semantic/sensor/" +
+                              std::to_string(i));
+    }
+    // The local side already knows every other name, in a different order.
+    std::vector<std::string> localEntries;
+    for (int i = names - 1; i >= 0; i -= 2) {
+        localEntries.push_back(peerEntries[i]);
+    }
+
+    std::cout << names << " peer names, " << localEntries.size()
+              << " already registered locally, " << repetitions
+              << " repetitions" << std::endl;
+
+    std::uint32_t checksum = 0;
+    auto linearSetup = timeRepeatedly(repetitions, [&] {
+        LinearStringMap map;
+        for (auto const &name : localEntries) {
+            map.getStringID(name);
+        }
+        std::vector<std::uint32_t> remoteToLocal;
+        for (auto const &name : peerEntries) {
+            remoteToLocal.push_back(map.getStringID(name));
+        }
+        checksum += remoteToLocal.back();
+    });
+    report("Linear search setupPeerMappings", linearSetup);
+
+    auto hashedSetup = timeRepeatedly(repetitions, [&] {
+        CorrelatedStringMap map;
+        for (auto const &name : localEntries) {
+            map.getStringID(name);
+        }
+        map.setupPeerMappings(peerEntries);
+        checksum += map.convertPeerToLocalID(
+                           osvr::util::PeerStringID(names - 1)).value();
+    });
+    report("Hash index setupPeerMappings", hashedSetup);
+
+    // Lookups of names already registered, as the server does when devices
+    // and clients refer to paths by name.
+    LinearStringMap linear;
+    RegisteredStringMap hashed;
+    for (auto const &name : peerEntries) {
+        linear.getStringID(name);
+        hashed.getStringID(name);
+    }
+    auto linearLookup = timeRepeatedly(repetitions, [&] {
+        for (auto const &name : peerEntries) {
+            checksum += linear.getStringID(name);
+        }
+    });
+    report("Linear search lookup of all names", linearLookup);
+    auto hashedLookup = timeRepeatedly(repetitions, [&] {
+        for (auto const &name : peerEntries) {
+            checksum += hashed.getStringID(name.c_str()).value();
+        }
+    });
+    report("Hash index lookup of all names", hashedLookup);
+
+    std::cout << "(checksum " << checksum << ")" << std::endl;
+    return 0;
+}
@@ -0,0 +1,232 @@
+/** @file
+    @brief Benchmark comparing a multi-sensor tracker sending one message per
+   sensor per sample with sending all the poses of a sample as a batch: an
+   async device in a server thread sends at a fixed sample rate, while a
+   client counts the messages and poses it receives.
+
+   Usage: TrackerPoseBatchRate [single|batch] [sensors] [samples per second]
+   [seconds]
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/Buffer.h>
+#include <osvr/Common/Serialization.h>
+#include <osvr/Common/TrackerPoseBatch.h>
+#include <osvr/Connection/Connection.h>
+#include <osvr/Connection/DeviceInitObject.h>
+#include <osvr/Connection/DeviceToken.h>
+#include <osvr/Connection/TrackerServerInterface.h>
+#include <osvr/Server/Server.h>
+#include <osvr/Util/GuardInterface.h>
+#include <osvr/Util/TimeValue.h>
+#include <vrpn_Connection.h>
+#include <vrpn_ConnectionPtr.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using osvr::common::messages::TrackerPoseBatch;
+using std::chrono::steady_clock;
+
+static const char DEVICE_NAME[] = "com_osvr_benchmark_TrackerPoseBatchRate";
+
+namespace {
+class ReceiveCounter {
+  public:
+    static int VRPN_CALLBACK handleSingle(void *userdata, vrpn_HANDLERPARAM) {
+        auto self = static_cast<ReceiveCounter *>(userdata);
+        if (self->m_recording) {
+            ++self->m_messages;
+            ++self->m_poses;
+        }
+        return 0;
+    }
+    static int VRPN_CALLBACK handleBatch(void *userdata, vrpn_HANDLERPARAM p) {
+        auto self = static_cast<ReceiveCounter *>(userdata);
+        // Decode, as a client would.
+        auto reader = osvr::common::readExternalBuffer(p.buffer, p.payload_len);
+        TrackerPoseBatch::MessageSerialization msg(self->m_batch);
+        osvr::common::deserialize(reader, msg);
+        if (self->m_recording) {
+            ++self->m_messages;
+            self->m_poses += self->m_batch.size();
+        }
+        return 0;
+    }
+    void startRecording() { m_recording = true; }
+    void stopRecording() { m_recording = false; }
+    std::size_t getMessages() const { return m_messages; }
+    std::size_t getPoses() const { return m_poses; }
+
+  private:
+    std::atomic<bool> m_recording{false};
+    std::size_t m_messages = 0;
+    std::size_t m_poses = 0;
+    std::vector<osvr::common::TrackerPoseBatchEntry> m_batch;
+};
+} // namespace
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> args(argv + 1, argv + argc);
+    bool batch = args.size() > 0 && args[0] == "batch";
+    int sensors = args.size() > 1 ? std::atoi(args[1].c_str()) : 64;
+    int rate = args.size() > 2 ? std::atoi(args[2].c_str()) : 1000;
+    int seconds = args.size() > 3 ? std::atoi(args[3].c_str()) : 5;
+    if (sensors <= 0 || rate <= 0 || seconds <= 0) {
+        std::cerr << "Usage: TrackerPoseBatchRate [single|batch] [sensors] "
+                     "[samples per second] [seconds]"
+                  << std::endl;
+        return 1;
+    }
+
+    std::vector<OSVR_PoseState> poses(sensors);
+    for (int i = 0; i < sensors; ++i) {
+        osvrPose3SetIdentity(&poses[i]);
+        poses[i].translation.data[0] = i;
+    }
+
+    // Server side: an async device sending all its sensors' poses at a fixed
+    // sample rate, timing each sample's sends.
+    auto conn = osvr::connection::Connection::createLocalConnection();
+    OSVR_DeviceInitObject init(conn);
+    init.setName(DEVICE_NAME);
+    osvr::connection::TrackerServerInterface *tracker = nullptr;
+    init.setTracker(&tracker);
+    auto token = OSVR_DeviceTokenObject::createAsyncDevice(init);
+    std::atomic<bool> sending(false);
+    std::atomic<bool> recordingSends(false);
+    std::vector<double> sendTimes;
+    sendTimes.reserve(rate * seconds * 2);
+    auto period = std::chrono::microseconds(1000000 / rate);
+    auto nextSample = steady_clock::now();
+    token->setUpdateCallback([&] {
+        if (!sending) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            nextSample = steady_clock::now();
+            return OSVR_RETURN_SUCCESS;
+        }
+        nextSample += period;
+        std::this_thread::sleep_until(nextSample);
+        osvr::util::time::TimeValue now;
+        osvr::util::time::getNow(now);
+        auto start = steady_clock::now();
+        {
+            auto guard = token->getSendGuard();
+            if (guard->lock()) {
+                if (batch) {
+                    tracker->sendPoseReports(poses.data(), nullptr,
+                                             OSVR_ChannelCount(sensors), now);
+                } else {
+                    for (int i = 0; i < sensors; ++i) {
+                        tracker->sendReport(poses[i], OSVR_ChannelCount(i),
+                                            now);
+                    }
+                }
+            }
+        }
+        if (recordingSends) {
+            sendTimes.push_back(std::chrono::duration<double, std::micro>(
+                                    steady_clock::now() - start)
+                                    .count());
+        }
+        return OSVR_RETURN_SUCCESS;
+    });
+
+    auto server = osvr::server::Server::create(conn);
+    server->start();
+
+    // Client side: a plain VRPN connection counting both kinds of messages.
+    std::atomic<bool> clientRunning(true);
+    ReceiveCounter counter;
+    std::thread clientThread([&] {
+        vrpn_ConnectionPtr client(vrpn_get_connection_by_name(
+            "localhost", nullptr, nullptr, nullptr, nullptr, nullptr, true));
+        client->removeReference(); // Remove extra reference.
+        auto sender = client->register_sender(DEVICE_NAME);
+        client->register_handler(
+            client->register_message_type("vrpn_Tracker Pos_Quat"),
+            &ReceiveCounter::handleSingle, &counter, sender);
+        client->register_handler(
+            client->register_message_type(TrackerPoseBatch::identifier()),
+            &ReceiveCounter::handleBatch, &counter, sender);
+        while (clientRunning) {
+            timeval timeout = {0, 10000};
+            client->mainloop(&timeout);
+        }
+    });
+
+    // Let the client connect before we start measuring.
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    sending = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    counter.startRecording();
+    recordingSends = true;
+    auto cpuStart = std::clock();
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    auto cpuSeconds = double(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    recordingSends = false;
+    counter.stopRecording();
+
+    sending = false;
+    clientRunning = false;
+    clientThread.join();
+    server->stop();
+
+    std::cout << (batch ? "Batched" : "One message per sensor") << ", "
+              << sensors << " sensors at " << rate << " samples/s for "
+              << seconds << " s" << std::endl;
+    std::cout << "Process CPU: " << 100. * cpuSeconds / seconds
+              << "% of one core" << std::endl;
+    std::cout << "Samples sent: " << sendTimes.size() << " ("
+              << double(sendTimes.size()) / seconds << " per second)"
+              << std::endl;
+    std::cout << "Received: " << double(counter.getMessages()) / seconds
+              << " messages/s carrying " << double(counter.getPoses()) / seconds
+              << " poses/s" << std::endl;
+    if (sendTimes.empty()) {
+        return 0;
+    }
+    std::sort(sendTimes.begin(), sendTimes.end());
+    double total = 0;
+    for (auto t : sendTimes) {
+        total += t;
+    }
+    std::cout << "Time to send a sample: mean " << total / sendTimes.size()
+              << " us, median " << sendTimes[sendTimes.size() / 2]
+              << " us, 99th percentile "
+              << sendTimes[sendTimes.size() * 99 / 100] << " us, max "
+              << sendTimes.back() << " us" << std::endl;
+    return 0;
+}
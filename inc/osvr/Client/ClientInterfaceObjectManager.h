@@ -87,10 +87,18 @@ namespace client {
         /// or more interface objects but no remote handler.
         void m_connectNeededCallbacks();
 
+        /// @brief Removes the handlers of those paths that resolve differently
+        /// in the newly-replaced path tree, leaving the rest (and their VRPN
+        /// remotes) running.
+        void m_removeChangedCallbacks();
+
         /// @brief Tree parallel to path tree for holding interface objects and
         /// remote handlers.
         InterfaceTree m_interfaces;
 
+        /// @brief The common::PathTreeOwner passed into constructor.
+        common::PathTreeOwner &m_treeOwner;
+
         /// @brief Reference to the main path tree object, retrieved from the
         /// common::PathTreeOwner passed into constructor.
         common::PathTree &m_pathTree;
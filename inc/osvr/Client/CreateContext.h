@@ -33,15 +33,27 @@
 // - none
 
 // Standard includes
-// - none
+#include <cstdint>
 
 class vrpn_ConnectionPtr;
 
 namespace osvr {
 namespace client {
 
+    /// @brief Options for createContext(), to be combined with bitwise-or.
+    enum ContextFlags {
+        /// @brief Update the context on a thread of its own, rather than in
+        /// the app's calls to update(). State reads never wait on it.
+        CONTEXT_UPDATE_THREAD = 1 << 0,
+        /// @brief With CONTEXT_UPDATE_THREAD, queue callbacks to be called
+        /// on the app's thread in its calls to update(), rather than calling
+        /// them on the update thread.
+        CONTEXT_DEFER_CALLBACKS = 1 << 1
+    };
+
     OSVR_CLIENT_EXPORT common::ClientContext *
-    createContext(const char appId[], const char host[] = "localhost");
+    createContext(const char appId[], const char host[] = "localhost",
+                  std::uint32_t flags = 0);
 
     OSVR_CLIENT_EXPORT common::ClientContext *
     createAnalysisClientContext(const char appId[], const char host[],
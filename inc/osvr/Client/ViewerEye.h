@@ -27,6 +27,7 @@
 
 // Internal Includes
 #include <osvr/Util/ClientOpaqueTypesC.h>
+#include <osvr/Util/ClientReportTypesC.h>
 #include <osvr/Util/RenderingTypesC.h>
 #include <osvr/Client/Export.h>
 #include <osvr/Client/InternalInterfaceOwner.h>
@@ -35,12 +36,18 @@
 #include <osvr/Util/Rect.h>
 #include <osvr/Util/MatrixConventionsC.h>
 #include <osvr/Util/RadialDistortionParametersC.h>
+#include <osvr/Util/RadialDistortion.h>
 #include <osvr/Util/Angles.h>
+#include <osvr/Util/TimeValue.h>
+#include <osvr/Util/SharedPtr.h>
+#include <osvr/Util/UniquePtr.h>
 
 // Library/third-party includes
 #include <boost/optional.hpp>
 
 // Standard includes
+#include <cstddef>
+#include <mutex>
 #include <vector>
 #include <stdexcept>
 #include <utility>
@@ -63,13 +70,15 @@ namespace client {
         ViewerEye(ViewerEye const &) = delete;
         ViewerEye &operator=(ViewerEye const &) = delete;
         ViewerEye(ViewerEye &&other)
-            : m_pose(std::move(other.m_pose)), m_offset(other.m_offset),
+            : m_poseSamples(std::move(other.m_poseSamples)),
+              m_pose(std::move(other.m_pose)), m_offset(other.m_offset),
               m_viewport(other.m_viewport),
               m_unitBounds(std::move(other.m_unitBounds)),
               m_rot180(other.m_rot180), m_pitchTilt(other.m_pitchTilt),
               m_radDistortParams(std::move(other.m_radDistortParams)),
               m_displayInputIdx(other.m_displayInputIdx),
-              m_opticalAxisOffsetY(other.m_opticalAxisOffsetY) {}
+              m_opticalAxisOffsetY(other.m_opticalAxisOffsetY),
+              m_distortionGrids(std::move(other.m_distortionGrids)) {}
 
         inline OSVR_SurfaceCount size() const { return 1; }
 #if 0
@@ -89,6 +98,35 @@ namespace client {
 
         OSVR_CLIENT_EXPORT Eigen::Matrix4d getView() const;
 
+        /// @brief Gets the pose extrapolated to the given time (typically,
+        /// when the frame being rendered will be displayed), using the
+        /// velocity the tracker reports (if recent enough) or, failing that,
+        /// the difference between its two most recent poses.
+        ///
+        /// Extrapolates at most 100 ms past the latest pose; a target time
+        /// before the latest pose gets the latest pose unchanged.
+        OSVR_CLIENT_EXPORT OSVR_Pose3
+        getPredictedPose(util::time::TimeValue const &targetTime) const;
+
+        /// @brief Gets the view matrix for the predicted pose.
+        /// @sa getPredictedPose()
+        OSVR_CLIENT_EXPORT Eigen::Matrix4d
+        getPredictedView(util::time::TimeValue const &targetTime) const;
+
+        /// @brief Gets the pose of the tracker this eye follows, predicted
+        /// for the target time if one is given (see getPredictedPose()).
+        ///
+        /// Taking one such sample and passing it to getPoseFromTracker() of
+        /// each eye following the same tracker gives poses consistent with
+        /// each other, even if state changes in between.
+        OSVR_CLIENT_EXPORT Eigen::Isometry3d
+        getTrackerPose(util::time::TimeValue const *targetTime = nullptr) const;
+
+        /// @brief Applies the eye offset and optical axis rotation to a pose
+        /// of the tracker.
+        OSVR_CLIENT_EXPORT Eigen::Isometry3d
+        getPoseFromTracker(Eigen::Isometry3d const &trackerPose) const;
+
         bool wantDistortion() const {
             return m_radDistortParams.is_initialized();
         }
@@ -104,6 +142,19 @@ namespace client {
                        : OSVR_DISTORTION_PRIORITY_UNAVAILABLE;
         }
 
+        /// @brief Gets the radial distortion evaluated over a grid of the
+        /// given size, worked out on the first request for that size and
+        /// sampling and kept until a grid of another size is requested with
+        /// the same sampling. The grid returned stays valid as long as it is
+        /// held, even once no longer kept here.
+        ///
+        /// @throws std::logic_error if there are no radial distortion
+        /// parameters, and whatever working out the grid throws
+        /// (std::invalid_argument, std::bad_alloc).
+        OSVR_CLIENT_EXPORT shared_ptr<util::RadialDistortionGrid const>
+        getRadialDistortionGrid(std::size_t columns, std::size_t rows,
+                                util::GridSampling sampling) const;
+
         /// @brief Gets a matrix that takes in row vectors in a right-handed
         /// system and outputs signed Z.
         OSVR_CLIENT_EXPORT Eigen::Matrix4d getProjection(double near,
@@ -132,6 +183,32 @@ namespace client {
             util::Angle opticalAxisOffsetY = 0. * util::radians);
         util::Rectd m_getRect(double near, double far) const;
         Eigen::Isometry3d getPoseIsometry() const;
+        Eigen::Isometry3d
+        getPredictedPoseIsometry(util::time::TimeValue const &targetTime) const;
+        /// @brief Gets the tracker's linear and angular velocity in room
+        /// space, as reported or estimated, or zero if neither is possible.
+        ///
+        /// A reported velocity more than 100 ms older than the pose at
+        /// poseTime is left out, as if not reported.
+        void m_getVelocity(util::time::TimeValue const &poseTime,
+                           Eigen::Vector3d &linVel,
+                           Eigen::Vector3d &angVel) const;
+
+        /// @brief The last two pose reports, written by the callback (on
+        /// the context's update thread, if it has one) and read when
+        /// predicting, so both sides go through the mutex.
+        struct PoseSamples {
+            static void handle(void *userdata,
+                               const OSVR_TimeValue *timestamp,
+                               const OSVR_PoseReport *report);
+            std::mutex mutex;
+            std::size_t count = 0;
+            util::time::TimeValue timestamps[2];
+            OSVR_Pose3 poses[2];
+        };
+        /// @brief Declared before m_pose so it outlives the callback
+        /// registered with the interface.
+        unique_ptr<PoseSamples> m_poseSamples;
         InternalInterfaceOwner m_pose;
         Eigen::Vector3d m_offset;
 #if 0
@@ -145,6 +222,9 @@ namespace client {
         boost::optional<OSVR_RadialDistortionParameters> m_radDistortParams;
         OSVR_DisplayInputCount m_displayInputIdx;
         util::Angle m_opticalAxisOffsetY;
+        /// @brief The last distortion grid worked out for each sampling.
+        mutable std::vector<shared_ptr<util::RadialDistortionGrid const> >
+            m_distortionGrids;
     };
 
 } // namespace client
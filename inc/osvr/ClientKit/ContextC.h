@@ -51,11 +51,25 @@ OSVR_EXTERN_C_BEGIN
     @{
 */
 
+/** @brief Flag for osvrClientInit(): run the connections, and update the
+    state that osvrGetPoseState() and the like report, on a thread of the
+    library's own instead of in osvrClientUpdate(). State reads then never
+    wait on network traffic. Callbacks get called from that thread, unless
+    OSVR_CLIENT_INIT_DEFER_CALLBACKS is also given.
+*/
+#define OSVR_CLIENT_INIT_THREADED (1u << 0)
+
+/** @brief Flag for osvrClientInit(), with OSVR_CLIENT_INIT_THREADED: queue
+    callbacks to be called from osvrClientUpdate() on the app's thread.
+*/
+#define OSVR_CLIENT_INIT_DEFER_CALLBACKS (1u << 1)
+
 /** @brief Initialize the library.
 
     @param applicationIdentifier A null terminated string identifying your
    application. Reverse DNS format strongly suggested.
-    @param flags initialization options (reserved) - pass 0 for now.
+    @param flags initialization options: 0, or a bitwise-or of the
+   OSVR_CLIENT_INIT_ flags.
 
     @returns Client context - will be needed for subsequent calls
 */
@@ -64,6 +78,9 @@ OSVR_CLIENTKIT_EXPORT OSVR_ClientContext osvrClientInit(
 
 /** @brief Updates the state of the context - call regularly in your mainloop.
 
+    For a context initialized with OSVR_CLIENT_INIT_THREADED, this just calls
+    any callbacks deferred to it.
+
     @param ctx Client context
 */
 OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode osvrClientUpdate(OSVR_ClientContext ctx);
@@ -74,7 +91,8 @@ OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode osvrClientUpdate(OSVR_ClientContext ctx);
     If this reports that the client context is not OK, there may not be a server
     running, or you may just have to call osvrClientUpdate() a few times to
     permit startup to finish. The return value of this call will not change from
-    failure to success without calling osvrClientUpdate().
+    failure to success without calling osvrClientUpdate(), unless the context
+    was initialized with OSVR_CLIENT_INIT_THREADED.
 
     @param ctx Client context
 
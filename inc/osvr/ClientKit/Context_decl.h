@@ -58,7 +58,8 @@ namespace clientkit {
         /// @brief Initialize the library.
         /// @param applicationIdentifier A string identifying your application.
         /// Reverse DNS format strongly suggested.
-        /// @param flags initialization options (reserved, optional)
+        /// @param flags initialization options (optional): a bitwise-or of
+        /// the OSVR_CLIENT_INIT_ flags from ContextC.h
         ClientContext(const char applicationIdentifier[], uint32_t flags = 0u);
 
         /// @brief Initialize the context with an existing context.
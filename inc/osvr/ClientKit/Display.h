@@ -35,7 +35,7 @@
 // - none
 
 // Standard includes
-// - none
+#include <vector>
 
 /// @name Overloads taking output parameters by reference
 /// @{
@@ -229,6 +229,51 @@ namespace clientkit {
             }
             return params;
         }
+
+        /// @brief Get the radial distortion evaluated at the vertices of a
+        /// mesh, columns by rows, spanning the surface.
+        ///
+        /// Will only succeed if getRadialDistortionPriority() is non-negative.
+        ///
+        /// @sa osvrClientGetViewerEyeSurfaceRadialDistortionMesh()
+        std::vector<OSVR_RadialDistortionMeshVertex>
+        getRadialDistortionMesh(uint32_t columns, uint32_t rows) {
+            std::vector<OSVR_RadialDistortionMeshVertex> vertices(columns *
+                                                                  rows);
+            OSVR_ReturnCode ret =
+                osvrClientGetViewerEyeSurfaceRadialDistortionMesh(
+                    m_disp, m_viewer, m_eye, m_surface, columns, rows,
+                    vertices.empty() ? NULL : &vertices.front(),
+                    static_cast<uint32_t>(vertices.size()));
+            if (OSVR_RETURN_SUCCESS != ret) {
+                handleDisplayError(
+                    "Could not get radial distortion mesh for surface!");
+            }
+            return vertices;
+        }
+
+        /// @brief Get the radial distortion evaluated at the texel centers of
+        /// a lookup table, width by height, covering the surface.
+        ///
+        /// Will only succeed if getRadialDistortionPriority() is non-negative.
+        ///
+        /// @sa osvrClientGetViewerEyeSurfaceRadialDistortionLookupTable()
+        std::vector<OSVR_RadialDistortionMeshVertex>
+        getRadialDistortionLookupTable(uint32_t width, uint32_t height) {
+            std::vector<OSVR_RadialDistortionMeshVertex> vertices(width *
+                                                                  height);
+            OSVR_ReturnCode ret =
+                osvrClientGetViewerEyeSurfaceRadialDistortionLookupTable(
+                    m_disp, m_viewer, m_eye, m_surface, width, height,
+                    vertices.empty() ? NULL : &vertices.front(),
+                    static_cast<uint32_t>(vertices.size()));
+            if (OSVR_RETURN_SUCCESS != ret) {
+                handleDisplayError(
+                    "Could not get radial distortion lookup table for "
+                    "surface!");
+            }
+            return vertices;
+        }
         /// @name Identification getters
         /// @{
         OSVR_DisplayConfig getDisplayConfig() const { return m_disp; }
@@ -302,6 +347,39 @@ namespace clientkit {
             return (ret == OSVR_RETURN_SUCCESS);
         }
 
+        /// @brief Attempt to get the eye pose predicted for the given time.
+        ///
+        /// @return false if there was an error in the input parameters or if no
+        /// pose is yet available
+        bool getPredictedPose(OSVR_TimeValue const &targetTime,
+                              OSVR_Pose3 &pose) {
+            OSVR_ReturnCode ret = osvrClientGetViewerEyePosePredicted(
+                m_disp, m_viewer, m_eye, &targetTime, &pose);
+            return (ret == OSVR_RETURN_SUCCESS);
+        }
+
+        /// @brief Attempt to get the view matrix for the pose predicted for
+        /// the given time.
+        ///
+        /// @return false if there was an error in the input parameters or if no
+        /// pose (and thus view) is yet available.
+        bool getPredictedViewMatrix(OSVR_TimeValue const &targetTime,
+                                    OSVR_MatrixConventions flags,
+                                    double mat[OSVR_MATRIX_SIZE]) {
+            OSVR_ReturnCode ret = osvrClientGetViewerEyeViewMatrixdPredicted(
+                m_disp, m_viewer, m_eye, &targetTime, flags, mat);
+            return (ret == OSVR_RETURN_SUCCESS);
+        }
+
+        /// @overload
+        bool getPredictedViewMatrix(OSVR_TimeValue const &targetTime,
+                                    OSVR_MatrixConventions flags,
+                                    float mat[OSVR_MATRIX_SIZE]) {
+            OSVR_ReturnCode ret = osvrClientGetViewerEyeViewMatrixfPredicted(
+                m_disp, m_viewer, m_eye, &targetTime, flags, mat);
+            return (ret == OSVR_RETURN_SUCCESS);
+        }
+
         /// @name Iteration methods
         /// @{
         template <typename F>
@@ -487,6 +565,46 @@ namespace clientkit {
             return dimensions;
         }
 
+        /// @brief Returns the number of surfaces of all eyes of all viewers.
+        ///
+        /// @sa osvrClientGetNumRenderInfo()
+        uint32_t getNumRenderInfo() const {
+            ensureValid();
+            uint32_t count;
+            OSVR_ReturnCode ret = osvrClientGetNumRenderInfo(m_disp, &count);
+            if (ret != OSVR_RETURN_SUCCESS) {
+                handleDisplayError("Couldn't get number of render info "
+                                   "entries!");
+            }
+            return count;
+        }
+
+        /// @brief Gets everything needed to render every surface, from one
+        /// pose sample per viewer. Resizes info only if needed, so reusing
+        /// it from frame to frame doesn't allocate.
+        ///
+        /// @param targetTime Time to predict poses for, or NULL for the
+        /// latest poses.
+        /// @return false if no pose is available yet.
+        ///
+        /// @sa osvrClientGetRenderInfo()
+        bool getRenderInfo(double near, double far,
+                           OSVR_MatrixConventions flags,
+                           std::vector<OSVR_RenderInfo> &info,
+                           OSVR_TimeValue const *targetTime = NULL) const {
+            ensureValid();
+            uint32_t count = getNumRenderInfo();
+            if (info.size() != count) {
+                info.resize(count);
+            }
+            if (count == 0) {
+                return true;
+            }
+            OSVR_ReturnCode ret = osvrClientGetRenderInfo(
+                m_disp, targetTime, near, far, flags, &info.front(), count);
+            return ret == OSVR_RETURN_SUCCESS;
+        }
+
         /// @name Child-related methods
         /// @{
         OSVR_ViewerCount getNumViewers() const {
@@ -39,6 +39,7 @@
 #include <osvr/Util/Pose3C.h>
 #include <osvr/Util/BoolC.h>
 #include <osvr/Util/RadialDistortionParametersC.h>
+#include <osvr/Util/TimeValueC.h>
 
 /* Library/third-party includes */
 /* none */
@@ -266,6 +267,79 @@ OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode osvrClientGetViewerEyeViewMatrixf(
     OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, OSVR_EyeCount eye,
     OSVR_MatrixConventions flags, float *mat);
 
+/** @brief Get the "viewpoint" for the given eye of a viewer in a display
+   config, extrapolated to a target time - typically, when the frame being
+   rendered will be displayed.
+
+    Extrapolation uses the velocity reported by the tracker if available, or
+   else the difference between its two most recent poses. It extends at most
+   100 ms past the latest pose; a target time before the latest pose gets the
+   latest pose unchanged.
+
+    Will only succeed if osvrClientCheckDisplayStartup() succeeds.
+
+    @param disp Display config object
+    @param viewer Viewer ID
+    @param eye Eye ID
+    @param targetTime Time to predict the pose for, on the same clock as
+   osvrTimeValueGetNow() and report timestamps.
+    @param[out] pose Room-space pose (not relative to pose of the viewer)
+
+    @return OSVR_RETURN_FAILURE if invalid parameters were passed or no pose was
+    yet available, in which case the pose argument is unmodified.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode osvrClientGetViewerEyePosePredicted(
+    OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, OSVR_EyeCount eye,
+    OSVR_TimeValue const *targetTime, OSVR_Pose3 *pose);
+
+/** @brief Get the view matrix (inverse of pose) for the given eye of a
+    viewer in a display config, extrapolated to a target time - matrix of
+    **doubles**.
+
+    @sa osvrClientGetViewerEyePosePredicted() for how the pose is predicted,
+   and osvrClientGetViewerEyeViewMatrixd() for the matrix conventions.
+
+    @param disp Display config object
+    @param viewer Viewer ID
+    @param eye Eye ID
+    @param targetTime Time to predict the pose for.
+    @param flags Bitwise OR of matrix convention flags (see @ref MatrixFlags)
+    @param[out] mat Pass a double[::OSVR_MATRIX_SIZE] to get the transformation
+    matrix from room space to eye space (not relative to pose of the viewer)
+
+    @return OSVR_RETURN_FAILURE if invalid parameters were passed or no pose was
+    yet available, in which case the output argument is unmodified.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrClientGetViewerEyeViewMatrixdPredicted(
+    OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, OSVR_EyeCount eye,
+    OSVR_TimeValue const *targetTime, OSVR_MatrixConventions flags,
+    double *mat);
+
+/** @brief Get the view matrix (inverse of pose) for the given eye of a
+    viewer in a display config, extrapolated to a target time - matrix of
+    **floats**.
+
+    @sa osvrClientGetViewerEyePosePredicted() for how the pose is predicted,
+   and osvrClientGetViewerEyeViewMatrixf() for the matrix conventions.
+
+    @param disp Display config object
+    @param viewer Viewer ID
+    @param eye Eye ID
+    @param targetTime Time to predict the pose for.
+    @param flags Bitwise OR of matrix convention flags (see @ref MatrixFlags)
+    @param[out] mat Pass a float[::OSVR_MATRIX_SIZE] to get the transformation
+    matrix from room space to eye space (not relative to pose of the viewer)
+
+    @return OSVR_RETURN_FAILURE if invalid parameters were passed or no pose was
+    yet available, in which case the output argument is unmodified.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrClientGetViewerEyeViewMatrixfPredicted(
+    OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, OSVR_EyeCount eye,
+    OSVR_TimeValue const *targetTime, OSVR_MatrixConventions flags,
+    float *mat);
+
 /** @brief Each eye of each viewer in a display config has one or more surfaces
     (aka "screens") on which content should be rendered.
 
@@ -497,6 +571,151 @@ osvrClientGetViewerEyeSurfaceRadialDistortion(
     OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, OSVR_EyeCount eye,
     OSVR_SurfaceCount surface, OSVR_RadialDistortionParameters *params);
 
+/** @brief A point of a radial distortion mesh or lookup table, as filled in
+    by osvrClientGetViewerEyeSurfaceRadialDistortionMesh() and
+    osvrClientGetViewerEyeSurfaceRadialDistortionLookupTable().
+
+    Coordinates run from (0, 0) at the bottom left to (1, 1) at the top right
+    of the surface, as does the center of projection in
+    OSVR_RadialDistortionParameters.
+*/
+typedef struct OSVR_RadialDistortionMeshVertex {
+    /** @brief Position on the surface */
+    OSVR_Vec2 position;
+    /** @brief Where to sample the undistorted image for the red, green and
+        blue channels, in that order. */
+    OSVR_Vec2 texCoords[3];
+} OSVR_RadialDistortionMeshVertex;
+
+/** @brief Evaluates the radial distortion for a surface seen by an eye of a
+    viewer at the vertices of a regular mesh, for distorting on the GPU
+    without a per-pixel shader.
+
+    Vertices are spaced evenly from edge to edge: the first and last in each
+    row and column lie on the edges of the surface. The mesh is worked out on
+    the CPU and cached with the display config object, so later calls for
+    the same size just copy it. Only the latest size is kept, so alternating
+    between sizes works the mesh out each time.
+
+    Will only succeed if osvrClientGetViewerEyeSurfaceRadialDistortionPriority()
+    reports a non-negative priority.
+
+    @param disp Display config object
+    @param viewer Viewer ID
+    @param eye Eye ID
+    @param surface Surface ID
+    @param columns Number of vertices across each row: at least 1.
+    @param rows Number of rows of vertices: at least 1.
+    @param[out] vertices Array of vertices to fill in, row by row starting
+    from the bottom.
+    @param count Number of entries in vertices: must be columns * rows.
+
+    @return OSVR_RETURN_FAILURE if this surface does not have radial
+    distortion parameters described, or if invalid parameters were passed, in
+    which case the output argument is unmodified.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrClientGetViewerEyeSurfaceRadialDistortionMesh(
+    OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, OSVR_EyeCount eye,
+    OSVR_SurfaceCount surface, uint32_t columns, uint32_t rows,
+    OSVR_RadialDistortionMeshVertex *vertices, uint32_t count);
+
+/** @brief Evaluates the radial distortion for a surface seen by an eye of a
+    viewer at the center of each texel of a lookup table, typically the size
+    of the viewport.
+
+    Identical to osvrClientGetViewerEyeSurfaceRadialDistortionMesh(), except
+    that the points are at texel centers, half a texel in from the edges of
+    the surface, rather than on the edges.
+
+    @param width Number of texels across each row: at least 1.
+    @param height Number of rows of texels: at least 1.
+    @param count Number of entries in vertices: must be width * height.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrClientGetViewerEyeSurfaceRadialDistortionLookupTable(
+    OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, OSVR_EyeCount eye,
+    OSVR_SurfaceCount surface, uint32_t width, uint32_t height,
+    OSVR_RadialDistortionMeshVertex *vertices, uint32_t count);
+
+/** @brief Everything needed to render to a surface seen by an eye of a viewer,
+    as filled in by osvrClientGetRenderInfo().
+*/
+typedef struct OSVR_RenderInfo {
+    /** @brief Viewer ID */
+    OSVR_ViewerCount viewer;
+    /** @brief Eye ID */
+    OSVR_EyeCount eye;
+    /** @brief Surface ID */
+    OSVR_SurfaceCount surface;
+    /** @brief Room-space pose of the eye: see osvrClientGetViewerEyePose() */
+    OSVR_Pose3 pose;
+    /** @brief View matrix: see osvrClientGetViewerEyeViewMatrixd() */
+    double viewMatrix[OSVR_MATRIX_SIZE];
+    /** @brief Projection matrix: see
+        osvrClientGetViewerEyeSurfaceProjectionMatrixd() */
+    double projectionMatrix[OSVR_MATRIX_SIZE];
+    /** @brief Viewport within the display input: see
+        osvrClientGetRelativeViewportForViewerEyeSurface() */
+    OSVR_ViewportDimension viewportLeft;
+    OSVR_ViewportDimension viewportBottom;
+    OSVR_ViewportDimension viewportWidth;
+    OSVR_ViewportDimension viewportHeight;
+    /** @brief Index of the display input: see
+        osvrClientGetViewerEyeSurfaceDisplayInputIndex() */
+    OSVR_DisplayInputCount displayInput;
+    /** @brief Priority of radial distortion, negative if unavailable: see
+        osvrClientGetViewerEyeSurfaceRadialDistortionPriority() */
+    OSVR_DistortionPriority radialDistortionPriority;
+    /** @brief Radial distortion parameters, only meaningful if
+        radialDistortionPriority is non-negative. */
+    OSVR_RadialDistortionParameters radialDistortion;
+} OSVR_RenderInfo;
+
+/** @brief Gets the number of OSVR_RenderInfo entries that
+    osvrClientGetRenderInfo() fills in: one for each surface of each eye of
+    each viewer. **Constant** throughout the active, valid lifetime of a
+    display config object.
+
+    @return OSVR_RETURN_FAILURE if invalid parameters were passed, in which case
+    the output argument is unmodified.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrClientGetNumRenderInfo(OSVR_DisplayConfig disp, uint32_t *count);
+
+/** @brief Gets the poses, view and projection matrices, viewports and
+    distortion parameters for all surfaces of all eyes of all viewers in one
+    call, typically once per frame.
+
+    Unlike the separate per-eye calls, the tracker state for each viewer is
+    sampled just once, so all of its eyes get poses from the same report,
+    even if state is updated during the call (as it can be with
+    OSVR_CLIENT_INIT_THREADED). Nothing is allocated.
+
+    Will only succeed if osvrClientCheckDisplayStartup() succeeds.
+
+    @param disp Display config object
+    @param targetTime Time to predict poses for (see
+    osvrClientGetViewerEyePosePredicted()), or NULL for the latest poses.
+    @param near Distance to near clipping plane: see
+    osvrClientGetViewerEyeSurfaceProjectionMatrixd()
+    @param far Distance to far clipping plane
+    @param flags Bitwise OR of matrix convention flags (see @ref MatrixFlags),
+    for both matrices.
+    @param[out] info Array of entries to fill in, in order of viewer, eye,
+    then surface.
+    @param count Number of entries in info: must be the number output by
+    osvrClientGetNumRenderInfo().
+
+    @return OSVR_RETURN_FAILURE if invalid parameters were passed or no pose was
+    yet available, in which case the output argument is unmodified.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrClientGetRenderInfo(OSVR_DisplayConfig disp,
+                        OSVR_TimeValue const *targetTime, double near,
+                        double far, OSVR_MatrixConventions flags,
+                        OSVR_RenderInfo *info, uint32_t count);
+
 /** @}
     @}
 */
@@ -42,16 +42,32 @@
 /* none */
 
 /* Standard includes */
-/* none */
+#include <stddef.h>
 
 OSVR_EXTERN_C_BEGIN
 
+/** @brief Set the number of past states to keep for each report type on an
+    interface, for the osvrGet...StateAtTime() functions.
+
+    Defaults to 0: only the latest state is kept, and those functions always
+    fail. Histories start filling from the next report received.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrSetStateHistoryCapacity(OSVR_ClientInterface iface, size_t capacity);
+
 #define OSVR_CALLBACK_METHODS(TYPE)                                            \
     /** @brief Get TYPE state from an interface, returning failure if none     \
      * exists */                                                               \
     OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode osvrGet##TYPE##State(                \
         OSVR_ClientInterface iface, struct OSVR_TimeValue *timestamp,          \
-        OSVR_##TYPE##State *state);
+        OSVR_##TYPE##State *state);                                            \
+    /** @brief Get TYPE state as of a given time from the history kept for an  \
+     * interface (interpolated between samples, for Pose, Position and         \
+     * Orientation, with timestamp set to the time asked for), returning       \
+     * failure if none exists */                                               \
+    OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode osvrGet##TYPE##StateAtTime(          \
+        OSVR_ClientInterface iface, struct OSVR_TimeValue const *time,         \
+        struct OSVR_TimeValue *timestamp, OSVR_##TYPE##State *state);
 
 OSVR_CALLBACK_METHODS(Pose)
 OSVR_CALLBACK_METHODS(Position)
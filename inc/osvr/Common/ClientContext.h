@@ -43,7 +43,11 @@
 // Standard includes
 #include <string>
 #include <vector>
+#include <deque>
+#include <cstddef>
 #include <map>
+#include <functional>
+#include <mutex>
 
 struct OSVR_ClientContextObject : boost::noncopyable {
   public:
@@ -52,6 +56,9 @@ struct OSVR_ClientContextObject : boost::noncopyable {
     OSVR_COMMON_EXPORT virtual ~OSVR_ClientContextObject();
 
     /// @brief System-wide update method.
+    ///
+    /// For a context with an update thread of its own, this just calls any
+    /// callbacks deferred to it.
     OSVR_COMMON_EXPORT void update();
 
     /// @brief Accessor for app ID
@@ -85,11 +92,15 @@ struct OSVR_ClientContextObject : boost::noncopyable {
     getStringParameter(std::string const &path) const;
 
     /// @brief Accessor for the path tree.
+    ///
+    /// For a context with an update thread of its own, hold lockUpdates()
+    /// for as long as the reference is used.
     OSVR_COMMON_EXPORT osvr::common::PathTree const &getPathTree() const;
 
     /// @brief Pass (smart-pointer) ownership of some object to the client
     /// context.
     template <typename T> void *acquireObject(T obj) {
+        std::lock_guard<std::mutex> lock(m_ownedObjectsMutex);
         return m_ownedObjects.acquire(obj);
     }
 
@@ -114,6 +125,29 @@ struct OSVR_ClientContextObject : boost::noncopyable {
     /// received, etc.)
     OSVR_COMMON_EXPORT bool getStatus() const;
 
+    /// @brief For a context with an update thread of its own, locks that
+    /// thread out of updating, for access to anything an update touches:
+    /// the methods here that need it take it themselves. Returns a lock
+    /// holding nothing otherwise.
+    OSVR_COMMON_EXPORT std::unique_lock<std::recursive_mutex>
+    lockUpdates() const;
+
+    /// @brief Whether callbacks get queued for the next update() on the
+    /// app's thread, rather than called from the update thread.
+    bool isDeferringCallbacks() const { return m_deferCallbacks; }
+
+    /// @brief Queues a call of an interface's callbacks for the next
+    /// update(). Dropped if the interface gets released first.
+    ///
+    /// At most MAX_DEFERRED_CALLBACKS wait at once: past that, the app isn't
+    /// calling update() often enough to keep up, and the oldest get dropped
+    /// to make room, rather than the queue growing without bound.
+    OSVR_COMMON_EXPORT void deferCallback(osvr::common::ClientInterface *iface,
+                                          std::function<void()> const &call);
+
+    /// @brief Maximum number of callbacks queued by deferCallback().
+    static const std::size_t MAX_DEFERRED_CALLBACKS = 1024;
+
   protected:
     /// @brief Constructor for derived class use only.
     OSVR_COMMON_EXPORT
@@ -126,7 +160,22 @@ struct OSVR_ClientContextObject : boost::noncopyable {
         osvr::common::ClientInterfaceFactory const &interfaceFactory,
         osvr::common::ClientContextDeleter del);
 
+    /// @brief For implementations with an update thread of their own: makes
+    /// the public methods take lockUpdates(), makes state readable from the
+    /// app's thread while the update thread sets it, and makes update() just
+    /// call the callbacks deferred to it, if deferCallbacks is set.
+    ///
+    /// Call from the constructor, before starting the thread or creating any
+    /// interface.
+    OSVR_COMMON_EXPORT void m_enableUpdateThread(bool deferCallbacks);
+
+    /// @brief Runs one update of the implementation and the interfaces,
+    /// publishing their new state: what update() does without an update
+    /// thread. From an update thread, call with lockUpdates() held.
+    OSVR_COMMON_EXPORT void m_runUpdate();
+
   private:
+    void m_callDeferredCallbacks();
     virtual void m_update() = 0;
     virtual void m_sendRoute(std::string const &route) = 0;
     OSVR_COMMON_EXPORT virtual bool m_getStatus() const;
@@ -157,8 +206,26 @@ struct OSVR_ClientContextObject : boost::noncopyable {
     InterfaceList m_interfaces;
     osvr::common::ClientInterfaceFactory m_clientInterfaceFactory;
 
+    std::mutex m_ownedObjectsMutex;
     osvr::util::MultipleKeyedOwnershipContainer m_ownedObjects;
     osvr::common::ClientContextDeleter m_deleter;
+
+    bool m_hasUpdateThread = false;
+    bool m_deferCallbacks = false;
+    mutable std::recursive_mutex m_updateMutex;
+    struct DeferredCallback {
+        osvr::common::ClientInterface *iface;
+        std::function<void()> call;
+    };
+    typedef std::deque<DeferredCallback> DeferredCallbackQueue;
+    std::mutex m_deferredMutex;
+    DeferredCallbackQueue m_deferred;
+    /// @brief Callbacks being called by update(), on the app's thread.
+    DeferredCallbackQueue m_calling;
+    bool m_callingDeferred = false;
+    /// @brief Whether callbacks have been dropped since the last update(),
+    /// so that we only say so once each time the app falls behind.
+    bool m_droppingDeferred = false;
 };
 
 namespace osvr {
@@ -27,7 +27,7 @@
 
 // Internal Includes
 #include <osvr/Common/Export.h>
-#include <osvr/Common/ClientContext_fwd.h>
+#include <osvr/Common/ClientContext.h>
 #include <osvr/Common/ClientInterfacePtr.h>
 #include <osvr/Common/InterfaceState.h>
 #include <osvr/Common/InterfaceCallbacks.h>
@@ -94,6 +94,33 @@ struct OSVR_ClientInterfaceObject : boost::noncopyable {
             "type!");
         m_state.setStateFromReport(timestamp, report);
     }
+
+    /// @brief Lets state be read from threads other than the one updating the
+    /// context: see InterfaceState::enableSnapshots().
+    void enableStateSnapshots() { m_state.enableSnapshots(); }
+
+    /// @brief Makes state set since the last call readable, if snapshots
+    /// are enabled.
+    void publishState() { m_state.publish(); }
+
+    /// @brief Set the number of past states to keep for each report type, for
+    /// getStateAtTime(). Defaults to 0.
+    void setStateHistoryCapacity(std::size_t capacity) {
+        m_state.setHistoryCapacity(capacity);
+    }
+
+    /// @brief If state as of the given time exists in the history for the
+    /// given ReportType on this interface, it will be returned in the
+    /// arguments (interpolated, for poses, positions and orientations), and
+    /// true will be returned.
+    template <typename ReportType>
+    bool getStateAtTime(
+        osvr::util::time::TimeValue const &t,
+        osvr::util::time::TimeValue &timestamp,
+        osvr::common::traits::StateFromReport_t<ReportType> &state) const {
+        osvr::common::tracing::markGetState(m_path);
+        return m_state.getStateAtTime<ReportType>(t, timestamp, state);
+    }
     /// @}
 
     /// @name Callback-related wrapper methods
@@ -102,15 +129,27 @@ struct OSVR_ClientInterfaceObject : boost::noncopyable {
     /// @brief Register a callback for a known report type.
     template <typename CallbackType>
     void registerCallback(CallbackType cb, void *userdata) {
+        auto lock = m_ctx.lockUpdates();
         m_callbacks.addCallback(cb, userdata);
     }
 
     /// @brief Trigger all callbacks for the given known report
-    /// type.
+    /// type - or, if the context defers callbacks, queue them for its next
+    /// update().
     template <typename ReportType>
     void triggerCallbacks(const OSVR_TimeValue &timestamp,
                           ReportType const &report) {
-        m_callbacks.triggerCallbacks(timestamp, report);
+        if (!m_ctx.isDeferringCallbacks()) {
+            m_callbacks.triggerCallbacks(timestamp, report);
+            return;
+        }
+        if (m_callbacks.getNumCallbacksFor(report) == 0) {
+            return;
+        }
+        auto callbacks = &m_callbacks;
+        m_ctx.deferCallback(this, [callbacks, timestamp, report] {
+            callbacks->triggerCallbacks(timestamp, report);
+        });
     }
 
     /// @brief Get the number of registered callbacks for the given report type.
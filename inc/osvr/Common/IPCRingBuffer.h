@@ -36,6 +36,7 @@
 
 // Standard includes
 #include <string>
+#include <utility>
 
 namespace osvr {
 namespace common {
@@ -69,6 +70,22 @@ namespace common {
         typedef uint16_t entry_count_type;
         typedef uint32_t entry_size_type;
         typedef uint32_t abi_level_type;
+
+        /// @brief How access to the entries of the ring buffer is
+        /// synchronized between the producer and the readers.
+        enum class SyncMode : uint8_t {
+            /// @brief Interprocess reader/writer mutexes on the bookkeeping
+            /// data and on each entry: readers keep the entry they hold from
+            /// being overwritten, at the cost of the producer possibly waiting
+            /// on them.
+            InterprocessMutex = 0,
+            /// @brief Lock-free: the producer stamps each entry with a
+            /// sequence counter (seqlock) and never waits, while readers copy
+            /// the entry out and validate the stamp afterwards, failing the
+            /// read if the entry was overwritten meanwhile.
+            Seqlock = 1
+        };
+
         class Options {
           public:
             OSVR_COMMON_EXPORT Options();
@@ -100,20 +117,42 @@ namespace common {
             Options &setEntrySize(entry_size_type entrySize);
             entry_size_type getEntrySize() const { return m_entrySize; }
 
+            /// @brief Sets the synchronization mode. Creator and finder of a
+            /// given ring buffer must agree on this.
+            /// @return *this for chained method idiom.
+            OSVR_COMMON_EXPORT Options &setSyncMode(SyncMode mode);
+            SyncMode getSyncMode() const { return m_syncMode; }
+
           private:
             std::string m_name;
             BackendType m_shmBackend;
             alignment_type m_alignment = 16;
             entry_count_type m_entries = 16;
             entry_size_type m_entrySize = 65536;
+            SyncMode m_syncMode = SyncMode::InterprocessMutex;
         };
 
         /// @brief Gets an integer representing a unique arrangement of the
         /// internal shared memory layout, such that if two processes try to
         /// communicate with different ABI levels, they will (likely) not
         /// succeed and thus should not try.
+        ///
+        /// This overload returns the ABI level of the default
+        /// (SyncMode::InterprocessMutex) mode.
         OSVR_COMMON_EXPORT static abi_level_type getABILevel();
 
+        /// @brief Gets the ABI level for the given synchronization mode: each
+        /// mode has its own shared memory layout and thus its own, distinct,
+        /// ABI level.
+        OSVR_COMMON_EXPORT static abi_level_type getABILevel(SyncMode mode);
+
+        /// @brief Looks up the synchronization mode corresponding to an ABI
+        /// level.
+        ///
+        /// @return false if the ABI level is not one we can communicate with.
+        OSVR_COMMON_EXPORT static bool
+        getSyncModeForABILevel(abi_level_type abi, SyncMode &mode);
+
         /// @brief Named constructor, for use by server processes: creates a
         /// shared memory ring buffer given the options structure.
         ///
@@ -136,6 +175,9 @@ namespace common {
         /// buffer
         OSVR_COMMON_EXPORT std::string const &getName() const;
 
+        /// @brief Returns the synchronization mode of this ring buffer.
+        OSVR_COMMON_EXPORT SyncMode getSyncMode() const;
+
         /// @brief Returns the size of each individual buffer entry, in bytes.
         OSVR_COMMON_EXPORT uint32_t getEntrySize() const;
 
@@ -157,6 +199,9 @@ namespace common {
         /// @brief A class providing write access to the next available element
         /// in the ring buffer, owning the appropriate mutex locks and providing
         /// access to the sequence number.
+        ///
+        /// In SyncMode::Seqlock, the entry is marked as being written for the
+        /// lifetime of this object, and published when it exits scope.
         class BufferWriteProxy {
           public:
             /// @brief not copyable
@@ -166,12 +211,17 @@ namespace common {
             BufferWriteProxy &operator=(BufferWriteProxy const &) = delete;
 
             /// @brief move-constructible
-            BufferWriteProxy(BufferWriteProxy &&other) {
+            BufferWriteProxy(BufferWriteProxy &&other)
+                : m_buf(nullptr), m_seq(0) {
+                std::swap(m_buf, other.m_buf);
+                std::swap(m_seq, other.m_seq);
                 std::swap(m_data, other.m_data);
             }
 
             /// @brief move-assignable
             BufferWriteProxy &operator=(BufferWriteProxy &&other) {
+                std::swap(m_buf, other.m_buf);
+                std::swap(m_seq, other.m_seq);
                 std::swap(m_data, other.m_data);
                 return *this;
             }
@@ -182,6 +232,13 @@ namespace common {
 
             sequence_type getSequenceNumber() const { return m_seq; }
 
+            /// @brief Gives up on the entry, which must not be accessed
+            /// afterwards. In SyncMode::Seqlock, it is left unpublished, and
+            /// its sequence number reused. Otherwise, the entry was made the
+            /// newest when this object was created, so this just releases the
+            /// locks early.
+            OSVR_COMMON_EXPORT void abandon();
+
           private:
             BufferWriteProxy(detail::IPCPutResultPtr &&data,
                              IPCRingBufferPtr &&shm);
@@ -195,6 +252,9 @@ namespace common {
         /// holding a sharable mutex lock preventing it from being overwritten
         /// while this object is in scope.
         ///
+        /// In SyncMode::Seqlock, there is no lock: this object instead owns a
+        /// validated, private copy of the entry.
+        ///
         /// As such, you should only access the memory pointed to by this object
         /// while you keep this object alive, and you should let it go out of
         /// scope when you no longer need the data.
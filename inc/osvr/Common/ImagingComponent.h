@@ -31,6 +31,8 @@
 #include <osvr/Common/SerializationTags.h>
 #include <osvr/Util/ChannelCountC.h>
 #include <osvr/Util/ImagingReportTypesC.h>
+#include <osvr/Util/AlignedMemoryUniquePtr.h>
+#include <osvr/Util/BlockPool.h>
 #include <osvr/Common/IPCRingBuffer.h>
 #include <osvr/Common/ImagingComponentConfig.h>
 
@@ -81,6 +83,9 @@ namespace common {
         static OSVR_COMMON_EXPORT shared_ptr<ImagingComponent>
         create(OSVR_ChannelCount numSensor = 0);
 
+        /// @brief Destructor
+        virtual ~ImagingComponent();
+
         /// @brief Message from server to client, containing some image data.
         messages::ImageRegion imageRegion;
 
@@ -98,6 +103,36 @@ namespace common {
             OSVR_ImagingMetadata metadata, OSVR_ImageBufferElement *imageData,
             OSVR_ChannelCount sensor, OSVR_TimeValue const &timestamp);
 
+        /// @brief Gets a buffer, sized for the given metadata, for the device
+        /// to write the next frame of a sensor into directly: when the shared
+        /// memory ring buffer is lock-free, this is its next entry, so the
+        /// frame need not be copied again by sendImageData(). Falls back to a
+        /// private buffer otherwise.
+        ///
+        /// If a buffer for that sensor was already acquired with the same
+        /// metadata and not yet committed, the same buffer is returned.
+        ///
+        /// @return nullptr if no buffer could be allocated.
+        OSVR_COMMON_EXPORT OSVR_ImageBufferElement *
+        acquireImageBuffer(OSVR_ImagingMetadata const &metadata,
+                           OSVR_ChannelCount sensor);
+
+        /// @brief Sends the frame in the buffer previously obtained from
+        /// acquireImageBuffer() for the given sensor, after which that buffer
+        /// must no longer be accessed.
+        ///
+        /// @return false if there was no acquired buffer for that sensor.
+        OSVR_COMMON_EXPORT bool
+        commitImageBuffer(OSVR_ChannelCount sensor,
+                          OSVR_TimeValue const &timestamp);
+
+        /// @brief Gives up on the buffer previously obtained from
+        /// acquireImageBuffer() for the given sensor without sending it,
+        /// after which that buffer must no longer be accessed.
+        ///
+        /// @return false if there was no acquired buffer for that sensor.
+        OSVR_COMMON_EXPORT bool releaseImageBuffer(OSVR_ChannelCount sensor);
+
         typedef std::function<void(ImageData const &,
                                    util::time::TimeValue const &)> ImageHandler;
         OSVR_COMMON_EXPORT void registerImageHandler(ImageHandler cb);
@@ -106,6 +141,20 @@ namespace common {
         ImagingComponent(OSVR_ChannelCount numChan);
         virtual void m_parentSet();
 
+        /// @brief Creates or replaces, if required, the shared memory ring
+        /// buffer for a sensor to suit the given metadata.
+        /// @return the ring buffer, or nullptr if it couldn't be created.
+        IPCRingBufferPtr const &
+        m_getShmBufFor(OSVR_ImagingMetadata const &metadata,
+                       OSVR_ChannelCount sensor);
+
+        /// @brief Sends the notification of an image placed in shared memory.
+        void m_sendShmNotification(OSVR_ImagingMetadata const &metadata,
+                                   IPCRingBuffer const &shm,
+                                   IPCRingBuffer::sequence_type seq,
+                                   OSVR_ChannelCount sensor,
+                                   OSVR_TimeValue const &timestamp);
+
         /// @return true if we could send it.
         bool m_sendImageDataViaSharedMemory(OSVR_ImagingMetadata metadata,
                                             OSVR_ImageBufferElement *imageData,
@@ -145,6 +194,27 @@ namespace common {
         bool m_gotOne;
         /// @brief One for each sensor
         std::vector<IPCRingBufferPtr> m_shmBuf;
+
+        /// @brief A frame buffer handed out by acquireImageBuffer() and not
+        /// yet committed.
+        struct AcquiredBuffer {
+            OSVR_ImagingMetadata metadata;
+            OSVR_ImageBufferElement *buffer = nullptr;
+            /// @brief Set if the buffer is a shared memory entry.
+            unique_ptr<IPCRingBuffer::BufferWriteProxy> proxy;
+            /// @brief Set if the buffer is a private fallback buffer.
+            util::AlignedImageBufferPtr fallback;
+        };
+        /// @brief One for each sensor
+        std::vector<AcquiredBuffer> m_acquired;
+
+        /// @brief Recycles the buffers of images received over the wire, so
+        /// a steady stream of them doesn't allocate per frame.
+        util::BlockPoolPtr m_pool;
+
+        /// @brief Reused to deserialize each shared memory notification.
+        unique_ptr<messages::ImagePlacedInSharedMemory::MessageSerialization>
+            m_shmMessage;
     };
 } // namespace common
 } // namespace osvr
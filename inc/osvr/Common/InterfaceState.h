@@ -29,7 +29,10 @@
 #include <osvr/Common/ReportTypes.h>
 #include <osvr/Common/StateType.h>
 #include <osvr/Common/ReportState.h>
+#include <osvr/Common/StateHistory.h>
 #include <osvr/Util/TimeValue.h>
+#include <osvr/Util/TripleBuffer.h>
+#include <osvr/Util/UniquePtr.h>
 #include <osvr/Common/Tracing.h>
 #include <osvr/TypePack/TypeKeyedTuple.h>
 #include <osvr/TypePack/Quote.h>
@@ -38,7 +41,8 @@
 #include <boost/optional.hpp>
 
 // Standard includes
-// - none
+#include <cstddef>
+#include <mutex>
 
 namespace osvr {
 namespace common {
@@ -61,16 +65,39 @@ namespace common {
         typepack::TypeKeyedTuple<traits::ReportTypeList,
                                  typepack::quote<StateMapValueType>>;
 
+    /// @brief Data structure mapping from a report type to a history of its
+    /// states.
+    using StateHistoryMap =
+        typepack::TypeKeyedTuple<traits::ReportTypeList,
+                                 typepack::quote<StateHistory>>;
+
+    /// @brief The latest state of each report type for an interface.
+    struct StateSnapshot {
+        StateMap states;
+        bool hasState = false;
+
+        template <typename ReportType> bool has() const {
+            return hasState && bool(typepack::cget<ReportType>(states));
+        }
+    };
+
     /// @brief Class to maintain state for an interface for each report (and
     /// thus state) type explicitly enumerated.
+    ///
+    /// By default, all access must come from one thread. Once
+    /// enableSnapshots() has been called, state may be set from one thread
+    /// (which calls publish() after each batch of changes) and read from
+    /// others, with the setting thread never waiting on a reader: reads see
+    /// the state as of the last publish().
     class InterfaceState {
       public:
         template <typename ReportType>
         void setStateFromReport(util::time::TimeValue const &timestamp,
                                 ReportType const &report) {
-            if (hasState<ReportType>()) {
+            if (m_current.has<ReportType>()) {
                 auto &oldTimestamp =
-                    typepack::cget<ReportType, StateMap>(m_states)->timestamp;
+                    typepack::cget<ReportType, StateMap>(m_current.states)
+                        ->timestamp;
                 if (osvrTimeValueGreater(oldTimestamp, timestamp)) {
                     tracing::markTimestampOutOfOrder();
                     return;
@@ -79,31 +106,134 @@ namespace common {
             StateMapContents<ReportType> c;
             c.state = reportState(report);
             c.timestamp = timestamp;
-            typepack::get<ReportType, StateMap>(m_states) = c;
-            m_hasState = true;
+            typepack::get<ReportType, StateMap>(m_current.states) = c;
+            m_current.hasState = true;
+            m_changed = true;
+
+            auto lock = m_lockHistories();
+            if (m_historyCapacity > 0) {
+                auto &history =
+                    typepack::get<ReportType, StateHistoryMap>(m_histories);
+                // Applied lazily, so only the report types actually received
+                // get their storage allocated.
+                history.setCapacity(m_historyCapacity);
+                history.push(timestamp, c.state);
+            }
         }
 
         template <typename ReportType> bool hasState() const {
-            // using typepack::get;
-            return m_hasState && bool(typepack::cget<ReportType>(m_states));
+            auto lock = m_lockRead();
+            return m_read().has<ReportType>();
         }
 
-        bool hasAnyState() const { return m_hasState; }
+        bool hasAnyState() const {
+            auto lock = m_lockRead();
+            return m_read().hasState;
+        }
 
         template <typename ReportType>
         void getState(util::time::TimeValue &timestamp,
                       traits::StateFromReport_t<ReportType> &state) const {
-            if (hasState<ReportType>()) {
-                timestamp = typepack::cget<ReportType>(m_states)->timestamp;
-                state = typepack::cget<ReportType>(m_states)->state;
+            auto lock = m_lockRead();
+            auto const &snapshot = m_read();
+            if (snapshot.has<ReportType>()) {
+                timestamp =
+                    typepack::cget<ReportType>(snapshot.states)->timestamp;
+                state = typepack::cget<ReportType>(snapshot.states)->state;
             }
             /// @todo do we fail silently or throw exception if we are asked for
             /// state we don't have?
         }
 
+        /// @brief Lets state be read from a thread other than the one
+        /// setting it: see the class documentation. Call before any state is
+        /// set.
+        void enableSnapshots() {
+            if (!m_snapshots) {
+                m_snapshots.reset(new Snapshots);
+            }
+        }
+
+        /// @brief Makes the state set since the last call visible to the
+        /// reading thread, if snapshots are enabled.
+        void publish() {
+            if (!m_snapshots || !m_changed) {
+                return;
+            }
+            m_snapshots->buffer.back() = m_current;
+            m_snapshots->buffer.publish();
+            m_changed = false;
+        }
+
+        /// @brief Sets the number of past states to keep for each report
+        /// type, for getStateAtTime(). Defaults to 0: only the latest state
+        /// is kept.
+        void setHistoryCapacity(std::size_t capacity) {
+            auto lock = m_lockHistories();
+            m_historyCapacity = capacity;
+            if (capacity == 0) {
+                m_histories = StateHistoryMap{};
+            }
+        }
+
+        std::size_t getHistoryCapacity() const { return m_historyCapacity; }
+
+        /// @brief Gets the state as of a given time, from the history kept
+        /// if setHistoryCapacity() has been called: see
+        /// StateHistory::getStateAtTime() for details.
+        ///
+        /// @returns false if there is no state as of that time.
+        template <typename ReportType>
+        bool
+        getStateAtTime(util::time::TimeValue const &t,
+                       util::time::TimeValue &timestamp,
+                       traits::StateFromReport_t<ReportType> &state) const {
+            auto lock = m_lockHistories();
+            return typepack::cget<ReportType, StateHistoryMap>(m_histories)
+                .getStateAtTime(t, timestamp, state);
+        }
+
       private:
-        StateMap m_states;
-        bool m_hasState = false;
+        struct Snapshots {
+            util::TripleBuffer<StateSnapshot> buffer;
+            /// @brief The buffer has just one reader side, so readers take
+            /// turns at it: they never wait on the setting thread.
+            std::mutex readMutex;
+            /// @brief Histories are too big to copy for each publish(), so
+            /// they're shared, behind a lock held just long enough for a push
+            /// or a lookup.
+            std::mutex historyMutex;
+        };
+
+        std::unique_lock<std::mutex> m_lockRead() const {
+            if (!m_snapshots) {
+                return std::unique_lock<std::mutex>();
+            }
+            return std::unique_lock<std::mutex>(m_snapshots->readMutex);
+        }
+
+        /// @brief The state to read, with m_lockRead() held: the latest
+        /// published, if snapshots are enabled.
+        StateSnapshot const &m_read() const {
+            if (!m_snapshots) {
+                return m_current;
+            }
+            m_snapshots->buffer.refresh();
+            return m_snapshots->buffer.front();
+        }
+
+        std::unique_lock<std::mutex> m_lockHistories() const {
+            if (!m_snapshots) {
+                return std::unique_lock<std::mutex>();
+            }
+            return std::unique_lock<std::mutex>(m_snapshots->historyMutex);
+        }
+
+        StateSnapshot m_current;
+        bool m_changed = false;
+        unique_ptr<Snapshots> m_snapshots;
+        StateHistoryMap m_histories;
+        std::size_t m_historyCapacity = 0;
     };
 
 } // namespace common
@@ -89,6 +89,20 @@ namespace common {
         PathNode *m_sensor;
         GeneralizedTransform m_transform;
     };
+
+    /// @brief Compares two sources by what they resolve to (device, interface,
+    /// sensor, and transform), so sources resolved in different trees can be
+    /// compared.
+    ///
+    /// @relates osvr::common::OriginalSource
+    OSVR_COMMON_EXPORT bool operator==(OriginalSource const &lhs,
+                                       OriginalSource const &rhs);
+
+    /// @relates osvr::common::OriginalSource
+    inline bool operator!=(OriginalSource const &lhs,
+                           OriginalSource const &rhs) {
+        return !(lhs == rhs);
+    }
 } // namespace common
 } // namespace osvr
 
@@ -130,17 +130,25 @@ namespace common {
             OSVR_COMMON_EXPORT Json::Value &getDescriptor();
             OSVR_COMMON_EXPORT Json::Value const &getDescriptor() const;
 
+            /// @brief Shared memory name of the channel the server also
+            /// publishes this device's reports in, for clients on the same
+            /// host, or empty if none.
+            OSVR_COMMON_EXPORT std::string &getSharedReports();
+            OSVR_COMMON_EXPORT std::string const &getSharedReports() const;
+
             /// @brief Equality comparison operator
             bool operator==(DeviceElement const &other) const {
                 return m_devName == other.m_devName &&
                        m_server == other.m_server &&
-                       m_descriptor == other.m_descriptor;
+                       m_descriptor == other.m_descriptor &&
+                       m_sharedReports == other.m_sharedReports;
             }
 
           private:
             std::string m_devName;
             std::string m_server;
             Json::Value m_descriptor;
+            std::string m_sharedReports;
         };
 
         /// @brief The element type corresponding to an interface, which often
@@ -82,6 +82,9 @@ namespace common {
         /// @brief Reset the path tree to a new, empty root node.
         OSVR_COMMON_EXPORT void reset();
 
+        /// @brief Exchange contents with another path tree, without copying.
+        void swap(PathTree &other) { m_root.swap(other.m_root); }
+
         PathNode &getRoot() { return *m_root; }
 
         PathNode const &getRoot() const { return *m_root; }
@@ -35,6 +35,7 @@
 #include <json/value.h>
 
 // Standard includes
+#include <string>
 #include <vector>
 
 namespace osvr {
@@ -67,8 +68,18 @@ namespace common {
 
         /// @brief Replace the entirety of the path tree from the given
         /// serialized array of nodes.
+        ///
+        /// The outgoing tree is kept until the AfterUpdate observers have run,
+        /// so they can use hasResolutionChanged() to update only what they
+        /// have to.
         OSVR_COMMON_EXPORT void replaceTree(Json::Value const &nodes);
 
+        /// @brief During AfterUpdate callbacks, reports whether the given path
+        /// resolves to a different original source (or transform) in the new
+        /// tree than it did in the tree it replaced. Outside of those
+        /// callbacks, conservatively reports true for any resolvable path.
+        OSVR_COMMON_EXPORT bool hasResolutionChanged(std::string const &path);
+
         /// @brief Access the path tree object itself
         PathTree &get() { return m_tree; }
 
@@ -77,6 +88,13 @@ namespace common {
 
       private:
         PathTree m_tree;
+        /// @brief The tree being replaced, during a replaceTree() call.
+        PathTree m_previousTree;
+        /// @brief The serialized nodes m_tree was last replaced from.
+        Json::Value m_nodes;
+        /// @brief Whether the latest replaceTree() call got the same nodes as
+        /// the one before it, meaning nothing changed.
+        bool m_unchanged = false;
         std::vector<PathTreeObserverWeakPtr> m_observers;
         bool m_valid = false;
     };
@@ -49,6 +49,24 @@ namespace common {
 
     /// @brief Deserialize a path tree from a JSON array of objects
     OSVR_COMMON_EXPORT void jsonToPathTree(PathTree &tree, Json::Value nodes);
+
+    /// @brief Compute the operations that turn one serialized path tree (as
+    /// from pathTreeToJson()) into another: a JSON array of objects, each
+    /// with an "op" of "add" or "change" and the new "node", or an "op" of
+    /// "remove" and the "path" of the node removed.
+    ///
+    /// Empty if the two contain the same nodes.
+    OSVR_COMMON_EXPORT Json::Value diffPathTreeJson(Json::Value const &from,
+                                                    Json::Value const &to);
+
+    /// @brief Apply operations from diffPathTreeJson() to a serialized path
+    /// tree, in place.
+    ///
+    /// @returns false (leaving nodes untouched) if the operations don't apply
+    /// to the given nodes: adding a node already there, or changing or
+    /// removing one that isn't.
+    OSVR_COMMON_EXPORT bool applyPathTreeJsonDiff(Json::Value &nodes,
+                                                  Json::Value const &ops);
 } // namespace common
 } // namespace osvr
 
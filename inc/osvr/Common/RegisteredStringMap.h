@@ -31,21 +31,51 @@
 
 // Library/third-party includes
 #include <json/value.h>
+#include <boost/unordered_map.hpp>
+#include <boost/utility/string_ref.hpp>
 
 // Standard includes
+#include <cstddef>
+#include <string>
 #include <vector>
 
 namespace osvr {
 namespace common {
 
+    namespace detail {
+        /// @brief Hash and equality for the string map index, accepting
+        /// either stored strings or non-owning references, so lookups don't
+        /// have to construct a std::string.
+        struct StringRefHash {
+            std::size_t operator()(boost::string_ref str) const;
+        };
+        struct StringRefEqual {
+            bool operator()(boost::string_ref a, boost::string_ref b) const {
+                return a == b;
+            }
+        };
+    } // namespace detail
+
     /// Centralize a string registry. Basically, the server side, and part
     /// of the client side internals.
+    ///
+    /// IDs are indices into a vector of entries, and stay stable as entries
+    /// are added; a hash index makes looking up an existing name constant
+    /// time.
     class RegisteredStringMap {
       public:
         /// retrieve the ID for the current name or register new ID and return
         /// that
         OSVR_COMMON_EXPORT util::StringID getStringID(std::string const &str);
 
+        /// @overload
+        ///
+        /// Only copies the string if it has to be registered.
+        OSVR_COMMON_EXPORT util::StringID getStringID(const char *str);
+
+        /// Make room for at least this many entries without rehashing.
+        OSVR_COMMON_EXPORT void reserve(std::size_t n);
+
         /// retrieve the name of the string given the ID
         /// returns empty string if nothing found
         OSVR_COMMON_EXPORT std::string getStringFromId(util::StringID id) const;
@@ -60,8 +90,15 @@ namespace common {
         OSVR_COMMON_EXPORT std::vector<std::string> getEntries() const;
 
       protected:
+        util::StringID m_getStringID(boost::string_ref str);
+
         std::vector<std::string> m_regEntries;
 
+        /// maps each entry to its index in m_regEntries
+        boost::unordered_map<std::string, uint32_t, detail::StringRefHash,
+                             detail::StringRefEqual>
+            m_index;
+
         /// special flag that gets switched whenever new element is inserted;
         bool m_modified = false;
     };
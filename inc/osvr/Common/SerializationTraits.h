@@ -30,6 +30,8 @@
 #include <osvr/Common/Endianness.h>
 #include <osvr/Common/SerializationTags.h>
 #include <osvr/Util/BoolC.h>
+#include <osvr/Util/Pose3C.h>
+#include <osvr/Util/QuaternionC.h>
 #include <osvr/Util/Vec2C.h>
 #include <osvr/Util/Vec3C.h>
 #include <osvr/Util/TypeSafeId.h>
@@ -558,6 +560,26 @@ namespace common {
             }
         };
 
+        template <>
+        struct SimpleStructSerialization<OSVR_Quaternion>
+            : SimpleStructSerializationBase {
+            template <typename F, typename T> static void apply(F &f, T &val) {
+                f(val.data[0]);
+                f(val.data[1]);
+                f(val.data[2]);
+                f(val.data[3]);
+            }
+        };
+
+        template <>
+        struct SimpleStructSerialization<OSVR_Pose3>
+            : SimpleStructSerializationBase {
+            template <typename F, typename T> static void apply(F &f, T &val) {
+                f(val.translation);
+                f(val.rotation);
+            }
+        };
+
         template <typename Tag>
         struct SimpleStructSerialization<util::TypeSafeId<Tag>>
             : SimpleStructSerializationBase {
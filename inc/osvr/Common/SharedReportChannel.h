@@ -0,0 +1,182 @@
+/** @file
+    @brief Header for a shared-memory channel carrying a device's tracker,
+   analog and button reports to clients on the same host.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_SharedReportChannel_h_GUID_DF439189_B458_4C75_94F9_73D2B781DDF3
+#define INCLUDED_SharedReportChannel_h_GUID_DF439189_B458_4C75_94F9_73D2B781DDF3
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+#include <osvr/Common/IPCRingBuffer.h>
+#include <osvr/Util/ChannelCountC.h>
+#include <osvr/Util/SharedPtr.h>
+#include <osvr/Util/StdInt.h>
+#include <osvr/Util/TimeValueC.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace osvr {
+namespace common {
+
+    /// @brief The kind of report carried by a SharedReportRecord.
+    enum class SharedReportKind : uint32_t {
+        Pose = 0,
+        Analog = 1,
+        Button = 2
+    };
+
+    /// @brief A fixed-size report record, as placed in shared memory.
+    ///
+    /// The meaning of the values depends on the kind: a pose is the
+    /// translation followed by the rotation quaternion (w, x, y, z), while
+    /// analog and button reports use only the first value.
+    struct SharedReportRecord {
+        SharedReportKind kind;
+        OSVR_ChannelCount sensor;
+        OSVR_TimeValue timestamp;
+        double values[7];
+    };
+
+    class SharedReportChannel;
+    typedef shared_ptr<SharedReportChannel> SharedReportChannelPtr;
+
+    /// @brief A single-producer, broadcast channel of report records in
+    /// shared memory, one per device and server, built on a lock-free
+    /// IPCRingBuffer.
+    ///
+    /// The server publishes each report both here and over VRPN: a client on
+    /// the same host may read reports from here as soon as they're published,
+    /// without waiting on the server mainloop or the socket, but it has to
+    /// expect the same reports to arrive over VRPN as well. The server
+    /// advertises the name of each device's channel in the path tree, so
+    /// clients need not guess which server on the host it belongs to.
+    ///
+    /// Readers that fall more than a ring buffer's worth of records behind
+    /// lose the oldest ones, which are counted rather than delivered.
+    ///
+    /// Code in the server process itself (analysis plugins) can instead
+    /// subscribe to the server's own channel object, found with
+    /// findInProcess(): each record is then handed over in memory as it is
+    /// published, in order, none dropped, and no copy needs to be taken from
+    /// VRPN at all.
+    class SharedReportChannel {
+      public:
+        /// @brief Number of records kept in the ring buffer.
+        enum { CAPACITY = 1024 };
+
+        typedef void (*Subscriber)(void *userdata,
+                                   SharedReportRecord const &record);
+
+        /// @brief Gets the shared memory name used for a device's channel on
+        /// the server listening on the given port, so servers on different
+        /// ports of one host don't share a channel.
+        OSVR_COMMON_EXPORT static std::string
+        getName(std::string const &deviceName, int port);
+
+        /// @brief Creates (replacing any stale one) the channel for a device,
+        /// for use by the server, and makes it the one findInProcess()
+        /// returns for that device.
+        ///
+        /// @param port The port the server listens on, or 0 if it isn't
+        /// reachable from other processes (a loopback connection): then no
+        /// shared memory is created.
+        ///
+        /// If the shared memory couldn't be created, the channel still serves
+        /// in-process subscribers.
+        OSVR_COMMON_EXPORT static SharedReportChannelPtr
+        create(std::string const &deviceName, int port);
+
+        /// @brief Gets the channel a server in this process created for a
+        /// device, for subscribing to directly.
+        ///
+        /// @return an empty pointer if there is none (alive).
+        OSVR_COMMON_EXPORT static SharedReportChannelPtr
+        findInProcess(std::string const &deviceName);
+
+        /// @brief Opens an existing channel by its shared memory name (as
+        /// advertised by the server), for use by clients. Only records
+        /// published after this call will be read.
+        ///
+        /// @return an empty pointer if no such channel exists.
+        OSVR_COMMON_EXPORT static SharedReportChannelPtr
+        find(std::string const &name);
+
+        /// @brief Gets the shared memory name of this channel, or an empty
+        /// string if it only serves in-process subscribers.
+        std::string const &getSharedMemoryName() const { return m_name; }
+
+        /// @brief Publishes a record: puts it in shared memory, then calls
+        /// each in-process subscriber with it. Never waits on readers.
+        OSVR_COMMON_EXPORT void publish(SharedReportRecord const &record);
+
+        /// @name In-process subscribers
+        /// @brief Subscribers get called synchronously by publish(), on the
+        /// publishing thread, just as VRPN calls handlers local to a
+        /// connection from pack_message(): so, like those handlers, only
+        /// (un)subscribe on the thread that runs the server, while devices
+        /// can't be sending.
+        /// @{
+        OSVR_COMMON_EXPORT void subscribe(Subscriber subscriber,
+                                          void *userdata);
+        OSVR_COMMON_EXPORT void unsubscribe(Subscriber subscriber,
+                                            void *userdata);
+        /// @}
+
+        /// @brief Copies out, in order, up to maxRecords records published
+        /// since the last call (or since the channel was opened).
+        ///
+        /// @return the number of records copied out.
+        OSVR_COMMON_EXPORT std::size_t poll(SharedReportRecord *out,
+                                            std::size_t maxRecords);
+
+        /// @brief Gets the number of records this reader missed by falling
+        /// behind.
+        std::size_t getDropped() const { return m_dropped; }
+
+      private:
+        SharedReportChannel(IPCRingBufferPtr const &buf,
+                            std::string const &name);
+        IPCRingBufferPtr m_buf;
+        std::string m_name;
+        IPCRingBuffer::sequence_type m_next;
+        std::size_t m_dropped;
+        std::vector<std::pair<Subscriber, void *> > m_subscribers;
+        /// @brief Depth of nested publish() calls in progress.
+        int m_publishing;
+        /// @brief Whether a subscriber unsubscribed while publish() was
+        /// calling them.
+        bool m_needsCompacting;
+    };
+
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_SharedReportChannel_h_GUID_DF439189_B458_4C75_94F9_73D2B781DDF3
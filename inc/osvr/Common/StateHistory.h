@@ -0,0 +1,165 @@
+/** @file
+    @brief Header providing a fixed-capacity, timestamp-ordered history of
+   the states of an interface, searchable by time.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_StateHistory_h_GUID_91443123_FC76_4E18_A29F_C8485A02DC1A
+#define INCLUDED_StateHistory_h_GUID_91443123_FC76_4E18_A29F_C8485A02DC1A
+
+// Internal Includes
+#include <osvr/Common/StateInterpolation.h>
+#include <osvr/Common/StateType.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace osvr {
+namespace common {
+    template <typename ReportType> struct StateMapContents;
+
+    /// @brief A ring buffer of the most recent states (and their timestamps)
+    /// of one report type, oldest first, for looking up the state as of a
+    /// given time.
+    ///
+    /// Entries are stored contiguously and never reallocated once the
+    /// capacity is set. States must be pushed in timestamp order, which lets
+    /// lookups by time use a binary search.
+    template <typename ReportType> class StateHistory {
+      public:
+        using value_type = StateMapContents<ReportType>;
+        using state_type = traits::StateFromReport_t<ReportType>;
+
+        /// @brief Number of states kept: 0 (the default) keeps none.
+        std::size_t capacity() const { return m_entries.size(); }
+        std::size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+
+        /// @brief Changes the capacity, keeping as many of the newest states
+        /// as fit.
+        void setCapacity(std::size_t capacity) {
+            if (capacity == this->capacity()) {
+                return;
+            }
+            std::vector<value_type> entries(capacity);
+            auto kept = std::min(capacity, m_size);
+            for (std::size_t i = 0; i < kept; ++i) {
+                entries[i] = (*this)[m_size - kept + i];
+            }
+            m_entries.swap(entries);
+            m_begin = 0;
+            m_size = kept;
+        }
+
+        /// @brief Adds a state newer than any already kept, replacing the
+        /// oldest if full.
+        void push(util::time::TimeValue const &timestamp,
+                  state_type const &state) {
+            if (m_entries.empty()) {
+                return;
+            }
+            std::size_t pos;
+            if (m_size < capacity()) {
+                pos = m_physicalIndex(m_size);
+                ++m_size;
+            } else {
+                pos = m_begin;
+                m_begin = m_physicalIndex(1);
+            }
+            m_entries[pos].timestamp = timestamp;
+            m_entries[pos].state = state;
+        }
+
+        /// @brief Access by age: 0 is the oldest state kept.
+        value_type const &operator[](std::size_t i) const {
+            return m_entries[m_physicalIndex(i)];
+        }
+
+        /// @brief Gets the index of the oldest state with a timestamp later
+        /// than the given time, or size() if there is none.
+        std::size_t upperBound(util::time::TimeValue const &t) const {
+            std::size_t first = 0;
+            std::size_t count = m_size;
+            while (count > 0) {
+                auto step = count / 2;
+                auto mid = first + step;
+                if (!osvrTimeValueGreater((*this)[mid].timestamp, t)) {
+                    first = mid + 1;
+                    count -= step + 1;
+                } else {
+                    count = step;
+                }
+            }
+            return first;
+        }
+
+        /// @brief Gets the state as of the given time.
+        ///
+        /// For report types that can be interpolated (pose, position and
+        /// orientation), a time between two states gets a state interpolated
+        /// between them, timestamped with the time asked for. Otherwise, and
+        /// for times after the newest state, gets the newest state at or
+        /// before the given time, with its own timestamp.
+        ///
+        /// @returns false if the time is before the oldest state kept.
+        bool getStateAtTime(util::time::TimeValue const &t,
+                            util::time::TimeValue &timestamp,
+                            state_type &state) const {
+            auto after = upperBound(t);
+            if (after == 0) {
+                return false;
+            }
+            auto const &before = (*this)[after - 1];
+            if (after < m_size && StateInterpolation<ReportType>::value) {
+                auto const &next = (*this)[after];
+                auto alpha = util::time::duration(t, before.timestamp) /
+                             util::time::duration(next.timestamp,
+                                                  before.timestamp);
+                StateInterpolation<ReportType>::interpolate(
+                    before.state, next.state, alpha, state);
+                timestamp = t;
+                return true;
+            }
+            timestamp = before.timestamp;
+            state = before.state;
+            return true;
+        }
+
+      private:
+        std::size_t m_physicalIndex(std::size_t i) const {
+            auto pos = m_begin + i;
+            return pos < m_entries.size() ? pos : pos - m_entries.size();
+        }
+        std::vector<value_type> m_entries;
+        std::size_t m_begin = 0;
+        std::size_t m_size = 0;
+    };
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_StateHistory_h_GUID_91443123_FC76_4E18_A29F_C8485A02DC1A
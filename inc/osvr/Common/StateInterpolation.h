@@ -0,0 +1,95 @@
+/** @file
+    @brief Header providing interpolation between two states of the report
+   types for which it makes sense: pose, position and orientation.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_StateInterpolation_h_GUID_BEA8EEDF_79C5_45CF_80E0_933CCE07C51F
+#define INCLUDED_StateInterpolation_h_GUID_BEA8EEDF_79C5_45CF_80E0_933CCE07C51F
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+#include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/Pose3C.h>
+#include <osvr/Util/QuaternionC.h>
+#include <osvr/Util/Vec3C.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace common {
+    /// @brief Linear interpolation: alpha of 0 gets a, 1 gets b.
+    OSVR_COMMON_EXPORT void interpolate(OSVR_Vec3 const &a,
+                                        OSVR_Vec3 const &b, double alpha,
+                                        OSVR_Vec3 &out);
+
+    /// @brief Spherical linear interpolation, along the shorter arc: alpha of
+    /// 0 gets a, 1 gets b.
+    OSVR_COMMON_EXPORT void interpolate(OSVR_Quaternion const &a,
+                                        OSVR_Quaternion const &b, double alpha,
+                                        OSVR_Quaternion &out);
+
+    /// @brief Interpolates translation linearly and rotation spherically.
+    OSVR_COMMON_EXPORT void interpolate(OSVR_Pose3 const &a,
+                                        OSVR_Pose3 const &b, double alpha,
+                                        OSVR_Pose3 &out);
+
+    /// @brief Trait indicating whether, and how, the state of a report type
+    /// can be interpolated between two samples: the primary template is for
+    /// those whose state can't.
+    template <typename ReportType> struct StateInterpolation {
+        static const bool value = false;
+        template <typename StateType>
+        static void interpolate(StateType const &a, StateType const &,
+                                double, StateType &out) {
+            out = a;
+        }
+    };
+
+    /// @brief Base for the specializations for report types whose state is
+    /// one of the types handled by the interpolate() overloads.
+    template <typename ReportType> struct InterpolatableState {
+        static const bool value = true;
+        template <typename StateType>
+        static void interpolate(StateType const &a, StateType const &b,
+                                double alpha, StateType &out) {
+            ::osvr::common::interpolate(a, b, alpha, out);
+        }
+    };
+
+    template <>
+    struct StateInterpolation<OSVR_PoseReport>
+        : InterpolatableState<OSVR_PoseReport> {};
+    template <>
+    struct StateInterpolation<OSVR_PositionReport>
+        : InterpolatableState<OSVR_PositionReport> {};
+    template <>
+    struct StateInterpolation<OSVR_OrientationReport>
+        : InterpolatableState<OSVR_OrientationReport> {};
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_StateInterpolation_h_GUID_BEA8EEDF_79C5_45CF_80E0_933CCE07C51F
@@ -36,7 +36,9 @@
 #include <json/value.h>
 
 // Standard includes
-// - none
+#include <cstdint>
+#include <functional>
+#include <vector>
 
 namespace osvr {
 namespace common {
@@ -69,6 +71,26 @@ namespace common {
             class MessageSerialization;
             static const char *identifier();
         };
+
+        class TreeSnapshotFromServer
+            : public MessageRegistration<TreeSnapshotFromServer> {
+          public:
+            class MessageSerialization;
+            static const char *identifier();
+        };
+
+        class TreeDeltaFromServer
+            : public MessageRegistration<TreeDeltaFromServer> {
+          public:
+            class MessageSerialization;
+            static const char *identifier();
+        };
+
+        class TreeAckToServer : public MessageRegistration<TreeAckToServer> {
+          public:
+            class MessageSerialization;
+            static const char *identifier();
+        };
     } // namespace messages
 
     /// @brief BaseDevice component, to be used only with the "OSVR" special
@@ -110,15 +132,81 @@ namespace common {
                                    util::time::TimeValue const &)> JsonHandler;
         OSVR_COMMON_EXPORT void registerReplaceTreeHandler(JsonHandler cb);
 
+        /// @brief Sends the full tree in the original, unversioned form,
+        /// which every client understands.
         OSVR_COMMON_EXPORT void sendReplacementTree(PathTree &tree);
 
+        /// @name Versioned path tree protocol
+        /// @brief The server sends a snapshot of the tree when clients
+        /// connect, and only the nodes added, removed, or changed after that.
+        /// Clients supporting this acknowledge each snapshot, so the server
+        /// can tell when it no longer needs to send replacement trees for
+        /// older clients.
+        ///
+        /// Handlers registered with registerReplaceTreeHandler() get the full
+        /// tree however it was sent.
+        /// @{
+        /// @brief Message from server with the full tree and its version.
+        messages::TreeSnapshotFromServer treeSnapshotOut;
+
+        /// @brief Message from server with the operations turning one version
+        /// of the tree into the next.
+        messages::TreeDeltaFromServer treeDeltaOut;
+
+        /// @brief Message from client acknowledging a snapshot, or asking for
+        /// a new one if it couldn't apply a delta.
+        messages::TreeAckToServer treeAckIn;
+
+        /// @brief Sends a snapshot of the tree, starting a new version.
+        OSVR_COMMON_EXPORT void sendTreeSnapshot(PathTree &tree);
+
+        /// @brief Sends the changes to the tree since the last snapshot or
+        /// delta sent, if any.
+        ///
+        /// @returns true if there were changes to send.
+        OSVR_COMMON_EXPORT bool sendTreeDelta(PathTree &tree);
+
+        /// @brief The version of the last snapshot sent: acknowledgements
+        /// of any other are stale.
+        std::uint32_t getTreeSnapshotVersion() const {
+            return m_snapshotVersion;
+        }
+
+        /// @brief Handler for acknowledgements from clients: the arguments
+        /// are the version of the tree the client has, and whether it needs a
+        /// new snapshot.
+        typedef std::function<void(std::uint32_t, bool)> TreeAckHandler;
+        OSVR_COMMON_EXPORT void registerTreeAckHandler(TreeAckHandler cb);
+        /// @}
+
       private:
         SystemComponent();
         virtual void m_parentSet();
         static int VRPN_CALLBACK
         m_handleReplaceTree(void *userdata, vrpn_HANDLERPARAM p);
+        static int VRPN_CALLBACK
+        m_handleTreeSnapshot(void *userdata, vrpn_HANDLERPARAM p);
+        static int VRPN_CALLBACK
+        m_handleTreeDelta(void *userdata, vrpn_HANDLERPARAM p);
+        static int VRPN_CALLBACK
+        m_handleTreeAck(void *userdata, vrpn_HANDLERPARAM p);
+        void m_sendTreeMessage(Json::Value const &msg, RawMessageType type);
+        void m_sendTreeAck(bool needSnapshot);
+        void m_deliverTree(util::time::TimeValue const &timestamp);
 
         std::vector<JsonHandler> m_replaceTreeHandlers;
+        std::vector<TreeAckHandler> m_treeAckHandlers;
+
+        /// @brief Server side: the version and contents last sent.
+        std::uint32_t m_sentVersion = 0;
+        std::uint32_t m_snapshotVersion = 0;
+        Json::Value m_sentNodes;
+
+        /// @brief Client side: the version and contents last received, if a
+        /// snapshot has been received.
+        bool m_haveSnapshot = false;
+        std::uint32_t m_receivedVersion = 0;
+        Json::Value m_receivedNodes;
     };
 } // namespace common
 } // namespace osvr
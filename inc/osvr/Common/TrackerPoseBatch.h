@@ -0,0 +1,96 @@
+/** @file
+    @brief Header defining the message carrying the poses of several tracker
+   sensors, sampled at the same time, in one report.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_TrackerPoseBatch_h_GUID_4E17DE3D_7D8D_418A_BCD2_24B7FA7E4E8C
+#define INCLUDED_TrackerPoseBatch_h_GUID_4E17DE3D_7D8D_418A_BCD2_24B7FA7E4E8C
+
+// Internal Includes
+#include <osvr/Common/SerializationTraits.h>
+#include <osvr/Util/ChannelCountC.h>
+#include <osvr/Util/ClientReportTypesC.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace osvr {
+namespace common {
+
+    /// @brief One sensor's pose in a batched tracker report.
+    struct TrackerPoseBatchEntry {
+        OSVR_ChannelCount sensor;
+        OSVR_PoseState pose;
+    };
+
+    namespace messages {
+        /// @brief Message sent alongside the standard VRPN tracker messages,
+        /// carrying the poses of several sensors of a device with a single
+        /// timestamp (that of the message).
+        class TrackerPoseBatch {
+          public:
+            /// @brief The most poses carried by one message, chosen so that a
+            /// message still fits in a single VRPN UDP datagram: larger
+            /// batches are split over several messages.
+            enum { MAX_POSES_PER_MESSAGE = 20 };
+
+            static const char *identifier() {
+                return "com.osvr.tracker.posebatch";
+            }
+
+            /// @brief Serializes from, or deserializes into, a vector of at
+            /// most MAX_POSES_PER_MESSAGE entries, which can be reused from
+            /// message to message.
+            class MessageSerialization {
+              public:
+                explicit MessageSerialization(
+                    std::vector<TrackerPoseBatchEntry> &entries)
+                    : m_entries(entries) {}
+
+                template <typename T> void processMessage(T &p) {
+                    auto n = static_cast<uint32_t>(m_entries.size());
+                    p(n);
+                    // Don't trust the count enough to allocate for it.
+                    m_entries.resize(std::min<uint32_t>(
+                        n, MAX_POSES_PER_MESSAGE));
+                    for (auto &entry : m_entries) {
+                        p(entry.sensor);
+                        p(entry.pose);
+                    }
+                }
+
+              private:
+                std::vector<TrackerPoseBatchEntry> &m_entries;
+            };
+        };
+    } // namespace messages
+
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_TrackerPoseBatch_h_GUID_4E17DE3D_7D8D_418A_BCD2_24B7FA7E4E8C
@@ -0,0 +1,76 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_WaitableVrpnConnection_h_GUID_0FED88D8_3047_4681_9737_769B724DE67F
+#define INCLUDED_WaitableVrpnConnection_h_GUID_0FED88D8_3047_4681_9737_769B724DE67F
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+
+// Library/third-party includes
+#include <vrpn_Connection.h>
+
+// Standard includes
+#include <vector>
+
+namespace osvr {
+namespace common {
+    /// @brief A VRPN connection that can report the sockets it would read
+    /// from in its mainloop, so that a caller can block until one of them
+    /// has something to read rather than polling.
+    class WaitableVrpnConnection : public vrpn_Connection_IP {
+      public:
+        /// @brief Creates a server connection, as
+        /// vrpn_create_server_connection() would, but not yet
+        /// reference-counted: hand it to vrpn_ConnectionPtr's constructor.
+        OSVR_COMMON_EXPORT static WaitableVrpnConnection *
+        create(int port, const char NIC[]);
+
+        /// @brief Creates a client connection to a server, as a forced
+        /// vrpn_get_connection_by_name() would, but not yet
+        /// reference-counted: hand it to vrpn_ConnectionPtr's constructor.
+        ///
+        /// @param name Server name (anything before an '@' is ignored), not a
+        /// file: URL.
+        OSVR_COMMON_EXPORT static WaitableVrpnConnection *
+        createClient(const char name[]);
+
+        OSVR_COMMON_EXPORT virtual ~WaitableVrpnConnection();
+
+        /// @brief Appends the listening sockets and those of all connected
+        /// (or, for a client, connecting) endpoints to the vector.
+        OSVR_COMMON_EXPORT void appendSockets(std::vector<SOCKET> &sockets);
+
+      private:
+        WaitableVrpnConnection(unsigned short port, const char NIC[]);
+        WaitableVrpnConnection(const char name[], int port);
+        /// @brief Endpoint allocator, so that we can get at the inbound UDP
+        /// socket of each endpoint.
+        static vrpn_Endpoint_IP *m_allocateEndpoint(vrpn_Connection *conn,
+                                                    vrpn_int32 *connectedEC);
+    };
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_WaitableVrpnConnection_h_GUID_0FED88D8_3047_4681_9737_769B724DE67F
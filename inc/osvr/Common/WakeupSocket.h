@@ -0,0 +1,86 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_WakeupSocket_h_GUID_5BE5A91E_C5AD_4A5E_8288_CF1E1DF1E9D5
+#define INCLUDED_WakeupSocket_h_GUID_5BE5A91E_C5AD_4A5E_8288_CF1E1DF1E9D5
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+#include <vrpn_Shared.h> // for SOCKET
+
+// Standard includes
+#include <atomic>
+#include <vector>
+
+namespace osvr {
+namespace common {
+    /// @brief A socket that can be waited on alongside the connection's own
+    /// sockets, and signalled from any thread to end that wait.
+    ///
+    /// This is a UDP socket bound to the loopback interface and connected to
+    /// itself, rather than an eventfd or pipe, so that it also works with
+    /// select() on Windows, which only accepts sockets.
+    class WakeupSocket : boost::noncopyable {
+      public:
+        /// @brief Constructor - check isValid() afterwards.
+        OSVR_COMMON_EXPORT WakeupSocket();
+        OSVR_COMMON_EXPORT ~WakeupSocket();
+
+        /// @brief Whether the socket could be set up.
+        bool isValid() const { return m_sock != INVALID_SOCKET; }
+
+        /// @brief The socket to watch for readability.
+        SOCKET getSocket() const { return m_sock; }
+
+        /// @brief Make the socket readable, if it isn't already. Thread-safe.
+        OSVR_COMMON_EXPORT void signal();
+
+        /// @brief Make the socket non-readable again. Call from the waiting
+        /// thread once it has woken, before it does the work it was woken for.
+        OSVR_COMMON_EXPORT void drain();
+
+        /// @brief Blocks until this socket is signalled, one of the given
+        /// sockets is readable, or the time is up, draining this socket if
+        /// it was signalled.
+        ///
+        /// Uses poll() where available, so that there is no limit on the
+        /// socket values as with an fd_set. Windows' fd_set holds a count of
+        /// sockets instead, so past FD_SETSIZE of them, the rest only get
+        /// looked at when the wait ends for some other reason.
+        OSVR_COMMON_EXPORT void wait(std::vector<SOCKET> const &sockets,
+                                     int microseconds);
+
+      private:
+        SOCKET m_sock;
+        /// @brief Set by signal() and cleared by drain(), so that a burst of
+        /// signals only costs one datagram.
+        std::atomic<bool> m_signalled;
+    };
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_WakeupSocket_h_GUID_5BE5A91E_C5AD_4A5E_8288_CF1E1DF1E9D5
@@ -111,6 +111,23 @@ namespace connection {
         /// Someone needs to call this method frequently.
         OSVR_CONNECTION_EXPORT void process();
 
+        /// @brief Send anything queued, then block until there may be
+        /// messages to process, wakeUp() is called, or the timeout elapses,
+        /// whichever comes first.
+        ///
+        /// Call between calls to process() instead of sleeping.
+        OSVR_CONNECTION_EXPORT void waitForActivity(int microseconds);
+
+        /// @brief Make a waitForActivity() call in progress return promptly
+        /// (or the next one, if none is in progress). May be called from any
+        /// thread.
+        OSVR_CONNECTION_EXPORT void wakeUp();
+
+        /// @brief Whether any device needs process() called regularly, rather
+        /// than just when there is activity to wake for (sync devices, for
+        /// instance).
+        OSVR_CONNECTION_EXPORT bool devicesRequirePolling() const;
+
         /// @brief Register a function to be called when a client connects or
         /// pings.
         OSVR_CONNECTION_EXPORT void
@@ -196,6 +213,15 @@ namespace connection {
         /// block.
         virtual void m_process() = 0;
 
+        /// @brief (Subclass implementation) Block until there may be
+        /// messages to process, m_wakeUp() is called, or the timeout elapses.
+        /// Default implementation just sleeps.
+        virtual void m_waitForActivity(int microseconds);
+
+        /// @brief (Subclass implementation) Wake up a waiting
+        /// m_waitForActivity(). Default implementation does nothing.
+        virtual void m_wakeUp();
+
         /// brief Constructor
         Connection();
 
@@ -61,6 +61,10 @@ namespace connection {
         /// Someone needs to call this method frequently.
         void process();
 
+        /// @brief Whether this device needs process() called regularly, even
+        /// when nothing has signalled any activity.
+        bool requiresPolling() const;
+
         /// @brief Send message (as primary device name)
         void sendData(util::time::TimeValue const &timestamp, MessageType *type,
                       const char *bytestream, size_t len);
@@ -78,6 +82,11 @@ namespace connection {
         /// @brief Get the most current JSON device descriptor
         OSVR_CONNECTION_EXPORT std::string const &getDeviceDescriptor() const;
 
+        /// @brief Get the shared memory name of the channel this device's
+        /// reports are also published in, or an empty string if none.
+        OSVR_CONNECTION_EXPORT std::string const &
+        getSharedReportChannel() const;
+
       protected:
         /// @brief Does this connection device have a device token? Should be
         /// true in nearly every case.
@@ -88,11 +97,19 @@ namespace connection {
         /// block.
         virtual void m_process() = 0;
 
+        /// @brief (Subclass implementation) Whether process() must be called
+        /// regularly. Default implementation asks the device token.
+        virtual bool m_requiresPolling() const;
+
         /// @brief (Subclass implementation) Send message.
         virtual void m_sendData(util::time::TimeValue const &timestamp,
                                 MessageType *type, const char *bytestream,
                                 size_t len) = 0;
 
+        /// @brief Set by derived classes that publish to a shared memory
+        /// report channel.
+        void m_setSharedReportChannel(std::string const &name);
+
         /// @brief Constructor for use by derived classes only.
         OSVR_CONNECTION_EXPORT ConnectionDevice(std::string const &name);
 
@@ -103,6 +120,7 @@ namespace connection {
         NameList m_names;
         DeviceToken *m_token;
         std::string m_descriptor;
+        std::string m_sharedReportChannel;
     };
 } // namespace connection
 } // namespace osvr
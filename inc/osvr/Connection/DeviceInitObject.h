@@ -31,6 +31,7 @@
 #include <osvr/Util/PluginRegContextC.h>
 #include <osvr/PluginHost/PluginSpecificRegistrationContext.h>
 #include <osvr/Util/StdInt.h>
+#include <osvr/Util/AsyncSendQueueC.h>
 #include <osvr/Util/UniquePtr.h>
 #include <osvr/Connection/Export.h>
 #include <osvr/Connection/ConnectionPtr.h>
@@ -46,6 +47,7 @@
 #include <string>
 #include <type_traits>
 #include <memory>
+#include <cstddef>
 
 namespace osvr {
 namespace connection {
@@ -96,6 +98,11 @@ struct OSVR_DeviceInitObject : boost::noncopyable {
     OSVR_CONNECTION_EXPORT void
     addComponent(osvr::common::DeviceComponentPtr const &comp);
 
+    /// @brief Configure the queue an async device's reports wait in for the
+    /// server thread: a capacity of 0 means the default.
+    OSVR_CONNECTION_EXPORT void setAsyncSendQueue(std::size_t capacity,
+                                                  OSVR_AsyncSendPolicy policy);
+
     /// @brief A helper method to make a "device interface object" of
     /// user-designated type and apppropriate lifetime.
     template <typename T> T *makeInterfaceObject() {
@@ -156,6 +163,13 @@ struct OSVR_DeviceInitObject : boost::noncopyable {
         return m_components;
     }
 
+    std::size_t getAsyncSendQueueCapacity() const {
+        return m_asyncSendQueueCapacity;
+    }
+    OSVR_AsyncSendPolicy getAsyncSendPolicy() const {
+        return m_asyncSendPolicy;
+    }
+
   private:
     osvr::pluginhost::PluginSpecificRegistrationContext *m_context;
     osvr::connection::ConnectionPtr m_conn;
@@ -169,6 +183,8 @@ struct OSVR_DeviceInitObject : boost::noncopyable {
     osvr::connection::TrackerServerInterface **m_trackerIface;
     osvr::connection::ServerInterfaceList m_serverInterfaces;
     osvr::common::DeviceComponentList m_components;
+    std::size_t m_asyncSendQueueCapacity;
+    OSVR_AsyncSendPolicy m_asyncSendPolicy;
     std::vector<OSVR_DeviceTokenObject **> m_tokenInterest;
 
     std::vector<osvr::connection::DeviceInterfaceBase *> m_deviceInterfaces;
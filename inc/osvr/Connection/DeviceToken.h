@@ -33,6 +33,7 @@
 #include <osvr/Connection/ConnectionPtr.h>
 #include <osvr/Connection/ConnectionDevicePtr.h>
 #include <osvr/Util/DeviceCallbackTypesC.h>
+#include <osvr/Util/AsyncSendQueueC.h>
 #include <osvr/Util/TimeValue.h>
 #include <osvr/Util/GuardPtr.h>
 #include <osvr/Connection/ServerInterfaceList.h>
@@ -118,9 +119,20 @@ struct OSVR_DeviceTokenObject : boost::noncopyable {
     /// ConnectionDevice::sendData from within here somehow.
     void connectionInteract();
 
+    /// @brief Whether connectionInteract() needs to be called regularly, even
+    /// when nothing has signalled any activity.
+    bool requiresPolling() const;
+
     /// @brief Stop any threads spawned and owned by this DeviceToken
     void stopThreads();
 
+    /// @brief Gets the counters of the queue reports wait in for the server
+    /// thread.
+    ///
+    /// @returns false if this kind of device token has no such queue.
+    OSVR_CONNECTION_EXPORT bool
+    getAsyncSendQueueStats(OSVR_AsyncSendQueueStats &stats) const;
+
     /// @brief Send a new or updated device descriptor for this device.
     OSVR_CONNECTION_EXPORT void
     setDeviceDescriptor(std::string const &jsonString);
@@ -148,6 +160,11 @@ struct OSVR_DeviceTokenObject : boost::noncopyable {
                             const char *bytestream, size_t len) = 0;
     virtual osvr::util::GuardPtr m_getSendGuard() = 0;
     virtual void m_connectionInteract() = 0;
+    /// @brief Default implementation returns false.
+    virtual bool m_requiresPolling() const;
+    /// @brief Default implementation returns false.
+    virtual bool
+    m_getAsyncSendQueueStats(OSVR_AsyncSendQueueStats &stats) const;
     virtual void m_stopThreads();
 
   private:
@@ -57,6 +57,19 @@ namespace connection {
                                 OSVR_ChannelCount sensor,
                                 util::time::TimeValue const &timestamp) = 0;
 
+        /// @brief Sends the poses of several sensors, all with the same
+        /// timestamp, batched into as few messages as possible.
+        ///
+        /// @param vals Array of poses
+        /// @param sensors Array of the sensor number for each pose, or null
+        /// if the poses are those of sensors 0 through count - 1.
+        /// @param count Number of poses
+        /// @param timestamp Timestamp shared by all poses.
+        virtual void sendPoseReports(OSVR_PoseState const *vals,
+                                     OSVR_ChannelCount const *sensors,
+                                     OSVR_ChannelCount count,
+                                     util::time::TimeValue const &timestamp) = 0;
+
         virtual void sendVelReport(OSVR_VelocityState const &val,
                                    OSVR_ChannelCount sensor,
                                    util::time::TimeValue const &timestamp) = 0;
@@ -29,10 +29,10 @@
 #include "FlexibleKalmanBase.h"
 
 // Library/third-party includes
-// - none
+#include <Eigen/Cholesky>
 
 // Standard includes
-// - none
+#include <cassert>
 
 namespace osvr {
 namespace kalman {
@@ -136,6 +136,158 @@ namespace kalman {
         state.postCorrect();
     }
 
+    /// A block of measurements, with a number of rows only known at runtime,
+    /// to be applied to a state in a single correction step by
+    /// correctStacked(): the measurements get stacked, each appending its
+    /// rows of residual and jacobian.
+    ///
+    /// Each measurement is whitened as it's appended (scaled by the inverse
+    /// of the Cholesky factor of its covariance), so the stack as a whole has
+    /// an identity covariance. Measurements are thus taken to be independent
+    /// of each other.
+    ///
+    /// Storage is kept between uses, so once it has grown to its working size
+    /// (see reserve()), clearing and refilling it doesn't allocate.
+    template <typename StateType> class StackedMeasurement {
+      public:
+        static const types::DimensionType STATE_DIMENSION =
+            types::Dimension<StateType>::value;
+        using JacobianStorage =
+            Eigen::Matrix<types::Scalar, Eigen::Dynamic, STATE_DIMENSION>;
+        using ResidualStorage = Eigen::VectorXd;
+
+        /// Makes room for up to the given number of rows.
+        void reserve(types::DimensionType rows) {
+            if (rows <= m_jacobian.rows()) {
+                return;
+            }
+            JacobianStorage jacobian;
+            jacobian.resize(rows, Eigen::NoChange);
+            jacobian.topRows(m_rows) = m_jacobian.topRows(m_rows);
+            m_jacobian.swap(jacobian);
+            ResidualStorage residual(rows);
+            residual.head(m_rows) = m_residual.head(m_rows);
+            m_residual.swap(residual);
+        }
+
+        /// Removes all measurements.
+        void clear() { m_rows = 0; }
+
+        /// Appends a measurement, given its residual, its jacobian with
+        /// respect to the state, and its covariance.
+        ///
+        /// @return false, appending nothing, if the covariance isn't positive
+        /// definite.
+        template <typename Residual, typename Jacobian, typename Covariance>
+        bool append(Residual const &residual, Jacobian const &jacobian,
+                    Covariance const &covariance) {
+            const types::DimensionType m = residual.rows();
+            assert(jacobian.rows() == m &&
+                   jacobian.cols() == STATE_DIMENSION);
+            assert(covariance.rows() == m && covariance.cols() == m);
+            Eigen::LLT<typename Covariance::PlainObject> llt(covariance);
+            if (llt.info() != Eigen::Success) {
+                return false;
+            }
+            if (m_rows + m > m_jacobian.rows()) {
+                reserve((m_rows + m) * 2);
+            }
+            m_residual.segment(m_rows, m) = llt.matrixL().solve(residual);
+            m_jacobian.middleRows(m_rows, m) = llt.matrixL().solve(jacobian);
+            m_rows += m;
+            return true;
+        }
+
+        /// Number of rows of stacked measurements.
+        types::DimensionType rows() const { return m_rows; }
+        bool empty() const { return 0 == m_rows; }
+
+        /// The stacked, whitened measurement jacobian
+        typename JacobianStorage::ConstRowsBlockXpr jacobian() const {
+            return m_jacobian.topRows(m_rows);
+        }
+
+        /// The stacked, whitened residual/innovation
+        typename ResidualStorage::ConstSegmentReturnType residual() const {
+            return m_residual.head(m_rows);
+        }
+
+      private:
+        types::DimensionType m_rows = 0;
+        JacobianStorage m_jacobian;
+        ResidualStorage m_residual;
+    };
+
+    /// Corrects the state with all the measurements in a StackedMeasurement at
+    /// once, with a single Cholesky factorization for the whole block.
+    ///
+    /// When there are more measurement rows than state dimensions, this works
+    /// in information form, factoring P^-1 + H^T H (the size of the state)
+    /// rather than the innovation covariance H P H^T + I (the size of the
+    /// measurements), so its cost grows only linearly with the number of
+    /// measurements.
+    ///
+    /// For measurements linear in the state, this gives the same result as
+    /// correcting with each of them in turn. Otherwise, the difference is that
+    /// all measurements are linearized around the same (predicted) state.
+    ///
+    /// @return false, leaving the state untouched, if the factorization
+    /// failed.
+    template <typename StateType, typename ProcessModelType>
+    inline bool correctStacked(StateType &state,
+                               ProcessModelType & /*processModel*/,
+                               StackedMeasurement<StateType> const &meas) {
+        /// Dimension of state
+        static const auto n = types::Dimension<StateType>::value;
+        using StateSquareMatrix = types::SquareMatrix<n>;
+        if (meas.empty()) {
+            return true;
+        }
+        auto H = meas.jacobian();
+        auto deltaz = meas.residual();
+        OSVR_KALMAN_DEBUG_OUTPUT("stacked deltaz", deltaz.transpose());
+
+        StateSquareMatrix P = state.errorCovariance();
+        types::Vector<n> stateCorrection;
+        StateSquareMatrix newP;
+        Eigen::LLT<StateSquareMatrix> priorInformation;
+        if (meas.rows() > n) {
+            priorInformation.compute(P);
+        }
+        if (meas.rows() > n && priorInformation.info() == Eigen::Success) {
+            // Information form: newP = (P^-1 + H^T H)^-1
+            StateSquareMatrix information =
+                priorInformation.solve(StateSquareMatrix::Identity());
+            information.noalias() += H.transpose() * H;
+            Eigen::LLT<StateSquareMatrix> denom(information);
+            if (denom.info() != Eigen::Success) {
+                return false;
+            }
+            newP = denom.solve(StateSquareMatrix::Identity());
+            stateCorrection = newP * (H.transpose() * deltaz);
+        } else {
+            // Covariance form, as in correct(), with R = I.
+            Eigen::Matrix<types::Scalar, n, Eigen::Dynamic> PHt =
+                P * H.transpose();
+            Eigen::MatrixXd S = H * PHt;
+            S.diagonal().array() += 1.;
+            Eigen::LLT<Eigen::MatrixXd> denom(S);
+            if (denom.info() != Eigen::Success) {
+                return false;
+            }
+            stateCorrection = PHt * denom.solve(deltaz);
+            newP = P - (PHt * denom.solve(PHt.transpose()));
+        }
+        OSVR_KALMAN_DEBUG_OUTPUT("state correction",
+                                 stateCorrection.transpose());
+
+        state.setStateVector(state.stateVector() + stateCorrection);
+        state.setErrorCovariance(newP);
+
+        state.postCorrect();
+        return true;
+    }
+
     /// The main class implementing the common components of the Kalman family
     /// of filters. Holds an instance of the state as well as an instance of the
     /// process model.
@@ -178,6 +330,10 @@ namespace kalman {
             kalman::correct(state(), processModel(), meas);
         }
 
+        bool correctStacked(StackedMeasurement<State> const &meas) {
+            return kalman::correctStacked(state(), processModel(), meas);
+        }
+
         ProcessModel &processModel() { return m_processModel; }
         ProcessModel const &processModel() const { return m_processModel; }
 
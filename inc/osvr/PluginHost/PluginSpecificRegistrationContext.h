@@ -41,6 +41,7 @@
 
 // Standard includes
 #include <string>
+#include <functional>
 
 namespace osvr {
 namespace pluginhost {
@@ -110,6 +111,14 @@ namespace pluginhost {
             return data;
         }
 
+        /// @brief Register a function to be called on plugin unload, before
+        /// any plugin data is deleted.
+        ///
+        /// Used to stop threads that may still be using that data. Called in
+        /// reverse order of registration.
+        OSVR_PLUGINHOST_EXPORT virtual void
+        registerUnloadCallback(std::function<void()> const &callback) = 0;
+
         /// @brief Register a callback to be invoked on some hardware detection
         /// event.
         OSVR_PLUGINHOST_EXPORT virtual void registerHardwareDetectCallback(
@@ -39,6 +39,7 @@
 // Standard includes
 #include <string>
 #include <map>
+#include <vector>
 
 namespace osvr {
 /// @brief PluginHost functionality: loading, hosting, registering, destroying,
@@ -46,6 +47,20 @@ namespace osvr {
 /// @ingroup PluginHost
 namespace pluginhost {
 
+    /// @brief Time a plugin took to start up, as recorded by a
+    /// RegistrationContext.
+    struct PluginStartupTiming {
+        std::string name;
+        /// @brief Whether the plugin was loaded (or adopted) successfully.
+        bool loaded = false;
+        /// @brief Seconds spent loading the plugin library and running its
+        /// entry point, not counting time spent waiting on other plugins.
+        double loadSeconds = 0;
+        /// @brief Seconds spent in the plugin's hardware detect callbacks
+        /// the last time they were triggered, likewise.
+        double detectSeconds = 0;
+    };
+
     /// @brief Class responsible for hosting plugins, along with their
     /// registration and destruction
     class RegistrationContext : boost::noncopyable {
@@ -64,6 +79,12 @@ namespace pluginhost {
 
         /// @brief Load all detected plugins except those with a .manualload
         /// suffix
+        ///
+        /// The plugins are loaded concurrently, each in its own context, which
+        /// are then adopted in order of name on the calling thread. Any access
+        /// a plugin makes to the host (through its parent context) waits until
+        /// the plugins before it are done, so those accesses happen in the
+        /// same order as they would loading the plugins one after another.
         OSVR_PLUGINHOST_EXPORT void loadPlugins();
 
         /// @brief Assume ownership of a plugin-specific registration context
@@ -72,6 +93,10 @@ namespace pluginhost {
         adoptPluginRegistrationContext(PluginRegPtr ctx);
 
         /// @brief Trigger any registered hardware detect callbacks.
+        ///
+        /// Different plugins' callbacks run concurrently, with their access to
+        /// the host ordered by plugin name as in loadPlugins(). Returns once
+        /// they are all done.
         OSVR_PLUGINHOST_EXPORT void triggerHardwareDetect();
 
         /// @brief Call a driver instantiation callback for the given plugin
@@ -84,6 +109,11 @@ namespace pluginhost {
                           const std::string &driverName,
                           const std::string &params = std::string()) const;
 
+        /// @brief Get the startup timing of each plugin loaded or adopted, in
+        /// order of name.
+        OSVR_PLUGINHOST_EXPORT std::vector<PluginStartupTiming>
+        getStartupTimings() const;
+
         /// @brief Access the data storage map.
         OSVR_PLUGINHOST_EXPORT util::AnyMap &data();
 
@@ -97,6 +127,7 @@ namespace pluginhost {
         typedef std::map<std::string, PluginRegPtr> PluginRegMap;
 
         PluginRegMap m_regMap;
+        std::map<std::string, PluginStartupTiming> m_timings;
         util::AnyMap m_data;
     };
 } // namespace pluginhost
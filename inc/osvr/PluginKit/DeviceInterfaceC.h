@@ -33,6 +33,7 @@
 #include <osvr/PluginKit/Export.h>
 #include <osvr/PluginKit/CommonC.h>
 #include <osvr/Util/DeviceCallbackTypesC.h>
+#include <osvr/Util/AsyncSendQueueC.h>
 #include <osvr/Util/AnnotationMacrosC.h>
 #include <osvr/Util/TimeValueC.h>
 
@@ -245,6 +246,42 @@ osvrDeviceAsyncInitWithOptions(OSVR_IN_PTR OSVR_PluginRegContext ctx,
                                OSVR_OUT_PTR OSVR_DeviceToken *device)
     OSVR_FUNC_NONNULL((1, 2, 3, 4));
 
+/** @brief Configure the queue that reports from an asynchronous device wait in
+    until the server's main thread sends them.
+
+    Sending from an async device copies the report into this queue and returns
+    without waiting for the main thread. When the queue is full, the policy
+    decides whether sending blocks until there's room
+    (OSVR_ASYNC_SEND_BACKPRESSURE, the default, so no report is lost) or
+    discards the oldest queued report (OSVR_ASYNC_SEND_DROP_OLDEST, for
+    devices where only the latest data matters).
+
+    @param options The DeviceInitOptions for your device, before passing them
+   to osvrDeviceAsyncInitWithOptions().
+    @param capacity Number of reports the queue holds, rounded up to a power
+   of two: 0 selects the default.
+    @param policy What to do when the queue is full.
+*/
+OSVR_PLUGINKIT_EXPORT OSVR_ReturnCode
+osvrDeviceAsyncSendQueueConfigure(OSVR_INOUT_PTR OSVR_DeviceInitOptions options,
+                                  OSVR_IN size_t capacity,
+                                  OSVR_IN OSVR_AsyncSendPolicy policy)
+    OSVR_FUNC_NONNULL((1));
+
+/** @brief Get the counters of an asynchronous device's report queue: current
+    and peak depth, reports sent, and reports dropped under the drop-oldest
+    policy.
+
+    @param device The device token.
+    @param [out] stats Will contain the counters.
+
+    @returns OSVR_RETURN_FAILURE if the device isn't asynchronous.
+*/
+OSVR_PLUGINKIT_EXPORT OSVR_ReturnCode
+osvrDeviceGetAsyncSendQueueStats(OSVR_IN_PTR OSVR_DeviceToken device,
+                                 OSVR_OUT_PTR OSVR_AsyncSendQueueStats *stats)
+    OSVR_FUNC_NONNULL((1, 2));
+
 /** @} */
 
 /** @brief Request a thread sleep for at least the given number of microseconds.
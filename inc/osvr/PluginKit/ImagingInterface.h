@@ -121,17 +121,8 @@ namespace pluginkit {
                     "Must initialize the imaging interface before using it!");
             }
             cv::Mat const &frame(message.getFrame());
-            util::NumberTypeData typedata =
-                util::opencvNumberTypeData(frame.type());
-            OSVR_ImagingMetadata metadata;
-            metadata.channels = frame.channels();
-            metadata.depth = typedata.getSize();
-            metadata.width = frame.cols;
-            metadata.height = frame.rows;
-            metadata.type = typedata.isFloatingPoint()
-                                ? OSVR_IVT_FLOATING_POINT
-                                : (typedata.isSigned() ? OSVR_IVT_SIGNED_INT
-                                                       : OSVR_IVT_UNSIGNED_INT);
+            OSVR_ImagingMetadata metadata =
+                m_getMetadata(frame.size(), frame.type());
 
             OSVR_ReturnCode ret = osvrDeviceImagingReportFrame(
                 dev, m_iface, metadata, message.getBuf(), message.getSensor(),
@@ -141,7 +132,72 @@ namespace pluginkit {
             }
         }
 
+        /// @brief Gets a cv::Mat header, of the given size and type, over a
+        /// buffer to write the next frame of a sensor into directly, without
+        /// the copies made by sending an ImagingMessage. Call commitFrame()
+        /// once filled.
+        ///
+        /// Make sure that whatever fills the frame writes into the returned
+        /// header's buffer rather than reallocating it (that is, that it's
+        /// given the same size and type).
+        cv::Mat acquireFrame(DeviceToken &dev, cv::Size size, int type,
+                             OSVR_ChannelCount sensor = 0) {
+            if (!m_iface) {
+                throw std::logic_error(
+                    "Must initialize the imaging interface before using it!");
+            }
+            OSVR_ImageBufferElement *buf = NULL;
+            OSVR_ReturnCode ret = osvrDeviceImagingAcquireFrameBuffer(
+                dev, m_iface, m_getMetadata(size, type), sensor, &buf);
+            if (OSVR_RETURN_SUCCESS != ret) {
+                throw std::runtime_error("Could not acquire frame buffer!");
+            }
+            return cv::Mat(size, type, buf);
+        }
+
+        /// @brief Sends the frame previously obtained from acquireFrame().
+        void commitFrame(DeviceToken &dev, OSVR_TimeValue const &timestamp,
+                         OSVR_ChannelCount sensor = 0) {
+            if (!m_iface) {
+                throw std::logic_error(
+                    "Must initialize the imaging interface before using it!");
+            }
+            OSVR_ReturnCode ret =
+                osvrDeviceImagingCommitFrame(dev, m_iface, sensor, &timestamp);
+            if (OSVR_RETURN_SUCCESS != ret) {
+                throw std::runtime_error("Could not commit frame!");
+            }
+        }
+
+        /// @brief Gives up on the frame previously obtained from
+        /// acquireFrame() without sending it.
+        void releaseFrame(DeviceToken &dev, OSVR_ChannelCount sensor = 0) {
+            if (!m_iface) {
+                throw std::logic_error(
+                    "Must initialize the imaging interface before using it!");
+            }
+            OSVR_ReturnCode ret =
+                osvrDeviceImagingReleaseFrameBuffer(dev, m_iface, sensor);
+            if (OSVR_RETURN_SUCCESS != ret) {
+                throw std::runtime_error("Could not release frame buffer!");
+            }
+        }
+
       private:
+        static OSVR_ImagingMetadata m_getMetadata(cv::Size size, int type) {
+            util::NumberTypeData typedata = util::opencvNumberTypeData(type);
+            OSVR_ImagingMetadata metadata;
+            metadata.channels = CV_MAT_CN(type);
+            metadata.depth = typedata.getSize();
+            metadata.width = size.width;
+            metadata.height = size.height;
+            metadata.type = typedata.isFloatingPoint()
+                                ? OSVR_IVT_FLOATING_POINT
+                                : (typedata.isSigned() ? OSVR_IVT_SIGNED_INT
+                                                       : OSVR_IVT_UNSIGNED_INT);
+            return metadata;
+        }
+
         OSVR_ImagingDeviceInterface m_iface;
     };
     /// @}
@@ -96,6 +96,69 @@ osvrDeviceImagingReportFrame(OSVR_IN_PTR OSVR_DeviceToken dev,
                              OSVR_IN OSVR_ChannelCount sensor,
                              OSVR_IN_PTR OSVR_TimeValue const *timestamp)
     OSVR_FUNC_NONNULL((1, 2, 4, 6));
+
+/** @brief Get a buffer to write the next frame for a sensor into directly,
+    avoiding the copy made when passing a frame to
+    osvrDeviceImagingReportFrame(). Fill it, then call
+    osvrDeviceImagingCommitFrame() to send it, or
+    osvrDeviceImagingReleaseFrameBuffer() if you can't.
+
+    When the server uses a lock-free shared-memory ring buffer, this is that
+    buffer's next entry, read by local clients without any further copy.
+    Otherwise, handing out an entry would lock readers out of the ring buffer
+    until the commit, so this is instead a private buffer, copied into the ring
+    buffer on commit.
+
+    If a buffer for this sensor was already acquired (with the same size) and
+    not yet committed, the same buffer is returned again.
+
+    @param dev Device token
+    @param iface Imaging interface
+    @param metadata Metadata of the frame you will write, determining the
+   buffer size.
+    @param sensor Sensor number, usually 0
+    @param [out] buffer Location to store the buffer pointer in. Remains owned
+   by the imaging interface: do not free it.
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode osvrDeviceImagingAcquireFrameBuffer(
+    OSVR_IN_PTR OSVR_DeviceToken dev,
+    OSVR_IN_PTR OSVR_ImagingDeviceInterface iface,
+    OSVR_IN OSVR_ImagingMetadata metadata, OSVR_IN OSVR_ChannelCount sensor,
+    OSVR_OUT_PTR OSVR_ImageBufferElement **buffer)
+    OSVR_FUNC_NONNULL((1, 2, 5));
+
+/** @brief Send the frame written into the buffer from
+    osvrDeviceImagingAcquireFrameBuffer(). The buffer must not be accessed
+    after this call.
+
+    @param dev Device token
+    @param iface Imaging interface
+    @param sensor Sensor number, usually 0
+    @param timestamp Timestamp correlating to frame.
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode
+osvrDeviceImagingCommitFrame(OSVR_IN_PTR OSVR_DeviceToken dev,
+                             OSVR_IN_PTR OSVR_ImagingDeviceInterface iface,
+                             OSVR_IN OSVR_ChannelCount sensor,
+                             OSVR_IN_PTR OSVR_TimeValue const *timestamp)
+    OSVR_FUNC_NONNULL((1, 2, 4));
+
+/** @brief Give up on the frame buffer from
+    osvrDeviceImagingAcquireFrameBuffer() without sending it, such as when the
+    frame couldn't be captured. The buffer must not be accessed after this
+    call.
+
+    @param dev Device token
+    @param iface Imaging interface
+    @param sensor Sensor number, usually 0
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode osvrDeviceImagingReleaseFrameBuffer(
+    OSVR_IN_PTR OSVR_DeviceToken dev,
+    OSVR_IN_PTR OSVR_ImagingDeviceInterface iface,
+    OSVR_IN OSVR_ChannelCount sensor) OSVR_FUNC_NONNULL((1, 2));
 /** @} */ /* end of group */
 
 OSVR_EXTERN_C_END
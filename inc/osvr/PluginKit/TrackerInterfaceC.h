@@ -89,6 +89,28 @@ OSVR_ReturnCode osvrDeviceTrackerSendPoseTimestamped(
     OSVR_IN_PTR OSVR_TimeValue const *timestamp)
     OSVR_FUNC_NONNULL((1, 2, 3, 5));
 
+/** @brief Report the full rigid body poses of several sensors, all sampled at
+   the same time, using the supplied timestamp.
+
+   The poses are sent batched into as few messages as possible, which is much
+   cheaper than calling osvrDeviceTrackerSendPoseTimestamped() for each sensor
+   when a device tracks many of them.
+
+   @param poses Array of numPoses poses.
+   @param sensors Array of numPoses sensor numbers, one for each pose, or NULL
+   if the poses are those of sensors 0 through numPoses - 1.
+   @param numPoses Number of poses in the array(s).
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode osvrDeviceTrackerSendPosesTimestamped(
+    OSVR_IN_PTR OSVR_DeviceToken dev,
+    OSVR_IN_PTR OSVR_TrackerDeviceInterface iface,
+    OSVR_IN_PTR OSVR_PoseState const *poses,
+    OSVR_IN_PTR OSVR_ChannelCount const *sensors,
+    OSVR_IN OSVR_ChannelCount numPoses,
+    OSVR_IN_PTR OSVR_TimeValue const *timestamp)
+    OSVR_FUNC_NONNULL((1, 2, 3, 6));
+
 /** @brief Report the position of a sensor that doesn't report orientation,
    automatically generating a timestamp.
 */
@@ -169,6 +169,7 @@ namespace server {
         }
 
         out << "Triggering automatic hardware detection..." << endl;
+        ret->reportStartupTimings();
         ret->triggerHardwareDetect();
 
         return ret;
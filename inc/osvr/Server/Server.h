@@ -161,6 +161,13 @@ namespace server {
         /// Safe to call from any thread, even when server is running.
         OSVR_SERVER_EXPORT void triggerHardwareDetect();
 
+        /// @brief Print, once the next hardware detection is done, how long
+        /// each plugin took to load and to run its hardware detection.
+        ///
+        /// Safe to call from any thread, even when server is running, though it
+        /// makes the most sense as a startup option.
+        OSVR_SERVER_EXPORT void reportStartupTimings();
+
         /// @brief Register a method to run during every time through the main
         /// loop.
         ///
@@ -221,6 +228,11 @@ namespace server {
         /// loop will sleep each loop when a client is connected (0 means no
         /// sleep)
         ///
+        /// The server wakes early for incoming messages and reports from
+        /// async devices, and when nothing needs to be polled each loop (sync
+        /// devices, mainloop methods), it doesn't wake on this schedule at
+        /// all.
+        ///
         /// Call only before starting the server or from within server thread.
         OSVR_SERVER_EXPORT void setSleepTime(int microseconds);
 
@@ -0,0 +1,79 @@
+/** @file
+    @brief Header declaring the send queue policy and statistics types of
+   asynchronous devices.
+
+    Must be c-safe!
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+/*
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#ifndef INCLUDED_AsyncSendQueueC_h_GUID_C272FBA6_E874_4C63_A70A_EBFA9FECC34E
+#define INCLUDED_AsyncSendQueueC_h_GUID_C272FBA6_E874_4C63_A70A_EBFA9FECC34E
+
+/* Internal Includes */
+#include <osvr/Util/APIBaseC.h>
+#include <osvr/Util/StdInt.h>
+
+/* Library/third-party includes */
+/* none */
+
+/* Standard includes */
+#include <stddef.h>
+
+OSVR_EXTERN_C_BEGIN
+
+/** @addtogroup PluginKit
+    @{
+*/
+/** @brief What an asynchronous device's send call does when the device's send
+    queue is full.
+*/
+typedef enum OSVR_AsyncSendPolicy {
+    /** @brief Block the sending thread until the server makes room (the
+        default): no report is lost, but a device can be slowed to the rate
+        the server handles reports.
+    */
+    OSVR_ASYNC_SEND_BACKPRESSURE = 0,
+    /** @brief Discard the oldest queued report to make room: the sending
+        thread never waits on the server, at the cost of losing reports when
+        it runs ahead.
+    */
+    OSVR_ASYNC_SEND_DROP_OLDEST = 1
+} OSVR_AsyncSendPolicy;
+
+/** @brief Counters describing an asynchronous device's send queue. */
+typedef struct OSVR_AsyncSendQueueStats {
+    /** @brief Number of reports queued right now. */
+    size_t depth;
+    /** @brief Largest number of reports that have been queued at once. */
+    size_t peakDepth;
+    /** @brief Number of reports taken from the queue and sent. */
+    uint64_t sent;
+    /** @brief Number of reports discarded because the queue was full. */
+    uint64_t dropped;
+} OSVR_AsyncSendQueueStats;
+/** @} */
+
+OSVR_EXTERN_C_END
+
+#endif
@@ -0,0 +1,233 @@
+/** @file
+    @brief Header providing a thread-safe cache of aligned memory blocks, as
+   well as a deleter and standard allocator drawing from it, so that objects
+   created and released at a steady rate (per-frame buffers and their handles,
+   for instance) don't go back to the heap each time.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_BlockPool_h_GUID_AB0CE332_AED3_47FE_BAF2_927C6FD9091B
+#define INCLUDED_BlockPool_h_GUID_AB0CE332_AED3_47FE_BAF2_927C6FD9091B
+
+// Internal Includes
+#include <osvr/Util/AlignedMemoryC.h>
+#include <osvr/Util/ImagingReportTypesC.h>
+#include <osvr/Util/SharedPtr.h>
+#include <osvr/Util/UniquePtr.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace osvr {
+namespace util {
+    class BlockPool;
+    typedef shared_ptr<BlockPool> BlockPoolPtr;
+
+    /// @brief A thread-safe cache of memory blocks, aligned to
+    /// OSVR_DEFAULT_ALIGN_SIZE, kept in free lists by size.
+    ///
+    /// Released blocks are kept for reuse up to a per-size limit, beyond which
+    /// they are returned to the heap, so holding on to more blocks than that
+    /// at once still works, just without the benefit of the pool.
+    ///
+    /// Always held by shared_ptr: the deleter and allocator below keep the
+    /// pool alive as long as any block handed out through them is.
+    class BlockPool {
+      public:
+        enum { DEFAULT_MAX_CACHED_PER_SIZE = 16 };
+
+        static BlockPoolPtr
+        create(std::size_t maxCachedPerSize = DEFAULT_MAX_CACHED_PER_SIZE) {
+            return BlockPoolPtr(new BlockPool(maxCachedPerSize));
+        }
+
+        ~BlockPool() {
+            for (auto &sizeAndBlocks : m_free) {
+                for (auto block : sizeAndBlocks.second) {
+                    m_freeBlock(block);
+                }
+            }
+        }
+
+        BlockPool(BlockPool const &) = delete;
+        BlockPool &operator=(BlockPool const &) = delete;
+
+        /// @brief Gets a block of at least the given size, reusing a released
+        /// one if available.
+        void *allocate(std::size_t bytes) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                auto &blocks = m_free[bytes];
+                if (!blocks.empty()) {
+                    auto ret = blocks.back();
+                    blocks.pop_back();
+                    return ret;
+                }
+                // Reserve now, so releasing never has to allocate.
+                blocks.reserve(m_maxCachedPerSize);
+                ++m_blocksAllocated;
+            }
+            return m_allocBlock(bytes);
+        }
+
+        /// @brief Releases a block obtained from allocate() with the same
+        /// size.
+        void deallocate(void *block, std::size_t bytes) {
+            if (nullptr == block) {
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                auto it = m_free.find(bytes);
+                if (it != m_free.end() &&
+                    it->second.size() < m_maxCachedPerSize) {
+                    it->second.push_back(block);
+                    return;
+                }
+            }
+            m_freeBlock(block);
+        }
+
+        /// @brief Gets the number of times a block had to be allocated from
+        /// the heap rather than reused.
+        std::size_t getBlocksAllocated() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_blocksAllocated;
+        }
+
+      private:
+        explicit BlockPool(std::size_t maxCachedPerSize)
+            : m_maxCachedPerSize(maxCachedPerSize), m_blocksAllocated(0) {}
+
+        /// @brief Gets an aligned block from the global operator new (rather
+        /// than malloc, as alignedAlloc() does), by over-allocating and
+        /// stashing the original pointer just before the aligned block.
+        static void *m_allocBlock(std::size_t bytes) {
+            static const std::uintptr_t ALIGNMENT = OSVR_DEFAULT_ALIGN_SIZE;
+            auto raw = static_cast<char *>(
+                ::operator new(bytes + ALIGNMENT + sizeof(void *)));
+            auto addr = reinterpret_cast<std::uintptr_t>(raw + sizeof(void *));
+            addr = (addr + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+            auto ret = reinterpret_cast<void **>(addr);
+            ret[-1] = raw;
+            return ret;
+        }
+
+        static void m_freeBlock(void *block) {
+            ::operator delete(static_cast<void **>(block)[-1]);
+        }
+
+        mutable std::mutex m_mutex;
+        std::map<std::size_t, std::vector<void *> > m_free;
+        std::size_t m_maxCachedPerSize;
+        std::size_t m_blocksAllocated;
+    };
+
+    /// @brief Deleter returning a block of known size to its pool.
+    class BlockPoolDeleter {
+      public:
+        BlockPoolDeleter() : m_bytes(0) {}
+        BlockPoolDeleter(BlockPoolPtr const &pool, std::size_t bytes)
+            : m_pool(pool), m_bytes(bytes) {}
+        void operator()(void *p) const {
+            if (m_pool) {
+                m_pool->deallocate(p, m_bytes);
+            }
+        }
+
+      private:
+        BlockPoolPtr m_pool;
+        std::size_t m_bytes;
+    };
+
+    /// @brief Standard allocator drawing from a BlockPool: for use with
+    /// allocate_shared, or as the allocator argument of the shared_ptr
+    /// constructor, so that control blocks get pooled too.
+    template <typename T> class BlockPoolAllocator {
+      public:
+        typedef T value_type;
+        template <typename U> struct rebind {
+            typedef BlockPoolAllocator<U> other;
+        };
+
+        explicit BlockPoolAllocator(BlockPoolPtr const &pool) : m_pool(pool) {}
+        template <typename U>
+        BlockPoolAllocator(BlockPoolAllocator<U> const &other)
+            : m_pool(other.getPool()) {}
+
+        T *allocate(std::size_t n) {
+            return static_cast<T *>(m_pool->allocate(n * sizeof(T)));
+        }
+        void deallocate(T *p, std::size_t n) {
+            m_pool->deallocate(p, n * sizeof(T));
+        }
+
+        BlockPoolPtr const &getPool() const { return m_pool; }
+
+      private:
+        BlockPoolPtr m_pool;
+    };
+
+    template <typename T, typename U>
+    inline bool operator==(BlockPoolAllocator<T> const &a,
+                           BlockPoolAllocator<U> const &b) {
+        return a.getPool() == b.getPool();
+    }
+
+    template <typename T, typename U>
+    inline bool operator!=(BlockPoolAllocator<T> const &a,
+                           BlockPoolAllocator<U> const &b) {
+        return !(a == b);
+    }
+
+    typedef unique_ptr<OSVR_ImageBufferElement, BlockPoolDeleter>
+        PooledImageBufferPtr;
+
+    /// @brief Gets an image buffer from the pool, with sole ownership.
+    inline PooledImageBufferPtr
+    makePooledImageBuffer(BlockPoolPtr const &pool, std::size_t bytes) {
+        return PooledImageBufferPtr(
+            static_cast<OSVR_ImageBufferElement *>(pool->allocate(bytes)),
+            BlockPoolDeleter(pool, bytes));
+    }
+
+    /// @brief Gets an image buffer from the pool with shared ownership: the
+    /// shared_ptr control block is drawn from the same pool.
+    inline shared_ptr<OSVR_ImageBufferElement>
+    makeSharedPooledImageBuffer(BlockPoolPtr const &pool, std::size_t bytes) {
+        return shared_ptr<OSVR_ImageBufferElement>(
+            static_cast<OSVR_ImageBufferElement *>(pool->allocate(bytes)),
+            BlockPoolDeleter(pool, bytes),
+            BlockPoolAllocator<OSVR_ImageBufferElement>(pool));
+    }
+} // namespace util
+} // namespace osvr
+
+#endif // INCLUDED_BlockPool_h_GUID_AB0CE332_AED3_47FE_BAF2_927C6FD9091B
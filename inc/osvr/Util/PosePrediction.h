@@ -0,0 +1,134 @@
+/** @file
+    @brief Header with functions for extrapolating a pose forward in time,
+   from a known velocity or one estimated from the two most recent poses.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_PosePrediction_h_GUID_D53DAD42_04AF_42C1_ACDA_660AAB468609
+#define INCLUDED_PosePrediction_h_GUID_D53DAD42_04AF_42C1_ACDA_660AAB468609
+
+// Internal Includes
+#include <osvr/Util/EigenCoreGeometry.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cmath>
+
+namespace osvr {
+namespace util {
+    namespace prediction {
+        /// @brief Below this rotation angle (radians), the small-angle
+        /// approximations are used, avoiding division by (nearly) zero.
+        static const double SMALL_ANGLE = 1.0e-9;
+
+        /// @brief Converts a unit quaternion to the rotation vector (axis
+        /// times angle in radians) of the shorter of the two equivalent
+        /// rotations.
+        inline Eigen::Vector3d toRotationVector(Eigen::Quaterniond const &q) {
+            // q and -q are the same rotation: use the one with w >= 0.
+            double sign = q.w() < 0 ? -1. : 1.;
+            Eigen::Vector3d vec = sign * q.vec();
+            auto n = vec.norm();
+            if (n < SMALL_ANGLE) {
+                return 2 * vec;
+            }
+            return vec * (2 * std::atan2(n, sign * q.w()) / n);
+        }
+
+        /// @brief Converts a rotation vector (axis times angle in radians)
+        /// to a unit quaternion.
+        inline Eigen::Quaterniond
+        fromRotationVector(Eigen::Vector3d const &rot) {
+            auto angle = rot.norm();
+            if (angle < SMALL_ANGLE) {
+                return Eigen::Quaterniond(1, rot.x() / 2, rot.y() / 2,
+                                          rot.z() / 2)
+                    .normalized();
+            }
+            return Eigen::Quaterniond(Eigen::AngleAxisd(angle, rot / angle));
+        }
+
+        /// @brief Gets the angular velocity (rotation vector per second, in
+        /// the same space as the orientations) represented by an incremental
+        /// rotation taking place over dt seconds, as in an
+        /// OSVR_AngularVelocityState.
+        inline Eigen::Vector3d
+        angularVelocityFromIncrementalRotation(Eigen::Quaterniond const &inc,
+                                               double dt) {
+            if (dt <= 0) {
+                return Eigen::Vector3d::Zero();
+            }
+            return toRotationVector(inc) / dt;
+        }
+
+        /// @brief Estimates the angular velocity that took orientation
+        /// before to orientation after in dt seconds.
+        inline Eigen::Vector3d
+        angularVelocityFromOrientations(Eigen::Quaterniond const &before,
+                                        Eigen::Quaterniond const &after,
+                                        double dt) {
+            return angularVelocityFromIncrementalRotation(
+                after * before.conjugate(), dt);
+        }
+
+        /// @brief Estimates the linear velocity that took position before to
+        /// position after in dt seconds.
+        inline Eigen::Vector3d
+        linearVelocityFromPositions(Eigen::Vector3d const &before,
+                                    Eigen::Vector3d const &after, double dt) {
+            if (dt <= 0) {
+                return Eigen::Vector3d::Zero();
+            }
+            return (after - before) / dt;
+        }
+
+        /// @brief Rotates an orientation by an angular velocity (expressed,
+        /// like the orientation, in the parent space) for dt seconds.
+        inline Eigen::Quaterniond
+        applyAngularVelocity(Eigen::Quaterniond const &orientation,
+                             Eigen::Vector3d const &angVel, double dt) {
+            return (fromRotationVector(angVel * dt) * orientation)
+                .normalized();
+        }
+
+        /// @brief Extrapolates a pose dt seconds forward, assuming constant
+        /// linear and angular velocity (both in the parent space of the
+        /// pose).
+        inline Eigen::Isometry3d predictPose(Eigen::Isometry3d const &pose,
+                                             Eigen::Vector3d const &linVel,
+                                             Eigen::Vector3d const &angVel,
+                                             double dt) {
+            Eigen::Isometry3d ret;
+            ret.fromPositionOrientationScale(
+                Eigen::Vector3d(pose.translation() + linVel * dt),
+                applyAngularVelocity(Eigen::Quaterniond(pose.rotation()),
+                                     angVel, dt),
+                Eigen::Vector3d::Ones());
+            return ret;
+        }
+    } // namespace prediction
+} // namespace util
+} // namespace osvr
+
+#endif // INCLUDED_PosePrediction_h_GUID_D53DAD42_04AF_42C1_ACDA_660AAB468609
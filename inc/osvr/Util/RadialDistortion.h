@@ -0,0 +1,184 @@
+/** @file
+    @brief Header for evaluating the per-color-component radial distortion
+   described by OSVR_RadialDistortionParameters on the CPU, both one point at
+   a time and over a whole grid of points at once.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_RadialDistortion_h_GUID_5660A964_1058_4F1A_977A_0FFB1EC697A3
+#define INCLUDED_RadialDistortion_h_GUID_5660A964_1058_4F1A_977A_0FFB1EC697A3
+
+// Internal Includes
+#include <osvr/Util/RadialDistortionParametersC.h>
+#include <osvr/Util/EigenCoreGeometry.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>
+#include <stdexcept>
+
+namespace osvr {
+namespace util {
+    /// @brief Color channels, in the order of the k1 coefficients in
+    /// OSVR_RadialDistortionParameters.
+    enum class ColorChannel { Red = 0, Green = 1, Blue = 2 };
+    static const std::size_t COLOR_CHANNELS = 3;
+
+    /// @brief Gets the k1 coefficient for a channel.
+    inline double getK1(OSVR_RadialDistortionParameters const &params,
+                        ColorChannel channel) {
+        switch (channel) {
+        case ColorChannel::Red:
+            return params.k1.data[0];
+        case ColorChannel::Green:
+            return params.k1.data[1];
+        case ColorChannel::Blue:
+        default:
+            return params.k1.data[2];
+        }
+    }
+
+    /// @brief The reference (scalar) form of the distortion: given a point
+    /// on the surface, in coordinates running from 0 to 1 across its bounds,
+    /// returns where in the undistorted image to sample for that channel.
+    ///
+    /// Matches the usual shader: the offset from the center of projection is
+    /// scaled by (1 + k1 * r^2), r being the length of that offset.
+    inline Eigen::Vector2d
+    applyRadialDistortion(OSVR_RadialDistortionParameters const &params,
+                          ColorChannel channel, Eigen::Vector2d const &point) {
+        Eigen::Vector2d center(params.centerOfProjection.data[0],
+                               params.centerOfProjection.data[1]);
+        Eigen::Vector2d offset = point - center;
+        return center +
+               offset * (1. + getK1(params, channel) * offset.squaredNorm());
+    }
+
+    /// @brief Where in each texel (or cell) of a grid the points fall.
+    enum class GridSampling {
+        /// @brief Points at the corners, the first and last at 0 and 1: the
+        /// vertices of a mesh of (columns - 1) x (rows - 1) quads.
+        Corners,
+        /// @brief Points at the centers, half a texel in from the edges: a
+        /// lookup table at the resolution of the rendered image.
+        TexelCenters
+    };
+
+    /// @brief Gets coordinate i of n along one side of a grid.
+    inline double gridCoordinate(std::size_t i, std::size_t n,
+                                 GridSampling sampling) {
+        if (sampling == GridSampling::TexelCenters) {
+            return (double(i) + 0.5) / double(n);
+        }
+        return n > 1 ? double(i) / double(n - 1) : 0.5;
+    }
+
+    /// @brief The distortion evaluated over a regular grid covering a
+    /// surface: for each point, the position on the surface and, for each
+    /// color channel, where to sample the undistorted image.
+    ///
+    /// Points are stored row by row, starting from the bottom left, as
+    /// separate arrays of x and y coordinates, so the whole grid is worked
+    /// out with array expressions that Eigen vectorizes (SSE2/AVX/NEON, as
+    /// the compiler targets) rather than one point at a time.
+    class RadialDistortionGrid {
+      public:
+        RadialDistortionGrid(OSVR_RadialDistortionParameters const &params,
+                             std::size_t columns, std::size_t rows,
+                             GridSampling sampling)
+            : m_params(params), m_columns(columns), m_rows(rows),
+              m_sampling(sampling) {
+            if (columns == 0 || rows == 0) {
+                throw std::invalid_argument(
+                    "Distortion grid must have at least one row and column");
+            }
+            m_compute();
+        }
+
+        std::size_t columns() const { return m_columns; }
+        std::size_t rows() const { return m_rows; }
+        std::size_t size() const { return m_columns * m_rows; }
+        GridSampling sampling() const { return m_sampling; }
+        OSVR_RadialDistortionParameters const &parameters() const {
+            return m_params;
+        }
+
+        /// @name Positions on the surface
+        /// @{
+        Eigen::ArrayXd const &x() const { return m_x; }
+        Eigen::ArrayXd const &y() const { return m_y; }
+        /// @}
+
+        /// @name Distorted texture coordinates for a channel
+        /// @{
+        Eigen::ArrayXd const &u(ColorChannel channel) const {
+            return m_u[static_cast<std::size_t>(channel)];
+        }
+        Eigen::ArrayXd const &v(ColorChannel channel) const {
+            return m_v[static_cast<std::size_t>(channel)];
+        }
+        /// @}
+
+      private:
+        void m_compute() {
+            typedef Eigen::ArrayXd Arr;
+            Arr xs(m_columns);
+            for (std::size_t i = 0; i < m_columns; ++i) {
+                xs[i] = gridCoordinate(i, m_columns, m_sampling);
+            }
+            m_x.resize(size());
+            m_y.resize(size());
+            for (std::size_t row = 0; row < m_rows; ++row) {
+                m_x.segment(row * m_columns, m_columns) = xs;
+                m_y.segment(row * m_columns, m_columns)
+                    .setConstant(gridCoordinate(row, m_rows, m_sampling));
+            }
+
+            auto const cx = m_params.centerOfProjection.data[0];
+            auto const cy = m_params.centerOfProjection.data[1];
+            Arr dx = m_x - cx;
+            Arr dy = m_y - cy;
+            // r^2 is shared by all three channels.
+            Arr r2 = dx * dx + dy * dy;
+            Arr scale(size());
+            for (std::size_t c = 0; c < COLOR_CHANNELS; ++c) {
+                scale = 1. + m_params.k1.data[c] * r2;
+                m_u[c] = cx + dx * scale;
+                m_v[c] = cy + dy * scale;
+            }
+        }
+        OSVR_RadialDistortionParameters m_params;
+        std::size_t m_columns;
+        std::size_t m_rows;
+        GridSampling m_sampling;
+        Eigen::ArrayXd m_x;
+        Eigen::ArrayXd m_y;
+        Eigen::ArrayXd m_u[COLOR_CHANNELS];
+        Eigen::ArrayXd m_v[COLOR_CHANNELS];
+    };
+
+} // namespace util
+} // namespace osvr
+
+#endif // INCLUDED_RadialDistortion_h_GUID_5660A964_1058_4F1A_977A_0FFB1EC697A3
@@ -56,6 +56,7 @@ namespace osvr {
 using boost::shared_ptr;
 using boost::weak_ptr;
 using boost::make_shared;
+using boost::allocate_shared;
 using boost::enable_shared_from_this;
 } // namespace osvr
 
@@ -66,6 +67,7 @@ namespace osvr {
 using std::shared_ptr;
 using std::weak_ptr;
 using std::make_shared;
+using std::allocate_shared;
 using std::enable_shared_from_this;
 } // namespace osvr
 #endif
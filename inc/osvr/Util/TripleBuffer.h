@@ -0,0 +1,97 @@
+/** @file
+    @brief Header providing a triple buffer: a way for one thread to hand the
+   latest version of a value to another, with neither ever waiting on the
+   other.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_TripleBuffer_h_GUID_A661BA0D_FBF8_45CA_A5AB_A06218CAA511
+#define INCLUDED_TripleBuffer_h_GUID_A661BA0D_FBF8_45CA_A5AB_A06218CAA511
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <atomic>
+
+namespace osvr {
+namespace util {
+    /// @brief Three copies of a value: one the writer fills in, one the
+    /// reader reads, and the latest one published, which each side swaps
+    /// with its own in a single atomic operation.
+    ///
+    /// Wait-free for one writer thread and one reader thread: the reader
+    /// always sees a whole, consistent value, skipping any published in
+    /// between two of its refresh() calls.
+    template <typename T> class TripleBuffer : boost::noncopyable {
+      public:
+        TripleBuffer() : m_middle(1) {}
+
+        /// @name Writer
+        /// @{
+        /// @brief The copy to write the next value into. Holds whatever was
+        /// last swapped into it: not necessarily the last value published.
+        T &back() { return m_buffers[m_back]; }
+
+        /// @brief Makes the back copy the latest value.
+        void publish() {
+            m_back = m_middle.exchange(m_back | FRESH_BIT,
+                                       std::memory_order_acq_rel) &
+                     INDEX_MASK;
+        }
+        /// @}
+
+        /// @name Reader
+        /// @{
+        /// @brief Takes the latest value published, if any since the last
+        /// call.
+        ///
+        /// @return true if front() changed.
+        bool refresh() {
+            if (!(m_middle.load(std::memory_order_relaxed) & FRESH_BIT)) {
+                return false;
+            }
+            m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) &
+                      INDEX_MASK;
+            return true;
+        }
+
+        /// @brief The value as of the last refresh() to find one.
+        T const &front() const { return m_buffers[m_front]; }
+        /// @}
+
+      private:
+        static const unsigned INDEX_MASK = 0x3;
+        static const unsigned FRESH_BIT = 0x4;
+        T m_buffers[3];
+        unsigned m_back = 0;
+        std::atomic<unsigned> m_middle;
+        unsigned m_front = 2;
+    };
+
+} // namespace util
+} // namespace osvr
+
+#endif // INCLUDED_TripleBuffer_h_GUID_A661BA0D_FBF8_45CA_A5AB_A06218CAA511
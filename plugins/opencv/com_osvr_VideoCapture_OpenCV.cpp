@@ -98,9 +98,31 @@ class CameraDevice : boost::noncopyable {
             // No frame available.
             return OSVR_RETURN_SUCCESS;
         }
-        bool retrieved = m_camera.retrieve(m_frame, m_channel);
-        if (!retrieved) {
-            return OSVR_RETURN_FAILURE;
+        if (!m_frame.empty()) {
+            // We know the frame format from the previous frame, so retrieve
+            // straight into the buffer the frame will be sent from (usually
+            // shared memory), skipping the copies made by ImagingMessage.
+            cv::Mat frame = m_imaging.acquireFrame(m_dev, m_frame.size(),
+                                                   m_frame.type());
+            auto buf = frame.data;
+            bool retrieved = m_camera.retrieve(frame, m_channel);
+            if (!retrieved) {
+                m_imaging.releaseFrame(m_dev);
+                return OSVR_RETURN_FAILURE;
+            }
+            if (frame.data == buf) {
+                m_imaging.commitFrame(m_dev, frameTime);
+                return OSVR_RETURN_SUCCESS;
+            }
+            // The format changed, so OpenCV had to reallocate: send the
+            // regular way below.
+            m_imaging.releaseFrame(m_dev);
+            m_frame = frame;
+        } else {
+            bool retrieved = m_camera.retrieve(m_frame, m_channel);
+            if (!retrieved) {
+                return OSVR_RETURN_FAILURE;
+            }
         }
 
         // Send the image.
@@ -33,6 +33,7 @@
 // Library/third-party includes
 #include <osvr/Util/TimeValue.h>
 #include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Kalman/FlexibleKalmanFilter.h>
 #include <osvr/Kalman/PureVectorState.h>
 #include <osvr/Kalman/PoseState.h>
 #include <osvr/Kalman/PoseSeparatelyDampedConstantVelocity.h>
@@ -45,6 +46,7 @@
 
 namespace osvr {
 namespace vbtracker {
+    class ImagePointMeasurement;
 
     struct BeaconData {
         bool seen = false;
@@ -155,6 +157,17 @@ namespace vbtracker {
         /// filter with beacon position auto-calibration to compute an estimate.
         bool m_kalmanAutocalibEstimator(LedGroup &leds, double dt);
 
+        /// @brief The batched alternative to correcting the Kalman filter once
+        /// per beacon: applies all the measurements in
+        /// m_pendingMeasurements to the pose in a single stacked correction,
+        /// with each beacon's uncertainty folded into its measurement's
+        /// covariance, then updates each of those beacons given the corrected
+        /// pose.
+        ///
+        /// @return false if the stacked correction failed, in which case
+        /// neither pose nor beacons were changed.
+        bool m_batchedKalmanCorrection(ImagePointMeasurement &meas);
+
         /// @brief A method that determines if the Kalman filter has gotten
         /// itself into a bad situation and we should start again with RANSAC.
         ///
@@ -214,6 +227,18 @@ namespace vbtracker {
         ProcessModel m_model;
         /// @}
 
+        /// @name Batched Kalman correction
+        /// @brief Kept between frames to avoid allocating per frame.
+        /// @{
+        struct PendingBeaconMeasurement {
+            int id;
+            cv::Point2f location;
+            double variance;
+        };
+        std::vector<PendingBeaconMeasurement> m_pendingMeasurements;
+        kalman::StackedMeasurement<State> m_stackedMeasurement;
+        /// @}
+
         /// @name Kalman startup status
         /// @{
         /// How long we've been turning in low ratios of good to bad residuals.
@@ -133,6 +133,8 @@ namespace vbtracker {
             m_params.maxResidual * m_params.maxResidual;
         const auto maxZComponent = m_params.maxZComponent;
         kalman::predict(m_state, m_model, dt);
+        const auto batched = m_params.batchedBeaconCorrection;
+        m_pendingMeasurements.clear();
 
         /// @todo should we be recalculating this for each beacon after each
         /// correction step? The order we filter them in is rather arbitrary...
@@ -239,6 +241,13 @@ namespace vbtracker {
                 (led.isBright() ? BRIGHT_PENALTY : 1.) *
                 m_beaconMeasurementVariance[id] / led.getMeasurement().area;
             debug.variance = effectiveVariance;
+
+            if (batched) {
+                /// Correct later, all at once.
+                m_pendingMeasurements.push_back(PendingBeaconMeasurement{
+                    id, led.getLocation(), effectiveVariance});
+                continue;
+            }
             meas.setVariance(effectiveVariance);
 
             /// Now, do the correction.
@@ -248,6 +257,16 @@ namespace vbtracker {
             m_gotMeasurement = true;
         }
 
+        if (batched && !m_pendingMeasurements.empty()) {
+            if (m_batchedKalmanCorrection(meas)) {
+                m_gotMeasurement = true;
+            } else if (m_params.extraVerbose) {
+                std::cout << "Batched Kalman correction of "
+                          << m_pendingMeasurements.size()
+                          << " beacon measurements failed" << std::endl;
+            }
+        }
+
         /// Probation: Dealing with ratios of bad to good residuals
         bool incrementProbation = false;
         if (0 == m_framesInProbation) {
@@ -286,6 +305,71 @@ namespace vbtracker {
         return true;
     }
 
+    bool BeaconBasedPoseEstimator::m_batchedKalmanCorrection(
+        ImagePointMeasurement &meas) {
+        static const auto POSE_DIMENSION =
+            kalman::types::Dimension<State>::value;
+        using BeaconJacobian = Eigen::Matrix<double, 2, 3>;
+        using BeaconGain = Eigen::Matrix<double, 3, 2>;
+
+        auto setUp = [&](PendingBeaconMeasurement const &pending) {
+            meas.setMeasurement(
+                Eigen::Vector2d(pending.location.x, pending.location.y));
+            meas.setVariance(pending.variance);
+            auto state =
+                kalman::makeAugmentedState(m_state, *(m_beacons[pending.id]));
+            meas.updateFromState(state);
+            return state;
+        };
+
+        /// Stack up the measurements of the pose, all linearized around the
+        /// predicted state. The beacons are independent of each other and of
+        /// the pose, so their uncertainty just adds a 2x2 block,
+        /// Hb * Pb * Hb^T, to their own measurement's covariance.
+        m_stackedMeasurement.clear();
+        m_stackedMeasurement.reserve(
+            2 * static_cast<kalman::types::DimensionType>(
+                    m_pendingMeasurements.size()));
+        for (auto const &pending : m_pendingMeasurements) {
+            auto state = setUp(pending);
+            ImagePointMeasurement::Jacobian H = meas.getJacobian(state);
+            BeaconJacobian Hb = H.rightCols<3>();
+            Eigen::Matrix2d R =
+                meas.getCovariance(state) +
+                Hb * state.b().errorCovariance() * Hb.transpose();
+            if (!m_stackedMeasurement.append(meas.getResidual(state),
+                                             H.leftCols<POSE_DIMENSION>(),
+                                             R)) {
+                return false;
+            }
+        }
+        if (!kalman::correctStacked(m_state, m_model, m_stackedMeasurement)) {
+            return false;
+        }
+
+        /// Then update each beacon from its own measurement, using the
+        /// residual against the corrected pose and accounting for what
+        /// uncertainty remains in that pose.
+        for (auto const &pending : m_pendingMeasurements) {
+            auto state = setUp(pending);
+            ImagePointMeasurement::Jacobian H = meas.getJacobian(state);
+            BeaconJacobian Hb = H.rightCols<3>();
+            auto Hp = H.leftCols<POSE_DIMENSION>();
+            auto &beacon = *(m_beacons[pending.id]);
+            Eigen::Matrix3d Pb = beacon.errorCovariance();
+            BeaconGain PbHbt = Pb * Hb.transpose();
+            Eigen::Matrix2d S = Hb * PbHbt + meas.getCovariance(state);
+            BeaconGain K = PbHbt * S.inverse();
+            Eigen::Matrix2d poseCovariance =
+                Hp * m_state.errorCovariance() * Hp.transpose();
+            beacon.setStateVector(beacon.stateVector() +
+                                  K * meas.getResidual(state));
+            beacon.setErrorCovariance(Pb - K * PbHbt.transpose() +
+                                      K * poseCovariance * K.transpose());
+        }
+        return true;
+    }
+
     OSVR_PoseState
     BeaconBasedPoseEstimator::GetPredictedState(double dt) const {
         auto state = m_state;
@@ -0,0 +1,183 @@
+/** @file
+    @brief Benchmark of associating blobs with tracked LEDs by linear search
+   versus through a LedMeasurementIndex, over synthetic frames with more and
+   more false blobs, also checking that both make the same associations.
+
+   Usage: vbtracker-association-bench [LEDs] [frames]
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include "LED.h"
+#include "LedMeasurementIndex.h"
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+#include <opencv2/core/core.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace osvr::vbtracker;
+
+namespace {
+static const double BLOB_MOVE_THRESHOLD = 4.;
+static const float BLOB_DIAMETER = 4.f;
+static const int WIDTH = 640;
+static const int HEIGHT = 480;
+
+LedMeasurement makeMeasurement(float x, float y) {
+    LedMeasurement meas;
+    meas.loc = cv::Point2f(x, y);
+    meas.brightness = BLOB_DIAMETER;
+    meas.diameter = BLOB_DIAMETER;
+    return meas;
+}
+
+/// @brief Association as VideoBasedTracker used to do it: copy the blobs,
+/// search them all for each LED, and erase each one claimed.
+void associateLinear(LedGroup &leds, LedMeasurementList const &blobs) {
+    auto remaining = blobs;
+    auto led = begin(leds);
+    while (led != end(leds)) {
+        auto threshold =
+            BLOB_MOVE_THRESHOLD * led->getMeasurement().diameter;
+        auto nearest = led->nearest(remaining, threshold);
+        if (nearest == end(remaining)) {
+            led = leds.erase(led);
+        } else {
+            led->addMeasurement(*nearest, false);
+            remaining.erase(nearest);
+            ++led;
+        }
+    }
+    for (auto &meas : remaining) {
+        leds.emplace_back(nullptr, meas);
+    }
+}
+
+/// @brief Association as VideoBasedTracker does it now.
+void associateIndexed(LedGroup &leds, LedMeasurementList const &blobs,
+                      LedMeasurementIndex &index) {
+    index.reset(blobs, static_cast<float>(BLOB_MOVE_THRESHOLD * BLOB_DIAMETER));
+    std::vector<bool> claimed(blobs.size(), false);
+    auto led = begin(leds);
+    while (led != end(leds)) {
+        auto threshold =
+            BLOB_MOVE_THRESHOLD * led->getMeasurement().diameter;
+        auto nearest = led->nearest(index, claimed, threshold);
+        if (nearest == LedMeasurementIndex::NONE) {
+            led = leds.erase(led);
+        } else {
+            led->addMeasurement(blobs[nearest], false);
+            claimed[nearest] = true;
+            ++led;
+        }
+    }
+    for (std::size_t i = 0; i < blobs.size(); ++i) {
+        if (!claimed[i]) {
+            leds.emplace_back(nullptr, blobs[i]);
+        }
+    }
+}
+
+bool sameLocations(LedGroup const &a, LedGroup const &b) {
+    return a.size() == b.size() &&
+           std::equal(begin(a), end(a), begin(b),
+                      [](Led const &x, Led const &y) {
+                          return x.getLocation() == y.getLocation();
+                      });
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> args(argv + 1, argv + argc);
+    int numLeds = args.size() > 0 ? std::atoi(args[0].c_str()) : 40;
+    int frames = args.size() > 1 ? std::atoi(args[1].c_str()) : 1000;
+    if (numLeds <= 0 || frames <= 0) {
+        std::cerr << "Usage: vbtracker-association-bench [LEDs] [frames]"
+                  << std::endl;
+        return 1;
+    }
+
+    std::cout << numLeds << " LEDs, " << frames << " frames" << std::endl;
+    std::cout << "False blobs\tLinear (us/frame)\tIndexed (us/frame)\tSpeedup"
+              << std::endl;
+    for (int falseBlobs : {0, 25, 100, 400, 1600}) {
+        std::mt19937 rng(falseBlobs);
+        std::uniform_real_distribution<float> x(0, WIDTH);
+        std::uniform_real_distribution<float> y(0, HEIGHT);
+        std::uniform_real_distribution<float> jitter(-1.f, 1.f);
+
+        // LEDs wander slowly, while false blobs appear anywhere each frame.
+        std::vector<cv::Point2f> ledLocations;
+        for (int i = 0; i < numLeds; ++i) {
+            ledLocations.emplace_back(x(rng), y(rng));
+        }
+        auto makeFrame = [&] {
+            LedMeasurementList blobs;
+            for (auto &loc : ledLocations) {
+                loc.x += jitter(rng);
+                loc.y += jitter(rng);
+                blobs.push_back(makeMeasurement(loc.x, loc.y));
+            }
+            for (int i = 0; i < falseBlobs; ++i) {
+                blobs.push_back(makeMeasurement(x(rng), y(rng)));
+            }
+            std::shuffle(begin(blobs), end(blobs), rng);
+            return blobs;
+        };
+
+        LedGroup linearLeds;
+        LedGroup indexedLeds;
+        LedMeasurementIndex index;
+        double linearSeconds = 0;
+        double indexedSeconds = 0;
+        for (int frame = 0; frame < frames; ++frame) {
+            auto blobs = makeFrame();
+            auto start = osvr::util::time::getNow();
+            associateLinear(linearLeds, blobs);
+            auto middle = osvr::util::time::getNow();
+            associateIndexed(indexedLeds, blobs, index);
+            auto finish = osvr::util::time::getNow();
+            linearSeconds += osvr::util::time::duration(middle, start);
+            indexedSeconds += osvr::util::time::duration(finish, middle);
+            if (!sameLocations(linearLeds, indexedLeds)) {
+                std::cout << "Associations differ at frame " << frame
+                          << " with " << falseBlobs << " false blobs!"
+                          << std::endl;
+                return 1;
+            }
+        }
+        std::cout << falseBlobs << "\t\t" << 1.e6 * linearSeconds / frames
+                  << "\t\t\t" << 1.e6 * indexedSeconds / frames << "\t\t\t"
+                  << linearSeconds / indexedSeconds << std::endl;
+    }
+    std::cout << "Associations were identical." << std::endl;
+    return 0;
+}
@@ -0,0 +1,76 @@
+/** @file
+    @brief Header for the interface of blob extractors, and a factory choosing
+   one based on the configuration.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef INCLUDED_BlobExtractor_h_GUID_1E95703E_C7FC_43A0_A085_6764F3DFB0CF
+#define INCLUDED_BlobExtractor_h_GUID_1E95703E_C7FC_43A0_A085_6764F3DFB0CF
+
+// Internal Includes
+#include "Types.h"
+#include "LED.h"
+
+// Library/third-party includes
+#include <opencv2/core/core.hpp>
+
+// Standard includes
+#include <memory>
+#include <vector>
+
+namespace osvr {
+namespace vbtracker {
+    /// @brief Interface of the classes finding the blobs (candidate LEDs) in
+    /// incoming frames.
+    class BlobExtractor {
+      public:
+        virtual ~BlobExtractor();
+
+        /// @brief Finds the blobs in a grayscale frame.
+        /// @return measurements valid until the next call.
+        virtual std::vector<LedMeasurement> const &
+        extractBlobs(cv::Mat const &grayImage) = 0;
+
+        /// @name Debug images
+        /// @brief Images describing the last frame passed to extractBlobs().
+        /// They may refer to that frame's data rather than a copy of it, so
+        /// ask for them before the caller reuses its buffer.
+        /// @{
+        virtual cv::Mat const &getDebugThresholdImage() = 0;
+        virtual cv::Mat const &getDebugBlobImage() = 0;
+        virtual cv::Mat const &getDebugExtraImage() = 0;
+        /// @}
+
+      protected:
+        BlobExtractor() = default;
+    };
+
+    typedef std::unique_ptr<BlobExtractor> BlobExtractorPtr;
+
+    /// @brief Creates the blob extractor selected by the blob parameters.
+    BlobExtractorPtr createBlobExtractor(ConfigParams const &params);
+
+} // namespace vbtracker
+} // namespace osvr
+
+#endif // INCLUDED_BlobExtractor_h_GUID_1E95703E_C7FC_43A0_A085_6764F3DFB0CF
@@ -0,0 +1,170 @@
+/** @file
+    @brief Validation tool comparing the blobs found by the SimpleBlobDetector-
+   based extractor and the single-pass one on a set of recorded frames, along
+   with how long each takes.
+
+   Usage: vbtracker-blob-compare <image directory> [match distance in pixels]
+
+   The image directory is one holding 0001.tif, 0002.tif, ..., such as
+   simulated_images/animation_from_fake or HDK_random_images.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include "BlobExtractor.h"
+#include "SBDBlobExtractor.h"
+#include "SinglePassBlobExtractor.h"
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+#include <opencv2/core/core.hpp>
+#include <opencv2/highgui/highgui.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace osvr::vbtracker;
+
+namespace {
+struct Totals {
+    std::size_t frames = 0;
+    std::size_t referenceBlobs = 0;
+    std::size_t candidateBlobs = 0;
+    std::size_t matched = 0;
+    double offsetSum = 0;
+    double offsetMax = 0;
+    double diameterRatioSum = 0;
+    double referenceSeconds = 0;
+    double candidateSeconds = 0;
+};
+
+/// @brief Pairs each reference blob with the nearest unpaired candidate blob
+/// within the match distance, accumulating the statistics.
+void compare(std::vector<LedMeasurement> const &reference,
+             std::vector<LedMeasurement> const &candidate,
+             double matchDistance, Totals &totals) {
+    totals.referenceBlobs += reference.size();
+    totals.candidateBlobs += candidate.size();
+    std::vector<bool> paired(candidate.size(), false);
+    for (auto const &ref : reference) {
+        auto best = candidate.size();
+        auto bestDist = matchDistance;
+        for (std::size_t i = 0; i < candidate.size(); ++i) {
+            if (paired[i]) {
+                continue;
+            }
+            auto diff = candidate[i].loc - ref.loc;
+            auto dist = std::sqrt(diff.dot(diff));
+            if (dist <= bestDist) {
+                bestDist = dist;
+                best = i;
+            }
+        }
+        if (best == candidate.size()) {
+            continue;
+        }
+        paired[best] = true;
+        ++totals.matched;
+        totals.offsetSum += bestDist;
+        totals.offsetMax = std::max(totals.offsetMax, bestDist);
+        totals.diameterRatioSum += candidate[best].diameter / ref.diameter;
+    }
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> args(argv + 1, argv + argc);
+    if (args.empty()) {
+        std::cerr << "Usage: vbtracker-blob-compare <image directory> "
+                     "[match distance in pixels]"
+                  << std::endl;
+        return 1;
+    }
+    double matchDistance = args.size() > 1 ? std::atof(args[1].c_str()) : 2.;
+
+    // Keep OpenCV's own threads out of the timing.
+    cv::setNumThreads(1);
+    ConfigParams params;
+    SBDBlobExtractor reference(params);
+    params.blobParams.singlePassDetector = true;
+    auto candidate = createBlobExtractor(params);
+
+    Totals totals;
+    for (int imageNum = 1;; ++imageNum) {
+        std::ostringstream fileName;
+        fileName << args[0] << "/" << std::setfill('0') << std::setw(4)
+                 << imageNum << ".tif";
+        cv::Mat color = cv::imread(fileName.str(), CV_LOAD_IMAGE_COLOR);
+        if (!color.data) {
+            break;
+        }
+        cv::Mat gray;
+        cv::cvtColor(color, gray, CV_RGB2GRAY);
+
+        auto start = osvr::util::time::getNow();
+        auto referenceBlobs = reference.extractBlobs(gray);
+        auto middle = osvr::util::time::getNow();
+        auto candidateBlobs = candidate->extractBlobs(gray);
+        auto finish = osvr::util::time::getNow();
+        totals.referenceSeconds += osvr::util::time::duration(middle, start);
+        totals.candidateSeconds += osvr::util::time::duration(finish, middle);
+        ++totals.frames;
+        compare(referenceBlobs, candidateBlobs, matchDistance, totals);
+    }
+    if (totals.frames == 0) {
+        std::cerr << "No images found in " << args[0] << std::endl;
+        return 1;
+    }
+
+    auto perFrame = [&](double x) { return x / totals.frames; };
+    std::cout << totals.frames << " frames" << std::endl;
+    std::cout << "SimpleBlobDetector: " << perFrame(totals.referenceBlobs)
+              << " blobs/frame, "
+              << 1000. * perFrame(totals.referenceSeconds) << " ms/frame"
+              << std::endl;
+    std::cout << "Single pass: " << perFrame(totals.candidateBlobs)
+              << " blobs/frame, "
+              << 1000. * perFrame(totals.candidateSeconds) << " ms/frame"
+              << std::endl;
+    if (totals.referenceBlobs == 0) {
+        return 0;
+    }
+    std::cout << "Matched within " << matchDistance
+              << " px: " << 100. * totals.matched / totals.referenceBlobs
+              << "% of SimpleBlobDetector blobs" << std::endl;
+    if (totals.matched > 0) {
+        std::cout << "Centroid offset: mean "
+                  << totals.offsetSum / totals.matched << " px, max "
+                  << totals.offsetMax << " px; mean diameter ratio "
+                  << totals.diameterRatioSum / totals.matched << std::endl;
+    }
+    return 0;
+}
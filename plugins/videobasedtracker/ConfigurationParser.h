@@ -69,6 +69,12 @@ namespace vbtracker {
         getOptionalParameter(config.blobsKeepIdentity, root,
                              "blobsKeepIdentity");
         getOptionalParameter(config.numThreads, root, "numThreads");
+        getOptionalParameter(config.sensorThreads, root, "sensorThreads");
+        getOptionalParameter(config.pipelined, root, "pipelined");
+        getOptionalParameter(config.pipelineQueueSize, root,
+                             "pipelineQueueSize");
+        getOptionalParameter(config.reportStageTimings, root,
+                             "reportStageTimings");
         getOptionalParameter(config.streamBeaconDebugInfo, root,
                              "streamBeaconDebugInfo");
         getOptionalParameter(config.offsetToCentroid, root, "offsetToCentroid");
@@ -90,6 +96,8 @@ namespace vbtracker {
                              "measurementVarianceScaleFactor");
         getOptionalParameter(config.highResidualVariancePenalty, root,
                              "highResidualVariancePenalty");
+        getOptionalParameter(config.batchedBeaconCorrection, root,
+                             "batchedBeaconCorrection");
         getOptionalParameter(config.boundingBoxFilterRatio, root,
                              "boundingBoxFilterRatio");
         getOptionalParameter(config.maxZComponent, root, "maxZComponent");
@@ -119,6 +127,8 @@ namespace vbtracker {
                                  "maxThresholdAlpha");
             getOptionalParameter(config.blobParams.thresholdSteps, blob,
                                  "thresholdSteps");
+            getOptionalParameter(config.blobParams.singlePassDetector, blob,
+                                 "singlePassDetector");
         }
 
         return config;
@@ -0,0 +1,117 @@
+/** @file
+    @brief Header for a small, bounded queue of captured frames, for pipelining
+   capture and processing.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef INCLUDED_FrameQueue_h_GUID_C2F585D2_2A7C_4BB0_96BD_137BF0A70CDD
+#define INCLUDED_FrameQueue_h_GUID_C2F585D2_2A7C_4BB0_96BD_137BF0A70CDD
+
+// Internal Includes
+#include <osvr/Util/TimeValueC.h>
+
+// Library/third-party includes
+#include <opencv2/core/core.hpp>
+
+// Standard includes
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+namespace osvr {
+namespace vbtracker {
+    /// @brief A frame, as captured, along with when it was captured and how
+    /// long that took.
+    struct CapturedFrame {
+        cv::Mat frame;
+        cv::Mat imageGray;
+        /// Time the grab completed: our best estimate of when the tracker was
+        /// at the pose we'll compute from it.
+        OSVR_TimeValue timestamp;
+        /// Seconds spent in grab() and in retrieve(), respectively.
+        double grabTime = 0;
+        double retrieveTime = 0;
+    };
+
+    /// @brief A bounded queue of frames between a capture thread and a
+    /// processing thread, with latest-frame-wins semantics: a full queue drops
+    /// its oldest frame to make room, and the consumer always gets the newest
+    /// frame, dropping any older ones.
+    ///
+    /// Each frame must own its image data (not share it with the producer),
+    /// since it's processed concurrently with the capture of the next.
+    class FrameQueue {
+      public:
+        explicit FrameQueue(std::size_t capacity)
+            : m_capacity(capacity < 1 ? 1 : capacity) {}
+
+        /// @brief Producer: adds a frame, dropping the oldest if full.
+        void push(CapturedFrame &&frame) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_frames.size() == m_capacity) {
+                    m_frames.pop_front();
+                    ++m_dropped;
+                }
+                m_frames.push_back(std::move(frame));
+            }
+            m_cv.notify_one();
+        }
+
+        /// @brief Consumer: waits up to the timeout for a frame, then takes
+        /// the newest one, dropping the rest.
+        /// @return false if no frame arrived in time.
+        template <typename Rep, typename Period>
+        bool popLatest(CapturedFrame &frame,
+                       std::chrono::duration<Rep, Period> const &timeout) {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (!m_cv.wait_for(lock, timeout,
+                               [&] { return !m_frames.empty(); })) {
+                return false;
+            }
+            m_dropped += m_frames.size() - 1;
+            frame = std::move(m_frames.back());
+            m_frames.clear();
+            return true;
+        }
+
+        /// @brief Gets the number of frames dropped, in total, because a newer
+        /// one was ready.
+        std::size_t getDropped() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_dropped;
+        }
+
+      private:
+        std::size_t const m_capacity;
+        mutable std::mutex m_mutex;
+        std::condition_variable m_cv;
+        std::deque<CapturedFrame> m_frames;
+        std::size_t m_dropped = 0;
+    };
+} // namespace vbtracker
+} // namespace osvr
+
+#endif // INCLUDED_FrameQueue_h_GUID_C2F585D2_2A7C_4BB0_96BD_137BF0A70CDD
@@ -0,0 +1,224 @@
+/** @file
+    @brief Benchmark of the autocalibrating Kalman pose estimator on recorded
+   frames, correcting once per beacon versus once per frame with all beacons
+   stacked, also comparing the poses the two report.
+
+   Usage: vbtracker-kalman-bench <image directory> [simulated|random] [passes]
+
+   The image directory is one holding 0001.tif, 0002.tif, ..., such as
+   simulated_images/animation_from_fake (with "simulated" patterns) or
+   HDK_random_images (with "random" patterns).
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "VideoBasedTracker.h"
+#include "HDKLedIdentifierFactory.h"
+#include "CameraParameters.h"
+#include "HDKData.h"
+#include <osvr/Util/EigenInterop.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+#include <opencv2/core/core.hpp>
+#include <opencv2/highgui/highgui.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace osvr::vbtracker;
+
+namespace {
+struct Frame {
+    cv::Mat color;
+    cv::Mat gray;
+};
+
+/// Reported poses, keyed by frame number and sensor.
+using PoseMap = std::map<std::pair<std::size_t, OSVR_ChannelCount>, OSVR_Pose3>;
+
+struct RunResult {
+    double seconds = 0;
+    double poseEstimation = 0;
+    PoseMap poses;
+};
+
+std::vector<Frame> loadFrames(std::string const &dir) {
+    std::vector<Frame> frames;
+    for (int imageNum = 1;; ++imageNum) {
+        std::ostringstream fileName;
+        fileName << dir << "/" << std::setfill('0') << std::setw(4)
+                 << imageNum << ".tif";
+        Frame frame;
+        frame.color = cv::imread(fileName.str(), CV_LOAD_IMAGE_COLOR);
+        if (!frame.color.data) {
+            break;
+        }
+        cv::cvtColor(frame.color, frame.gray, CV_RGB2GRAY);
+        frames.push_back(frame);
+    }
+    return frames;
+}
+
+RunResult run(std::vector<Frame> const &frames, bool random, bool batched,
+              int passes) {
+    ConfigParams params;
+    params.batchedBeaconCorrection = batched;
+    VideoBasedTracker tracker(params);
+    auto camParams = getSimulatedHDKCameraParameters();
+    // The same fixed beacons as the plugin uses with fake images.
+    auto backPanelFixedBeacon = [](int) { return true; };
+    auto frontPanelFixedBeacon = [](int id) {
+        return (id == 16) || (id == 17) || (id == 19) || (id == 20);
+    };
+    tracker.addSensor(random ? createRandomHDKLedIdentifier()
+                             : createHDKLedIdentifierSimulated(0),
+                      camParams, OsvrHdkLedLocations_SENSOR0,
+                      OsvrHdkLedDirections_SENSOR0, frontPanelFixedBeacon, 4,
+                      2);
+    tracker.addSensor(createHDKLedIdentifierSimulated(1), camParams,
+                      OsvrHdkLedLocations_SENSOR1,
+                      OsvrHdkLedDirections_SENSOR1, backPanelFixedBeacon, 4,
+                      0);
+
+    RunResult ret;
+    // Fake a 60 Hz camera, so the Kalman filters see the same timestamps on
+    // every run.
+    OSVR_TimeValue tv = {0, 0};
+    std::size_t frameNum = 0;
+    auto handler = [&](OSVR_ChannelCount sensor, OSVR_Pose3 const &pose) {
+        ret.poses[std::make_pair(frameNum, sensor)] = pose;
+    };
+    auto start = osvr::util::time::getNow();
+    for (int pass = 0; pass < passes; ++pass) {
+        for (auto const &frame : frames) {
+            tv.microseconds += 1000000 / 60;
+            osvrTimeValueNormalize(&tv);
+            tracker.processImage(frame.color, frame.gray, tv, handler);
+            ret.poseEstimation +=
+                tracker.getLastStageTimings().poseEstimation;
+            ++frameNum;
+        }
+    }
+    ret.seconds =
+        osvr::util::time::duration(osvr::util::time::getNow(), start);
+    return ret;
+}
+
+void printResult(std::string const &label, RunResult const &result,
+                 std::size_t frames) {
+    auto ms = [&](double seconds) { return 1000. * seconds / frames; };
+    std::cout << label << ": " << ms(result.seconds)
+              << " ms per frame, of which pose estimation (summed over "
+                 "sensors) "
+              << ms(result.poseEstimation) << " ms; " << result.poses.size()
+              << " poses reported" << std::endl;
+}
+
+/// Prints how far apart the poses the two runs reported for the same frame
+/// and sensor are.
+void comparePoses(PoseMap const &a, PoseMap const &b) {
+    std::vector<double> distances;
+    std::vector<double> angles;
+    for (auto const &entry : a) {
+        auto it = b.find(entry.first);
+        if (it == b.end()) {
+            continue;
+        }
+        auto const &poseA = entry.second;
+        auto const &poseB = it->second;
+        distances.push_back((osvr::util::vecMap(poseA.translation) -
+                             osvr::util::vecMap(poseB.translation))
+                                .norm());
+        angles.push_back(osvr::util::fromQuat(poseA.rotation)
+                             .angularDistance(
+                                 osvr::util::fromQuat(poseB.rotation)));
+    }
+    std::cout << distances.size() << " poses reported by both";
+    if (distances.empty()) {
+        std::cout << std::endl;
+        return;
+    }
+    auto summarize = [](std::vector<double> &values, double scale,
+                        const char units[]) {
+        std::sort(values.begin(), values.end());
+        double total = 0;
+        for (auto v : values) {
+            total += v;
+        }
+        std::cout << "mean " << scale * total / values.size() << units
+                  << ", median " << scale * values[values.size() / 2] << units
+                  << ", max " << scale * values.back() << units;
+    };
+    std::cout << ", differing in position by ";
+    summarize(distances, 1000., " mm");
+    std::cout << "; in orientation by ";
+    summarize(angles, 180. / M_PI, " deg");
+    std::cout << std::endl;
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> args(argv + 1, argv + argc);
+    if (args.empty()) {
+        std::cerr << "Usage: vbtracker-kalman-bench <image directory> "
+                     "[simulated|random] [passes]"
+                  << std::endl;
+        return 1;
+    }
+    bool random = args.size() > 1 && args[1] == "random";
+    int passes = args.size() > 2 ? std::atoi(args[2].c_str()) : 20;
+    if (passes <= 0) {
+        std::cerr << "Pass count must be positive." << std::endl;
+        return 1;
+    }
+
+    auto frames = loadFrames(args[0]);
+    if (frames.empty()) {
+        std::cerr << "No images found in " << args[0] << std::endl;
+        return 1;
+    }
+    cv::setNumThreads(1);
+    auto total = frames.size() * passes;
+    std::cout << frames.size() << " frames, " << passes << " passes"
+              << std::endl;
+
+    auto sequential = run(frames, random, false, passes);
+    printResult("Correcting once per beacon", sequential, total);
+    auto batched = run(frames, random, true, passes);
+    printResult("Correcting once per frame", batched, total);
+    std::cout << "Pose estimation speedup: "
+              << sequential.poseEstimation / batched.poseEstimation
+              << std::endl;
+    comparePoses(sequential.poses, batched.poses);
+    return 0;
+}
@@ -23,6 +23,7 @@ Sensics, Inc.
 // limitations under the License.
 
 #include "LED.h"
+#include "LedMeasurementIndex.h"
 
 namespace osvr {
 namespace vbtracker {
@@ -149,6 +150,12 @@ namespace vbtracker {
         return end(meas);
     }
 
+    std::size_t Led::nearest(LedMeasurementIndex const &index,
+                             std::vector<bool> const &claimed,
+                             double threshold) const {
+        return index.nearest(getLocation(), threshold, claimed);
+    }
+
     void Led::markMisidentified() {
         m_id = SENTINEL_NO_IDENTIFIER_OBJECT_OR_INSUFFICIENT_DATA;
         if (!m_brightnessHistory.empty()) {
@@ -32,6 +32,7 @@
 #include <opencv2/core/core.hpp>
 
 // Standard includes
+#include <cstddef>
 #include <vector>
 
 namespace osvr {
@@ -66,6 +67,8 @@ namespace vbtracker {
         cv::Size2f boundingBox;
     };
 
+    class LedMeasurementIndex;
+
     /// @brief Helper class to keep track of the state of a blob over time. This
     /// is used to help determine the identity of each LED in the scene. The
     /// LEDs are identified by their blink codes.  A steady one is presumed to
@@ -141,6 +144,17 @@ namespace vbtracker {
         LedMeasurementIterator nearest(LedMeasurementList &meas,
                                        double threshold) const;
 
+        /// @overload
+        ///
+        /// Searches a spatial index of a frame's measurements, skipping those
+        /// flagged as claimed. Runtime: proportional to the number of
+        /// measurements near me, rather than to all of them.
+        /// @return the position of the measurement in the indexed list, or
+        /// LedMeasurementIndex::NONE.
+        std::size_t nearest(LedMeasurementIndex const &index,
+                            std::vector<bool> const &claimed,
+                            double threshold) const;
+
         /// @brief Returns the most-recent boolean "bright" state according to
         /// the LED identifier. Note that the value is only meaningful if
         /// `identified()` is true.
@@ -0,0 +1,156 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include "LedMeasurementIndex.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+
+namespace osvr {
+namespace vbtracker {
+    const std::size_t LedMeasurementIndex::NONE = std::size_t(-1);
+
+    void LedMeasurementIndex::reset(LedMeasurementList const &meas,
+                                    float cellSize) {
+        m_cellStart.clear();
+        m_entries.clear();
+        m_locations.clear();
+        m_cols = m_rows = 0;
+        const auto n = meas.size();
+        if (n == 0) {
+            return;
+        }
+        auto minLoc = meas.front().loc;
+        auto maxLoc = minLoc;
+        for (auto const &m : meas) {
+            minLoc.x = std::min(minLoc.x, m.loc.x);
+            minLoc.y = std::min(minLoc.y, m.loc.y);
+            maxLoc.x = std::max(maxLoc.x, m.loc.x);
+            maxLoc.y = std::max(maxLoc.y, m.loc.y);
+        }
+        m_origin = minLoc;
+
+        // Enlarge the cells if there'd be too many of them for the number of
+        // measurements, to bound the time and space spent on empty ones.
+        const auto maxCells = std::max<std::size_t>(64, 4 * n);
+        m_cellSize = std::max(cellSize, 1.f);
+        while (true) {
+            m_cols = static_cast<int>((maxLoc.x - minLoc.x) / m_cellSize) + 1;
+            m_rows = static_cast<int>((maxLoc.y - minLoc.y) / m_cellSize) + 1;
+            if (std::size_t(m_cols) * std::size_t(m_rows) <= maxCells) {
+                break;
+            }
+            m_cellSize *= 2;
+        }
+
+        // Counting sort by cell, keeping the original order within a cell.
+        auto cellOf = [&](cv::Point2f const &loc) {
+            auto col = std::min(
+                static_cast<int>((loc.x - m_origin.x) / m_cellSize),
+                m_cols - 1);
+            auto row = std::min(
+                static_cast<int>((loc.y - m_origin.y) / m_cellSize),
+                m_rows - 1);
+            return std::size_t(row) * m_cols + col;
+        };
+        m_cellStart.assign(std::size_t(m_cols) * m_rows + 1, 0);
+        for (auto const &m : meas) {
+            ++m_cellStart[cellOf(m.loc) + 1];
+        }
+        for (std::size_t i = 1; i < m_cellStart.size(); ++i) {
+            m_cellStart[i] += m_cellStart[i - 1];
+        }
+        m_entries.resize(n);
+        m_locations.resize(n);
+        auto next = m_cellStart;
+        for (std::size_t i = 0; i < n; ++i) {
+            auto slot = next[cellOf(meas[i].loc)]++;
+            m_entries[slot] = i;
+            m_locations[slot] = meas[i].loc;
+        }
+    }
+
+    std::size_t
+    LedMeasurementIndex::nearest(cv::Point2f const &loc, double threshold,
+                                 std::vector<bool> const &claimed) const {
+        if (m_entries.empty()) {
+            return NONE;
+        }
+        // The range of cells overlapping the square around the threshold
+        // circle, clamped to the grid: computed in double so that huge
+        // thresholds don't overflow, and padded a little so that rounding
+        // can't leave out a blob right at the threshold.
+        auto reach = threshold + 0.5;
+        auto firstCell = [&](double coord, float origin) {
+            return std::floor((coord - reach - origin) / m_cellSize);
+        };
+        auto lastCell = [&](double coord, float origin) {
+            return std::floor((coord + reach - origin) / m_cellSize);
+        };
+        auto col0 = std::max(firstCell(loc.x, m_origin.x), 0.);
+        auto col1 = std::min(lastCell(loc.x, m_origin.x), m_cols - 1.);
+        auto row0 = std::max(firstCell(loc.y, m_origin.y), 0.);
+        auto row1 = std::min(lastCell(loc.y, m_origin.y), m_rows - 1.);
+        if (col0 > col1 || row0 > row1) {
+            return NONE;
+        }
+
+        // Squaring the threshold to avoid doing a square-root in a tight loop.
+        auto thresholdSquared = threshold * threshold;
+        auto ret = NONE;
+        auto minDistSq = 0.f;
+        for (auto row = int(row0); row <= int(row1); ++row) {
+            auto cell = std::size_t(row) * m_cols;
+            for (auto col = int(col0); col <= int(col1); ++col) {
+                auto b = m_cellStart[cell + col];
+                auto e = m_cellStart[cell + col + 1];
+                for (auto slot = b; slot < e; ++slot) {
+                    auto i = m_entries[slot];
+                    if (claimed[i]) {
+                        continue;
+                    }
+                    auto diff = loc - m_locations[slot];
+                    auto distSq = diff.dot(diff);
+                    if (ret == NONE || distSq < minDistSq ||
+                        (distSq == minDistSq && i < ret)) {
+                        minDistSq = distSq;
+                        ret = i;
+                    }
+                }
+            }
+        }
+        if (ret != NONE && minDistSq <= thresholdSquared) {
+            return ret;
+        }
+        return NONE;
+    }
+
+} // namespace vbtracker
+} // namespace osvr
@@ -0,0 +1,94 @@
+/** @file
+    @brief Header for a per-frame spatial index of blob measurements, used to
+   associate blobs with the LEDs tracked in previous frames.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef INCLUDED_LedMeasurementIndex_h_GUID_86B74DEA_524B_4325_8C76_EF90E9C1E5F5
+#define INCLUDED_LedMeasurementIndex_h_GUID_86B74DEA_524B_4325_8C76_EF90E9C1E5F5
+
+// Internal Includes
+#include "LED.h"
+
+// Library/third-party includes
+#include <opencv2/core/core.hpp>
+
+// Standard includes
+#include <cstddef>
+#include <vector>
+
+namespace osvr {
+namespace vbtracker {
+    /// @brief A uniform grid over the locations of a frame's blob
+    /// measurements, so that finding the nearest blob to an LED only looks at
+    /// the blobs around it rather than at all of them.
+    ///
+    /// The index itself isn't changed by queries: each user keeps its own
+    /// flags marking the measurements it has claimed, so several sensors can
+    /// search the same index at once.
+    class LedMeasurementIndex {
+      public:
+        /// @brief Returned by nearest() when no measurement qualifies.
+        static const std::size_t NONE;
+
+        /// @brief Rebuilds the index over a frame's measurements.
+        /// @param cellSize Side of a grid cell, in pixels: about the usual
+        /// search radius works well. It is enlarged if needed to keep the
+        /// grid from having many more cells than measurements.
+        void reset(LedMeasurementList const &meas, float cellSize);
+
+        /// @brief Gets the number of measurements indexed.
+        std::size_t size() const { return m_entries.size(); }
+
+        /// @brief Finds the nearest measurement to a location that isn't
+        /// claimed yet, if it is within the threshold distance.
+        ///
+        /// Gives the same answer as a linear search over the unclaimed
+        /// measurements in their original order would: when several are
+        /// equally near, the first of them.
+        ///
+        /// @param claimed Flags, one per measurement, for those to skip.
+        /// @return the measurement's position in the list passed to
+        /// reset(), or NONE.
+        std::size_t nearest(cv::Point2f const &loc, double threshold,
+                            std::vector<bool> const &claimed) const;
+
+      private:
+        cv::Point2f m_origin;
+        float m_cellSize = 1.f;
+        int m_cols = 0;
+        int m_rows = 0;
+        /// @brief Offset in m_entries of each cell's first entry, plus one
+        /// past the end.
+        std::vector<std::size_t> m_cellStart;
+        /// @brief Measurement positions, grouped by cell and in order within
+        /// each cell.
+        std::vector<std::size_t> m_entries;
+        /// @brief Location of each entry in m_entries.
+        std::vector<cv::Point2f> m_locations;
+    };
+
+} // namespace vbtracker
+} // namespace osvr
+
+#endif // INCLUDED_LedMeasurementIndex_h_GUID_86B74DEA_524B_4325_8C76_EF90E9C1E5F5
@@ -26,6 +26,7 @@
 #define INCLUDED_SBDBlobExtractor_h_GUID_E67E1F86_F827_48A3_5FA2_F9F241BA79AF
 
 // Internal Includes
+#include "BlobExtractor.h"
 #include "Types.h"
 #include "LED.h"
 
@@ -40,18 +41,19 @@ namespace osvr {
 namespace vbtracker {
     class KeypointDetailer;
 
-    /// A class performing blob-extraction duties on incoming frames.
-    class SBDBlobExtractor {
+    /// A class performing blob-extraction duties on incoming frames, using
+    /// OpenCV's SimpleBlobDetector over a sweep of thresholds.
+    class SBDBlobExtractor : public BlobExtractor {
       public:
         explicit SBDBlobExtractor(ConfigParams const &params);
-        ~SBDBlobExtractor();
+        ~SBDBlobExtractor() override;
         std::vector<LedMeasurement> const &
-        extractBlobs(cv::Mat const &grayImage);
+        extractBlobs(cv::Mat const &grayImage) override;
 
-        cv::Mat const &getDebugThresholdImage();
+        cv::Mat const &getDebugThresholdImage() override;
 
-        cv::Mat const &getDebugBlobImage();
-        cv::Mat const &getDebugExtraImage();
+        cv::Mat const &getDebugBlobImage() override;
+        cv::Mat const &getDebugExtraImage() override;
 
       private:
         void getKeypoints(cv::Mat const &grayImage);
@@ -0,0 +1,212 @@
+/** @file
+    @brief Benchmark of processing recorded frames with the sensors tracked in
+   turn versus on several threads, also checking that both report the same
+   poses.
+
+   Usage: vbtracker-sensor-bench <image directory> [simulated|random]
+   [sensor threads] [passes] [sensor pairs]
+
+   The image directory is one holding 0001.tif, 0002.tif, ..., such as
+   simulated_images/animation_from_fake (with "simulated" patterns) or
+   HDK_random_images (with "random" patterns). Passing more than one pair of
+   sensors tracks the HDK front and back plates that many times over, standing
+   in for a multi-object setup.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include "VideoBasedTracker.h"
+#include "HDKLedIdentifierFactory.h"
+#include "CameraParameters.h"
+#include "HDKData.h"
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+#include <opencv2/core/core.hpp>
+#include <opencv2/highgui/highgui.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+
+// Standard includes
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace osvr::vbtracker;
+
+namespace {
+struct Frame {
+    cv::Mat color;
+    cv::Mat gray;
+};
+
+struct ReportedPose {
+    OSVR_ChannelCount sensor;
+    OSVR_Pose3 pose;
+};
+
+struct RunResult {
+    double seconds = 0;
+    VideoBasedTracker::StageTimings timings;
+    std::vector<ReportedPose> poses;
+};
+
+std::vector<Frame> loadFrames(std::string const &dir) {
+    std::vector<Frame> frames;
+    for (int imageNum = 1;; ++imageNum) {
+        std::ostringstream fileName;
+        fileName << dir << "/" << std::setfill('0') << std::setw(4)
+                 << imageNum << ".tif";
+        Frame frame;
+        frame.color = cv::imread(fileName.str(), CV_LOAD_IMAGE_COLOR);
+        if (!frame.color.data) {
+            break;
+        }
+        cv::cvtColor(frame.color, frame.gray, CV_RGB2GRAY);
+        frames.push_back(frame);
+    }
+    return frames;
+}
+
+RunResult run(std::vector<Frame> const &frames, bool random, int threads,
+              int passes, int sensorPairs) {
+    ConfigParams params;
+    params.sensorThreads = threads;
+    VideoBasedTracker tracker(params);
+    auto camParams = getSimulatedHDKCameraParameters();
+    // The same fixed beacons as the plugin uses with fake images.
+    auto backPanelFixedBeacon = [](int) { return true; };
+    auto frontPanelFixedBeacon = [](int id) {
+        return (id == 16) || (id == 17) || (id == 19) || (id == 20);
+    };
+    for (int i = 0; i < sensorPairs; ++i) {
+        tracker.addSensor(random ? createRandomHDKLedIdentifier()
+                                 : createHDKLedIdentifierSimulated(0),
+                          camParams, OsvrHdkLedLocations_SENSOR0,
+                          OsvrHdkLedDirections_SENSOR0, frontPanelFixedBeacon,
+                          4, 2);
+        tracker.addSensor(createHDKLedIdentifierSimulated(1), camParams,
+                          OsvrHdkLedLocations_SENSOR1,
+                          OsvrHdkLedDirections_SENSOR1, backPanelFixedBeacon,
+                          4, 0);
+    }
+
+    RunResult ret;
+    // Fake a 60 Hz camera, so the Kalman filters see the same timestamps on
+    // every run.
+    OSVR_TimeValue tv = {0, 0};
+    auto handler = [&](OSVR_ChannelCount sensor, OSVR_Pose3 const &pose) {
+        ret.poses.push_back(ReportedPose{sensor, pose});
+    };
+    auto start = osvr::util::time::getNow();
+    for (int pass = 0; pass < passes; ++pass) {
+        for (auto const &frame : frames) {
+            tv.microseconds += 1000000 / 60;
+            osvrTimeValueNormalize(&tv);
+            tracker.processImage(frame.color, frame.gray, tv, handler);
+            auto const &timings = tracker.getLastStageTimings();
+            ret.timings.blobExtraction += timings.blobExtraction;
+            ret.timings.ledIdentification += timings.ledIdentification;
+            ret.timings.poseEstimation += timings.poseEstimation;
+        }
+    }
+    ret.seconds =
+        osvr::util::time::duration(osvr::util::time::getNow(), start);
+    return ret;
+}
+
+void printResult(std::string const &label, RunResult const &result,
+                 std::size_t frames) {
+    auto ms = [&](double seconds) { return 1000. * seconds / frames; };
+    std::cout << label << ": " << ms(result.seconds)
+              << " ms per frame; per-frame sums over sensors: blob extraction "
+              << ms(result.timings.blobExtraction) << " ms, LED identification "
+              << ms(result.timings.ledIdentification)
+              << " ms, pose estimation " << ms(result.timings.poseEstimation)
+              << " ms; " << result.poses.size() << " poses reported"
+              << std::endl;
+}
+
+bool samePoses(std::vector<ReportedPose> const &a,
+               std::vector<ReportedPose> const &b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i].sensor != b[i].sensor ||
+            std::memcmp(&a[i].pose, &b[i].pose, sizeof(OSVR_Pose3)) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> args(argv + 1, argv + argc);
+    if (args.empty()) {
+        std::cerr << "Usage: vbtracker-sensor-bench <image directory> "
+                     "[simulated|random] [sensor threads] [passes] "
+                     "[sensor pairs]"
+                  << std::endl;
+        return 1;
+    }
+    bool random = args.size() > 1 && args[1] == "random";
+    int threads = args.size() > 2 ? std::atoi(args[2].c_str()) : 2;
+    int passes = args.size() > 3 ? std::atoi(args[3].c_str()) : 20;
+    int sensorPairs = args.size() > 4 ? std::atoi(args[4].c_str()) : 1;
+    if (threads <= 0 || passes <= 0 || sensorPairs <= 0) {
+        std::cerr << "Thread, pass and sensor pair counts must be positive."
+                  << std::endl;
+        return 1;
+    }
+
+    auto frames = loadFrames(args[0]);
+    if (frames.empty()) {
+        std::cerr << "No images found in " << args[0] << std::endl;
+        return 1;
+    }
+    // Keep OpenCV's own threads out of the comparison.
+    cv::setNumThreads(1);
+    auto total = frames.size() * passes;
+    std::cout << frames.size() << " frames, " << passes << " passes, "
+              << 2 * sensorPairs << " sensors" << std::endl;
+
+    auto serial = run(frames, random, 1, passes, sensorPairs);
+    printResult("Sensors in turn", serial, total);
+    auto threaded = run(frames, random, threads, passes, sensorPairs);
+    std::ostringstream label;
+    label << "Sensors on " << threads << " threads";
+    printResult(label.str(), threaded, total);
+    std::cout << "Speedup: " << serial.seconds / threaded.seconds << std::endl;
+
+    if (!samePoses(serial.poses, threaded.poses)) {
+        std::cout << "Reported poses differ!" << std::endl;
+        return 1;
+    }
+    std::cout << "Reported poses are identical." << std::endl;
+    return 0;
+}
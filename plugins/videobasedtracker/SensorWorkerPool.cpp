@@ -0,0 +1,113 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include "SensorWorkerPool.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace vbtracker {
+
+    SensorWorkerPool::SensorWorkerPool(std::size_t threads) {
+        for (std::size_t i = 1; i < threads; ++i) {
+            m_workers.emplace_back([this] { m_workerLoop(); });
+        }
+    }
+
+    SensorWorkerPool::~SensorWorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_workAvailable.notify_all();
+        for (auto &worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    void SensorWorkerPool::run(std::size_t n, Task const &task) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_task = &task;
+        m_count = n;
+        m_next = 0;
+        m_remaining = n;
+        m_error = nullptr;
+        m_workAvailable.notify_all();
+
+        // Pitch in, rather than idling while the workers run.
+        while (m_runNext(lock)) {
+        }
+        m_batchDone.wait(lock, [&] { return m_remaining == 0; });
+        m_task = nullptr;
+        m_count = 0;
+        if (m_error) {
+            auto error = m_error;
+            m_error = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+
+    void SensorWorkerPool::m_workerLoop() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+            m_workAvailable.wait(
+                lock, [&] { return m_stopping || m_next < m_count; });
+            if (m_stopping) {
+                return;
+            }
+            m_runNext(lock);
+        }
+    }
+
+    bool SensorWorkerPool::m_runNext(std::unique_lock<std::mutex> &lock) {
+        if (m_next >= m_count) {
+            return false;
+        }
+        auto i = m_next++;
+        auto &task = *m_task;
+        lock.unlock();
+        std::exception_ptr error;
+        try {
+            task(i);
+        } catch (...) {
+            error = std::current_exception();
+        }
+        lock.lock();
+        if (error && !m_error) {
+            m_error = error;
+        }
+        if (--m_remaining == 0) {
+            m_batchDone.notify_all();
+        }
+        return true;
+    }
+
+} // namespace vbtracker
+} // namespace osvr
@@ -0,0 +1,87 @@
+/** @file
+    @brief Header for a small pool of threads running per-sensor work.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef INCLUDED_SensorWorkerPool_h_GUID_86BCF896_6B86_42F9_AC1F_34F03D90191E
+#define INCLUDED_SensorWorkerPool_h_GUID_86BCF896_6B86_42F9_AC1F_34F03D90191E
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace osvr {
+namespace vbtracker {
+    /// @brief A fixed set of threads that, together with the calling thread,
+    /// runs a batch of independent tasks (one per sensor) and waits for all of
+    /// them to finish.
+    class SensorWorkerPool : boost::noncopyable {
+      public:
+        typedef std::function<void(std::size_t)> Task;
+
+        /// @brief Constructor
+        /// @param threads Total number of threads to run tasks on, including
+        /// the calling thread, so one less than this is started here.
+        explicit SensorWorkerPool(std::size_t threads);
+        ~SensorWorkerPool();
+
+        /// @brief Calls task(i) for each i in [0, n), spread over the threads
+        /// of the pool and the calling thread, in no particular order.
+        /// Returns once they have all completed: if any threw, the first
+        /// exception caught is rethrown here.
+        void run(std::size_t n, Task const &task);
+
+      private:
+        void m_workerLoop();
+        /// @brief Runs the next unclaimed task of the current batch, if any.
+        /// Expects the lock to be held on entry, and holds it on return.
+        /// @return false if there was no task left to claim.
+        bool m_runNext(std::unique_lock<std::mutex> &lock);
+
+        std::vector<std::thread> m_workers;
+        std::mutex m_mutex;
+        std::condition_variable m_workAvailable;
+        std::condition_variable m_batchDone;
+        Task const *m_task = nullptr;
+        std::size_t m_count = 0;
+        std::size_t m_next = 0;
+        std::size_t m_remaining = 0;
+        std::exception_ptr m_error;
+        bool m_stopping = false;
+    };
+
+} // namespace vbtracker
+} // namespace osvr
+
+#endif // INCLUDED_SensorWorkerPool_h_GUID_86BCF896_6B86_42F9_AC1F_34F03D90191E
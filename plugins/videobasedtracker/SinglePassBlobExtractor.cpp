@@ -0,0 +1,262 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include "SinglePassBlobExtractor.h"
+
+// Library/third-party includes
+#include <opencv2/imgproc/imgproc.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace osvr {
+namespace vbtracker {
+    /// Same as SimpleBlobDetector's default maximum blob area, in square
+    /// pixels.
+    static const std::size_t MAX_AREA = 5000;
+
+    /// Gets the next 8 pixels of a row as one word, to skip over runs of
+    /// them at a time.
+    static inline std::uint64_t loadWord(uchar const *p) {
+        std::uint64_t ret;
+        std::memcpy(&ret, p, sizeof(ret));
+        return ret;
+    }
+
+    SinglePassBlobExtractor::SinglePassBlobExtractor(
+        ConfigParams const &params)
+        : m_params(params) {}
+
+    SinglePassBlobExtractor::~SinglePassBlobExtractor() {}
+
+    std::vector<LedMeasurement> const &
+    SinglePassBlobExtractor::extractBlobs(cv::Mat const &grayImage) {
+        m_latestMeasurements.clear();
+        m_lastGrayImage = grayImage;
+        m_debugBlobImageDirty = true;
+
+        double minVal, maxVal;
+        cv::minMaxIdx(grayImage, &minVal, &maxVal);
+        auto &p = m_params.blobParams;
+        if (maxVal < p.absoluteMinThreshold) {
+            /// empty image, early out!
+            m_binaryImage = cv::Mat::zeros(grayImage.size(), CV_8UC1);
+            return m_latestMeasurements;
+        }
+
+        // The same thresholds as SBDBlobExtractor would sweep between.
+        auto imageRangeLerp = [=](double alpha) {
+            return minVal + (maxVal - minVal) * alpha;
+        };
+        auto minThreshold = std::max(imageRangeLerp(p.minThresholdAlpha),
+                                     p.absoluteMinThreshold);
+        auto maxThreshold = std::max(imageRangeLerp(p.maxThresholdAlpha),
+                                     p.absoluteMinThreshold);
+        auto peakThreshold =
+            minThreshold +
+            (maxThreshold - minThreshold) / std::max(p.thresholdSteps, 1);
+
+        // OpenCV's thresholding is vectorized, and leaves us pixels that are
+        // either 0 or 255, so that whole words of them can be skipped.
+        cv::threshold(grayImage, m_binaryImage, minThreshold, 255,
+                      CV_THRESH_BINARY);
+
+        m_regions.clear();
+        m_previousRuns.clear();
+        for (int y = 0; y < grayImage.rows; ++y) {
+            m_scanRow(y, m_binaryImage.ptr<uchar>(y), grayImage.ptr<uchar>(y));
+            std::swap(m_runs, m_previousRuns);
+        }
+        m_measureRegions(peakThreshold);
+        return m_latestMeasurements;
+    }
+
+    void SinglePassBlobExtractor::m_scanRow(int y, uchar const *binaryRow,
+                                            uchar const *grayRow) {
+        static const std::uint64_t ALL_SET = ~std::uint64_t(0);
+        const int cols = m_binaryImage.cols;
+        m_runs.clear();
+        auto previous = begin(m_previousRuns);
+        const auto previousEnd = end(m_previousRuns);
+        int x = 0;
+        while (x < cols) {
+            // Skip the dark pixels, a word at a time where we can.
+            while (x + 8 <= cols && loadWord(binaryRow + x) == 0) {
+                x += 8;
+            }
+            while (x < cols && !binaryRow[x]) {
+                ++x;
+            }
+            if (x == cols) {
+                break;
+            }
+            // Then find the end of the bright ones.
+            const int runBegin = x;
+            while (x + 8 <= cols && loadWord(binaryRow + x) == ALL_SET) {
+                x += 8;
+            }
+            while (x < cols && binaryRow[x]) {
+                ++x;
+            }
+            const int runEnd = x;
+
+            Region region;
+            region.parent = m_regions.size();
+            region.area = runEnd - runBegin;
+            region.sumX = (runBegin + runEnd - 1) * 0.5 * region.area;
+            region.sumY = double(y) * region.area;
+            region.minX = runBegin;
+            region.maxX = runEnd - 1;
+            region.minY = region.maxY = y;
+            region.peak = *std::max_element(grayRow + runBegin,
+                                            grayRow + runEnd);
+            m_regions.push_back(region);
+            m_runs.push_back(Run{runBegin, runEnd, region.parent});
+
+            // Merge with the runs of the previous row that touch this one,
+            // diagonally included. Both rows' runs are in order, so the ones
+            // entirely to our left can't touch any later run either.
+            while (previous != previousEnd && previous->end < runBegin) {
+                ++previous;
+            }
+            for (auto it = previous; it != previousEnd && it->begin <= runEnd;
+                 ++it) {
+                m_merge(it->region, region.parent);
+            }
+        }
+    }
+
+    std::size_t SinglePassBlobExtractor::m_findRoot(std::size_t region) {
+        while (m_regions[region].parent != region) {
+            // Path halving.
+            auto &parent = m_regions[region].parent;
+            parent = m_regions[parent].parent;
+            region = parent;
+        }
+        return region;
+    }
+
+    void SinglePassBlobExtractor::m_merge(std::size_t a, std::size_t b) {
+        a = m_findRoot(a);
+        b = m_findRoot(b);
+        if (a == b) {
+            return;
+        }
+        // Keep the earlier region as the root, so the blobs come out in the
+        // order of their first pixel.
+        if (b < a) {
+            std::swap(a, b);
+        }
+        auto &root = m_regions[a];
+        auto const &other = m_regions[b];
+        root.area += other.area;
+        root.sumX += other.sumX;
+        root.sumY += other.sumY;
+        root.minX = std::min(root.minX, other.minX);
+        root.maxX = std::max(root.maxX, other.maxX);
+        root.minY = std::min(root.minY, other.minY);
+        root.maxY = std::max(root.maxY, other.maxY);
+        root.peak = std::max(root.peak, other.peak);
+        m_regions[b].parent = a;
+    }
+
+    void SinglePassBlobExtractor::m_measureRegions(double peakThreshold) {
+        auto &p = m_params.blobParams;
+        const auto minDistSquared =
+            p.minDistBetweenBlobs * p.minDistBetweenBlobs;
+        std::vector<std::size_t> kept;
+        for (std::size_t i = 0; i < m_regions.size(); ++i) {
+            auto const &region = m_regions[i];
+            if (region.parent != i || region.area < p.minArea ||
+                region.area > MAX_AREA || region.peak < peakThreshold) {
+                continue;
+            }
+            LedMeasurement meas;
+            meas.loc = cv::Point2f(float(region.sumX / region.area),
+                                   float(region.sumY / region.area));
+            meas.area = float(region.area);
+            meas.diameter = float(2 * std::sqrt(region.area / CV_PI));
+            /// Like the keypoint size SBDBlobExtractor uses.
+            meas.brightness = meas.diameter;
+            meas.knowBoundingBox = true;
+            meas.boundingBox =
+                cv::Size2f(float(region.maxX - region.minX + 1),
+                           float(region.maxY - region.minY + 1));
+
+            // Like SimpleBlobDetector, don't report two blobs closer than the
+            // minimum distance: fold this one into the earlier one instead.
+            auto near = std::find_if(
+                begin(m_latestMeasurements), end(m_latestMeasurements),
+                [&](LedMeasurement const &other) {
+                    auto diff = other.loc - meas.loc;
+                    return diff.dot(diff) < minDistSquared;
+                });
+            if (near == end(m_latestMeasurements)) {
+                m_latestMeasurements.push_back(meas);
+                continue;
+            }
+            auto totalArea = near->area + meas.area;
+            near->loc = (near->loc * near->area + meas.loc * meas.area) *
+                        (1.f / totalArea);
+            near->area = totalArea;
+            near->diameter = float(2 * std::sqrt(totalArea / CV_PI));
+            near->brightness = near->diameter;
+            near->knowBoundingBox = false;
+        }
+    }
+
+    cv::Mat const &SinglePassBlobExtractor::getDebugThresholdImage() {
+        return m_binaryImage;
+    }
+
+    cv::Mat SinglePassBlobExtractor::generateDebugBlobImage() const {
+        cv::Mat ret;
+        cv::cvtColor(m_lastGrayImage, ret, CV_GRAY2BGR);
+        // Draw detected blobs as blue circles.
+        for (auto const &meas : m_latestMeasurements) {
+            cv::circle(ret, meas.loc, int(std::ceil(meas.diameter / 2)),
+                       cv::Scalar(255, 0, 0));
+        }
+        return ret;
+    }
+
+    cv::Mat const &SinglePassBlobExtractor::getDebugBlobImage() {
+        if (m_debugBlobImageDirty) {
+            m_debugBlobImage = generateDebugBlobImage();
+            m_debugBlobImageDirty = false;
+        }
+        return m_debugBlobImage;
+    }
+
+    cv::Mat const &SinglePassBlobExtractor::getDebugExtraImage() {
+        return m_binaryImage;
+    }
+
+} // namespace vbtracker
+} // namespace osvr
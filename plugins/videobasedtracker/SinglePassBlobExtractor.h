@@ -0,0 +1,106 @@
+/** @file
+    @brief Header for a blob extractor making a single connected-components
+   pass over a thresholded frame.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef INCLUDED_SinglePassBlobExtractor_h_GUID_4393AB0B_B928_47AA_82E6_EC5D6C2683E7
+#define INCLUDED_SinglePassBlobExtractor_h_GUID_4393AB0B_B928_47AA_82E6_EC5D6C2683E7
+
+// Internal Includes
+#include "BlobExtractor.h"
+#include "Types.h"
+#include "LED.h"
+
+// Library/third-party includes
+#include <opencv2/core/core.hpp>
+
+// Standard includes
+#include <cstddef>
+#include <vector>
+
+namespace osvr {
+namespace vbtracker {
+    /// @brief A blob extractor thresholding each frame once, then finding
+    /// the connected regions of bright pixels and their centroid, area and
+    /// bounding box in a single scan of runs of pixels, row by row.
+    ///
+    /// Much cheaper than SBDBlobExtractor, which finds contours at each of
+    /// several thresholds and merges the results. It also keeps only a
+    /// reference to the last frame for its debug images, instead of a copy.
+    class SinglePassBlobExtractor : public BlobExtractor {
+      public:
+        explicit SinglePassBlobExtractor(ConfigParams const &params);
+        ~SinglePassBlobExtractor() override;
+        std::vector<LedMeasurement> const &
+        extractBlobs(cv::Mat const &grayImage) override;
+
+        cv::Mat const &getDebugThresholdImage() override;
+        cv::Mat const &getDebugBlobImage() override;
+        cv::Mat const &getDebugExtraImage() override;
+
+      private:
+        /// @brief A connected region of above-threshold pixels, as the union
+        /// of runs of them. Only meaningful at the root of its set.
+        struct Region {
+            std::size_t parent;
+            std::size_t area;
+            double sumX;
+            double sumY;
+            int minX;
+            int maxX;
+            int minY;
+            int maxY;
+            uchar peak;
+        };
+        /// @brief A run of above-threshold pixels, [begin, end), in a row.
+        struct Run {
+            int begin;
+            int end;
+            std::size_t region;
+        };
+        /// @brief Finds a row's runs, creating a region for each and merging
+        /// it with those of the touching runs in the previous row.
+        void m_scanRow(int y, uchar const *binaryRow, uchar const *grayRow);
+        std::size_t m_findRoot(std::size_t region);
+        void m_merge(std::size_t a, std::size_t b);
+        /// @brief Turns the root regions into measurements.
+        void m_measureRegions(double peakThreshold);
+        cv::Mat generateDebugBlobImage() const;
+
+        ConfigParams m_params;
+        std::vector<LedMeasurement> m_latestMeasurements;
+        /// @brief Refers to the caller's frame, for the debug blob image.
+        cv::Mat m_lastGrayImage;
+        cv::Mat m_binaryImage;
+        std::vector<Region> m_regions;
+        std::vector<Run> m_runs;
+        std::vector<Run> m_previousRuns;
+
+        bool m_debugBlobImageDirty = true;
+        cv::Mat m_debugBlobImage;
+    };
+} // namespace vbtracker
+} // namespace osvr
+
+#endif // INCLUDED_SinglePassBlobExtractor_h_GUID_4393AB0B_B928_47AA_82E6_EC5D6C2683E7
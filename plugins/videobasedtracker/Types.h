@@ -125,6 +125,14 @@ namespace vbtracker {
         /// the blob extractor will take between the two threshold extrema, and
         /// thus greatly impacts performance. Adjust with care.
         int thresholdSteps = 4;
+        /// If true, find blobs with a single thresholding and
+        /// connected-components pass, at the minimum threshold, instead of
+        /// running SimpleBlobDetector at each step. The shape filters
+        /// (circularity, convexity) aren't applied by that detector: to
+        /// stand in for SimpleBlobDetector's requirement that a blob be seen
+        /// at two or more thresholds, it keeps only blobs whose brightest
+        /// pixel reaches the second threshold step.
+        bool singlePassDetector = false;
     };
     /// General configuration parameters
     struct ConfigParams {
@@ -155,6 +163,13 @@ namespace vbtracker {
         /// decide (that is, not set an explicit preference)
         int numThreads = 1;
 
+        /// How many threads to associate blobs with LEDs and estimate poses
+        /// on, one sensor at a time per thread. Sensors share no state while
+        /// doing so, and their poses are still reported in sensor order, so
+        /// this only changes how fast a frame is processed. 1 or less
+        /// processes the sensors in turn on the calling thread.
+        int sensorThreads = 1;
+
         /// This is the autocorrelation kernel of the process noise. The first
         /// three elements correspond to position, the second three to
         /// incremental rotation.
@@ -216,6 +231,11 @@ namespace vbtracker {
         /// measurements with a "bad" residual
         double highResidualVariancePenalty = 10.;
 
+        /// When true, the Kalman estimator corrects the pose with all of a
+        /// frame's beacon measurements in one stacked step, then updates each
+        /// beacon, rather than correcting pose and beacon once per beacon.
+        bool batchedBeaconCorrection = false;
+
         /// When true, will stream debug info (variance, pixel measurement,
         /// pixel residual) on up to the first 34 beacons of your first sensor
         /// as analogs.
@@ -255,6 +275,21 @@ namespace vbtracker {
         /// Only make sense for a single target.
         std::string calibrationFile = "";
 
+        /// If true, capture frames on a thread of their own, so camera I/O
+        /// overlaps with processing the previous frame, instead of capturing
+        /// and processing in turn.
+        bool pipelined = false;
+
+        /// In pipelined mode, the most captured frames waiting to be processed:
+        /// when full, the oldest is dropped. Processing always takes the newest
+        /// frame waiting.
+        int pipelineQueueSize = 2;
+
+        /// If true, periodically print the mean time spent in each stage of
+        /// tracking (capture, waiting in the queue, blob extraction, LED
+        /// identification, pose estimation).
+        bool reportStageTimings = false;
+
         ConfigParams() {
             // Apparently I can't non-static-data-initializer initialize an
             // array member. Sad. GCC almost let me. MSVC said no way.
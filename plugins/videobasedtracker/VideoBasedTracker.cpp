@@ -28,6 +28,7 @@
 #include "CameraDistortionModel.h"
 #include <osvr/Util/EigenCoreGeometry.h>
 #include <osvr/Util/CSV.h>
+#include <osvr/Util/TimeValue.h>
 
 // Library/third-party includes
 #include <opencv2/core/version.hpp>
@@ -43,7 +44,11 @@ namespace osvr {
 namespace vbtracker {
 
     VideoBasedTracker::VideoBasedTracker(ConfigParams const &params)
-        : m_params(params), m_blobExtractor(params) {}
+        : m_params(params), m_blobExtractor(createBlobExtractor(params)) {
+        if (m_params.sensorThreads > 1) {
+            m_sensorPool.reset(new SensorWorkerPool(m_params.sensorThreads));
+        }
+    }
 
     // This version requires YOU to add your beacons! You!
     void VideoBasedTracker::addSensor(
@@ -150,6 +155,68 @@ namespace vbtracker {
         return ret;
     }
 
+    void VideoBasedTracker::m_trackSensor(
+        std::size_t sensor, LedMeasurementList const &undistortedLeds,
+        OSVR_TimeValue const &tv) {
+        auto &result = m_sensorResults[sensor];
+        result = SensorResult{};
+        auto stageStart = util::time::getNow();
+        std::vector<bool> claimed(undistortedLeds.size(), false);
+
+        // Locate the closest blob from this frame to each LED found
+        // in the previous frame.  If it is close enough to the nearest
+        // neighbor from last time, we assume that it is the same LED and
+        // update it.  If not, we delete the LED from the list.  Once we
+        // have matched a blob to an LED, we mark it as claimed.  If
+        // there are any blobs leftover, we create new LEDs from them.
+        // @todo: Include motion estimate based on Kalman filter along with
+        // model of the projection once we have one built.  Note that this
+        // will require handling the lens distortion appropriately.
+        {
+            auto &myLeds = m_led_groups[sensor];
+            auto led = begin(myLeds);
+            while (led != end(myLeds)) {
+                led->resetUsed();
+                auto threshold = m_params.blobMoveThreshold *
+                                 led->getMeasurement().diameter;
+                auto nearest = led->nearest(m_blobIndex, claimed, threshold);
+                if (nearest == LedMeasurementIndex::NONE) {
+                    // We have no blob corresponding to this LED, so we need
+                    // to delete this LED.
+                    led = myLeds.erase(led);
+                } else {
+                    // Update the values in this LED and then go on to the
+                    // next one. Claim this blob so it's no longer a
+                    // potential match.
+                    led->addMeasurement(undistortedLeds[nearest],
+                                        m_params.blobsKeepIdentity);
+                    claimed[nearest] = true;
+                    ++led;
+                }
+            }
+            // If we have any blobs that have not been associated with an
+            // LED, then we add a new LED for each of them.
+            for (size_t i = 0; i < undistortedLeds.size(); ++i) {
+                if (!claimed[i]) {
+                    myLeds.emplace_back(m_identifiers[sensor].get(),
+                                        undistortedLeds[i]);
+                }
+            }
+        }
+        auto identified = util::time::getNow();
+        result.ledIdentification = util::time::duration(identified, stageStart);
+        //==================================================================
+        // Compute the pose of the HMD w.r.t. the camera frame of
+        // reference.
+        if (m_estimators[sensor]) {
+            // Get an estimated pose, if we have enough data.
+            result.gotPose = m_estimators[sensor]->EstimatePoseFromLeds(
+                m_led_groups[sensor], tv, result.pose);
+        }
+        result.poseEstimation =
+            util::time::duration(util::time::getNow(), identified);
+    }
+
     bool VideoBasedTracker::processImage(cv::Mat frame, cv::Mat grayImage,
                                          OSVR_TimeValue const &tv,
                                          PoseHandler handler) {
@@ -157,75 +224,58 @@ namespace vbtracker {
         bool done = false;
         m_frame = frame;
         m_imageGray = grayImage;
-        auto foundLeds = m_blobExtractor.extractBlobs(grayImage);
+        m_timings = StageTimings{};
+        auto stageStart = util::time::getNow();
+        auto foundLeds = m_blobExtractor->extractBlobs(grayImage);
 
         /// Perform the undistortion of keypoints
         auto undistortedLeds = undistortLeds(foundLeds, m_camParams);
+        m_timings.blobExtraction =
+            util::time::duration(util::time::getNow(), stageStart);
+
+        // Index the blobs for association, with grid cells about the size of
+        // the distance an average blob may move between frames.
+        stageStart = util::time::getNow();
+        auto meanDiameter = 0.;
+        for (auto const &meas : undistortedLeds) {
+            meanDiameter += meas.diameter;
+        }
+        if (!undistortedLeds.empty()) {
+            meanDiameter /= undistortedLeds.size();
+        }
+        auto cellSize = m_params.blobMoveThreshold * meanDiameter;
+        m_blobIndex.reset(undistortedLeds, static_cast<float>(cellSize));
+        m_timings.ledIdentification =
+            util::time::duration(util::time::getNow(), stageStart);
 
         // We allow multiple sets of LEDs, each corresponding to a different
         // sensor, to be located in the same image.  We construct a new set
         // of LEDs for each and try to find them.  It is assumed that they all
         // have unique ID patterns across all sensors.
-        for (size_t sensor = 0; sensor < m_identifiers.size(); sensor++) {
+        const auto numSensors = m_identifiers.size();
+        m_sensorResults.resize(numSensors);
+        auto trackSensor = [&](std::size_t sensor) {
+            m_trackSensor(sensor, undistortedLeds, tv);
+        };
+        if (m_sensorPool) {
+            m_sensorPool->run(numSensors, trackSensor);
+        } else {
+            for (size_t sensor = 0; sensor < numSensors; sensor++) {
+                trackSensor(sensor);
+            }
+        }
 
+        // Report the poses, and show the debug display, in sensor order no
+        // matter how the sensors were tracked.
+        for (size_t sensor = 0; sensor < numSensors; sensor++) {
+            auto const &result = m_sensorResults[sensor];
+            m_timings.ledIdentification += result.ledIdentification;
+            m_timings.poseEstimation += result.poseEstimation;
             osvrPose3SetIdentity(&m_pose);
-            auto ledsMeasurements = undistortedLeds;
-
-            // Locate the closest blob from this frame to each LED found
-            // in the previous frame.  If it is close enough to the nearest
-            // neighbor from last time, we assume that it is the same LED and
-            // update it.  If not, we delete the LED from the list.  Once we
-            // have matched a blob to an LED, we remove it from the list.  If
-            // there are any blobs leftover, we create new LEDs from them.
-            // @todo: Include motion estimate based on Kalman filter along with
-            // model of the projection once we have one built.  Note that this
-            // will require handling the lens distortion appropriately.
-            {
-                auto &myLeds = m_led_groups[sensor];
-                auto led = begin(myLeds);
-                auto e = end(myLeds);
-                while (led != end(myLeds)) {
-                    led->resetUsed();
-                    auto threshold = m_params.blobMoveThreshold *
-                                     led->getMeasurement().diameter;
-                    auto nearest = led->nearest(ledsMeasurements, threshold);
-                    if (nearest == end(ledsMeasurements)) {
-                        // We have no blob corresponding to this LED, so we need
-                        // to delete this LED.
-                        led = myLeds.erase(led);
-                    } else {
-                        // Update the values in this LED and then go on to the
-                        // next one. Remove this blob from the list of
-                        // potential matches.
-                        led->addMeasurement(*nearest,
-                                            m_params.blobsKeepIdentity);
-                        ledsMeasurements.erase(nearest);
-                        ++led;
-                    }
-                }
-                // If we have any blobs that have not been associated with an
-                // LED, then we add a new LED for each of them.
-                // std::cout << "Had " << Leds.size() << " LEDs, " <<
-                // keyPoints.size() << " new ones available" << std::endl;
-                for (auto &remainingLed : ledsMeasurements) {
-                    myLeds.emplace_back(m_identifiers[sensor].get(),
-                                        remainingLed);
-                }
-            }
-            //==================================================================
-            // Compute the pose of the HMD w.r.t. the camera frame of
-            // reference.
-            bool gotPose = false;
-            if (m_estimators[sensor]) {
-
-                // Get an estimated pose, if we have enough data.
-                OSVR_PoseState pose;
-                if (m_estimators[sensor]->EstimatePoseFromLeds(
-                        m_led_groups[sensor], tv, pose)) {
-                    m_pose = pose;
-                    handler(static_cast<unsigned>(sensor), pose);
-                    gotPose = true;
-                }
+            bool gotPose = result.gotPose;
+            if (gotPose) {
+                m_pose = result.pose;
+                handler(static_cast<unsigned>(sensor), result.pose);
             }
             if (m_params.debug) {
                 // Don't display the debugging info every frame, or we can't go
@@ -237,10 +287,11 @@ namespace vbtracker {
                 if (++count == 11) {
                     // Fake the thresholded image to give an idea of what the
                     // blob detector is doing.
-                    m_thresholdImage = m_blobExtractor.getDebugThresholdImage();
+                    m_thresholdImage =
+                        m_blobExtractor->getDebugThresholdImage();
 
                     // Draw detected blobs as blue circles.
-                    m_imageWithBlobs = m_blobExtractor.getDebugBlobImage();
+                    m_imageWithBlobs = m_blobExtractor->getDebugBlobImage();
 
                     // Draw the unidentified (flying?) blobs (UFBs?) on the
                     // status image
@@ -29,9 +29,11 @@
 #include "Types.h"
 #include "LED.h"
 #include "LedIdentifier.h"
+#include "LedMeasurementIndex.h"
 #include "BeaconBasedPoseEstimator.h"
 #include "CameraParameters.h"
-#include "SBDBlobExtractor.h"
+#include "BlobExtractor.h"
+#include "SensorWorkerPool.h"
 #include <osvr/Util/ChannelCountC.h>
 
 // Library/third-party includes
@@ -43,6 +45,7 @@
 #include <list>
 #include <functional>
 #include <algorithm>
+#include <memory>
 
 // Define the constant below to provide debugging (window showing video and
 // behavior, printing tracked positions)
@@ -128,12 +131,24 @@ namespace vbtracker {
         typedef std::function<void(OSVR_ChannelCount, OSVR_Pose3 const &)>
             PoseHandler;
 
+        /// @brief Seconds spent in each stage of processing an image, summed
+        /// over all sensors.
+        struct StageTimings {
+            double blobExtraction = 0;
+            double ledIdentification = 0;
+            double poseEstimation = 0;
+        };
+
         /// @brief The main method that processes an image into tracked poses.
         /// @return true if user hit q to quit in a debug window, if such a
         /// thing exists.
         bool processImage(cv::Mat frame, cv::Mat grayImage,
                           OSVR_TimeValue const &tv, PoseHandler handler);
 
+        /// @brief Gets the time spent in each stage by the last call to
+        /// processImage()
+        StageTimings const &getLastStageTimings() const { return m_timings; }
+
         /// For debug purposes
         BeaconBasedPoseEstimator const &getFirstEstimator() const {
             return *(m_estimators.front());
@@ -153,6 +168,25 @@ namespace vbtracker {
             std::function<void(BeaconBasedPoseEstimator &)> const &beaconAdder,
             size_t requiredInliers = 4, size_t permittedOutliers = 2);
 
+        /// @brief What tracking one sensor in one frame produced.
+        struct SensorResult {
+            bool gotPose = false;
+            OSVR_PoseState pose;
+            /// Seconds spent associating blobs with this sensor's LEDs.
+            double ledIdentification = 0;
+            /// Seconds spent estimating this sensor's pose.
+            double poseEstimation = 0;
+        };
+
+        /// @brief Associates the frame's blobs with a sensor's LEDs and
+        /// estimates its pose, into m_sensorResults[sensor].
+        ///
+        /// Touches only that sensor's LED group, estimator and result, so it
+        /// may run for several sensors at once.
+        void m_trackSensor(std::size_t sensor,
+                           LedMeasurementList const &undistortedLeds,
+                           OSVR_TimeValue const &tv);
+
         void dumpKeypointDebugData(std::vector<cv::KeyPoint> const &keypoints);
 
         void drawLedCircleOnStatusImage(Led const &led, bool filled,
@@ -172,7 +206,7 @@ namespace vbtracker {
         /// @}
 
         ConfigParams m_params;
-        SBDBlobExtractor m_blobExtractor;
+        BlobExtractorPtr m_blobExtractor;
         cv::SimpleBlobDetector::Params m_sbdParams;
 
         /// @brief Test (with asserts) what Ryan thinks are the invariants. Will
@@ -201,6 +235,17 @@ namespace vbtracker {
         /// @brief The pose that we report
         OSVR_PoseState m_pose;
 
+        StageTimings m_timings;
+
+        /// @brief The current frame's undistorted blobs, indexed for
+        /// association with each sensor's LEDs.
+        LedMeasurementIndex m_blobIndex;
+
+        std::vector<SensorResult> m_sensorResults;
+
+        /// @brief Threads to track sensors on, if more than one was requested.
+        std::unique_ptr<SensorWorkerPool> m_sensorPool;
+
         /// A captured copy of the camera parameters;
         CameraParameters m_camParams;
     };
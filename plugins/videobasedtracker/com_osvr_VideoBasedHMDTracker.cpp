@@ -28,9 +28,11 @@
 #include "CameraParameters.h"
 #include "ImageSource.h"
 #include "ImageSourceFactories.h"
+#include "FrameQueue.h"
 #include <osvr/PluginKit/PluginKit.h>
 #include <osvr/PluginKit/TrackerInterfaceC.h>
 #include <osvr/PluginKit/AnalogInterfaceC.h>
+#include <osvr/Util/TimeValue.h>
 #include "HDKData.h"
 
 #include "ConfigurationParser.h"
@@ -49,6 +51,9 @@
 #include <boost/noncopyable.hpp>
 
 // Standard includes
+#include <atomic>
+#include <chrono>
+#include <thread>
 #include <iostream>
 #include <fstream>
 #include <iomanip>
@@ -77,7 +82,8 @@ class VideoBasedHMDTracker : boost::noncopyable {
                          int devNumber = 0,
                          osvr::vbtracker::ConfigParams const &params =
                              osvr::vbtracker::ConfigParams{})
-        : m_source(std::move(source)), m_vbtracker(params), m_params(params) {
+        : m_source(std::move(source)), m_params(params),
+          m_queue(params.pipelineQueueSize), m_vbtracker(params) {
         if (params.numThreads > 0) {
             // Set the number of threads for OpenCV to use.
             cv::setNumThreads(params.numThreads);
@@ -106,6 +112,13 @@ class VideoBasedHMDTracker : boost::noncopyable {
         m_dev.registerUpdateCallback(this);
     }
 
+    ~VideoBasedHMDTracker() {
+        if (m_captureThread.joinable()) {
+            m_capturing = false;
+            m_captureThread.join();
+        }
+    }
+
     OSVR_ReturnCode update();
 
     /// Provides access to the underlying video-based tracker object to add
@@ -113,6 +126,21 @@ class VideoBasedHMDTracker : boost::noncopyable {
     osvr::vbtracker::VideoBasedTracker &vbtracker() { return m_vbtracker; }
 
   private:
+    /// @brief Grabs and retrieves a frame, timestamping it.
+    /// @return false if the camera failed.
+    bool m_capture(osvr::vbtracker::CapturedFrame &captured);
+
+    /// @brief Body of the capture thread, in pipelined mode.
+    void m_captureLoop();
+
+    /// @brief Tracks and reports poses from a captured frame.
+    void m_process(osvr::vbtracker::CapturedFrame &captured);
+
+    /// @brief Adds a frame's timings to the running totals, printing and
+    /// resetting them every so often.
+    void m_accumulateTimings(osvr::vbtracker::CapturedFrame const &captured,
+                             double queueTime);
+
     osvr::pluginkit::DeviceToken m_dev;
     OSVR_TrackerDeviceInterface m_tracker;
     OSVR_AnalogDeviceInterface m_analog;
@@ -121,25 +149,39 @@ class VideoBasedHMDTracker : boost::noncopyable {
 #ifdef VBHMD_SAVE_IMAGES
     int m_imageNum = 1;
 #endif
-    cv::Mat m_frame;
-    cv::Mat m_imageGray;
+    /// @brief The frame being processed; in non-pipelined mode, its buffers
+    /// are reused for every capture.
+    osvr::vbtracker::CapturedFrame m_captured;
+
+    /// @name Pipelined mode
+    /// @{
+    osvr::vbtracker::FrameQueue m_queue;
+    std::thread m_captureThread;
+    std::atomic<bool> m_capturing{false};
+    /// @}
+
+    /// @name Stage timing totals, for reportStageTimings
+    /// @{
+    std::size_t m_timedFrames = 0;
+    double m_grabTotal = 0;
+    double m_retrieveTotal = 0;
+    double m_queueTotal = 0;
+    osvr::vbtracker::VideoBasedTracker::StageTimings m_stageTotals;
+    osvr::util::time::TimeValue m_timingStart;
+    /// @}
 
     osvr::vbtracker::VideoBasedTracker m_vbtracker;
 };
 
-inline OSVR_ReturnCode VideoBasedHMDTracker::update() {
-    if (!m_source->ok()) {
-        // Couldn't open the camera.  Failing silently for now. Maybe the
-        // camera will be plugged back in later.
-        return OSVR_RETURN_SUCCESS;
-    }
-
+inline bool
+VideoBasedHMDTracker::m_capture(osvr::vbtracker::CapturedFrame &captured) {
     //==================================================================
     // Trigger a camera grab.
+    auto start = osvr::util::time::getNow();
     if (!m_source->grab()) {
         // Couldn't open the camera.  Failing silently for now. Maybe the
         // camera will be plugged back in later.
-        return OSVR_RETURN_SUCCESS;
+        return false;
     }
 
     //==================================================================
@@ -149,10 +191,68 @@ inline OSVR_ReturnCode VideoBasedHMDTracker::update() {
     // TODO: Back-date the aquisition time by the expected image
     // transfer time and perhaps by half the exposure time to say
     // when the photons actually arrived.
-    OSVR_TimeValue timestamp;
-    osvrTimeValueGetNow(&timestamp);
-    // Pull the image into an OpenCV matrix named m_frame.
-    m_source->retrieve(m_frame, m_imageGray);
+    osvrTimeValueGetNow(&captured.timestamp);
+    captured.grabTime = osvr::util::time::duration(captured.timestamp, start);
+    // Pull the image into OpenCV matrices.
+    m_source->retrieve(captured.frame, captured.imageGray);
+    captured.retrieveTime = osvr::util::time::duration(
+        osvr::util::time::getNow(), captured.timestamp);
+    return true;
+}
+
+inline void VideoBasedHMDTracker::m_captureLoop() {
+    while (m_capturing) {
+        if (!m_source->ok()) {
+            // Maybe the camera will be plugged back in later.
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            continue;
+        }
+        // Fresh buffers for each frame, since the last one may still be
+        // getting processed.
+        osvr::vbtracker::CapturedFrame captured;
+        if (m_capture(captured)) {
+            m_queue.push(std::move(captured));
+        }
+    }
+}
+
+inline OSVR_ReturnCode VideoBasedHMDTracker::update() {
+    if (m_params.pipelined) {
+        if (!m_captureThread.joinable()) {
+            // Started here, rather than in the constructor, so that the
+            // sensors are all set up first.
+            m_capturing = true;
+            m_captureThread = std::thread([&] { m_captureLoop(); });
+        }
+        // Wait only briefly, so the device thread can still shut down if
+        // the camera has stopped.
+        if (!m_queue.popLatest(m_captured, std::chrono::milliseconds(100))) {
+            return OSVR_RETURN_SUCCESS;
+        }
+        m_process(m_captured);
+        return OSVR_RETURN_SUCCESS;
+    }
+
+    if (!m_source->ok()) {
+        // Couldn't open the camera.  Failing silently for now. Maybe the
+        // camera will be plugged back in later.
+        return OSVR_RETURN_SUCCESS;
+    }
+    if (!m_capture(m_captured)) {
+        return OSVR_RETURN_SUCCESS;
+    }
+    m_process(m_captured);
+    return OSVR_RETURN_SUCCESS;
+}
+
+inline void
+VideoBasedHMDTracker::m_process(osvr::vbtracker::CapturedFrame &captured) {
+    // Time from capture to the start of processing: more than zero only
+    // when pipelined.
+    auto queueTime = osvr::util::time::duration(osvr::util::time::getNow(),
+                                                captured.timestamp) -
+                     captured.retrieveTime;
+    auto const &timestamp = captured.timestamp;
 
 #ifdef VBHMD_SAVE_IMAGES
     // If we're supposed to save images, make file names that match the
@@ -161,7 +261,7 @@ inline OSVR_ReturnCode VideoBasedHMDTracker::update() {
     fileName << VBHMD_SAVE_IMAGES << "/";
     fileName << std::setfill('0') << std::setw(4) << m_imageNum++;
     fileName << ".tif";
-    if (!cv::imwrite(fileName.str(), m_frame)) {
+    if (!cv::imwrite(fileName.str(), captured.frame)) {
         std::cerr << "Could not write image to " << fileName.str() << std::endl;
     }
 
@@ -187,7 +287,7 @@ inline OSVR_ReturnCode VideoBasedHMDTracker::update() {
 #endif
     bool shouldSendDebug = false;
     m_vbtracker.processImage(
-        m_frame, m_imageGray, timestamp,
+        captured.frame, captured.imageGray, timestamp,
         [&](OSVR_ChannelCount sensor, OSVR_Pose3 const &pose) {
 
             //==================================================================
@@ -217,8 +317,48 @@ inline OSVR_ReturnCode VideoBasedHMDTracker::update() {
         }
         osvrDeviceAnalogSetValuesTimestamped(m_dev, m_analog, data, n, &now);
     }
+    if (m_params.reportStageTimings) {
+        m_accumulateTimings(captured, queueTime);
+    }
+}
 
-    return OSVR_RETURN_SUCCESS;
+inline void VideoBasedHMDTracker::m_accumulateTimings(
+    osvr::vbtracker::CapturedFrame const &captured, double queueTime) {
+    static const std::size_t FRAMES_PER_REPORT = 100;
+    if (m_timedFrames == 0) {
+        m_timingStart = osvr::util::time::getNow();
+    }
+    auto const &stages = m_vbtracker.getLastStageTimings();
+    ++m_timedFrames;
+    m_grabTotal += captured.grabTime;
+    m_retrieveTotal += captured.retrieveTime;
+    m_queueTotal += queueTime;
+    m_stageTotals.blobExtraction += stages.blobExtraction;
+    m_stageTotals.ledIdentification += stages.ledIdentification;
+    m_stageTotals.poseEstimation += stages.poseEstimation;
+    if (m_timedFrames < FRAMES_PER_REPORT) {
+        return;
+    }
+    auto elapsed = osvr::util::time::duration(osvr::util::time::getNow(),
+                                              m_timingStart);
+    auto ms = [&](double total) { return total * 1000. / m_timedFrames; };
+    std::cout << "Video-based tracker: " << m_timedFrames / elapsed
+              << " frames/s processed"
+              << (m_params.pipelined ? " (pipelined)" : "")
+              << ", mean ms per frame: grab " << ms(m_grabTotal)
+              << ", retrieve " << ms(m_retrieveTotal) << ", queued "
+              << ms(m_queueTotal) << ", blobs "
+              << ms(m_stageTotals.blobExtraction) << ", LED identification "
+              << ms(m_stageTotals.ledIdentification) << ", pose estimation "
+              << ms(m_stageTotals.poseEstimation);
+    if (m_params.pipelined) {
+        std::cout << "; " << m_queue.getDropped()
+                  << " frames dropped in total";
+    }
+    std::cout << std::endl;
+    m_timedFrames = 0;
+    m_grabTotal = m_retrieveTotal = m_queueTotal = 0;
+    m_stageTotals = osvr::vbtracker::VideoBasedTracker::StageTimings{};
 }
 
 class HardwareDetection {
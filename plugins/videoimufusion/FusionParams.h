@@ -32,7 +32,7 @@
 // - none
 
 // Standard includes
-// - none
+#include <cstddef>
 
 struct VideoIMUFusionParams {
     double videoPosVariance = 3.0e-4;
@@ -44,6 +44,18 @@ struct VideoIMUFusionParams {
     double damping = 0.1;
     double eyeHeight = 1.6;
     bool cameraIsForward = true;
+    /// Run the Kalman filter's predict and correct steps on each report.
+    /// Off, each report just overwrites its part of the state, and the fused
+    /// output of a video report carries the video timestamp.
+    bool kalmanPredictCorrect = false;
+    /// Video reports arrive after IMU reports sampled later than they were:
+    /// reports up to this many seconds older than the newest one are filtered
+    /// in at their own timestamp, replaying the newer reports after them. 0
+    /// filters in every report in arrival order.
+    double maxReportLag = 0.05;
+    /// The most newer reports replayed for one late report: a report later
+    /// than that is filtered in in arrival order instead.
+    std::size_t maxReplayedReports = 32;
 };
 
 #endif // INCLUDED_FusionParams_h_GUID_BD4F7F35_7854_4C9C_F4FF_73F62D33287D
@@ -37,9 +37,13 @@
 #include <json/reader.h>
 
 // Standard includes
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <string>
 #include <iostream>
 #include <fstream>
+#include <vector>
 
 namespace ei = osvr::util::eigen_interop;
 
@@ -114,11 +118,197 @@ void processReports(Json::Value const &log) {
         reportNumber++;
     }
 }
+/// The outcome of feeding a log to the fusion filter in some order, non-quiet
+/// about only the running state.
+struct ReplayRun {
+    /// Index (in the log) of the report that switched fusion to running.
+    std::size_t firstRunningReport = 0;
+    /// Fused pose after each IMU report handled while running, by index in
+    /// the log.
+    std::vector<OSVR_PoseState> poses;
+    std::vector<bool> gotPose;
+    /// Fused pose after each video report handled while running, by index in
+    /// the log of the newest IMU report handled before it, whose time the
+    /// state is then current as of.
+    std::vector<OSVR_PoseState> posesAfterVideo;
+    std::vector<bool> gotPoseAfterVideo;
+    /// Time spent handling reports while running, in microseconds.
+    std::vector<double> reportTimes;
+    VideoIMUFusion::ReplayStats stats;
+};
+
+/// Feeds the reports of the log, in the given order, to the fusion filter.
+static ReplayRun runInOrder(Json::Value const &log,
+                            std::vector<Json::ArrayIndex> const &order,
+                            VideoIMUFusionParams const &params) {
+    VideoIMUFusion fusion(params);
+    ReplayRun ret;
+    ret.poses.resize(log.size());
+    ret.gotPose.resize(log.size(), false);
+    ret.posesAfterVideo.resize(log.size());
+    ret.gotPoseAfterVideo.resize(log.size(), false);
+    bool gotOri = false;
+    Json::ArrayIndex lastIMU = 0;
+    OSVR_OrientationReport ori;
+    for (auto i : order) {
+        auto &report = log[i];
+        auto timestamp = osvr::common::timevalueFromJson(report["timestamp"]);
+        Eigen::Quaterniond quat =
+            osvr::common::quatFromJson(report["rotation"]);
+        auto wasRunning = fusion.running();
+        auto start = std::chrono::steady_clock::now();
+        bool isIMU = report["path"] == IMU_PATH;
+        if (isIMU) {
+            gotOri = true;
+            ei::map(ori.rotation) = quat;
+            fusion.handleIMUData(timestamp, ori);
+        } else {
+            OSVR_PoseReport pose;
+            ei::map(pose.pose).translation() =
+                osvr::common::vec3FromJson(report["translation"]);
+            ei::map(pose.pose).rotation() = quat;
+            if (wasRunning) {
+                fusion.handleVideoTrackerDataWhileRunning(timestamp, pose);
+            } else if (gotOri) {
+                fusion.handleVideoTrackerDataDuringStartup(timestamp, pose,
+                                                           ori.rotation);
+                if (fusion.running()) {
+                    ret.firstRunningReport = i;
+                }
+            }
+        }
+        if (!wasRunning) {
+            continue;
+        }
+        ret.reportTimes.push_back(std::chrono::duration<double, std::micro>(
+                                      std::chrono::steady_clock::now() - start)
+                                      .count());
+        if (isIMU) {
+            ret.poses[i] = fusion.getLatestPose();
+            ret.gotPose[i] = true;
+            lastIMU = i;
+        } else {
+            ret.posesAfterVideo[lastIMU] = fusion.getLatestPose();
+            ret.gotPoseAfterVideo[lastIMU] = true;
+        }
+    }
+    if (fusion.running()) {
+        ret.stats = fusion.getReplayStats();
+    }
+    return ret;
+}
+
+static void printCost(const char label[], ReplayRun &run) {
+    auto &times = run.reportTimes;
+    if (times.empty()) {
+        return;
+    }
+    std::sort(times.begin(), times.end());
+    double total = 0;
+    for (auto t : times) {
+        total += t;
+    }
+    std::cout << label << ": " << times.size()
+              << " reports while running, mean " << total / times.size()
+              << " us, 99th percentile " << times[times.size() * 99 / 100]
+              << " us, max " << times.back() << " us per report; "
+              << run.stats.lateReports << " late reports filtered in at "
+              << "their own timestamp, replaying "
+              << run.stats.replayedReports << " reports; "
+              << run.stats.tooLateReports << " too late to do so"
+              << std::endl;
+}
+
+/// Compares poses to those of the reference run after the same IMU reports.
+static void printError(const char label[],
+                       std::vector<OSVR_PoseState> const &poses,
+                       std::vector<bool> const &gotPose,
+                       ReplayRun const &reference) {
+    double squaredPos = 0;
+    double squaredAngle = 0;
+    double maxPos = 0;
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < poses.size(); ++i) {
+        if (!gotPose[i] || !reference.gotPose[i]) {
+            continue;
+        }
+        auto pos = (ei::map(poses[i].translation) -
+                    ei::map(reference.poses[i].translation))
+                       .norm();
+        auto angle = Eigen::Quaterniond(ei::map(poses[i].rotation))
+                         .angularDistance(Eigen::Quaterniond(
+                             ei::map(reference.poses[i].rotation)));
+        squaredPos += pos * pos;
+        squaredAngle += angle * angle;
+        maxPos = std::max(maxPos, pos);
+        ++n;
+    }
+    if (0 == n) {
+        std::cout << label << ": no poses to compare" << std::endl;
+        return;
+    }
+    std::cout << label << ": over " << n
+              << " fused poses, position RMS deviation "
+              << 1000. * std::sqrt(squaredPos / n) << " mm (max "
+              << 1000. * maxPos << " mm), orientation RMS deviation "
+              << std::sqrt(squaredAngle / n) * 180. / M_PI << " deg"
+              << std::endl;
+}
+
+/// Quantifies what filtering in late reports at their own timestamp gains
+/// over doing so in arrival order, and what it costs. The reference is the
+/// filter fed the reports in timestamp order, as though none were late.
+static void compareReplay(Json::Value const &log) {
+    std::vector<Json::ArrayIndex> arrival;
+    for (Json::ArrayIndex i = 0; i < log.size(); ++i) {
+        arrival.push_back(i);
+    }
+    // Overwriting the state leaves little for lateness to bias, so compare
+    // with the filter's predict and correct steps on.
+    VideoIMUFusionParams inOrderParams;
+    inOrderParams.kalmanPredictCorrect = true;
+    inOrderParams.maxReportLag = 0;
+    VideoIMUFusionParams replayParams;
+    replayParams.kalmanPredictCorrect = true;
+
+    auto inOrder = runInOrder(log, arrival, inOrderParams);
+    auto replay = runInOrder(log, arrival, replayParams);
+
+    // Start up the same way as the others, then sort the rest by timestamp.
+    auto sorted = arrival;
+    auto timestampOf = [&](Json::ArrayIndex i) {
+        return osvr::common::timevalueFromJson(log[i]["timestamp"]);
+    };
+    std::stable_sort(
+        sorted.begin() + inOrder.firstRunningReport + 1, sorted.end(),
+        [&](Json::ArrayIndex a, Json::ArrayIndex b) {
+            return timestampOf(a) < timestampOf(b);
+        });
+    auto reference = runInOrder(log, sorted, inOrderParams);
+
+    std::cout << "Compared to reports filtered in in timestamp order, once "
+                 "the late reports have arrived:"
+              << std::endl;
+    printError("Arrival order", inOrder.posesAfterVideo,
+               inOrder.gotPoseAfterVideo, reference);
+    printError("Late reports replayed", replay.posesAfterVideo,
+               replay.gotPoseAfterVideo, reference);
+    std::cout << "Compared to reports filtered in in timestamp order, at "
+                 "each IMU report (some late reports still to come):"
+              << std::endl;
+    printError("Arrival order", inOrder.poses, inOrder.gotPose, reference);
+    printError("Late reports replayed", replay.poses, replay.gotPose,
+               reference);
+    printCost("Arrival order", inOrder);
+    printCost("Late reports replayed", replay);
+}
+
 int main(int argc, char *argv[]) {
     if (argc < 2) {
         std::cerr << "Must pass the path to the input file!" << std::endl;
         return -1;
     }
+    bool replay = argc > 2 && std::string{argv[2]} == "replay";
     Json::Value log;
     {
         auto fn = std::string{argv[1]};
@@ -136,6 +326,10 @@ int main(int argc, char *argv[]) {
         }
     }
     try {
+        if (replay) {
+            compareReplay(log);
+            return 0;
+        }
         processReports(log);
     } catch (std::exception const &e) {
         std::cerr << "Exception: " << e.what() << std::endl;
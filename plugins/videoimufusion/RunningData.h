@@ -47,12 +47,10 @@ inline void dumpKalmanDebugOuput(const char name[], const char expr[],
 #include <osvr/Util/TimeValue.h>
 
 #include <osvr/Kalman/PoseDampedConstantVelocity.h>
-#if 0
 #include <osvr/Kalman/FlexibleKalmanFilter.h>
 #include <osvr/Kalman/AbsoluteOrientationMeasurement.h>
 #include <osvr/Kalman/AbsolutePositionMeasurement.h>
 #include <osvr/Kalman/AngularVelocityMeasurement.h>
-#endif
 
 #include <osvr/Util/Verbosity.h>
 
@@ -60,18 +58,17 @@ inline void dumpKalmanDebugOuput(const char name[], const char expr[],
 // - none
 
 // Standard includes
-// - none
+#include <deque>
+#include <vector>
 
 using ProcessModel = osvr::kalman::PoseDampedConstantVelocityProcessModel;
 using FilterState = ProcessModel::State;
-#if 0
 using AbsoluteOrientationMeasurement =
     osvr::kalman::AbsoluteOrientationMeasurement<FilterState>;
 using AbsolutePositionMeasurement =
     osvr::kalman::AbsolutePositionMeasurement<FilterState>;
 using AngularVelocityMeasurement =
     osvr::kalman::AngularVelocityMeasurement<FilterState>;
-#endif
 class VideoIMUFusion::RunningData {
   public:
     EIGEN_MAKE_ALIGNED_OPERATOR_NEW
@@ -91,6 +88,12 @@ class VideoIMUFusion::RunningData {
     /// Returns true if we succeeded and can filter in some data.
     bool preReport(const OSVR_TimeValue &timestamp);
 
+    /// Timestamp of the newest report filtered in, which the state is
+    /// current as of.
+    OSVR_TimeValue const &getLastTime() const { return m_last; }
+
+    ReplayStats const &getReplayStats() const { return m_replayStats; }
+
     Eigen::Quaterniond getOrientation() const {
         return state().getQuaternion();
     }
@@ -105,20 +108,60 @@ class VideoIMUFusion::RunningData {
     }
 
   private:
+    /// A report, as kept in the history to be replayed.
+    struct Input {
+        enum class Kind { IMUOrientation, IMUAngularVelocity, VideoPosition };
+        Kind kind;
+        OSVR_TimeValue timestamp;
+        Eigen::Quaterniond orientation;
+        Eigen::Vector3d vec;
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+    };
+    /// An input along with the filter state from just before it was applied.
+    struct HistoryEntry {
+        Input input;
+        FilterState stateBefore;
+        OSVR_TimeValue lastBefore;
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+    };
+    using InputVector =
+        std::vector<Input, Eigen::aligned_allocator<Input>>;
+    using History =
+        std::deque<HistoryEntry, Eigen::aligned_allocator<HistoryEntry>>;
+
+    /// Filters in a report: one older than the newest report in the history
+    /// is applied at its own timestamp, restoring the state from before that
+    /// point and replaying the newer reports after it.
+    void handleInput(Input const &input);
+    /// Records the input in the history, then applies it to the state.
+    void applyAndRecord(Input const &input);
+    /// The actual predict and correct steps for an input.
+    void apply(Input const &input);
+    /// Drops history older than the lag window or the replay budget.
+    void trimHistory();
+
     FilterState &state() { return m_state; }
     FilterState const &state() const { return m_state; }
     ProcessModel &processModel() { return m_processModel; }
     ProcessModel const &processModel() const { return m_processModel; }
     ProcessModel m_processModel;
     FilterState m_state;
-#if 0
     AbsoluteOrientationMeasurement m_imuMeas;
     AngularVelocityMeasurement m_imuMeasVel;
-    AbsoluteOrientationMeasurement m_cameraMeasOri;
     AbsolutePositionMeasurement m_cameraMeasPos;
-#endif
     const Eigen::Isometry3d m_rTc;
     OSVR_TimeValue m_last;
+    const bool m_kalmanPredictCorrect;
+
+    /// @name Fixed-lag replay
+    /// @{
+    const double m_maxReportLag;
+    const std::size_t m_maxReplayedReports;
+    History m_history;
+    /// Scratch space for the inputs being replayed.
+    InputVector m_replay;
+    ReplayStats m_replayStats;
+    /// @}
 };
 
 #endif // INCLUDED_RunningData_h_GUID_6B3479E5_9D56_4BA9_DEC0_84AF53842168
@@ -42,17 +42,29 @@ namespace ei = osvr::util::eigen_interop;
 
 void VideoIMUFusion::RunningData::handleIMUReport(
     const OSVR_TimeValue &timestamp, const OSVR_OrientationReport &report) {
-    state().setQuaternion(ei::map(report.rotation));
+    Input input;
+    input.kind = Input::Kind::IMUOrientation;
+    input.timestamp = timestamp;
+    input.orientation = ei::map(report.rotation);
+    handleInput(input);
 }
 
 void VideoIMUFusion::RunningData::handleIMUVelocity(
     const OSVR_TimeValue &timestamp, const Eigen::Vector3d &angVel) {
-    state().angularVelocity() = angVel;
+    Input input;
+    input.kind = Input::Kind::IMUAngularVelocity;
+    input.timestamp = timestamp;
+    input.vec = angVel;
+    handleInput(input);
 }
 
 void VideoIMUFusion::RunningData::handleVideoTrackerReport(
     const OSVR_TimeValue &timestamp, const OSVR_PoseReport &report) {
-    state().position() = takeCameraPoseToRoom(report.pose).translation();
+    Input input;
+    input.kind = Input::Kind::VideoPosition;
+    input.timestamp = timestamp;
+    input.vec = takeCameraPoseToRoom(report.pose).translation();
+    handleInput(input);
 }
 
 /// Returns true if we succeeded and can filter in some data.
@@ -60,6 +72,116 @@ bool VideoIMUFusion::RunningData::preReport(const OSVR_TimeValue &timestamp) {
     auto dt = duration(timestamp, m_last);
     if (dt > 0) {
         m_last = timestamp;
+        if (m_kalmanPredictCorrect) {
+            osvr::kalman::predict(state(), processModel(), dt);
+            state().externalizeRotation();
+        }
     }
     return true;
 }
+
+void VideoIMUFusion::RunningData::handleInput(Input const &input) {
+#ifdef OSVR_FPE
+    FPExceptionEnabler fpe;
+#endif
+    if (m_history.empty() ||
+        !(input.timestamp < m_history.back().input.timestamp)) {
+        // In order, the usual case.
+        applyAndRecord(input);
+        trimHistory();
+        return;
+    }
+
+    // Late: find the first report newer than this one.
+    auto it = m_history.end();
+    std::size_t newer = 0;
+    while (it != m_history.begin() &&
+           input.timestamp < (it - 1)->input.timestamp &&
+           newer <= m_maxReplayedReports) {
+        --it;
+        ++newer;
+    }
+    if (newer > m_maxReplayedReports || input.timestamp < it->lastBefore) {
+        // Out of budget or history: filter it in as though it were current.
+        m_replayStats.tooLateReports++;
+        applyAndRecord(input);
+        trimHistory();
+        return;
+    }
+
+    // Rewind to just before the first newer report...
+    m_replay.clear();
+    for (auto replayIt = it; replayIt != m_history.end(); ++replayIt) {
+        m_replay.push_back(replayIt->input);
+    }
+    m_state = it->stateBefore;
+    m_last = it->lastBefore;
+    m_history.erase(it, m_history.end());
+
+    // ...filter this one in, then the newer ones again.
+    applyAndRecord(input);
+    for (auto const &replayed : m_replay) {
+        applyAndRecord(replayed);
+    }
+    m_replayStats.lateReports++;
+    m_replayStats.replayedReports += m_replay.size();
+    trimHistory();
+}
+
+void VideoIMUFusion::RunningData::applyAndRecord(Input const &input) {
+    if (m_maxReportLag > 0) {
+        m_history.emplace_back();
+        auto &entry = m_history.back();
+        entry.input = input;
+        entry.stateBefore = m_state;
+        entry.lastBefore = m_last;
+    }
+    apply(input);
+}
+
+void VideoIMUFusion::RunningData::apply(Input const &input) {
+    if (!preReport(input.timestamp)) {
+        return;
+    }
+    if (!m_kalmanPredictCorrect) {
+        switch (input.kind) {
+        case Input::Kind::IMUOrientation:
+            state().setQuaternion(input.orientation);
+            break;
+        case Input::Kind::IMUAngularVelocity:
+            state().angularVelocity() = input.vec;
+            break;
+        case Input::Kind::VideoPosition:
+            state().position() = input.vec;
+            break;
+        }
+        return;
+    }
+    switch (input.kind) {
+    case Input::Kind::IMUOrientation:
+        m_imuMeas.setMeasurement(input.orientation);
+        osvr::kalman::correct(state(), processModel(), m_imuMeas);
+        break;
+    case Input::Kind::IMUAngularVelocity:
+        m_imuMeasVel.setMeasurement(input.vec);
+        osvr::kalman::correct(state(), processModel(), m_imuMeasVel);
+        break;
+    case Input::Kind::VideoPosition:
+        m_cameraMeasPos.setMeasurement(input.vec);
+        osvr::kalman::correct(state(), processModel(), m_cameraMeasPos);
+        break;
+    }
+}
+
+void VideoIMUFusion::RunningData::trimHistory() {
+    if (m_history.empty()) {
+        return;
+    }
+    auto const newest = m_history.back().input.timestamp;
+    while (!m_history.empty() &&
+           (m_history.size() > m_maxReplayedReports ||
+            duration(newest, m_history.front().input.timestamp) >
+                m_maxReportLag)) {
+        m_history.pop_front();
+    }
+}
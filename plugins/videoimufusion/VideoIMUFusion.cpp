@@ -72,6 +72,12 @@ VideoIMUFusion::getErrorCovariance() const {
     return m_runningData->getErrorCovariance();
 }
 
+VideoIMUFusion::ReplayStats const &VideoIMUFusion::getReplayStats() const {
+    BOOST_ASSERT_MSG(running(),
+                     "Only valid if fusion is in the running state!");
+    return m_runningData->getReplayStats();
+}
+
 void VideoIMUFusion::enterRunningState(
     Eigen::Isometry3d const &rTc, const OSVR_TimeValue &timestamp,
     const OSVR_PoseReport &report, const OSVR_OrientationState &orientation) {
@@ -143,7 +149,13 @@ void VideoIMUFusion::handleVideoTrackerDataWhileRunning(
     // Pass this along to the filter
     m_runningData->handleVideoTrackerReport(timestamp, report);
 
-    updateFusedOutput(timestamp);
+    if (m_params.kalmanPredictCorrect) {
+        // A late report gets filtered in at its own timestamp, but the
+        // state is then predicted to that of the newest report.
+        updateFusedOutput(m_runningData->getLastTime());
+    } else {
+        updateFusedOutput(timestamp);
+    }
     // For debugging, we will output a second sensor that is just the
     // video tracker data re-oriented.
     Eigen::Isometry3d videoPose =
@@ -37,6 +37,7 @@
 // Standard includes
 #include <memory>
 #include <cassert>
+#include <cstddef>
 
 /// The core of the fusion code - doesn't deal with getting data in or reporting
 /// it out, for easier use in testing.
@@ -100,6 +101,22 @@ class VideoIMUFusion {
     /// Only valid once running state is entered!
     Eigen::Matrix<double, 12, 12> const &getErrorCovariance() const;
 
+    /// Counts of what it took to filter in reports that arrived after newer
+    /// ones.
+    struct ReplayStats {
+        /// Reports filtered in at their own timestamp.
+        std::size_t lateReports = 0;
+        /// Newer reports replayed to do so.
+        std::size_t replayedReports = 0;
+        /// Reports too old for the history kept or the replay budget, so
+        /// filtered in in arrival order.
+        std::size_t tooLateReports = 0;
+    };
+
+    /// Returns the counts of late reports handled
+    /// Only valid once running state is entered!
+    ReplayStats const &getReplayStats() const;
+
   private:
     void enterCameraPoseAcquisitionState();
     void enterRunningState(Eigen::Isometry3d const &rTc,
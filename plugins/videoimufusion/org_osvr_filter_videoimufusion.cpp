@@ -98,6 +98,16 @@ class AnalysisPluginInstantiation {
             root.get("eyeHeight", fusionParams.eyeHeight).asDouble();
         fusionParams.cameraIsForward =
             root.get("cameraIsForward", fusionParams.cameraIsForward).asBool();
+        fusionParams.kalmanPredictCorrect =
+            root.get("kalmanPredictCorrect",
+                     fusionParams.kalmanPredictCorrect)
+                .asBool();
+        fusionParams.maxReportLag =
+            root.get("maxReportLag", fusionParams.maxReportLag).asDouble();
+        fusionParams.maxReplayedReports =
+            root.get("maxReplayedReports",
+                     Json::UInt(fusionParams.maxReplayedReports))
+                .asUInt();
 
         osvr::pluginkit::PluginContext context(ctx);
 
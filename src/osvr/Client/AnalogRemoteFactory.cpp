@@ -57,12 +57,23 @@ namespace client {
     class VRPNAnalogHandler : public RemoteHandler {
       public:
         typedef util::ValueOrRange<int> RangeType;
-        VRPNAnalogHandler(vrpn_ConnectionPtr const &conn, const char *src,
-                          boost::optional<int> sensor,
+        VRPNAnalogHandler(AnalogRemoteDispatcherPtr const &remote,
+                          const char *src, boost::optional<int> sensor,
+                          SharedReportDispatcherPtr const &reports,
                           common::InterfaceList &ifaces)
-            : m_remote(new vrpn_Analog_Remote(src, conn.get())),
-              m_internals(ifaces), m_all(!sensor.is_initialized()) {
-            m_remote->register_change_handler(this, &VRPNAnalogHandler::handle);
+            : m_remote(remote), m_internals(ifaces),
+              m_all(!sensor.is_initialized()), m_reports(reports),
+              m_fromVRPN(!reports || !reports->isInProcess()),
+              m_sensorKey(sensor.get_value_or(-1)) {
+            // A server in this process hands over every report itself.
+            if (m_fromVRPN) {
+                m_remote->reports().registerHandler(&VRPNAnalogHandler::handle,
+                                                    this, m_sensorKey);
+            }
+            if (m_reports) {
+                m_reports->registerHandler(
+                    &VRPNAnalogHandler::handleSharedReport, this);
+            }
             OSVR_DEV_VERBOSE("Constructed an AnalogHandler for " << src);
 
             if (sensor.is_initialized()) {
@@ -70,15 +81,27 @@ namespace client {
             }
         }
         virtual ~VRPNAnalogHandler() {
-            m_remote->unregister_change_handler(this,
-                                                &VRPNAnalogHandler::handle);
+            if (m_fromVRPN) {
+                m_remote->reports().unregisterHandler(
+                    &VRPNAnalogHandler::handle, this, m_sensorKey);
+            }
+            if (m_reports) {
+                m_reports->unregisterHandler(
+                    &VRPNAnalogHandler::handleSharedReport, this);
+            }
         }
 
-        static void VRPN_CALLBACK handle(void *userdata, vrpn_ANALOGCB info) {
+        static void handle(void *userdata, vrpn_ANALOGCB const &info) {
             auto self = static_cast<VRPNAnalogHandler *>(userdata);
             self->m_handle(info);
         }
-        virtual void update() { m_remote->mainloop(); }
+        static void handleSharedReport(void *userdata,
+                                       common::SharedReportRecord const &r) {
+            auto self = static_cast<VRPNAnalogHandler *>(userdata);
+            self->m_handle(r);
+        }
+        /// The shared remote gets updated by the connection collection.
+        virtual void update() {}
 
       private:
         void m_handle(vrpn_ANALOGCB const &info) {
@@ -101,17 +124,50 @@ namespace client {
             }
             for (auto sensor : m_sensors.getIntersection(
                      RangeType::RangeZeroTo(maxChannel))) {
-                OSVR_AnalogReport report;
-                report.sensor = sensor;
-                /// @todo handle transform?
-                report.state = info.channel[report.sensor];
-                m_internals.setStateAndTriggerCallbacks(timestamp, report);
+                if (m_reports && !m_filter.acceptFromVRPN(sensor, timestamp)) {
+                    // Coming through shared memory instead.
+                    continue;
+                }
+                m_report(timestamp, sensor, info.channel[sensor]);
+            }
+        }
+        void m_handle(common::SharedReportRecord const &r) {
+            if (r.kind != common::SharedReportKind::Analog) {
+                return;
             }
+            auto channel = static_cast<int>(r.sensor);
+            if (m_all) {
+                if (m_sensors.empty()) {
+                    m_sensors.setRangeMaxMin(channel);
+                } else {
+                    m_sensors.extendRangeToMax(channel);
+                }
+            } else if (m_sensors.getValue() != channel) {
+                return;
+            }
+            if (m_fromVRPN &&
+                !m_filter.acceptFromSharedMemory(r.sensor, r.timestamp)) {
+                // Already had this one through VRPN.
+                return;
+            }
+            m_report(r.timestamp, channel, r.values[0]);
+        }
+        void m_report(OSVR_TimeValue const &timestamp, int sensor,
+                      vrpn_float64 state) {
+            OSVR_AnalogReport report;
+            report.sensor = sensor;
+            /// @todo handle transform?
+            report.state = state;
+            m_internals.setStateAndTriggerCallbacks(timestamp, report);
         }
-        unique_ptr<vrpn_Analog_Remote> m_remote;
+        AnalogRemoteDispatcherPtr m_remote;
         RemoteHandlerInternals m_internals;
         bool m_all;
         RangeType m_sensors;
+        SharedReportDispatcherPtr m_reports;
+        bool m_fromVRPN;
+        SharedReportFilter m_filter;
+        int m_sensorKey;
     };
 
     AnalogRemoteFactory::AnalogRemoteFactory(
@@ -132,9 +188,11 @@ namespace client {
         auto const &devElt = source.getDeviceElement();
 
         /// @todo find out why make_shared causes a crash here
-        ret.reset(new VRPNAnalogHandler(m_conns.getConnection(devElt),
+        ret.reset(new VRPNAnalogHandler(m_conns.getAnalogRemote(devElt),
                                         devElt.getFullDeviceName().c_str(),
-                                        source.getSensorNumber(), ifaces));
+                                        source.getSensorNumber(),
+                                        m_conns.getSharedReports(devElt),
+                                        ifaces));
         return ret;
     }
 
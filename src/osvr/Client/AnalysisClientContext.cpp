@@ -54,6 +54,10 @@ namespace client {
           m_ifaceMgr(m_pathTreeOwner, m_factory,
                      *static_cast<common::ClientContext *>(this)) {
 
+        /// We're in the server process: take reports from its devices
+        /// straight from their report channels, rather than through VRPN.
+        m_vrpnConns.enableInProcessReports();
+
         /// Create all the remote handler factories.
         populateRemoteHandlerFactory(m_factory, m_vrpnConns);
 
@@ -89,6 +93,9 @@ namespace client {
 
         /// Update system device
         m_systemDevice->update();
+        /// Update the remotes shared by handlers: the connection itself is
+        /// the server's.
+        m_vrpnConns.updateRemotes();
         /// Update handlers.
         m_ifaceMgr.updateHandlers();
     }
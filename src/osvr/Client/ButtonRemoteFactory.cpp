@@ -54,12 +54,23 @@ namespace client {
         typedef util::ValueOrRange<int> RangeType;
         VRPNButtonHandler(vrpn_ConnectionPtr const &conn, const char *src,
                           boost::optional<int> sensor,
+                          SharedReportDispatcherPtr const &reports,
                           common::InterfaceList &ifaces)
             : m_remote(new vrpn_Button_Remote(src, conn.get())),
-              m_internals(ifaces), m_all(!sensor.is_initialized()) {
-            m_remote->register_change_handler(this, &VRPNButtonHandler::handle);
-            m_remote->register_states_handler(
-                this, &VRPNButtonHandler::handle_states);
+              m_internals(ifaces), m_all(!sensor.is_initialized()),
+              m_reports(reports),
+              m_fromVRPN(!reports || !reports->isInProcess()) {
+            // A server in this process hands over every change itself.
+            if (m_fromVRPN) {
+                m_remote->register_change_handler(this,
+                                                  &VRPNButtonHandler::handle);
+                m_remote->register_states_handler(
+                    this, &VRPNButtonHandler::handle_states);
+            }
+            if (m_reports) {
+                m_reports->registerHandler(
+                    &VRPNButtonHandler::handleSharedReport, this);
+            }
             OSVR_DEV_VERBOSE("Constructed a ButtonHandler for " << src);
 
             if (sensor.is_initialized()) {
@@ -67,10 +78,16 @@ namespace client {
             }
         }
         virtual ~VRPNButtonHandler() {
-            m_remote->unregister_change_handler(this,
-                                                &VRPNButtonHandler::handle);
-            m_remote->unregister_states_handler(
-                this, &VRPNButtonHandler::handle_states);
+            if (m_fromVRPN) {
+                m_remote->unregister_change_handler(
+                    this, &VRPNButtonHandler::handle);
+                m_remote->unregister_states_handler(
+                    this, &VRPNButtonHandler::handle_states);
+            }
+            if (m_reports) {
+                m_reports->unregisterHandler(
+                    &VRPNButtonHandler::handleSharedReport, this);
+            }
         }
 
         static void VRPN_CALLBACK handle(void *userdata, vrpn_BUTTONCB info) {
@@ -83,6 +100,11 @@ namespace client {
             auto self = static_cast<VRPNButtonHandler *>(userdata);
             self->m_handle(info);
         }
+        static void handleSharedReport(void *userdata,
+                                       common::SharedReportRecord const &r) {
+            auto self = static_cast<VRPNButtonHandler *>(userdata);
+            self->m_handle(r);
+        }
         virtual void update() { m_remote->mainloop(); }
 
       private:
@@ -94,7 +116,7 @@ namespace client {
             OSVR_TimeValue timestamp;
             osvrStructTimevalToTimeValue(&timestamp, &(info.msg_time));
 
-            m_report(timestamp, info.button, info.state);
+            m_reportFromVRPN(timestamp, info.button, info.state);
         }
         void m_handle(vrpn_BUTTONSTATESCB const &info) {
             auto maxChannel =
@@ -118,8 +140,29 @@ namespace client {
 
             for (auto sensor : m_sensors.getIntersection(
                      RangeType::RangeZeroTo(maxChannel))) {
-                m_report(timestamp, sensor, info.states[sensor]);
+                m_reportFromVRPN(timestamp, sensor, info.states[sensor]);
+            }
+        }
+        void m_handle(common::SharedReportRecord const &r) {
+            if (r.kind != common::SharedReportKind::Button ||
+                (!m_all && !m_sensors.contains(static_cast<int>(r.sensor)))) {
+                return;
+            }
+            if (m_fromVRPN &&
+                !m_filter.acceptFromSharedMemory(r.sensor, r.timestamp)) {
+                // Already had this one through VRPN.
+                return;
+            }
+            m_report(r.timestamp, r.sensor,
+                     static_cast<vrpn_int32>(r.values[0]));
+        }
+        void m_reportFromVRPN(OSVR_TimeValue const &timestamp, int32_t sensor,
+                              vrpn_int32 state) {
+            if (m_reports && !m_filter.acceptFromVRPN(sensor, timestamp)) {
+                // Coming through shared memory instead.
+                return;
             }
+            m_report(timestamp, sensor, state);
         }
         void m_report(OSVR_TimeValue const &timestamp, int32_t sensor,
                       vrpn_int32 state) {
@@ -132,6 +175,9 @@ namespace client {
         RemoteHandlerInternals m_internals;
         bool m_all;
         RangeType m_sensors;
+        SharedReportDispatcherPtr m_reports;
+        bool m_fromVRPN;
+        SharedReportFilter m_filter;
     };
 
     ButtonRemoteFactory::ButtonRemoteFactory(
@@ -154,7 +200,9 @@ namespace client {
         /// @todo find out why make_shared causes a crash here
         ret.reset(new VRPNButtonHandler(m_conns.getConnection(devElt),
                                         devElt.getFullDeviceName().c_str(),
-                                        source.getSensorNumber(), ifaces));
+                                        source.getSensorNumber(),
+                                        m_conns.getSharedReports(devElt),
+                                        ifaces));
         return ret;
     }
 
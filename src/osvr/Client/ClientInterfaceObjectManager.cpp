@@ -37,20 +37,21 @@
 
 // Standard includes
 #include <unordered_set>
+#include <vector>
 
 namespace osvr {
 namespace client {
     ClientInterfaceObjectManager::ClientInterfaceObjectManager(
         common::PathTreeOwner &tree, RemoteHandlerFactory &handlerFactory,
         common::ClientContext &ctx)
-        : m_pathTree(tree.get()), m_treeObserver(tree.makeObserver()),
-          m_factory(handlerFactory), m_ctx(&ctx) {
+        : m_treeOwner(tree), m_pathTree(tree.get()),
+          m_treeObserver(tree.makeObserver()), m_factory(handlerFactory),
+          m_ctx(&ctx) {
         m_treeObserver->setEventCallback(
-            common::PathTreeEvents::AboutToUpdate,
-            [&](common::PathTree &) { m_interfaces.clearHandlers(); });
-        m_treeObserver->setEventCallback(
-            common::PathTreeEvents::AfterUpdate,
-            [&](common::PathTree &) { m_connectNeededCallbacks(); });
+            common::PathTreeEvents::AfterUpdate, [&](common::PathTree &) {
+                m_removeChangedCallbacks();
+                m_connectNeededCallbacks();
+            });
     }
 
     void ClientInterfaceObjectManager::addInterface(
@@ -111,6 +112,20 @@ namespace client {
         m_interfaces.eraseHandlerForPath(path);
     }
 
+    void ClientInterfaceObjectManager::m_removeChangedCallbacks() {
+        auto changedPaths = std::vector<std::string>{};
+        m_interfaces.visitPathsWithHandlers([&](std::string const &path) {
+            if (m_treeOwner.hasResolutionChanged(path)) {
+                changedPaths.push_back(path);
+            }
+        });
+        for (auto const &path : changedPaths) {
+            m_removeCallbacksOnPath(path);
+        }
+        OSVR_DEV_VERBOSE("Tree update changed the resolution of "
+                         << changedPaths.size() << " connected paths");
+    }
+
     void ClientInterfaceObjectManager::m_connectNeededCallbacks() {
         auto failedPaths = std::unordered_set<std::string>{};
         auto successfulPaths = size_t{0};
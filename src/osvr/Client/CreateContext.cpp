@@ -36,15 +36,15 @@
 
 namespace osvr {
 namespace client {
-    common::ClientContext *createContext(const char appId[],
-                                         const char host[]) {
+    common::ClientContext *createContext(const char appId[], const char host[],
+                                         std::uint32_t flags) {
         common::ClientContext *ret = nullptr;
         if (!appId || std::strlen(appId) == 0) {
             OSVR_DEV_VERBOSE("Could not create client context - null or empty "
                              "appId provided!");
             return ret;
         }
-        ret = common::makeContext<PureClientContext>(appId, host);
+        ret = common::makeContext<PureClientContext>(appId, host, flags);
         return ret;
     }
 
@@ -32,6 +32,7 @@
 #include <osvr/Common/ClientInterface.h>
 #include <osvr/Util/Verbosity.h>
 #include <osvr/Common/DeduplicatingFunctionWrapper.h>
+#include <osvr/Client/CreateContext.h>
 
 #include <boost/algorithm/string.hpp>
 
@@ -83,12 +84,19 @@ namespace client {
     static const std::chrono::milliseconds STARTUP_CONNECT_TIMEOUT(200);
     static const std::chrono::milliseconds STARTUP_TREE_TIMEOUT(1000);
     static const std::chrono::milliseconds STARTUP_LOOP_SLEEP(1);
+    static const std::chrono::milliseconds UPDATE_THREAD_SLEEP(1);
+    /// @brief Longest the update thread blocks on the connections' sockets,
+    /// in microseconds, so that it also picks up new connections and
+    /// reconnection attempts.
+    static const int UPDATE_THREAD_MAX_WAIT = 100000;
 
     PureClientContext::PureClientContext(const char appId[], const char host[],
+                                         std::uint32_t flags,
                                          common::ClientContextDeleter del)
         : ::OSVR_ClientContextObject(appId, del), m_host(host),
           m_ifaceMgr(m_pathTreeOwner, m_factory,
-                     *static_cast<common::ClientContext *>(this)) {
+                     *static_cast<common::ClientContext *>(this)),
+          m_stopUpdateThread(false) {
 
         if (!m_network.isUp()) {
             throw std::runtime_error("Network error: " + m_network.getError());
@@ -123,6 +131,17 @@ namespace client {
                 m_pathTreeOwner.replaceTree(nodes);
             }));
 
+        // The startup spin stays on this thread, so the context comes back
+        // connected (if it can be) either way.
+        m_waitForStartup();
+
+        if (flags & CONTEXT_UPDATE_THREAD) {
+            m_enableUpdateThread((flags & CONTEXT_DEFER_CALLBACKS) != 0);
+            m_updateThread = std::thread([&] { m_updateThreadLoop(); });
+        }
+    }
+
+    void PureClientContext::m_waitForStartup() {
         typedef std::chrono::system_clock clock;
         auto begin = clock::now();
 
@@ -160,7 +179,35 @@ namespace client {
             << (m_pathTreeOwner ? "have path tree" : "don't have path tree"));
     }
 
-    PureClientContext::~PureClientContext() {}
+    PureClientContext::~PureClientContext() {
+        if (m_updateThread.joinable()) {
+            m_stopUpdateThread = true;
+            m_updateWakeup.signal();
+            m_updateThread.join();
+        }
+    }
+
+    void PureClientContext::m_updateThreadLoop() {
+        while (!m_stopUpdateThread) {
+            bool canWait;
+            {
+                auto lock = lockUpdates();
+                m_runUpdate();
+                m_updateSockets.clear();
+                canWait = m_vrpnConns.appendSockets(m_updateSockets) &&
+                          m_updateWakeup.isValid();
+            }
+            // Reports come in over the sockets (shared-memory ones too have
+            // a VRPN copy on the way), so block on them, unlocked, rather
+            // than spin. Otherwise, poll, leaving a gap for the app's other
+            // calls into the context.
+            if (canWait) {
+                m_updateWakeup.wait(m_updateSockets, UPDATE_THREAD_MAX_WAIT);
+            } else {
+                std::this_thread::sleep_for(UPDATE_THREAD_SLEEP);
+            }
+        }
+    }
 
     void PureClientContext::m_update() {
         /// Mainloop connections
@@ -38,6 +38,7 @@
 #include <osvr/Client/RemoteHandlerFactory.h>
 #include <osvr/Client/ClientInterfaceObjectManager.h>
 #include <osvr/Common/PathTreeOwner.h>
+#include <osvr/Common/WakeupSocket.h>
 
 // Library/third-party includes
 #include <vrpn_ConnectionPtr.h>
@@ -45,6 +46,10 @@
 
 // Standard includes
 #include <string>
+#include <atomic>
+#include <thread>
+#include <cstdint>
+#include <vector>
 
 namespace osvr {
 namespace client {
@@ -54,10 +59,20 @@ namespace client {
         PureClientContext(const char appId[], common::ClientContextDeleter del)
             : PureClientContext(appId, "localhost", del) {}
         PureClientContext(const char appId[], const char host[],
+                          common::ClientContextDeleter del)
+            : PureClientContext(appId, host, 0, del) {}
+        /// @param flags Bitwise-or of ContextFlags
+        PureClientContext(const char appId[], const char host[],
+                          std::uint32_t flags,
                           common::ClientContextDeleter del);
         virtual ~PureClientContext();
         EIGEN_MAKE_ALIGNED_OPERATOR_NEW
       private:
+        /// @brief Updates until connected and with a path tree, or until
+        /// timing out.
+        void m_waitForStartup();
+        /// @brief Body of the update thread, if we have one.
+        void m_updateThreadLoop();
         virtual void m_update();
         virtual void m_sendRoute(std::string const &route);
 
@@ -114,6 +129,17 @@ namespace client {
         /// @brief Manager of client interface objects and their interaction
         /// with the path tree.
         ClientInterfaceObjectManager m_ifaceMgr;
+
+        /// @brief Signalled to end the update thread's wait early.
+        common::WakeupSocket m_updateWakeup;
+
+        /// @brief Sockets the update thread waits on, kept to reuse their
+        /// storage.
+        std::vector<SOCKET> m_updateSockets;
+
+        /// @brief Thread running updates, if requested at construction.
+        std::thread m_updateThread;
+        std::atomic<bool> m_stopUpdateThread;
     };
 } // namespace client
 } // namespace osvr
@@ -0,0 +1,176 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_SensorDispatchTable_h_GUID_5ADCEF82_02CE_4513_A87D_E9FBEC6951E2
+#define INCLUDED_SensorDispatchTable_h_GUID_5ADCEF82_02CE_4513_A87D_E9FBEC6951E2
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace osvr {
+namespace client {
+    /// @brief Handlers for one kind of report from a device, indexed by the
+    /// sensor they want, so that passing on a report costs a lookup rather
+    /// than a call to (and a check by) every handler for the device.
+    template <typename ReportType> class SensorDispatchTable {
+      public:
+        typedef void (*Handler)(void *userdata, ReportType const &report);
+
+        /// @brief The sensor to give to get reports for all sensors.
+        static const int ALL_SENSORS = -1;
+
+        void registerHandler(Handler handler, void *userdata, int sensor) {
+            m_getList(sensor).emplace_back(handler, userdata);
+        }
+
+        void unregisterHandler(Handler handler, void *userdata, int sensor) {
+            auto &handlers = m_getList(sensor);
+            HandlerEntry removed(handler, userdata);
+            if (m_dispatching > 0) {
+                // Erasing would shift the rest down under the dispatch loop,
+                // which would then skip the next handler: mark them instead,
+                // to be compacted away once the dispatch is done.
+                for (auto &entry : handlers) {
+                    if (entry == removed) {
+                        entry.first = nullptr;
+                        m_needsCompacting = true;
+                    }
+                }
+                return;
+            }
+            handlers.erase(std::remove(begin(handlers), end(handlers), removed),
+                           end(handlers));
+        }
+
+        /// @brief Whether there's any handler at all.
+        bool empty() const {
+            return m_isEmpty(m_allSensors) &&
+                   std::all_of(begin(m_bySensor), end(m_bySensor),
+                               &SensorDispatchTable::m_isEmpty);
+        }
+
+        /// @brief One more than the highest sensor with a handler of its own
+        /// (or that has had one).
+        std::size_t sensorLimit() const { return m_bySensor.size(); }
+
+        /// @brief Calls the handlers for this sensor, then those for all
+        /// sensors.
+        void dispatch(int sensor, ReportType const &report) {
+            dispatchToSensor(sensor, report);
+            dispatchToAllSensors(report);
+        }
+
+        /// @brief Calls just the handlers registered for this sensor.
+        void dispatchToSensor(int sensor, ReportType const &report) {
+            if (sensor < 0 || std::size_t(sensor) >= m_bySensor.size()) {
+                return;
+            }
+            // Looked up each time, as a handler registering for a new sensor
+            // moves the lists.
+            m_call([&]() -> HandlerList & { return m_bySensor[sensor]; },
+                   report);
+        }
+
+        /// @brief Calls just the handlers registered for all sensors.
+        void dispatchToAllSensors(ReportType const &report) {
+            m_call([&]() -> HandlerList & { return m_allSensors; }, report);
+        }
+
+      private:
+        typedef std::pair<Handler, void *> HandlerEntry;
+        typedef std::vector<HandlerEntry> HandlerList;
+
+        HandlerList &m_getList(int sensor) {
+            if (sensor < 0) {
+                return m_allSensors;
+            }
+            if (std::size_t(sensor) >= m_bySensor.size()) {
+                m_bySensor.resize(sensor + 1);
+            }
+            return m_bySensor[sensor];
+        }
+
+        static bool m_isEmpty(HandlerList const &handlers) {
+            return std::all_of(
+                begin(handlers), end(handlers),
+                [](HandlerEntry const &entry) { return !entry.first; });
+        }
+
+        /// @brief Calls the handlers in a list, by index, as a handler may
+        /// register another (which gets called too). Those unregistered
+        /// meanwhile are null until the outermost dispatch is done.
+        template <typename GetList>
+        void m_call(GetList getList, ReportType const &report) {
+            ++m_dispatching;
+            for (std::size_t i = 0; i < getList().size(); ++i) {
+                auto entry = getList()[i];
+                if (entry.first) {
+                    entry.first(entry.second, report);
+                }
+            }
+            --m_dispatching;
+            if (m_dispatching == 0 && m_needsCompacting) {
+                m_compact();
+            }
+        }
+
+        /// @brief Drops the entries of handlers unregistered during a
+        /// dispatch.
+        void m_compact() {
+            auto removeNull = [](HandlerList &handlers) {
+                handlers.erase(
+                    std::remove_if(begin(handlers), end(handlers),
+                                   [](HandlerEntry const &entry) {
+                                       return !entry.first;
+                                   }),
+                    end(handlers));
+            };
+            removeNull(m_allSensors);
+            for (auto &handlers : m_bySensor) {
+                removeNull(handlers);
+            }
+            m_needsCompacting = false;
+        }
+
+        HandlerList m_allSensors;
+        std::vector<HandlerList> m_bySensor;
+        /// @brief Depth of nested dispatches in progress.
+        int m_dispatching = 0;
+        /// @brief Whether a handler was unregistered during a dispatch.
+        bool m_needsCompacting = false;
+    };
+
+} // namespace client
+} // namespace osvr
+
+#endif // INCLUDED_SensorDispatchTable_h_GUID_5ADCEF82_02CE_4513_A87D_E9FBEC6951E2
@@ -0,0 +1,198 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include "SharedReportDispatcher.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace client {
+    /// @brief Most records handled per update.
+    static const std::size_t MAX_RECORDS_PER_UPDATE = 256;
+
+    SharedReportDispatcherPtr
+    SharedReportDispatcher::find(std::string const &name) {
+        SharedReportDispatcherPtr ret;
+        auto channel = common::SharedReportChannel::find(name);
+        if (channel) {
+            ret.reset(new SharedReportDispatcher(channel, name, false));
+        }
+        return ret;
+    }
+
+    SharedReportDispatcherPtr
+    SharedReportDispatcher::findInProcess(std::string const &device) {
+        SharedReportDispatcherPtr ret;
+        auto channel = common::SharedReportChannel::findInProcess(device);
+        if (channel) {
+            ret.reset(new SharedReportDispatcher(channel, device, true));
+        }
+        return ret;
+    }
+
+    SharedReportDispatcher::SharedReportDispatcher(
+        common::SharedReportChannelPtr const &channel, std::string const &name,
+        bool inProcess)
+        : m_channel(channel), m_name(name), m_inProcess(inProcess) {
+        if (m_inProcess) {
+            m_channel->subscribe(&SharedReportDispatcher::m_handleInProcess,
+                                 this);
+        } else {
+            m_records.resize(MAX_RECORDS_PER_UPDATE);
+        }
+    }
+
+    SharedReportDispatcher::~SharedReportDispatcher() {
+        if (m_inProcess) {
+            m_channel->unsubscribe(&SharedReportDispatcher::m_handleInProcess,
+                                   this);
+        }
+    }
+
+    void SharedReportDispatcher::registerHandler(Handler handler,
+                                                 void *userdata) {
+        m_handlers.registerHandler(handler, userdata,
+                                   HandlerTable::ALL_SENSORS);
+    }
+
+    void SharedReportDispatcher::unregisterHandler(Handler handler,
+                                                   void *userdata) {
+        m_handlers.unregisterHandler(handler, userdata,
+                                     HandlerTable::ALL_SENSORS);
+    }
+
+    void SharedReportDispatcher::update() {
+        if (m_inProcess) {
+            return;
+        }
+        std::size_t n;
+        do {
+            // Read even without handlers, so a handler registered later
+            // doesn't get a backlog.
+            n = m_channel->poll(m_records.data(), m_records.size());
+            for (std::size_t i = 0; i < n; ++i) {
+                m_dispatch(m_records[i]);
+            }
+        } while (n == m_records.size());
+    }
+
+    bool SharedReportDispatcher::reopen() {
+        if (m_inProcess) {
+            auto channel = common::SharedReportChannel::findInProcess(m_name);
+            if (!channel) {
+                return false;
+            }
+            if (channel != m_channel) {
+                m_channel->unsubscribe(
+                    &SharedReportDispatcher::m_handleInProcess, this);
+                m_channel = channel;
+                m_channel->subscribe(&SharedReportDispatcher::m_handleInProcess,
+                                     this);
+            }
+            return true;
+        }
+        auto channel = common::SharedReportChannel::find(m_name);
+        if (!channel) {
+            return false;
+        }
+        m_channel = channel;
+        return true;
+    }
+
+    void SharedReportDispatcher::m_handleInProcess(
+        void *userdata, common::SharedReportRecord const &r) {
+        static_cast<SharedReportDispatcher *>(userdata)->m_dispatch(r);
+    }
+
+    void SharedReportDispatcher::m_dispatch(
+        common::SharedReportRecord const &r) {
+        m_handlers.dispatchToAllSensors(r);
+    }
+
+    const OSVR_TimeValue_Microseconds SharedReportFilter::STALE_AFTER_US;
+    const OSVR_ChannelCount SharedReportFilter::MAX_SENSORS;
+
+    SharedReportFilter::SensorState *
+    SharedReportFilter::m_getSensor(OSVR_ChannelCount sensor) {
+        if (sensor >= MAX_SENSORS) {
+            return nullptr;
+        }
+        if (sensor >= m_sensors.size()) {
+            SensorState initial = {false, {0, 0}, {0, 0}};
+            m_sensors.resize(sensor + 1, initial);
+        }
+        return &m_sensors[sensor];
+    }
+
+    bool SharedReportFilter::acceptFromVRPN(OSVR_ChannelCount sensor,
+                                            OSVR_TimeValue const &timestamp) {
+        auto state = m_getSensor(sensor);
+        if (!state) {
+            return true;
+        }
+        if (state->shared) {
+            OSVR_TimeValue stale = state->latestFromSharedMemory;
+            stale.microseconds += STALE_AFTER_US;
+            osvrTimeValueNormalize(&stale);
+            if (!osvrTimeValueGreater(timestamp, stale)) {
+                return false;
+            }
+            // Shared memory has gone quiet while VRPN hasn't.
+            state->shared = false;
+        }
+        if (osvrTimeValueGreater(timestamp, state->latestFromVRPN)) {
+            state->latestFromVRPN = timestamp;
+        }
+        return true;
+    }
+
+    bool SharedReportFilter::acceptFromSharedMemory(
+        OSVR_ChannelCount sensor, OSVR_TimeValue const &timestamp) {
+        auto state = m_getSensor(sensor);
+        if (!state) {
+            return false;
+        }
+        if (!state->shared) {
+            if (!osvrTimeValueGreater(timestamp, state->latestFromVRPN)) {
+                // Published before we started reading, and already
+                // delivered over VRPN.
+                return false;
+            }
+            state->shared = true;
+        }
+        if (osvrTimeValueGreater(timestamp,
+                                 state->latestFromSharedMemory)) {
+            state->latestFromSharedMemory = timestamp;
+        }
+        return true;
+    }
+
+} // namespace client
+} // namespace osvr
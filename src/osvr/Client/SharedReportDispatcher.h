@@ -0,0 +1,161 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef INCLUDED_SharedReportDispatcher_h_GUID_2AF935DA_358C_4A91_9D91_A1D8C5F932F2
+#define INCLUDED_SharedReportDispatcher_h_GUID_2AF935DA_358C_4A91_9D91_A1D8C5F932F2
+
+// Internal Includes
+#include "SensorDispatchTable.h"
+#include <osvr/Client/Export.h>
+#include <osvr/Common/SharedReportChannel.h>
+#include <osvr/Util/ChannelCountC.h>
+#include <osvr/Util/SharedPtr.h>
+#include <osvr/Util/TimeValueC.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <string>
+#include <vector>
+
+namespace osvr {
+namespace client {
+    class SharedReportDispatcher;
+    typedef shared_ptr<SharedReportDispatcher> SharedReportDispatcherPtr;
+
+    /// @brief Reads a device's shared-memory report channel and passes the
+    /// records on to the handlers registered for that device.
+    class SharedReportDispatcher {
+      public:
+        typedef void (*Handler)(void *userdata,
+                                common::SharedReportRecord const &record);
+
+        /// @brief Opens a report channel of a device served on this host, by
+        /// the shared memory name the server advertised for it.
+        ///
+        /// @return an empty pointer if the server didn't create one.
+        OSVR_CLIENT_EXPORT static SharedReportDispatcherPtr
+        find(std::string const &name);
+
+        /// @brief Subscribes to the report channel of a device served by
+        /// this very process, so records get passed on as they're published
+        /// rather than on update().
+        ///
+        /// @return an empty pointer if this process isn't serving the device.
+        static SharedReportDispatcherPtr
+        findInProcess(std::string const &device);
+
+        ~SharedReportDispatcher();
+
+        /// @brief Whether records come straight from the server in this
+        /// process: if so, they're all delivered, in order, and handlers
+        /// needn't also take (or filter out) the same reports from VRPN.
+        bool isInProcess() const { return m_inProcess; }
+
+        OSVR_CLIENT_EXPORT void registerHandler(Handler handler,
+                                                void *userdata);
+        OSVR_CLIENT_EXPORT void unregisterHandler(Handler handler,
+                                                  void *userdata);
+
+        /// @brief Dispatches all records published since the last call.
+        /// Does nothing in process.
+        OSVR_CLIENT_EXPORT void update();
+
+        /// @brief Opens the channel again by the same name, for when the
+        /// server has been restarted: a new server replaces the channel
+        /// with a new one, leaving the old one to nobody.
+        ///
+        /// @return false if there is no such channel (anymore), in which
+        /// case the old one is kept.
+        OSVR_CLIENT_EXPORT bool reopen();
+
+      private:
+        SharedReportDispatcher(common::SharedReportChannelPtr const &channel,
+                               std::string const &name, bool inProcess);
+        static void m_handleInProcess(void *userdata,
+                                      common::SharedReportRecord const &r);
+        void m_dispatch(common::SharedReportRecord const &r);
+        common::SharedReportChannelPtr m_channel;
+        /// @brief The shared memory name, or the device name in process.
+        std::string m_name;
+        bool m_inProcess;
+        /// @brief A table, for its handling of handlers unregistered while
+        /// dispatching: records have no sensor lookup, so all handlers are
+        /// for all sensors.
+        typedef SensorDispatchTable<common::SharedReportRecord> HandlerTable;
+        HandlerTable m_handlers;
+        std::vector<common::SharedReportRecord> m_records;
+    };
+
+    /// @brief Since a report may arrive both over shared memory and over
+    /// VRPN, picks which copy of each sensor's reports handlers deliver:
+    /// VRPN's until the first record for that sensor arrives over shared
+    /// memory, and from then on only shared memory's, which has every report
+    /// exactly once and in order.
+    ///
+    /// Should shared memory stop delivering (its server was restarted, say)
+    /// while VRPN still does, VRPN takes over again.
+    class SharedReportFilter {
+      public:
+        /// @brief How far (by report timestamps) VRPN has to get ahead of
+        /// the last record from shared memory for a sensor before it takes
+        /// back over.
+        static const OSVR_TimeValue_Microseconds STALE_AFTER_US = 500000;
+
+        /// @brief Sensors from this number up are always left to VRPN, so
+        /// a bogus sensor number can't make us keep state without bound.
+        static const OSVR_ChannelCount MAX_SENSORS = 1024;
+
+        /// @brief Returns true if a report from VRPN should be delivered:
+        /// that is, if shared memory hasn't taken over for this sensor, or
+        /// has stopped delivering.
+        OSVR_CLIENT_EXPORT bool
+        acceptFromVRPN(OSVR_ChannelCount sensor,
+                       OSVR_TimeValue const &timestamp);
+
+        /// @brief Returns true if a record from shared memory should be
+        /// delivered, taking over for its sensor: only until it has, records
+        /// get checked against the reports VRPN delivered, by timestamp, since
+        /// VRPN may have beaten them to it.
+        OSVR_CLIENT_EXPORT bool
+        acceptFromSharedMemory(OSVR_ChannelCount sensor,
+                               OSVR_TimeValue const &timestamp);
+
+      private:
+        struct SensorState {
+            bool shared;
+            OSVR_TimeValue latestFromVRPN;
+            OSVR_TimeValue latestFromSharedMemory;
+        };
+        /// @return nullptr if the sensor number is past MAX_SENSORS.
+        SensorState *m_getSensor(OSVR_ChannelCount sensor);
+        std::vector<SensorState> m_sensors;
+    };
+
+} // namespace client
+} // namespace osvr
+
+#endif // INCLUDED_SharedReportDispatcher_h_GUID_2AF935DA_358C_4A91_9D91_A1D8C5F932F2
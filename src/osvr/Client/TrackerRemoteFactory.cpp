@@ -50,7 +50,7 @@
 #include <json/reader.h>
 
 // Standard includes
-// - none
+#include <string>
 
 namespace ei = osvr::util::eigen_interop;
 
@@ -63,51 +63,66 @@ namespace client {
             bool reportPosition = false;
             bool reportOrientation = false;
         };
-        VRPNTrackerHandler(vrpn_ConnectionPtr const &conn, const char *src,
-                           Options const &options,
+        VRPNTrackerHandler(TrackerRemoteDispatcherPtr const &remote,
+                           const char *src, Options const &options,
                            common::TrackerSensorInfo const &info,
                            common::Transform const &t,
                            boost::optional<int> sensor,
+                           SharedReportDispatcherPtr const &reports,
                            common::InterfaceList &ifaces,
                            common::ClientContext &ctx)
-            : m_remote(new vrpn_Tracker_Remote(src, conn.get())),
-              m_transform(t), m_ctx(ctx), m_internals(ifaces), m_opts(options),
-              m_info(info), m_sensor(sensor) {
+            : m_remote(remote), m_transform(t), m_ctx(ctx),
+              m_internals(ifaces), m_opts(options), m_info(info),
+              m_sensor(sensor) {
+            auto sensorKey = m_sensor.get_value_or(-1);
             if (m_info.reportsPosition || m_info.reportsOrientation) {
-                m_remote->register_change_handler(this,
-                                                  &VRPNTrackerHandler::handle,
-                                                  m_sensor.get_value_or(-1));
+                // Poses from a server on this host come through shared
+                // memory too: we take whichever copy comes first - unless
+                // the server is in this process, in which case every pose
+                // comes straight from it and VRPN isn't needed at all.
+                m_reports = reports;
+                m_posesFromVRPN = !m_reports || !m_reports->isInProcess();
+                if (m_posesFromVRPN) {
+                    m_remote->poses().registerHandler(
+                        &VRPNTrackerHandler::handle, this, sensorKey);
+                }
+                if (m_reports) {
+                    m_reports->registerHandler(
+                        &VRPNTrackerHandler::handleSharedReport, this);
+                }
             }
             if (m_info.reportsLinearVelocity || m_info.reportsAngularVelocity) {
-                m_remote->register_change_handler(
-                    this, &VRPNTrackerHandler::handleVel,
-                    m_sensor.get_value_or(-1));
+                m_remote->velocities().registerHandler(
+                    &VRPNTrackerHandler::handleVel, this, sensorKey);
             }
             if (m_info.reportsLinearAcceleration ||
                 m_info.reportsAngularAcceleration) {
-                m_remote->register_change_handler(
-                    this, &VRPNTrackerHandler::handleAccel,
-                    m_sensor.get_value_or(-1));
+                m_remote->accelerations().registerHandler(
+                    &VRPNTrackerHandler::handleAccel, this, sensorKey);
             }
             OSVR_DEV_VERBOSE("Constructed a TrackerHandler for "
                              << src << " sensor " << m_sensor.get_value_or(-1));
         }
         virtual ~VRPNTrackerHandler() {
+            auto sensorKey = m_sensor.get_value_or(-1);
             if (m_info.reportsPosition || m_info.reportsOrientation) {
-                m_remote->unregister_change_handler(this,
-                                                    &VRPNTrackerHandler::handle,
-                                                    m_sensor.get_value_or(-1));
+                if (m_posesFromVRPN) {
+                    m_remote->poses().unregisterHandler(
+                        &VRPNTrackerHandler::handle, this, sensorKey);
+                }
+                if (m_reports) {
+                    m_reports->unregisterHandler(
+                        &VRPNTrackerHandler::handleSharedReport, this);
+                }
             }
             if (m_info.reportsLinearVelocity || m_info.reportsAngularVelocity) {
-                m_remote->unregister_change_handler(
-                    this, &VRPNTrackerHandler::handleVel,
-                    m_sensor.get_value_or(-1));
+                m_remote->velocities().unregisterHandler(
+                    &VRPNTrackerHandler::handleVel, this, sensorKey);
             }
             if (m_info.reportsLinearAcceleration ||
                 m_info.reportsAngularAcceleration) {
-                m_remote->unregister_change_handler(
-                    this, &VRPNTrackerHandler::handleAccel,
-                    m_sensor.get_value_or(-1));
+                m_remote->accelerations().unregisterHandler(
+                    &VRPNTrackerHandler::handleAccel, this, sensorKey);
             }
         }
 
@@ -119,33 +134,64 @@ namespace client {
             return ret;
         }
 
-        static void VRPN_CALLBACK handle(void *userdata, vrpn_TRACKERCB info) {
+        static void handle(void *userdata, TrackerPoseInfo const &info) {
             auto self = static_cast<VRPNTrackerHandler *>(userdata);
-            self->m_handle(info);
+            if (self->m_reports &&
+                !self->m_poseFilter.acceptFromVRPN(info.sensor,
+                                                   info.timestamp)) {
+                // Coming through shared memory instead.
+                return;
+            }
+            self->m_handlePose(info.timestamp, info.sensor, info.pose,
+                               self->getCurrentTransform());
+        }
+        static void handleSharedReport(void *userdata,
+                                       common::SharedReportRecord const &r) {
+            auto self = static_cast<VRPNTrackerHandler *>(userdata);
+            self->m_handleSharedReport(r);
         }
-        static void VRPN_CALLBACK handleVel(void *userdata,
-                                            vrpn_TRACKERVELCB info) {
+        static void handleVel(void *userdata, vrpn_TRACKERVELCB const &info) {
             auto self = static_cast<VRPNTrackerHandler *>(userdata);
             self->m_handle(info);
         }
-        static void VRPN_CALLBACK handleAccel(void *userdata,
-                                              vrpn_TRACKERACCCB info) {
+        static void handleAccel(void *userdata,
+                                vrpn_TRACKERACCCB const &info) {
             auto self = static_cast<VRPNTrackerHandler *>(userdata);
             self->m_handle(info);
         }
-        virtual void update() { m_remote->mainloop(); }
+        /// The shared remote gets updated by the connection collection.
+        virtual void update() {}
 
       private:
-        /// Pass pose messages on to the client
-        void m_handle(vrpn_TRACKERCB const &info) {
+
+        /// Pass poses published in shared memory on to the client
+        void m_handleSharedReport(common::SharedReportRecord const &r) {
+            if (r.kind != common::SharedReportKind::Pose ||
+                (m_sensor && *m_sensor != static_cast<vrpn_int32>(r.sensor))) {
+                return;
+            }
+            if (m_posesFromVRPN &&
+                !m_poseFilter.acceptFromSharedMemory(r.sensor, r.timestamp)) {
+                // Already had this one through VRPN.
+                return;
+            }
+            OSVR_PoseState pose;
+            for (int i = 0; i < 3; ++i) {
+                pose.translation.data[i] = r.values[i];
+            }
+            for (int i = 0; i < 4; ++i) {
+                pose.rotation.data[i] = r.values[3 + i];
+            }
+            m_handlePose(r.timestamp, r.sensor, pose, getCurrentTransform());
+        }
+
+        void m_handlePose(OSVR_TimeValue const &timestamp,
+                          OSVR_ChannelCount sensor, OSVR_PoseState const &pose,
+                          common::Transform const &xform) {
             common::tracing::markNewTrackerData();
             OSVR_PoseReport report;
-            report.sensor = info.sensor;
-            OSVR_TimeValue timestamp;
-            osvrStructTimevalToTimeValue(&timestamp, &(info.msg_time));
-            osvrQuatFromQuatlib(&(report.pose.rotation), info.quat);
-            osvrVec3FromQuatlib(&(report.pose.translation), info.pos);
-            auto xform = getCurrentTransform();
+            report.sensor = sensor;
+            report.pose = pose;
             ei::map(report.pose) =
                 xform.transform(ei::map(report.pose).matrix());
 
@@ -155,7 +201,7 @@ namespace client {
 
             if (m_opts.reportPosition) {
                 OSVR_PositionReport positionReport;
-                positionReport.sensor = info.sensor;
+                positionReport.sensor = sensor;
                 positionReport.xyz = report.pose.translation;
 
                 m_internals.setStateAndTriggerCallbacks(timestamp,
@@ -164,7 +210,7 @@ namespace client {
 
             if (m_opts.reportOrientation) {
                 OSVR_OrientationReport oriReport;
-                oriReport.sensor = info.sensor;
+                oriReport.sensor = sensor;
                 oriReport.rotation = report.pose.rotation;
 
                 m_internals.setStateAndTriggerCallbacks(timestamp, oriReport);
@@ -266,7 +312,10 @@ namespace client {
 
             m_internals.setStateAndTriggerCallbacks(timestamp, overallReport);
         }
-        unique_ptr<vrpn_Tracker_Remote> m_remote;
+        TrackerRemoteDispatcherPtr m_remote;
+        SharedReportDispatcherPtr m_reports;
+        bool m_posesFromVRPN = true;
+        SharedReportFilter m_poseFilter;
         common::Transform m_transform;
         common::ClientContext &m_ctx;
         RemoteHandlerInternals m_internals;
@@ -306,8 +355,10 @@ namespace client {
 
         /// @todo find out why make_shared causes a crash here
         ret.reset(new VRPNTrackerHandler(
-            m_conns.getConnection(devElt), devElt.getFullDeviceName().c_str(),
-            opts, info, xform, source.getSensorNumber(), ifaces, ctx));
+            m_conns.getTrackerRemote(devElt),
+            devElt.getFullDeviceName().c_str(),
+            opts, info, xform, source.getSensorNumber(),
+            m_conns.getSharedReports(devElt), ifaces, ctx));
         return ret;
     }
 
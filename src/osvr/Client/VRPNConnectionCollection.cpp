@@ -24,17 +24,24 @@
 
 // Internal Includes
 #include "VRPNConnectionCollection.h"
+#include <osvr/Common/WaitableVrpnConnection.h>
+#include <osvr/Util/Verbosity.h>
 
 // Library/third-party includes
 #include <vrpn_Connection.h>
 
 // Standard includes
-// - none
+#include <cstring>
 
 namespace osvr {
 namespace client {
     VRPNConnectionCollection::VRPNConnectionCollection()
-        : m_connMap(make_shared<ConnectionMap>()) {}
+        : m_connMap(make_shared<ConnectionMap>()),
+          m_sharedReports(make_shared<SharedReportMap>()),
+          m_connected(make_shared<ConnectedMap>()),
+          m_trackerRemotes(make_shared<TrackerRemoteMap>()),
+          m_analogRemotes(make_shared<AnalogRemoteMap>()),
+          m_inProcessReports(false) {}
 
     vrpn_ConnectionPtr VRPNConnectionCollection::getConnection(
         common::elements::DeviceElement const &elt) {
@@ -64,18 +71,149 @@ namespace client {
         }
         auto fullName = device + "@" + host;
 
-        vrpn_ConnectionPtr newConn(
-            vrpn_get_connection_by_name(fullName.c_str(), nullptr, nullptr,
-                                        nullptr, nullptr, nullptr, true));
+        vrpn_ConnectionPtr newConn;
+        if (0 == std::strncmp(host.c_str(), "file:", 5)) {
+            newConn = vrpn_ConnectionPtr(vrpn_get_connection_by_name(
+                fullName.c_str(), nullptr, nullptr, nullptr, nullptr, nullptr,
+                true));
+            newConn->removeReference(); // Remove extra reference.
+        } else {
+            // Waitable, so an update thread can block on its sockets.
+            newConn = vrpn_ConnectionPtr(
+                common::WaitableVrpnConnection::createClient(
+                    fullName.c_str()));
+        }
         connMap[host] = newConn;
-        newConn->removeReference(); // Remove extra reference.
         BOOST_ASSERT(!empty());
         return newConn;
     }
 
+    /// @brief Whether a server host (possibly with a port) is this one, so
+    /// could share memory with us.
+    static bool isLocalHost(std::string const &host) {
+        auto hostname = host.substr(0, host.find(':'));
+        return hostname == "localhost" || hostname == "127.0.0.1";
+    }
+
+    SharedReportDispatcherPtr VRPNConnectionCollection::getSharedReports(
+        common::elements::DeviceElement const &elt) {
+        if (!isLocalHost(elt.getServer())) {
+            return SharedReportDispatcherPtr();
+        }
+        auto &reportMap = *m_sharedReports;
+        auto const &device = elt.getDeviceName();
+        bool inProcess = m_inProcessReports && elt.getServer() == "localhost";
+        // Named by the server, so it's the one we're connected to even with
+        // several servers on this host, and a new name from a new server
+        // gets a new channel.
+        auto const &key = inProcess ? device : elt.getSharedReports();
+        if (key.empty()) {
+            return SharedReportDispatcherPtr();
+        }
+        auto existing = reportMap.find(key);
+        if (existing != end(reportMap)) {
+            return existing->second.dispatcher;
+        }
+        SharedReportDispatcherPtr ret;
+        if (inProcess) {
+            ret = SharedReportDispatcher::findInProcess(device);
+        } else {
+            ret = SharedReportDispatcher::find(key);
+        }
+        if (ret) {
+            SharedReports &reports = reportMap[key];
+            reports.dispatcher = ret;
+            reports.host = elt.getServer();
+        }
+        return ret;
+    }
+
+    /// @brief Gets the shared remote for a device from a map, creating it on
+    /// the device's connection if needed.
+    template <typename DispatcherPtr, typename Map>
+    static DispatcherPtr
+    getOrCreateRemote(Map &remoteMap, VRPNConnectionCollection &conns,
+                      common::elements::DeviceElement const &elt) {
+        auto const &device = elt.getFullDeviceName();
+        auto existing = remoteMap.find(device);
+        if (existing != end(remoteMap)) {
+            return existing->second;
+        }
+        DispatcherPtr ret = make_shared<typename DispatcherPtr::element_type>(
+            conns.getConnection(elt), device);
+        remoteMap[device] = ret;
+        return ret;
+    }
+
+    TrackerRemoteDispatcherPtr VRPNConnectionCollection::getTrackerRemote(
+        common::elements::DeviceElement const &elt) {
+        return getOrCreateRemote<TrackerRemoteDispatcherPtr>(*m_trackerRemotes,
+                                                             *this, elt);
+    }
+
+    AnalogRemoteDispatcherPtr VRPNConnectionCollection::getAnalogRemote(
+        common::elements::DeviceElement const &elt) {
+        return getOrCreateRemote<AnalogRemoteDispatcherPtr>(*m_analogRemotes,
+                                                            *this, elt);
+    }
+
     void VRPNConnectionCollection::updateAll() {
+        // Shared memory first: anything it has is no later than (and so
+        // takes the place of) its copy on the way over VRPN.
+        for (auto &reportPair : *m_sharedReports) {
+            reportPair.second.dispatcher->update();
+        }
         for (auto &connPair : *m_connMap) {
             connPair.second->mainloop();
+            bool connected = connPair.second->connected() != 0;
+            auto wasConnected = m_connected->find(connPair.first);
+            if (wasConnected == end(*m_connected)) {
+                if (connected) {
+                    (*m_connected)[connPair.first] = true;
+                }
+                continue;
+            }
+            if (connected && !wasConnected->second) {
+                m_reopenSharedReports(connPair.first);
+            }
+            wasConnected->second = connected;
+        }
+        updateRemotes();
+    }
+
+    void
+    VRPNConnectionCollection::m_reopenSharedReports(std::string const &host) {
+        for (auto &reportPair : *m_sharedReports) {
+            auto &reports = reportPair.second;
+            if (reports.host == host && !reports.dispatcher->reopen()) {
+                OSVR_DEV_VERBOSE("Shared memory report channel "
+                                 << reportPair.first
+                                 << " is gone: its reports will only come "
+                                    "over VRPN.");
+            }
+        }
+    }
+
+    bool VRPNConnectionCollection::appendSockets(std::vector<SOCKET> &sockets) {
+        bool ret = true;
+        for (auto &connPair : *m_connMap) {
+            auto waitable = dynamic_cast<common::WaitableVrpnConnection *>(
+                connPair.second.get());
+            if (waitable) {
+                waitable->appendSockets(sockets);
+            } else {
+                ret = false;
+            }
+        }
+        return ret;
+    }
+
+    void VRPNConnectionCollection::updateRemotes() {
+        for (auto &remotePair : *m_trackerRemotes) {
+            remotePair.second->update();
+        }
+        for (auto &remotePair : *m_analogRemotes) {
+            remotePair.second->update();
         }
     }
 
@@ -29,13 +29,17 @@
 #include <osvr/Util/SharedPtr.h>
 #include <osvr/Common/PathElementTypes.h>
 #include <osvr/Client/Export.h>
+#include "SharedReportDispatcher.h"
+#include "VRPNRemoteDispatchers.h"
 
 // Library/third-party includes
 #include <vrpn_ConnectionPtr.h>
+#include <vrpn_Shared.h> // for SOCKET
 
 // Standard includes
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace osvr {
 namespace client {
@@ -50,15 +54,84 @@ namespace client {
                                          std::string const &host);
         vrpn_ConnectionPtr
         getConnection(common::elements::DeviceElement const &elt);
+
+        /// @brief Gets the shared-memory report channel for a device, if it
+        /// is served on this host and its server provides one.
+        ///
+        /// With in-process reports enabled, the channel for a device served
+        /// on "localhost" is the server's own, subscribed to directly.
+        ///
+        /// @return an empty pointer if the VRPN connection is the only path.
+        SharedReportDispatcherPtr
+        getSharedReports(common::elements::DeviceElement const &elt);
+
+        /// @brief For contexts living in the server process (analysis
+        /// plugins): take reports from devices on "localhost" straight from
+        /// the server's report channels. Call before making any copies of
+        /// this collection.
+        void enableInProcessReports() { m_inProcessReports = true; }
+
+        /// @brief Gets the tracker remote for a device, shared by all the
+        /// handlers for it, creating it if needed.
+        TrackerRemoteDispatcherPtr
+        getTrackerRemote(common::elements::DeviceElement const &elt);
+
+        /// @brief Gets the analog remote for a device, shared by all the
+        /// handlers for it, creating it if needed.
+        AnalogRemoteDispatcherPtr
+        getAnalogRemote(common::elements::DeviceElement const &elt);
+
+        /// @brief Dispatches shared-memory reports, mainloops the
+        /// connections, then updates the shared remotes.
+        ///
+        /// When a connection comes back after having been lost, the server
+        /// has likely been restarted, so the shared-memory channels of its
+        /// host get opened again.
         OSVR_CLIENT_EXPORT void updateAll();
+
+        /// @brief Updates just the shared remotes, for contexts whose
+        /// connections get mainlooped elsewhere.
+        OSVR_CLIENT_EXPORT void updateRemotes();
+
+        /// @brief Appends the sockets the connections would read from in
+        /// updateAll() to the vector, so that a caller can block until one
+        /// of them has something to read.
+        ///
+        /// @return false if some connection (one added from elsewhere, or a
+        /// file connection) can't report its sockets, so must be polled.
+        OSVR_CLIENT_EXPORT bool appendSockets(std::vector<SOCKET> &sockets);
         bool empty() const {
             return m_connMap->empty();
         }
 
       private:
+        /// @brief Opens again the shared-memory channels provided by the
+        /// server on a host.
+        void m_reopenSharedReports(std::string const &host);
+
         typedef std::unordered_map<std::string, vrpn_ConnectionPtr>
             ConnectionMap;
         shared_ptr<ConnectionMap> m_connMap;
+        /// @brief A shared-memory report channel and the host of the server
+        /// providing it.
+        struct SharedReports {
+            SharedReportDispatcherPtr dispatcher;
+            std::string host;
+        };
+        /// @brief By advertised channel name (or device name, in process).
+        typedef std::unordered_map<std::string, SharedReports> SharedReportMap;
+        shared_ptr<SharedReportMap> m_sharedReports;
+        /// @brief By host, whether each connection was connected as of the
+        /// last update, if it has ever been.
+        typedef std::unordered_map<std::string, bool> ConnectedMap;
+        shared_ptr<ConnectedMap> m_connected;
+        typedef std::unordered_map<std::string, TrackerRemoteDispatcherPtr>
+            TrackerRemoteMap;
+        shared_ptr<TrackerRemoteMap> m_trackerRemotes;
+        typedef std::unordered_map<std::string, AnalogRemoteDispatcherPtr>
+            AnalogRemoteMap;
+        shared_ptr<AnalogRemoteMap> m_analogRemotes;
+        bool m_inProcessReports;
     };
 
 } // namespace client
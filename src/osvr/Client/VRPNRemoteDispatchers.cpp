@@ -0,0 +1,147 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "VRPNRemoteDispatchers.h"
+#include <osvr/Common/Buffer.h>
+#include <osvr/Common/Serialization.h>
+#include <osvr/Util/QuatlibInteropC.h>
+#include <osvr/Util/Verbosity.h>
+
+// Library/third-party includes
+#include <vrpn_Connection.h>
+
+// Standard includes
+#include <algorithm>
+
+namespace osvr {
+namespace client {
+    TrackerRemoteDispatcher::TrackerRemoteDispatcher(
+        vrpn_ConnectionPtr const &conn, std::string const &device)
+        : m_remote(new vrpn_Tracker_Remote(device.c_str(), conn.get())),
+          m_conn(conn) {
+        m_remote->register_change_handler(
+            this, &TrackerRemoteDispatcher::m_handlePose);
+        m_remote->register_change_handler(
+            this, &TrackerRemoteDispatcher::m_handleVel);
+        m_remote->register_change_handler(
+            this, &TrackerRemoteDispatcher::m_handleAccel);
+        // Batched poses come in as a message of our own, alongside the ones
+        // vrpn_Tracker_Remote handles.
+        auto sender = device.substr(0, device.find('@'));
+        m_poseBatchSender = m_conn->register_sender(sender.c_str());
+        m_poseBatchMsgId = m_conn->register_message_type(
+            common::messages::TrackerPoseBatch::identifier());
+        m_conn->register_handler(m_poseBatchMsgId,
+                                 &TrackerRemoteDispatcher::m_handlePoseBatch,
+                                 this, m_poseBatchSender);
+        OSVR_DEV_VERBOSE("Constructed the shared tracker remote for "
+                         << device);
+    }
+
+    TrackerRemoteDispatcher::~TrackerRemoteDispatcher() {
+        m_remote->unregister_change_handler(
+            this, &TrackerRemoteDispatcher::m_handlePose);
+        m_remote->unregister_change_handler(
+            this, &TrackerRemoteDispatcher::m_handleVel);
+        m_remote->unregister_change_handler(
+            this, &TrackerRemoteDispatcher::m_handleAccel);
+        m_conn->unregister_handler(m_poseBatchMsgId,
+                                   &TrackerRemoteDispatcher::m_handlePoseBatch,
+                                   this, m_poseBatchSender);
+    }
+
+    void TrackerRemoteDispatcher::update() { m_remote->mainloop(); }
+
+    void VRPN_CALLBACK
+    TrackerRemoteDispatcher::m_handlePose(void *userdata, vrpn_TRACKERCB info) {
+        auto self = static_cast<TrackerRemoteDispatcher *>(userdata);
+        TrackerPoseInfo pose;
+        osvrStructTimevalToTimeValue(&pose.timestamp, &(info.msg_time));
+        pose.sensor = info.sensor;
+        osvrQuatFromQuatlib(&(pose.pose.rotation), info.quat);
+        osvrVec3FromQuatlib(&(pose.pose.translation), info.pos);
+        self->m_poses.dispatch(info.sensor, pose);
+    }
+
+    int VRPN_CALLBACK
+    TrackerRemoteDispatcher::m_handlePoseBatch(void *userdata,
+                                               vrpn_HANDLERPARAM p) {
+        auto self = static_cast<TrackerRemoteDispatcher *>(userdata);
+        auto bufReader = common::readExternalBuffer(p.buffer, p.payload_len);
+        common::messages::TrackerPoseBatch::MessageSerialization msg(
+            self->m_poseBatch);
+        common::deserialize(bufReader, msg);
+        TrackerPoseInfo pose;
+        osvrStructTimevalToTimeValue(&pose.timestamp, &(p.msg_time));
+        for (auto const &entry : self->m_poseBatch) {
+            pose.sensor = entry.sensor;
+            pose.pose = entry.pose;
+            self->m_poses.dispatch(static_cast<int>(entry.sensor), pose);
+        }
+        return 0;
+    }
+
+    void VRPN_CALLBACK TrackerRemoteDispatcher::m_handleVel(
+        void *userdata, vrpn_TRACKERVELCB info) {
+        auto self = static_cast<TrackerRemoteDispatcher *>(userdata);
+        self->m_velocities.dispatch(info.sensor, info);
+    }
+
+    void VRPN_CALLBACK TrackerRemoteDispatcher::m_handleAccel(
+        void *userdata, vrpn_TRACKERACCCB info) {
+        auto self = static_cast<TrackerRemoteDispatcher *>(userdata);
+        self->m_accelerations.dispatch(info.sensor, info);
+    }
+
+    AnalogRemoteDispatcher::AnalogRemoteDispatcher(
+        vrpn_ConnectionPtr const &conn, std::string const &device)
+        : m_remote(new vrpn_Analog_Remote(device.c_str(), conn.get())) {
+        m_remote->register_change_handler(this,
+                                          &AnalogRemoteDispatcher::m_handle);
+        OSVR_DEV_VERBOSE("Constructed the shared analog remote for "
+                         << device);
+    }
+
+    AnalogRemoteDispatcher::~AnalogRemoteDispatcher() {
+        m_remote->unregister_change_handler(this,
+                                            &AnalogRemoteDispatcher::m_handle);
+    }
+
+    void AnalogRemoteDispatcher::update() { m_remote->mainloop(); }
+
+    void VRPN_CALLBACK AnalogRemoteDispatcher::m_handle(void *userdata,
+                                                        vrpn_ANALOGCB info) {
+        auto self = static_cast<AnalogRemoteDispatcher *>(userdata);
+        auto &reports = self->m_reports;
+        auto channels = std::min<std::size_t>(
+            std::max<vrpn_int32>(info.num_channel, 0), reports.sensorLimit());
+        for (std::size_t i = 0; i < channels; ++i) {
+            reports.dispatchToSensor(static_cast<int>(i), info);
+        }
+        reports.dispatchToAllSensors(info);
+    }
+
+} // namespace client
+} // namespace osvr
@@ -0,0 +1,132 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_VRPNRemoteDispatchers_h_GUID_909F4F38_D949_43A3_9E52_295D278F6C41
+#define INCLUDED_VRPNRemoteDispatchers_h_GUID_909F4F38_D949_43A3_9E52_295D278F6C41
+
+// Internal Includes
+#include "SensorDispatchTable.h"
+#include <osvr/Client/Export.h>
+#include <osvr/Common/TrackerPoseBatch.h>
+#include <osvr/Util/ChannelCountC.h>
+#include <osvr/Util/Pose3C.h>
+#include <osvr/Util/SharedPtr.h>
+#include <osvr/Util/TimeValueC.h>
+#include <osvr/Util/UniquePtr.h>
+
+// Library/third-party includes
+#include <vrpn_Analog.h>
+#include <vrpn_ConnectionPtr.h>
+#include <vrpn_Tracker.h>
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <string>
+#include <vector>
+
+namespace osvr {
+namespace client {
+    /// @brief A pose from a tracker, whether it came in its own message or in
+    /// a batch.
+    struct TrackerPoseInfo {
+        OSVR_TimeValue timestamp;
+        OSVR_ChannelCount sensor;
+        OSVR_PoseState pose;
+    };
+
+    /// @brief The one vrpn_Tracker_Remote for a device on a connection,
+    /// shared by all the handlers for paths resolving to that device: each
+    /// message is decoded once and passed on only to the handlers for its
+    /// sensor.
+    class TrackerRemoteDispatcher : boost::noncopyable {
+      public:
+        /// @param conn Connection the device is served on
+        /// @param device Full device name, with the host
+        OSVR_CLIENT_EXPORT
+        TrackerRemoteDispatcher(vrpn_ConnectionPtr const &conn,
+                                std::string const &device);
+        OSVR_CLIENT_EXPORT ~TrackerRemoteDispatcher();
+
+        /// @brief Poses, from both the standard VRPN messages and batches.
+        SensorDispatchTable<TrackerPoseInfo> &poses() { return m_poses; }
+        SensorDispatchTable<vrpn_TRACKERVELCB> &velocities() {
+            return m_velocities;
+        }
+        SensorDispatchTable<vrpn_TRACKERACCCB> &accelerations() {
+            return m_accelerations;
+        }
+
+        /// @brief Runs the remote's mainloop.
+        OSVR_CLIENT_EXPORT void update();
+
+      private:
+        static void VRPN_CALLBACK m_handlePose(void *userdata,
+                                               vrpn_TRACKERCB info);
+        static int VRPN_CALLBACK m_handlePoseBatch(void *userdata,
+                                                   vrpn_HANDLERPARAM p);
+        static void VRPN_CALLBACK m_handleVel(void *userdata,
+                                              vrpn_TRACKERVELCB info);
+        static void VRPN_CALLBACK m_handleAccel(void *userdata,
+                                                vrpn_TRACKERACCCB info);
+        unique_ptr<vrpn_Tracker_Remote> m_remote;
+        vrpn_ConnectionPtr m_conn;
+        vrpn_int32 m_poseBatchSender;
+        vrpn_int32 m_poseBatchMsgId;
+        std::vector<common::TrackerPoseBatchEntry> m_poseBatch;
+        SensorDispatchTable<TrackerPoseInfo> m_poses;
+        SensorDispatchTable<vrpn_TRACKERVELCB> m_velocities;
+        SensorDispatchTable<vrpn_TRACKERACCCB> m_accelerations;
+    };
+    typedef shared_ptr<TrackerRemoteDispatcher> TrackerRemoteDispatcherPtr;
+
+    /// @brief The one vrpn_Analog_Remote for a device on a connection, shared
+    /// by all the handlers for paths resolving to that device.
+    ///
+    /// An analog message carries every channel, so a handler for one channel
+    /// gets called only if the message has that channel.
+    class AnalogRemoteDispatcher : boost::noncopyable {
+      public:
+        /// @param conn Connection the device is served on
+        /// @param device Full device name, with the host
+        OSVR_CLIENT_EXPORT
+        AnalogRemoteDispatcher(vrpn_ConnectionPtr const &conn,
+                               std::string const &device);
+        OSVR_CLIENT_EXPORT ~AnalogRemoteDispatcher();
+
+        SensorDispatchTable<vrpn_ANALOGCB> &reports() { return m_reports; }
+
+        /// @brief Runs the remote's mainloop.
+        OSVR_CLIENT_EXPORT void update();
+
+      private:
+        static void VRPN_CALLBACK m_handle(void *userdata, vrpn_ANALOGCB info);
+        unique_ptr<vrpn_Analog_Remote> m_remote;
+        SensorDispatchTable<vrpn_ANALOGCB> m_reports;
+    };
+    typedef shared_ptr<AnalogRemoteDispatcher> AnalogRemoteDispatcherPtr;
+
+} // namespace client
+} // namespace osvr
+
+#endif // INCLUDED_VRPNRemoteDispatchers_h_GUID_909F4F38_D949_43A3_9E52_295D278F6C41
@@ -29,27 +29,139 @@
 #include <osvr/Util/EigenInterop.h>
 #include <osvr/Util/ProjectionMatrix.h>
 #include <osvr/Util/MatrixConventions.h>
+#include <osvr/Util/PosePrediction.h>
 
 // Library/third-party includes
 // - none
 
 // Standard includes
-// - none
+#include <algorithm>
 
 namespace osvr {
 namespace client {
+    /// @brief Furthest past the latest pose (in seconds) that prediction will
+    /// extrapolate.
+    static const double MAX_PREDICTION_INTERVAL = 0.1;
+
+    /// @brief Longest gap between poses (in seconds) that a finite-difference
+    /// velocity estimate will span.
+    static const double MAX_FINITE_DIFFERENCE_INTERVAL = 0.1;
+
+    /// @brief Oldest (in seconds) relative to the latest pose that a reported
+    /// velocity can be and still be used, rather than finite differences.
+    static const double MAX_REPORTED_VELOCITY_AGE = 0.1;
+
+    void ViewerEye::PoseSamples::handle(void *userdata,
+                                        const OSVR_TimeValue *timestamp,
+                                        const OSVR_PoseReport *report) {
+        auto &self = *static_cast<PoseSamples *>(userdata);
+        std::lock_guard<std::mutex> lock(self.mutex);
+        self.timestamps[0] = self.timestamps[1];
+        self.poses[0] = self.poses[1];
+        self.timestamps[1] = *timestamp;
+        self.poses[1] = report->pose;
+        self.count = std::min<std::size_t>(self.count + 1, 2);
+    }
+
+    Eigen::Isometry3d
+    ViewerEye::getPoseFromTracker(Eigen::Isometry3d const &trackerPose) const {
+        Eigen::Isometry3d transformedPose =
+            trackerPose * Eigen::Translation3d(m_offset) *
+            Eigen::AngleAxisd(util::getRadians(m_opticalAxisOffsetY),
+                              Eigen::Vector3d::UnitY());
+        return transformedPose;
+    }
+
     Eigen::Isometry3d ViewerEye::getPoseIsometry() const {
+        return getPoseFromTracker(getTrackerPose());
+    }
+
+    void ViewerEye::m_getVelocity(util::time::TimeValue const &poseTime,
+                                  Eigen::Vector3d &linVel,
+                                  Eigen::Vector3d &angVel) const {
+        namespace pred = util::prediction;
+        linVel = Eigen::Vector3d::Zero();
+        angVel = Eigen::Vector3d::Zero();
+        bool haveLinVel = false;
+        bool haveAngVel = false;
+        OSVR_TimeValue timestamp = {};
+        OSVR_VelocityState vel = {};
+        // A device that stopped reporting velocity, or reports it less often
+        // than poses, would otherwise have its poses extrapolated with a
+        // velocity that no longer applies.
+        if (m_pose->getState<OSVR_VelocityReport>(timestamp, vel) &&
+            util::time::duration(poseTime, timestamp) <=
+                MAX_REPORTED_VELOCITY_AGE) {
+            if (vel.linearVelocityValid) {
+                linVel = util::vecMap(vel.linearVelocity);
+                haveLinVel = true;
+            }
+            if (vel.angularVelocityValid) {
+                angVel = pred::angularVelocityFromIncrementalRotation(
+                    util::fromQuat(vel.angularVelocity.incrementalRotation),
+                    vel.angularVelocity.dt);
+                haveAngVel = true;
+            }
+        }
+        if ((haveLinVel && haveAngVel) || !m_poseSamples) {
+            return;
+        }
+
+        // Fall back to finite differences for whatever isn't reported.
+        util::time::TimeValue timestamps[2];
+        OSVR_Pose3 poses[2];
+        {
+            std::lock_guard<std::mutex> lock(m_poseSamples->mutex);
+            if (m_poseSamples->count < 2) {
+                return;
+            }
+            std::copy(m_poseSamples->timestamps,
+                      m_poseSamples->timestamps + 2, timestamps);
+            std::copy(m_poseSamples->poses, m_poseSamples->poses + 2, poses);
+        }
+        auto dt = util::time::duration(timestamps[1], timestamps[0]);
+        if (dt <= 0 || dt > MAX_FINITE_DIFFERENCE_INTERVAL) {
+            return;
+        }
+        if (!haveLinVel) {
+            linVel = pred::linearVelocityFromPositions(
+                util::vecMap(poses[0].translation),
+                util::vecMap(poses[1].translation), dt);
+        }
+        if (!haveAngVel) {
+            angVel = pred::angularVelocityFromOrientations(
+                util::fromQuat(poses[0].rotation),
+                util::fromQuat(poses[1].rotation), dt);
+        }
+    }
+
+    Eigen::Isometry3d ViewerEye::getPredictedPoseIsometry(
+        util::time::TimeValue const &targetTime) const {
+        return getPoseFromTracker(getTrackerPose(&targetTime));
+    }
+
+    Eigen::Isometry3d ViewerEye::getTrackerPose(
+        util::time::TimeValue const *targetTime) const {
         OSVR_TimeValue timestamp;
         OSVR_Pose3 pose;
         bool hasState = m_pose->getState<OSVR_PoseReport>(timestamp, pose);
         if (!hasState) {
             throw NoPoseYet();
         }
-        Eigen::Isometry3d transformedPose =
-            util::fromPose(pose) * Eigen::Translation3d(m_offset) *
-            Eigen::AngleAxisd(util::getRadians(m_opticalAxisOffsetY),
-                              Eigen::Vector3d::UnitY());
-        return transformedPose;
+        Eigen::Isometry3d trackerPose = util::fromPose(pose);
+        if (!targetTime) {
+            return trackerPose;
+        }
+        auto dt = std::min(util::time::duration(*targetTime, timestamp),
+                           MAX_PREDICTION_INTERVAL);
+        if (dt > 0) {
+            Eigen::Vector3d linVel;
+            Eigen::Vector3d angVel;
+            m_getVelocity(timestamp, linVel, angVel);
+            trackerPose = util::prediction::predictPose(trackerPose, linVel,
+                                                        angVel, dt);
+        }
+        return trackerPose;
     }
     OSVR_Pose3 ViewerEye::getPose() const {
         Eigen::Isometry3d transformedPose = getPoseIsometry();
@@ -58,6 +170,15 @@ namespace client {
         return pose;
     }
 
+    OSVR_Pose3 ViewerEye::getPredictedPose(
+        util::time::TimeValue const &targetTime) const {
+        Eigen::Isometry3d transformedPose =
+            getPredictedPoseIsometry(targetTime);
+        OSVR_Pose3 pose;
+        util::toPose(transformedPose, pose);
+        return pose;
+    }
+
     bool ViewerEye::hasPose() const {
         return m_pose->hasStateForReportType<OSVR_PoseReport>();
     }
@@ -67,6 +188,13 @@ namespace client {
         return transformedPose.inverse().matrix();
     }
 
+    Eigen::Matrix4d ViewerEye::getPredictedView(
+        util::time::TimeValue const &targetTime) const {
+        Eigen::Isometry3d transformedPose =
+            getPredictedPoseIsometry(targetTime);
+        return transformedPose.inverse().matrix();
+    }
+
     util::Rectd ViewerEye::m_getRect(double near, double /*far*/ = 100) const {
         util::Rectd rect(m_unitBounds);
         // Scale the in-plane positions based on the near plane to put
@@ -184,17 +312,48 @@ namespace client {
 
     util::Rectd ViewerEye::getRect() const { return m_getRect(1.0); }
 
+    shared_ptr<util::RadialDistortionGrid const>
+    ViewerEye::getRadialDistortionGrid(std::size_t columns, std::size_t rows,
+                                       util::GridSampling sampling) const {
+        if (!m_radDistortParams) {
+            throw std::logic_error(
+                "No radial distortion parameters for this eye!");
+        }
+        auto it = std::find_if(
+            m_distortionGrids.begin(), m_distortionGrids.end(),
+            [&](shared_ptr<util::RadialDistortionGrid const> const &grid) {
+                return grid->sampling() == sampling;
+            });
+        if (it != m_distortionGrids.end() && (*it)->columns() == columns &&
+            (*it)->rows() == rows) {
+            return *it;
+        }
+        auto grid = make_shared<util::RadialDistortionGrid const>(
+            *m_radDistortParams, columns, rows, sampling);
+        // Only the latest size is kept: a caller asking for a new size every
+        // frame (following its render target, say) mustn't grow this.
+        if (it == m_distortionGrids.end()) {
+            m_distortionGrids.push_back(grid);
+        } else {
+            *it = grid;
+        }
+        return grid;
+    }
+
     ViewerEye::ViewerEye(
         OSVR_ClientContext ctx, Eigen::Vector3d const &offset,
         const char path[], Viewport &&viewport, util::Rectd &&unitBounds,
         bool rot180, double pitchTilt,
         boost::optional<OSVR_RadialDistortionParameters> radDistortParams,
         OSVR_DisplayInputCount displayInputIdx, util::Angle opticalAxisOffsetY)
-        : m_pose(ctx, path), m_offset(offset), m_viewport(viewport),
-          m_unitBounds(unitBounds), m_rot180(rot180), m_pitchTilt(pitchTilt),
+        : m_poseSamples(new PoseSamples), m_pose(ctx, path),
+          m_offset(offset), m_viewport(viewport), m_unitBounds(unitBounds),
+          m_rot180(rot180), m_pitchTilt(pitchTilt),
           m_radDistortParams(radDistortParams),
           m_displayInputIdx(displayInputIdx),
-          m_opticalAxisOffsetY(opticalAxisOffsetY) {}
+          m_opticalAxisOffsetY(opticalAxisOffsetY) {
+        m_pose->registerCallback(&PoseSamples::handle, m_poseSamples.get());
+    }
 
 } // namespace client
 } // namespace osvr
@@ -39,15 +39,23 @@
 static const char HOST_ENV_VAR[] = "OSVR_HOST";
 
 OSVR_ClientContext osvrClientInit(const char applicationIdentifier[],
-                                  uint32_t /*flags*/) {
+                                  uint32_t flags) {
+    std::uint32_t contextFlags = 0;
+    if (flags & OSVR_CLIENT_INIT_THREADED) {
+        contextFlags |= ::osvr::client::CONTEXT_UPDATE_THREAD;
+        if (flags & OSVR_CLIENT_INIT_DEFER_CALLBACKS) {
+            contextFlags |= ::osvr::client::CONTEXT_DEFER_CALLBACKS;
+        }
+    }
     auto host = osvr::common::getEnvironmentVariable(HOST_ENV_VAR);
     if (host.is_initialized()) {
         OSVR_DEV_VERBOSE("Connecting to non-default host " << *host);
         return ::osvr::client::createContext(applicationIdentifier,
-                                             host->c_str());
+                                             host->c_str(), contextFlags);
     } else {
         OSVR_DEV_VERBOSE("Connecting to default (local) host");
-        return ::osvr::client::createContext(applicationIdentifier);
+        return ::osvr::client::createContext(applicationIdentifier,
+                                             "localhost", contextFlags);
     }
 }
 OSVR_ReturnCode osvrClientCheckStatus(OSVR_ClientContext ctx) {
@@ -62,6 +62,15 @@ struct OSVR_DisplayConfigObject {
     }                                                                          \
     OSVR_UTIL_MULTILINE_END
 
+#define OSVR_VALIDATE_INPUT_PTR(X, DESC)                                       \
+    OSVR_UTIL_MULTILINE_BEGIN                                                  \
+    if (nullptr == X) {                                                        \
+        OSVR_DEV_VERBOSE("Passed a null pointer for input parameter " #X       \
+                         ", " DESC "!");                                       \
+        return OSVR_RETURN_FAILURE;                                            \
+    }                                                                          \
+    OSVR_UTIL_MULTILINE_END
+
 OSVR_ReturnCode osvrClientGetDisplay(OSVR_ClientContext ctx,
                                      OSVR_DisplayConfig *disp) {
     OSVR_VALIDATE_OUTPUT_PTR(disp, "display config");
@@ -265,6 +274,76 @@ OSVR_ReturnCode osvrClientGetViewerEyeViewMatrixf(
     return getViewMatrixImpl(disp, viewer, eye, mat, flags);
 }
 
+OSVR_ReturnCode osvrClientGetViewerEyePosePredicted(
+    OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, OSVR_EyeCount eye,
+    OSVR_TimeValue const *targetTime, OSVR_Pose3 *pose) {
+    OSVR_VALIDATE_DISPLAY_CONFIG;
+    OSVR_VALIDATE_VIEWER_ID;
+    OSVR_VALIDATE_EYE_ID;
+    OSVR_VALIDATE_INPUT_PTR(targetTime, "target time");
+    OSVR_VALIDATE_OUTPUT_PTR(pose, "eye pose");
+    try {
+        *pose =
+            disp->cfg->getViewerEye(viewer, eye).getPredictedPose(*targetTime);
+        return OSVR_RETURN_SUCCESS;
+    } catch (osvr::client::NoPoseYet &) {
+        OSVR_DEV_VERBOSE(
+            "Error getting predicted viewer eye pose: no pose yet available");
+        return OSVR_RETURN_FAILURE;
+    } catch (std::exception &e) {
+        OSVR_DEV_VERBOSE(
+            "Error getting predicted viewer eye pose - exception: "
+            << e.what());
+        return OSVR_RETURN_FAILURE;
+    }
+}
+
+template <typename Scalar>
+static inline OSVR_ReturnCode
+getPredictedViewMatrixImpl(OSVR_DisplayConfig disp, OSVR_ViewerCount viewer,
+                           OSVR_EyeCount eye, OSVR_TimeValue const *targetTime,
+                           Scalar *mat, OSVR_MatrixConventions flags) {
+    OSVR_VALIDATE_DISPLAY_CONFIG;
+    OSVR_VALIDATE_VIEWER_ID;
+    OSVR_VALIDATE_EYE_ID;
+    OSVR_VALIDATE_INPUT_PTR(targetTime, "target time");
+    OSVR_VALIDATE_OUTPUT_PTR(mat, "view matrix");
+    try {
+        osvr::util::matrixEigenAssign(
+            disp->cfg->getViewerEye(viewer, eye).getPredictedView(*targetTime),
+            flags, mat);
+        return OSVR_RETURN_SUCCESS;
+    } catch (osvr::client::NoPoseYet &) {
+        OSVR_DEV_VERBOSE("Error getting predicted viewer eye view matrix: no "
+                         "pose yet available");
+        return OSVR_RETURN_FAILURE;
+    } catch (std::exception &e) {
+        OSVR_DEV_VERBOSE(
+            "Error getting predicted viewer eye view matrix - exception: "
+            << e.what());
+        return OSVR_RETURN_FAILURE;
+    } catch (...) {
+        OSVR_DEV_VERBOSE("Error getting predicted viewer eye view matrix");
+        return OSVR_RETURN_FAILURE;
+    }
+}
+
+OSVR_ReturnCode osvrClientGetViewerEyeViewMatrixdPredicted(
+    OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, OSVR_EyeCount eye,
+    OSVR_TimeValue const *targetTime, OSVR_MatrixConventions flags,
+    double *mat) {
+    return getPredictedViewMatrixImpl(disp, viewer, eye, targetTime, mat,
+                                      flags);
+}
+
+OSVR_ReturnCode osvrClientGetViewerEyeViewMatrixfPredicted(
+    OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, OSVR_EyeCount eye,
+    OSVR_TimeValue const *targetTime, OSVR_MatrixConventions flags,
+    float *mat) {
+    return getPredictedViewMatrixImpl(disp, viewer, eye, targetTime, mat,
+                                      flags);
+}
+
 OSVR_ReturnCode
 osvrClientGetNumSurfacesForViewerEye(OSVR_DisplayConfig disp,
                                      OSVR_ViewerCount viewer, OSVR_EyeCount eye,
@@ -426,3 +505,176 @@ OSVR_ReturnCode osvrClientGetViewerEyeSurfaceRadialDistortion(
     }
     return OSVR_RETURN_FAILURE;
 }
+
+static OSVR_ReturnCode getRadialDistortionGridImpl(
+    OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, OSVR_EyeCount eye,
+    OSVR_SurfaceCount surface, uint32_t columns, uint32_t rows,
+    osvr::util::GridSampling sampling,
+    OSVR_RadialDistortionMeshVertex *vertices, uint32_t count) {
+    OSVR_VALIDATE_DISPLAY_CONFIG;
+    OSVR_VALIDATE_VIEWER_ID;
+    OSVR_VALIDATE_EYE_ID;
+    OSVR_VALIDATE_SURFACE_ID;
+    OSVR_VALIDATE_OUTPUT_PTR(vertices, "distortion mesh vertex array");
+    if (columns == 0 || rows == 0 ||
+        uint64_t(columns) * rows != uint64_t(count)) {
+        OSVR_DEV_VERBOSE("Distortion mesh size does not match the count of "
+                         "vertices passed!");
+        return OSVR_RETURN_FAILURE;
+    }
+    auto &eyeSurface = disp->cfg->getViewerEyeSurface(viewer, eye, surface);
+    if (!eyeSurface.wantDistortion()) {
+        return OSVR_RETURN_FAILURE;
+    }
+    using osvr::util::ColorChannel;
+    try {
+        auto grid =
+            eyeSurface.getRadialDistortionGrid(columns, rows, sampling);
+        auto const &x = grid->x();
+        auto const &y = grid->y();
+        static const ColorChannel channels[] = {
+            ColorChannel::Red, ColorChannel::Green, ColorChannel::Blue};
+        for (uint32_t i = 0; i < count; ++i) {
+            vertices[i].position.data[0] = x[i];
+            vertices[i].position.data[1] = y[i];
+        }
+        for (std::size_t c = 0; c < osvr::util::COLOR_CHANNELS; ++c) {
+            auto const &u = grid->u(channels[c]);
+            auto const &v = grid->v(channels[c]);
+            for (uint32_t i = 0; i < count; ++i) {
+                vertices[i].texCoords[c].data[0] = u[i];
+                vertices[i].texCoords[c].data[1] = v[i];
+            }
+        }
+        return OSVR_RETURN_SUCCESS;
+    } catch (std::exception &e) {
+        OSVR_DEV_VERBOSE(
+            "Error getting radial distortion grid - exception: " << e.what());
+        return OSVR_RETURN_FAILURE;
+    } catch (...) {
+        OSVR_DEV_VERBOSE("Error getting radial distortion grid");
+        return OSVR_RETURN_FAILURE;
+    }
+}
+
+OSVR_ReturnCode osvrClientGetViewerEyeSurfaceRadialDistortionMesh(
+    OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, OSVR_EyeCount eye,
+    OSVR_SurfaceCount surface, uint32_t columns, uint32_t rows,
+    OSVR_RadialDistortionMeshVertex *vertices, uint32_t count) {
+    return getRadialDistortionGridImpl(disp, viewer, eye, surface, columns,
+                                       rows, osvr::util::GridSampling::Corners,
+                                       vertices, count);
+}
+
+OSVR_ReturnCode osvrClientGetViewerEyeSurfaceRadialDistortionLookupTable(
+    OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, OSVR_EyeCount eye,
+    OSVR_SurfaceCount surface, uint32_t width, uint32_t height,
+    OSVR_RadialDistortionMeshVertex *vertices, uint32_t count) {
+    return getRadialDistortionGridImpl(
+        disp, viewer, eye, surface, width, height,
+        osvr::util::GridSampling::TexelCenters, vertices, count);
+}
+
+/// @brief Total surfaces of all eyes of all viewers.
+static uint32_t getNumRenderInfo(osvr::client::DisplayConfig const &cfg) {
+    uint32_t ret = 0;
+    for (OSVR_ViewerCount viewer = 0; viewer < cfg.getNumViewers(); ++viewer) {
+        for (OSVR_EyeCount eye = 0; eye < cfg.getNumViewerEyes(viewer);
+             ++eye) {
+            ret += cfg.getNumViewerEyeSurfaces(viewer, eye);
+        }
+    }
+    return ret;
+}
+
+OSVR_ReturnCode osvrClientGetNumRenderInfo(OSVR_DisplayConfig disp,
+                                           uint32_t *count) {
+    OSVR_VALIDATE_DISPLAY_CONFIG;
+    OSVR_VALIDATE_OUTPUT_PTR(count, "render info count");
+    *count = getNumRenderInfo(*disp->cfg);
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrClientGetRenderInfo(OSVR_DisplayConfig disp,
+                                        OSVR_TimeValue const *targetTime,
+                                        double near, double far,
+                                        OSVR_MatrixConventions flags,
+                                        OSVR_RenderInfo *info,
+                                        uint32_t count) {
+    OSVR_VALIDATE_DISPLAY_CONFIG;
+    OSVR_VALIDATE_OUTPUT_PTR(info, "render info array");
+    if (near <= 0 || far <= 0 || near == far) {
+        OSVR_DEV_VERBOSE("Must specify positive, distinct near and far "
+                         "distances!");
+        return OSVR_RETURN_FAILURE;
+    }
+    auto const &cfg = *disp->cfg;
+    if (count != getNumRenderInfo(cfg)) {
+        OSVR_DEV_VERBOSE("Render info array has "
+                         << count << " entries, expected "
+                         << getNumRenderInfo(cfg));
+        return OSVR_RETURN_FAILURE;
+    }
+    // Once there's a pose, there always is, so checking up front keeps the
+    // output untouched on failure.
+    for (OSVR_ViewerCount viewer = 0; viewer < cfg.getNumViewers(); ++viewer) {
+        if (cfg.getNumViewerEyes(viewer) > 0 &&
+            !cfg.getViewerEye(viewer, 0).hasPose()) {
+            OSVR_DEV_VERBOSE("Error getting render info: no pose yet "
+                             "available");
+            return OSVR_RETURN_FAILURE;
+        }
+    }
+    try {
+        for (OSVR_ViewerCount viewer = 0; viewer < cfg.getNumViewers();
+             ++viewer) {
+            auto eyes = cfg.getNumViewerEyes(viewer);
+            if (eyes == 0) {
+                continue;
+            }
+            // All eyes of a viewer follow its tracker: one sample for all.
+            Eigen::Isometry3d trackerPose =
+                cfg.getViewerEye(viewer, 0).getTrackerPose(targetTime);
+            for (OSVR_EyeCount eye = 0; eye < eyes; ++eye) {
+                auto const &viewerEye = cfg.getViewerEye(viewer, eye);
+                Eigen::Isometry3d eyePose =
+                    viewerEye.getPoseFromTracker(trackerPose);
+                OSVR_Pose3 pose;
+                osvr::util::toPose(eyePose, pose);
+                Eigen::Matrix4d view = eyePose.inverse().matrix();
+                auto surfaces = cfg.getNumViewerEyeSurfaces(viewer, eye);
+                for (OSVR_SurfaceCount surface = 0; surface < surfaces;
+                     ++surface) {
+                    auto const &eyeSurface =
+                        cfg.getViewerEyeSurface(viewer, eye, surface);
+                    auto &out = *info;
+                    ++info;
+                    out.viewer = viewer;
+                    out.eye = eye;
+                    out.surface = surface;
+                    out.pose = pose;
+                    osvr::util::matrixEigenAssign(view, flags,
+                                                  out.viewMatrix);
+                    osvr::util::matrixEigenAssign(
+                        eyeSurface.getProjection(near, far, flags), flags,
+                        out.projectionMatrix);
+                    auto viewport = eyeSurface.getDisplayRelativeViewport();
+                    out.viewportLeft = viewport.left;
+                    out.viewportBottom = viewport.bottom;
+                    out.viewportWidth = viewport.width;
+                    out.viewportHeight = viewport.height;
+                    out.displayInput = eyeSurface.getDisplayInputIdx();
+                    out.radialDistortionPriority =
+                        eyeSurface.getRadialDistortionPriority();
+                    out.radialDistortion =
+                        eyeSurface.getRadialDistortionParams().get_value_or(
+                            OSVR_RadialDistortionParameters{});
+                }
+            }
+        }
+        return OSVR_RETURN_SUCCESS;
+    } catch (std::exception &e) {
+        OSVR_DEV_VERBOSE("Error getting render info - exception: " << e.what());
+        return OSVR_RETURN_FAILURE;
+    }
+}
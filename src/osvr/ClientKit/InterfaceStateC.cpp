@@ -32,6 +32,12 @@
 // Standard includes
 // - none
 
+OSVR_ReturnCode osvrSetStateHistoryCapacity(OSVR_ClientInterface iface,
+                                            size_t capacity) {
+    iface->setStateHistoryCapacity(capacity);
+    return OSVR_RETURN_SUCCESS;
+}
+
 #define OSVR_CALLBACK_METHODS(TYPE)                                            \
     OSVR_ReturnCode osvrGet##TYPE##State(OSVR_ClientInterface iface,           \
                                          struct OSVR_TimeValue *timestamp,     \
@@ -39,6 +45,13 @@
         bool hasState =                                                        \
             iface->getState<OSVR_##TYPE##Report>(*timestamp, *state);          \
         return hasState ? OSVR_RETURN_SUCCESS : OSVR_RETURN_FAILURE;           \
+    }                                                                          \
+    OSVR_ReturnCode osvrGet##TYPE##StateAtTime(                                \
+        OSVR_ClientInterface iface, struct OSVR_TimeValue const *time,         \
+        struct OSVR_TimeValue *timestamp, OSVR_##TYPE##State *state) {         \
+        bool hasState = iface->getStateAtTime<OSVR_##TYPE##Report>(            \
+            *time, *timestamp, *state);                                        \
+        return hasState ? OSVR_RETURN_SUCCESS : OSVR_RETURN_FAILURE;           \
     }
 
 OSVR_CALLBACK_METHODS(Pose)
@@ -39,6 +39,8 @@ using ::osvr::common::ClientInterface;
 using ::osvr::common::ClientContextDeleter;
 using ::osvr::make_shared;
 
+const std::size_t OSVR_ClientContextObject::MAX_DEFERRED_CALLBACKS;
+
 namespace osvr {
 namespace common {
     void deleteContext(ClientContext *ctx) {
@@ -71,17 +73,81 @@ std::string const &OSVR_ClientContextObject::getAppId() const {
 }
 
 void OSVR_ClientContextObject::update() {
+    if (m_hasUpdateThread) {
+        m_callDeferredCallbacks();
+        return;
+    }
+    m_runUpdate();
+}
+
+void OSVR_ClientContextObject::m_runUpdate() {
     m_update();
     for (auto const &iface : m_interfaces) {
         iface->update();
+        iface->publishState();
     }
 }
 
+void OSVR_ClientContextObject::m_callDeferredCallbacks() {
+    if (m_callingDeferred) {
+        // A callback called update(): the rest get called when it returns.
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_deferredMutex);
+        m_calling.swap(m_deferred);
+        m_droppingDeferred = false;
+    }
+    m_callingDeferred = true;
+    for (auto const &deferred : m_calling) {
+        // Null if its interface got released in the meantime.
+        if (deferred.iface) {
+            deferred.call();
+        }
+    }
+    m_callingDeferred = false;
+    std::lock_guard<std::mutex> lock(m_deferredMutex);
+    m_calling.clear();
+}
+
+void OSVR_ClientContextObject::deferCallback(ClientInterface *iface,
+                                             std::function<void()> const &call) {
+    std::lock_guard<std::mutex> lock(m_deferredMutex);
+    if (m_deferred.size() >= MAX_DEFERRED_CALLBACKS) {
+        if (!m_droppingDeferred) {
+            OSVR_DEV_VERBOSE("Client context for "
+                             << m_appId
+                             << " is dropping its oldest callbacks: call "
+                                "update() more often to keep up.");
+            m_droppingDeferred = true;
+        }
+        m_deferred.pop_front();
+    }
+    m_deferred.push_back(DeferredCallback{iface, call});
+}
+
+void OSVR_ClientContextObject::m_enableUpdateThread(bool deferCallbacks) {
+    m_hasUpdateThread = true;
+    m_deferCallbacks = deferCallbacks;
+}
+
+std::unique_lock<std::recursive_mutex>
+OSVR_ClientContextObject::lockUpdates() const {
+    if (!m_hasUpdateThread) {
+        return std::unique_lock<std::recursive_mutex>();
+    }
+    return std::unique_lock<std::recursive_mutex>(m_updateMutex);
+}
+
 ClientInterfacePtr OSVR_ClientContextObject::getInterface(const char path[]) {
+    auto lock = lockUpdates();
     auto ret = m_clientInterfaceFactory(*this, path);
     if (!ret) {
         return ret;
     }
+    if (m_hasUpdateThread) {
+        ret->enableStateSnapshots();
+    }
     m_handleNewInterface(ret);
     m_interfaces.push_back(ret);
     return ret;
@@ -93,6 +159,7 @@ OSVR_ClientContextObject::releaseInterface(ClientInterface *iface) {
     if (!iface) {
         return ret;
     }
+    auto lock = lockUpdates();
     auto it = std::find_if(begin(m_interfaces), end(m_interfaces),
                            [&](ClientInterfacePtr const &ptr) {
                                if (ptr.get() == iface) {
@@ -109,12 +176,22 @@ OSVR_ClientContextObject::releaseInterface(ClientInterface *iface) {
         m_interfaces.erase(it);
         // Notify the derived class if desired
         m_handleReleasingInterface(ret);
+        // Drop any of its callbacks still waiting to be called.
+        std::lock_guard<std::mutex> deferredLock(m_deferredMutex);
+        for (auto *queue : {&m_deferred, &m_calling}) {
+            for (auto &deferred : *queue) {
+                if (deferred.iface == iface) {
+                    deferred.iface = nullptr;
+                }
+            }
+        }
     }
     return ret;
 }
 
 std::string
 OSVR_ClientContextObject::getStringParameter(std::string const &path) const {
+    auto lock = lockUpdates();
     return getJSONStringFromTree(getPathTree(), path);
 }
 
@@ -123,10 +200,12 @@ osvr::common::PathTree const &OSVR_ClientContextObject::getPathTree() const {
 }
 
 void OSVR_ClientContextObject::sendRoute(std::string const &route) {
+    auto lock = lockUpdates();
     m_sendRoute(route);
 }
 
 bool OSVR_ClientContextObject::releaseObject(void *obj) {
+    std::lock_guard<std::mutex> lock(m_ownedObjectsMutex);
     return m_ownedObjects.release(obj);
 }
 
@@ -137,6 +216,7 @@ OSVR_ClientContextObject::getRoomToWorldTransform() const {
 
 void OSVR_ClientContextObject::setRoomToWorldTransform(
     osvr::common::Transform const &xform) {
+    auto lock = lockUpdates();
     m_setRoomToWorldTransform(xform);
 }
 
@@ -144,7 +224,10 @@ ClientContextDeleter OSVR_ClientContextObject::getDeleter() const {
     return m_deleter;
 }
 
-bool OSVR_ClientContextObject::getStatus() const { return m_getStatus(); }
+bool OSVR_ClientContextObject::getStatus() const {
+    auto lock = lockUpdates();
+    return m_getStatus();
+}
 
 bool OSVR_ClientContextObject::m_getStatus() const {
     // by default, assume we are started up.
@@ -49,6 +49,11 @@ namespace common {
     /// that would interfere with communication.
     static IPCRingBuffer::abi_level_type SHM_SOURCE_ABI_LEVEL = 0;
 
+    /// @brief the ABI level of the lock-free (seqlock) mode: same rules as
+    /// above, but for SeqlockBookkeeping and SeqlockElementData. Kept in a
+    /// disjoint range so that it can never be confused with the mutex mode.
+    static IPCRingBuffer::abi_level_type SHM_SEQLOCK_ABI_LEVEL = 0x10000;
+
 /// Some tests that can be automated for ensuring validity of the ABI level
 /// number.
 /// The base boost version test has been moved exclusively to CMake, to error
@@ -104,25 +109,75 @@ namespace common {
             size_t alignedEntrySize = opts.getEntrySize() + opts.getAlignment();
             size_t dataSize = alignedEntrySize * (opts.getEntries() + 1);
             // Give 33% overhead on the raw bookkeeping data
-            static const size_t BOOKKEEPING_SIZE =
-                (sizeof(detail::Bookkeeping) +
-                 (sizeof(detail::ElementData) * opts.getEntries())) *
+            const size_t BOOKKEEPING_SIZE =
+                (opts.getSyncMode() == IPCRingBuffer::SyncMode::Seqlock
+                     ? (sizeof(detail::SeqlockBookkeeping) +
+                        (sizeof(detail::SeqlockElementData) *
+                         opts.getEntries()))
+                     : (sizeof(detail::Bookkeeping) +
+                        (sizeof(detail::ElementData) * opts.getEntries()))) *
                 4 / 3;
             return dataSize + BOOKKEEPING_SIZE;
         }
 
         class SharedMemorySegmentHolder {
           public:
-            SharedMemorySegmentHolder() : m_bookkeeping(nullptr) {}
+            SharedMemorySegmentHolder()
+                : m_bookkeeping(nullptr), m_seqlockBookkeeping(nullptr) {}
             virtual ~SharedMemorySegmentHolder(){};
 
+            /// @brief Non-null only in SyncMode::InterprocessMutex
             detail::Bookkeeping *getBookkeeping() { return m_bookkeeping; }
 
+            /// @brief Non-null only in SyncMode::Seqlock
+            detail::SeqlockBookkeeping *getSeqlockBookkeeping() {
+                return m_seqlockBookkeeping;
+            }
+
+            bool valid() const {
+                return nullptr != m_bookkeeping ||
+                       nullptr != m_seqlockBookkeeping;
+            }
+
             virtual uint64_t getSize() const = 0;
             virtual uint64_t getFreeMemory() const = 0;
 
           protected:
+            template <typename ManagedMemory>
+            void constructBookkeeping(ManagedMemory &shm,
+                                      IPCRingBuffer::Options const &opts) {
+                if (opts.getSyncMode() == IPCRingBuffer::SyncMode::Seqlock) {
+                    m_seqlockBookkeeping =
+                        detail::SeqlockBookkeeping::construct(shm, opts);
+                } else {
+                    m_bookkeeping = detail::Bookkeeping::construct(shm, opts);
+                }
+            }
+
+            template <typename ManagedMemory>
+            void findBookkeeping(ManagedMemory &shm,
+                                 IPCRingBuffer::Options const &opts) {
+                if (opts.getSyncMode() == IPCRingBuffer::SyncMode::Seqlock) {
+                    m_seqlockBookkeeping =
+                        detail::SeqlockBookkeeping::find(shm);
+                } else {
+                    m_bookkeeping = detail::Bookkeeping::find(shm);
+                }
+            }
+
+            template <typename ManagedMemory>
+            void destroyBookkeeping(ManagedMemory &shm) {
+                if (nullptr != m_seqlockBookkeeping) {
+                    // Seqlock readers take no locks, so one may still be
+                    // reading: leave the bookkeeping for it to find nothing
+                    // new in, as the segment goes with its last mapping.
+                    return;
+                }
+                detail::Bookkeeping::destroy(shm);
+            }
+
             detail::Bookkeeping *m_bookkeeping;
+            detail::SeqlockBookkeeping *m_seqlockBookkeeping;
         };
 
         template <typename ManagedMemory>
@@ -162,12 +217,13 @@ namespace common {
                     return;
                 }
                 // detail::Bookkeeping::destroy(*Base::m_shm);
-                Base::m_bookkeeping =
-                    detail::Bookkeeping::construct(*Base::m_shm, opts);
+                Base::constructBookkeeping(*Base::m_shm, opts);
             }
 
             virtual ~ServerSharedMemorySegmentHolder() {
-                detail::Bookkeeping::destroy(*Base::m_shm);
+                if (Base::m_shm) {
+                    Base::destroyBookkeeping(*Base::m_shm);
+                }
                 removeSharedMemory();
             }
 
@@ -196,7 +252,7 @@ namespace common {
                                      << " with exception: " << e.what());
                     return;
                 }
-                Base::m_bookkeeping = detail::Bookkeeping::find(*Base::m_shm);
+                Base::findBookkeeping(*Base::m_shm, opts);
             }
 
             virtual ~ClientSharedMemorySegmentHolder() {}
@@ -217,7 +273,7 @@ namespace common {
                 ret.reset(
                     new ClientSharedMemorySegmentHolder<ManagedMemory>(opts));
             }
-            if (nullptr == ret->getBookkeeping()) {
+            if (!ret->valid()) {
                 ret.reset();
             } else {
                 OSVR_SHM_VERBOSE("size: " << ret->getSize() << ", free: "
@@ -237,6 +293,14 @@ namespace common {
         }
     }
 
+    void IPCRingBuffer::BufferWriteProxy::abandon() {
+        if (m_data) {
+            m_data->abandoned = true;
+            m_data.reset();
+        }
+        m_buf = nullptr;
+    }
+
     IPCRingBuffer::BufferReadProxy::BufferReadProxy(
         detail::IPCGetResultPtr &&data, IPCRingBufferPtr &&shm)
         : m_buf(nullptr), m_seq(0), m_data(std::move(data)) {
@@ -287,45 +351,65 @@ namespace common {
         m_entrySize = entrySize;
         return *this;
     }
+
+    IPCRingBuffer::Options &IPCRingBuffer::Options::setSyncMode(SyncMode mode) {
+        m_syncMode = mode;
+        return *this;
+    }
     class IPCRingBuffer::Impl {
       public:
         Impl(unique_ptr<SharedMemorySegmentHolder> &&segment,
              Options const &opts)
-            : m_seg(std::move(segment)), m_bookkeeping(nullptr), m_opts(opts) {
+            : m_seg(std::move(segment)), m_bookkeeping(nullptr),
+              m_seqlock(nullptr), m_opts(opts),
+              m_pool(util::BlockPool::create()) {
             m_bookkeeping = m_seg->getBookkeeping();
-            m_opts.setEntries(m_bookkeeping->getCapacity());
-            m_opts.setEntrySize(m_bookkeeping->getBufferLength());
+            m_seqlock = m_seg->getSeqlockBookkeeping();
+            if (m_seqlock) {
+                m_opts.setEntries(m_seqlock->getCapacity());
+                m_opts.setEntrySize(m_seqlock->getBufferLength());
+            } else {
+                m_opts.setEntries(m_bookkeeping->getCapacity());
+                m_opts.setEntrySize(m_bookkeeping->getBufferLength());
+            }
         }
 
         detail::IPCPutResultPtr put() {
+            if (m_seqlock) {
+                return m_seqlock->produceElement();
+            }
             return m_bookkeeping->produceElement();
         }
 
         detail::IPCGetResultPtr get(sequence_type num) {
+            if (m_seqlock) {
+                return m_getOptimistic(num);
+            }
             detail::IPCGetResultPtr ret;
             auto boundsLock = m_bookkeeping->getSharableLock();
             auto elt = m_bookkeeping->getBySequenceNumber(num, boundsLock);
             if (nullptr != elt) {
                 auto readerLock = elt->getSharableLock();
                 auto buf = elt->getBuf(readerLock);
-                /// The nullptr will be filled in by the main object.
-                ret.reset(new detail::IPCGetResult{buf, std::move(readerLock),
-                                                   num, nullptr});
+                ret = m_makeResult(buf, num);
+                ret->elementLock = std::move(readerLock);
             }
             return ret;
         }
 
         detail::IPCGetResultPtr getLatest() {
+            if (m_seqlock) {
+                return m_getLatestOptimistic();
+            }
             detail::IPCGetResultPtr ret;
             auto boundsLock = m_bookkeeping->getSharableLock();
             auto elt = m_bookkeeping->back(boundsLock);
             if (nullptr != elt) {
                 auto readerLock = elt->getSharableLock();
                 auto buf = elt->getBuf(readerLock);
-                /// The nullptr will be filled in by the main object.
-                ret.reset(new detail::IPCGetResult{
-                    buf, std::move(readerLock),
-                    m_bookkeeping->backSequenceNumber(boundsLock), nullptr});
+                ret = m_makeResult(
+                    buf, m_bookkeeping->backSequenceNumber(boundsLock));
+                ret->elementLock = std::move(readerLock);
             }
             return ret;
         }
@@ -333,10 +417,55 @@ namespace common {
         Options const &getOpts() const { return m_opts; }
 
       private:
+        /// @brief How many times getLatest() will chase the producer in the
+        /// lock-free mode before giving up.
+        static const int MAX_LATEST_READ_ATTEMPTS = 3;
+
+        detail::IPCGetResultPtr m_getOptimistic(sequence_type num) {
+            detail::IPCGetResultPtr ret;
+            auto copy =
+                util::makePooledImageBuffer(m_pool, m_opts.getEntrySize());
+            if (m_seqlock->tryRead(num, copy.get())) {
+                ret = m_makeResult(copy.get(), num);
+                ret->localCopy = std::move(copy);
+            }
+            return ret;
+        }
+
+        detail::IPCGetResultPtr m_getLatestOptimistic() {
+            detail::IPCGetResultPtr ret;
+            for (int i = 0; i < MAX_LATEST_READ_ATTEMPTS && !ret; ++i) {
+                sequence_type num;
+                if (!m_seqlock->getLatestSequenceNumber(num)) {
+                    break;
+                }
+                // If this fails, the producer lapped us: try the new latest.
+                ret = m_getOptimistic(num);
+            }
+            return ret;
+        }
+
+        /// @brief Gets a result object, along with its shared_ptr control
+        /// block, from our pool rather than the heap, since a high-rate client
+        /// gets one of these per frame.
+        detail::IPCGetResultPtr m_makeResult(value_type *buf,
+                                             sequence_type num) {
+            auto ret = allocate_shared<detail::IPCGetResult>(
+                util::BlockPoolAllocator<detail::IPCGetResult>(m_pool));
+            ret->buffer = buf;
+            ret->seq = num;
+            /// The shm member will be filled in by the main object.
+            return ret;
+        }
+
         unique_ptr<SharedMemorySegmentHolder> m_seg;
         detail::Bookkeeping *m_bookkeeping;
+        detail::SeqlockBookkeeping *m_seqlock;
 
         Options m_opts;
+        /// @brief Recycles result objects and, in the lock-free mode, the
+        /// private copies of entries.
+        util::BlockPoolPtr m_pool;
     };
 
     IPCRingBufferPtr IPCRingBuffer::m_constructorHelper(Options const &opts,
@@ -384,6 +513,24 @@ namespace common {
         return SHM_SOURCE_ABI_LEVEL;
     }
 
+    IPCRingBuffer::abi_level_type IPCRingBuffer::getABILevel(SyncMode mode) {
+        return mode == SyncMode::Seqlock ? SHM_SEQLOCK_ABI_LEVEL
+                                         : SHM_SOURCE_ABI_LEVEL;
+    }
+
+    bool IPCRingBuffer::getSyncModeForABILevel(abi_level_type abi,
+                                               SyncMode &mode) {
+        if (abi == SHM_SOURCE_ABI_LEVEL) {
+            mode = SyncMode::InterprocessMutex;
+            return true;
+        }
+        if (abi == SHM_SEQLOCK_ABI_LEVEL) {
+            mode = SyncMode::Seqlock;
+            return true;
+        }
+        return false;
+    }
+
     IPCRingBufferPtr IPCRingBuffer::create(Options const &opts) {
         return m_constructorHelper(opts, true);
     }
@@ -404,6 +551,10 @@ namespace common {
         return m_impl->getOpts().getName();
     }
 
+    IPCRingBuffer::SyncMode IPCRingBuffer::getSyncMode() const {
+        return m_impl->getOpts().getSyncMode();
+    }
+
     uint32_t IPCRingBuffer::getEntrySize() const {
         return m_impl->getOpts().getEntrySize();
     }
@@ -29,6 +29,7 @@
 #include <osvr/Common/IPCRingBuffer.h>
 #include "SharedMemory.h"
 #include "SharedMemoryObjectWithMutex.h"
+#include <osvr/Util/BlockPool.h>
 
 // Library/third-party includes
 // - none
@@ -40,20 +41,21 @@ namespace osvr {
 namespace common {
 
     namespace detail {
+        class SeqlockBookkeeping;
         struct IPCPutResult {
-            ~IPCPutResult() {
-#ifdef OSVR_SHM_LOCK_DEBUGGING
-                OSVR_DEV_VERBOSE("Releasing exclusive lock on sequence "
-                                 << seq);
-#endif
-                elementLock.unlock();
-                boundsLock.unlock();
-            }
+            /// @brief Defined in IPCRingBufferSharedObjects.h, since it needs
+            /// the full definition of SeqlockBookkeeping.
+            inline ~IPCPutResult();
             IPCRingBuffer::value_type *buffer;
             IPCRingBuffer::sequence_type seq;
             ipc::exclusive_lock_type elementLock;
             ipc::exclusive_lock_type boundsLock;
             IPCRingBufferPtr shm;
+            /// @brief Non-null only in the lock-free mode, where the element
+            /// is published on destruction instead of unlocked.
+            SeqlockBookkeeping *seqlock;
+            /// @brief Set to leave a lock-free mode element unpublished.
+            bool abandoned;
         };
 
         struct IPCGetResult {
@@ -62,12 +64,17 @@ namespace common {
 #ifdef OSVR_SHM_LOCK_DEBUGGING
                 OSVR_DEV_VERBOSE("Releasing shared lock on sequence " << seq);
 #endif
-                elementLock.unlock();
+                if (elementLock) {
+                    elementLock.unlock();
+                }
             }
             IPCRingBuffer::value_type *buffer;
             ipc::sharable_lock_type elementLock;
             IPCRingBuffer::sequence_type seq;
             IPCRingBufferPtr shm;
+            /// @brief Only used in the lock-free mode: the private copy of the
+            /// entry that buffer points to.
+            util::PooledImageBufferPtr localCopy;
         };
     } // namespace detail
 
@@ -37,6 +37,8 @@
 #include <boost/noncopyable.hpp>
 
 // Standard includes
+#include <atomic>
+#include <cstring>
 #include <utility>
 
 namespace osvr {
@@ -201,7 +203,8 @@ namespace common {
                 /// shared memory nullptr filled in by outer class
                 IPCPutResultPtr ret(new IPCPutResult{
                     back(lock)->getBuf(elementLock), sequenceNumber,
-                    std::move(elementLock), std::move(lock), nullptr});
+                    std::move(elementLock), std::move(lock), nullptr,
+                    nullptr, false});
                 return ret;
             }
 
@@ -214,6 +217,240 @@ namespace common {
             raw_index_type m_size;
             uint32_t m_bufLen;
         };
+
+        static_assert(ATOMIC_INT_LOCK_FREE == 2,
+                      "The lock-free ring buffer mode places std::atomic "
+                      "integers in shared memory, which requires them to be "
+                      "always lock-free (and thus address-free).");
+
+        /// @brief Element data for the lock-free (seqlock) ring buffer mode:
+        /// instead of a mutex, the element carries a version stamp that is odd
+        /// while the producer is writing to it, and the sequence number of the
+        /// entry it currently holds.
+        class SeqlockElementData : boost::noncopyable {
+          public:
+            typedef IPCRingBuffer::value_type BufferType;
+            typedef IPCRingBuffer::sequence_type sequence_type;
+            typedef uint32_t version_type;
+
+            SeqlockElementData() : m_version(0), m_seq(0), m_buf(nullptr) {}
+
+            BufferType *getBuf() const { return m_buf.get(); }
+
+            template <typename ManagedMemory>
+            void allocateBuf(ManagedMemory &shm,
+                             IPCRingBuffer::Options const &opts) {
+                freeBuf(shm);
+                m_buf = static_cast<BufferType *>(shm.allocate_aligned(
+                    opts.getEntrySize(), opts.getAlignment()));
+            }
+
+            template <typename ManagedMemory> void freeBuf(ManagedMemory &shm) {
+                if (nullptr != m_buf) {
+                    shm.deallocate(m_buf.get());
+                }
+                m_buf = nullptr;
+            }
+
+            /// @brief Producer only: marks the element as being written, to
+            /// hold the given sequence number.
+            void beginWrite(sequence_type seq) {
+                auto v = m_version.load(std::memory_order_relaxed);
+                m_version.store(v + 1, std::memory_order_relaxed);
+                // Keep the data writes from moving ahead of the odd stamp.
+                std::atomic_thread_fence(std::memory_order_release);
+                m_seq.store(seq, std::memory_order_relaxed);
+            }
+
+            /// @brief Producer only: marks the write as complete.
+            void endWrite() {
+                auto v = m_version.load(std::memory_order_relaxed);
+                m_version.store(v + 1, std::memory_order_release);
+            }
+
+            /// @brief Reader: copies out the element, if it holds the given
+            /// sequence number and wasn't written to during the copy.
+            bool tryCopy(sequence_type seq, BufferType *dest,
+                         size_t len) const {
+                auto before = m_version.load(std::memory_order_acquire);
+                if ((before & 0x1) != 0 ||
+                    m_seq.load(std::memory_order_relaxed) != seq) {
+                    return false;
+                }
+                std::memcpy(dest, m_buf.get(), len);
+                // Keep the data reads from moving past the validation.
+                std::atomic_thread_fence(std::memory_order_acquire);
+                return m_version.load(std::memory_order_relaxed) == before;
+            }
+
+          private:
+            std::atomic<version_type> m_version;
+            std::atomic<sequence_type> m_seq;
+            ipc_offset_ptr<BufferType> m_buf;
+        };
+
+        /// @brief Bookkeeping for the lock-free (seqlock) ring buffer mode.
+        ///
+        /// There is exactly one producer, who never waits: it may overwrite an
+        /// entry that a reader is in the middle of copying, in which case that
+        /// reader's validation fails and it reports the entry as unavailable.
+        class SeqlockBookkeeping : boost::noncopyable {
+          public:
+            typedef IPCRingBuffer::sequence_type sequence_type;
+            typedef uint16_t raw_index_type;
+
+            template <typename ManagedMemory>
+            static SeqlockBookkeeping *find(ManagedMemory &shm) {
+                auto self =
+                    shm.template find<SeqlockBookkeeping>(bip::unique_instance);
+                return self.first;
+            }
+
+            template <typename ManagedMemory>
+            static SeqlockBookkeeping *
+            construct(ManagedMemory &shm, IPCRingBuffer::Options const &opts) {
+                return shm.template construct<SeqlockBookkeeping>(
+                    bip::unique_instance)(shm, opts);
+            }
+
+            template <typename ManagedMemory>
+            static void destroy(ManagedMemory &shm) {
+                auto self = find(shm);
+                if (nullptr == self) {
+                    return;
+                }
+                self->freeBufs(shm);
+                shm.template destroy<SeqlockBookkeeping>(bip::unique_instance);
+            }
+
+            template <typename ManagedMemory>
+            SeqlockBookkeeping(ManagedMemory &shm,
+                               IPCRingBuffer::Options const &opts)
+                : m_capacity(opts.getEntries()),
+                  elementArray(shm.template construct<SeqlockElementData>(
+                      bip::unique_instance)[m_capacity]()),
+                  m_nextSequenceNumber(0), m_size(0),
+                  m_bufLen(opts.getEntrySize()) {
+                for (raw_index_type i = 0; i < m_capacity; ++i) {
+                    try {
+                        (elementArray + i)->allocateBuf(shm, opts);
+                    } catch (std::bad_alloc &) {
+                        OSVR_DEV_VERBOSE("Couldn't allocate buffer #"
+                                         << i
+                                         << ", truncating the ring buffer");
+                        m_capacity = i;
+                        break;
+                    }
+                }
+            }
+
+            template <typename ManagedMemory>
+            void freeBufs(ManagedMemory &shm) {
+                for (raw_index_type i = 0; i < m_capacity; ++i) {
+                    (elementArray + i)->freeBuf(shm);
+                }
+                shm.template destroy<SeqlockElementData>(bip::unique_instance);
+            }
+
+            /// @brief Get number of elements.
+            raw_index_type getCapacity() const { return m_capacity; }
+
+            /// @brief Get capacity of elements.
+            uint32_t getBufferLength() const { return m_bufLen; }
+
+            /// @brief Producer only: starts writing the next element. It is
+            /// published when the returned result is destroyed.
+            IPCPutResultPtr produceElement() {
+                auto sequenceNumber =
+                    m_nextSequenceNumber.load(std::memory_order_relaxed);
+                auto &elt = getBySequenceNumber(sequenceNumber);
+                elt.beginWrite(sequenceNumber);
+                /// shared memory nullptr filled in by outer class
+                IPCPutResultPtr ret(new IPCPutResult{
+                    elt.getBuf(), sequenceNumber, ipc::exclusive_lock_type(),
+                    ipc::exclusive_lock_type(), nullptr, this, false});
+                return ret;
+            }
+
+            /// @brief Producer only: publishes the element started by
+            /// produceElement()
+            void publishElement(sequence_type sequenceNumber) {
+                getBySequenceNumber(sequenceNumber).endWrite();
+                auto size = m_size.load(std::memory_order_relaxed);
+                if (size < m_capacity) {
+                    m_size.store(size + 1, std::memory_order_relaxed);
+                }
+                m_nextSequenceNumber.store(sequenceNumber + 1,
+                                           std::memory_order_release);
+            }
+
+            /// @brief Producer only: ends writing the element started by
+            /// produceElement() without publishing it, so its sequence number
+            /// goes to the next element produced.
+            void abandonElement(sequence_type sequenceNumber) {
+                getBySequenceNumber(sequenceNumber).endWrite();
+            }
+
+            /// @brief Reader: gets the most recently published sequence
+            /// number.
+            /// @return false if nothing has been published yet.
+            bool getLatestSequenceNumber(sequence_type &num) const {
+                auto next =
+                    m_nextSequenceNumber.load(std::memory_order_acquire);
+                if (m_size.load(std::memory_order_relaxed) == 0) {
+                    return false;
+                }
+                num = next - 1;
+                return true;
+            }
+
+            /// @brief Reader: copies out the entry with the given sequence
+            /// number into dest, which must be at least getBufferLength()
+            /// bytes.
+            /// @return false if that entry is not (or no longer) available.
+            bool tryRead(sequence_type num,
+                         IPCRingBuffer::value_type *dest) const {
+                auto next =
+                    m_nextSequenceNumber.load(std::memory_order_acquire);
+                auto size = m_size.load(std::memory_order_relaxed);
+                sequence_type sequenceRelativeToBack = next - 1 - num;
+                if (sequenceRelativeToBack >= size) {
+                    return false; // out of bounds request
+                }
+                return getBySequenceNumber(num).tryCopy(num, dest, m_bufLen);
+            }
+
+          private:
+            /// @brief The element an entry lives in is a pure function of its
+            /// sequence number, so readers need no shared index state. (When
+            /// the sequence number wraps, a few elements get recycled early,
+            /// which the per-element sequence check handles.)
+            SeqlockElementData &getBySequenceNumber(sequence_type num) const {
+                return *(elementArray + (num % m_capacity));
+            }
+
+            raw_index_type m_capacity;
+            ipc_offset_ptr<SeqlockElementData> elementArray;
+            std::atomic<sequence_type> m_nextSequenceNumber;
+            std::atomic<uint32_t> m_size;
+            uint32_t m_bufLen;
+        };
+
+        inline IPCPutResult::~IPCPutResult() {
+            if (nullptr != seqlock) {
+                if (abandoned) {
+                    seqlock->abandonElement(seq);
+                } else {
+                    seqlock->publishElement(seq);
+                }
+                return;
+            }
+#ifdef OSVR_SHM_LOCK_DEBUGGING
+            OSVR_DEV_VERBOSE("Releasing exclusive lock on sequence " << seq);
+#endif
+            elementLock.unlock();
+            boundsLock.unlock();
+        }
     } // namespace detail
 
 } // namespace common
@@ -28,6 +28,7 @@
 #include <osvr/Common/Serialization.h>
 #include <osvr/Common/Buffer.h>
 #include <osvr/Util/AlignedMemoryUniquePtr.h>
+#include <osvr/Util/BlockPool.h>
 #include <osvr/Util/Flag.h>
 #include <osvr/Util/Verbosity.h>
 
@@ -68,11 +69,14 @@ namespace common {
                            }), // That's a null-deleter right there for you.
                   m_sensor(sensor) {}
 
-            MessageSerialization() : m_imgBuf(nullptr) {}
+            /// @brief Constructor for deserializing, drawing the image buffer
+            /// from the given pool.
+            explicit MessageSerialization(util::BlockPoolPtr const &pool)
+                : m_imgBuf(nullptr), m_pool(pool) {}
 
             template <typename T>
             void allocateBuffer(T &, size_t bytes, std::true_type const &) {
-                m_imgBuf = util::makeAlignedImageBuffer(bytes);
+                m_imgBuf = util::makeSharedPooledImageBuffer(m_pool, bytes);
             }
 
             template <typename T>
@@ -102,6 +106,7 @@ namespace common {
             OSVR_ImagingMetadata m_meta;
             ImageBufferPtr m_imgBuf;
             OSVR_ChannelCount m_sensor;
+            util::BlockPoolPtr m_pool;
         };
         const char *ImageRegion::identifier() {
             return "com.osvr.imaging.imageregion";
@@ -201,7 +206,12 @@ namespace common {
         return ret;
     }
     ImagingComponent::ImagingComponent(OSVR_ChannelCount numChan)
-        : m_numSensor(numChan) {}
+        : m_numSensor(numChan), m_gotOne(false),
+          m_pool(util::BlockPool::create()),
+          m_shmMessage(
+              new messages::ImagePlacedInSharedMemory::MessageSerialization) {}
+
+    ImagingComponent::~ImagingComponent() {}
 
     void ImagingComponent::sendImageData(OSVR_ImagingMetadata metadata,
                                          OSVR_ImageBufferElement *imageData,
@@ -247,12 +257,16 @@ namespace common {
     }
 #endif
 
-    bool ImagingComponent::m_sendImageDataViaSharedMemory(
-        OSVR_ImagingMetadata metadata, OSVR_ImageBufferElement *imageData,
-        OSVR_ChannelCount sensor, OSVR_TimeValue const &timestamp) {
-
+    IPCRingBufferPtr const &
+    ImagingComponent::m_getShmBufFor(OSVR_ImagingMetadata const &metadata,
+                                     OSVR_ChannelCount sensor) {
         m_growShmVecIfRequired(sensor);
         uint32_t imageBufferSize = getBufferSize(metadata);
+#ifdef OSVR_COMMON_SEQLOCK_IMAGING
+        static const auto syncMode = IPCRingBuffer::SyncMode::Seqlock;
+#else
+        static const auto syncMode = IPCRingBuffer::SyncMode::InterprocessMutex;
+#endif
         if (!m_shmBuf[sensor] ||
             m_shmBuf[sensor]->getEntrySize() != imageBufferSize) {
             // create or replace the shared memory ring buffer.
@@ -265,25 +279,120 @@ namespace common {
             m_shmBuf[sensor] = IPCRingBuffer::create(
                 IPCRingBuffer::Options(
                     makeName(sensor, m_getParent().getDeviceName()))
-                    .setEntrySize(imageBufferSize));
-        }
-        if (!m_shmBuf[sensor]) {
-            OSVR_DEV_VERBOSE(
-                "Some issue creating shared memory for imaging, skipping out.");
-            return false;
+                    .setEntrySize(imageBufferSize)
+                    .setSyncMode(syncMode));
         }
-        auto &shm = *(m_shmBuf[sensor]);
-        auto seq = shm.put(imageData, imageBufferSize);
+        return m_shmBuf[sensor];
+    }
 
+    void ImagingComponent::m_sendShmNotification(
+        OSVR_ImagingMetadata const &metadata, IPCRingBuffer const &shm,
+        IPCRingBuffer::sequence_type seq, OSVR_ChannelCount sensor,
+        OSVR_TimeValue const &timestamp) {
         Buffer<> buf;
         messages::ImagePlacedInSharedMemory::MessageSerialization serialization(
-            messages::SharedMemoryMessage{metadata, seq, sensor,
-                                          IPCRingBuffer::getABILevel(),
-                                          shm.getBackend(), shm.getName()});
+            messages::SharedMemoryMessage{
+                metadata, seq, sensor,
+                IPCRingBuffer::getABILevel(shm.getSyncMode()),
+                shm.getBackend(), shm.getName()});
         serialize(buf, serialization);
         m_getParent().packMessage(
             buf, imagePlacedInSharedMemory.getMessageType(), timestamp);
+    }
+
+    bool ImagingComponent::m_sendImageDataViaSharedMemory(
+        OSVR_ImagingMetadata metadata, OSVR_ImageBufferElement *imageData,
+        OSVR_ChannelCount sensor, OSVR_TimeValue const &timestamp) {
 
+        // Can't have two entries in progress at once: abandon the acquired
+        // one.
+        releaseImageBuffer(sensor);
+        auto &shmBuf = m_getShmBufFor(metadata, sensor);
+        if (!shmBuf) {
+            OSVR_DEV_VERBOSE(
+                "Some issue creating shared memory for imaging, skipping out.");
+            return false;
+        }
+        auto &shm = *shmBuf;
+        auto seq = shm.put(imageData, getBufferSize(metadata));
+        m_sendShmNotification(metadata, shm, seq, sensor, timestamp);
+        return true;
+    }
+
+    OSVR_ImageBufferElement *
+    ImagingComponent::acquireImageBuffer(OSVR_ImagingMetadata const &metadata,
+                                         OSVR_ChannelCount sensor) {
+        if (m_acquired.size() <= sensor) {
+            m_acquired.resize(sensor + 1);
+        }
+        auto &acquired = m_acquired[sensor];
+        auto imageBufferSize = getBufferSize(metadata);
+        if (acquired.buffer &&
+            getBufferSize(acquired.metadata) == imageBufferSize) {
+            // Re-use the not-yet-committed buffer.
+            acquired.metadata = metadata;
+            return acquired.buffer;
+        }
+        // Release whatever we had, in case the size changed.
+        releaseImageBuffer(sensor);
+        acquired.metadata = metadata;
+
+#ifndef OSVR_COMMON_IN_PROCESS_IMAGING
+        auto &shmBuf = m_getShmBufFor(metadata, sensor);
+        if (!shmBuf) {
+            OSVR_DEV_VERBOSE("Some issue creating shared memory for imaging, "
+                             "using a private frame buffer instead.");
+        } else if (shmBuf->getSyncMode() == IPCRingBuffer::SyncMode::Seqlock) {
+            // Only a lock-free ring buffer entry can be handed out to write
+            // into: the locks on any other would keep readers out until the
+            // commit. Otherwise, the commit copies in from a private buffer.
+            acquired.proxy.reset(
+                new IPCRingBuffer::BufferWriteProxy(shmBuf->put()));
+            acquired.buffer = acquired.proxy->get();
+            return acquired.buffer;
+        }
+#endif
+        acquired.fallback = util::makeAlignedImageBuffer(imageBufferSize);
+        acquired.buffer = acquired.fallback.get();
+        return acquired.buffer;
+    }
+
+    bool ImagingComponent::commitImageBuffer(OSVR_ChannelCount sensor,
+                                             OSVR_TimeValue const &timestamp) {
+        if (m_acquired.size() <= sensor || !m_acquired[sensor].buffer) {
+            return false;
+        }
+        AcquiredBuffer acquired = std::move(m_acquired[sensor]);
+        m_acquired[sensor] = AcquiredBuffer{};
+
+        if (!acquired.proxy) {
+            // Private buffer: the regular, copying, path.
+            sendImageData(acquired.metadata, acquired.buffer, sensor,
+                          timestamp);
+            return true;
+        }
+
+        auto seq = acquired.proxy->getSequenceNumber();
+        // Publishes the entry (and releases any locks) before we notify.
+        acquired.proxy.reset();
+        m_sendShmNotification(acquired.metadata, *m_shmBuf[sensor], seq, sensor,
+                              timestamp);
+        // We're the only writer, so the entry is still intact to read from for
+        // remote clients.
+        m_sendImageDataOnTheWire(acquired.metadata, acquired.buffer, sensor,
+                                 timestamp);
+        m_checkFirst(acquired.metadata);
+        return true;
+    }
+
+    bool ImagingComponent::releaseImageBuffer(OSVR_ChannelCount sensor) {
+        if (m_acquired.size() <= sensor || !m_acquired[sensor].buffer) {
+            return false;
+        }
+        if (m_acquired[sensor].proxy) {
+            m_acquired[sensor].proxy->abandon();
+        }
+        m_acquired[sensor] = AcquiredBuffer{};
         return true;
     }
 
@@ -316,7 +425,7 @@ namespace common {
         auto self = static_cast<ImagingComponent *>(userdata);
         auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
 
-        messages::ImageRegion::MessageSerialization msg;
+        messages::ImageRegion::MessageSerialization msg(self->m_pool);
         deserialize(bufReader, msg);
         auto data = msg.getData();
         auto timestamp = util::time::fromStructTimeval(p.msg_time);
@@ -358,27 +467,32 @@ namespace common {
         auto self = static_cast<ImagingComponent *>(userdata);
         auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
 
-        messages::ImagePlacedInSharedMemory::MessageSerialization msgSerialize;
+        // Reusing the message object keeps the storage of its string.
+        auto &msgSerialize = *self->m_shmMessage;
         deserialize(bufReader, msgSerialize);
         auto &msg = msgSerialize.getMessage();
         auto timestamp = util::time::fromStructTimeval(p.msg_time);
 
-        if (IPCRingBuffer::getABILevel() != msg.abiLevel) {
+        IPCRingBuffer::SyncMode syncMode;
+        if (!IPCRingBuffer::getSyncModeForABILevel(msg.abiLevel, syncMode)) {
             /// Can't interoperate with this server over shared memory
             OSVR_DEV_VERBOSE("Can't handle SHM ABI level " << msg.abiLevel);
             return 0;
         }
         self->m_growShmVecIfRequired(msg.sensor);
-        auto checkSameRingBuf = [](messages::SharedMemoryMessage const &msg,
-                                   IPCRingBufferPtr &ringbuf) {
+        auto checkSameRingBuf = [syncMode](
+            messages::SharedMemoryMessage const &msg,
+            IPCRingBufferPtr &ringbuf) {
             return (msg.backend == ringbuf->getBackend()) &&
+                   (ringbuf->getSyncMode() == syncMode) &&
                    (ringbuf->getEntrySize() == getBufferSize(msg.metadata)) &&
                    (ringbuf->getName() == msg.shmName);
         };
         if (!self->m_shmBuf[msg.sensor] ||
             !checkSameRingBuf(msg, self->m_shmBuf[msg.sensor])) {
             self->m_shmBuf[msg.sensor] = IPCRingBuffer::find(
-                IPCRingBuffer::Options(msg.shmName, msg.backend));
+                IPCRingBuffer::Options(msg.shmName, msg.backend)
+                    .setSyncMode(syncMode));
         }
         if (!self->m_shmBuf[msg.sensor]) {
             /// Can't find the shared memory referred to - possibly not a local
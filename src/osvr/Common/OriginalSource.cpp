@@ -210,5 +210,25 @@ namespace common {
     void OriginalSource::decompose(PathNode &node) {
         DecomposeOriginalSource decomp{node, *this};
     }
+
+    bool operator==(OriginalSource const &lhs, OriginalSource const &rhs) {
+        if (lhs.isResolved() != rhs.isResolved()) {
+            return false;
+        }
+        if (!lhs.isResolved()) {
+            return true;
+        }
+        if ((nullptr == lhs.getSensor()) != (nullptr == rhs.getSensor())) {
+            return false;
+        }
+        if (lhs.getSensor() &&
+            lhs.getSensor()->getName() != rhs.getSensor()->getName()) {
+            return false;
+        }
+        return lhs.getDevicePath() == rhs.getDevicePath() &&
+               lhs.getDeviceElement() == rhs.getDeviceElement() &&
+               lhs.getInterfaceName() == rhs.getInterfaceName() &&
+               lhs.getTransformJson() == rhs.getTransformJson();
+    }
 } // namespace common
 } // namespace osvr
@@ -56,6 +56,15 @@ namespace common {
                 m_val[name] = data;
             }
 
+            /// @brief Serialize a string with default, leaving it out when
+            /// it's the default
+            void operator()(const char name[], std::string const &data,
+                            const char defaultVal[]) {
+                if (data != defaultVal) {
+                    m_val[name] = data;
+                }
+            }
+
           private:
             Json::Value &m_val;
         };
@@ -71,6 +80,15 @@ namespace common {
                 m_requireName(name);
                 dataRef = m_val[name].asString();
             }
+            /// @brief Deserialize a string with default
+            void operator()(const char name[], std::string &dataRef,
+                            const char defaultVal[]) {
+                if (m_hasName(name)) {
+                    dataRef = m_val[name].asString();
+                } else {
+                    dataRef = defaultVal;
+                }
+            }
             /// @brief Deserialize a bool
             void operator()(const char name[], bool &dataRef) {
                 m_requireName(name);
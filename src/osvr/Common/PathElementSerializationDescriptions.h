@@ -53,6 +53,7 @@ namespace common {
             f("device_name", value.getDeviceName());
             f("server", value.getServer());
             f("descriptor", value.getDescriptor());
+            f("shared_reports", value.getSharedReports(), "");
         }
 
         /// @brief Description for AliasElement
@@ -108,6 +108,13 @@ namespace common {
         Json::Value const &DeviceElement::getDescriptor() const {
             return m_descriptor;
         }
+
+        std::string &DeviceElement::getSharedReports() {
+            return m_sharedReports;
+        }
+        std::string const &DeviceElement::getSharedReports() const {
+            return m_sharedReports;
+        }
     } // namespace elements
 } // namespace common
 } // namespace osvr
@@ -26,6 +26,7 @@
 #include <osvr/Common/PathTreeOwner.h>
 #include <osvr/Common/PathTreeObserver.h>
 #include <osvr/Common/PathTreeSerialization.h>
+#include <osvr/Common/ResolveTreeNode.h>
 
 // Library/third-party includes
 // - none
@@ -77,16 +78,38 @@ namespace common {
                 observer.notifyEvent(PathTreeEvents::AboutToUpdate, m_tree);
             });
 
+        /// Keep the outgoing tree around while observers compare against it.
+        m_previousTree.swap(m_tree);
         m_tree.reset();
 
         common::jsonToPathTree(m_tree, nodes);
 
+        /// Servers re-send the whole tree whenever anything in it changes, or
+        /// a client connects, so identical trees are common: catch those
+        /// before resolving anything.
+        m_unchanged = m_valid && nodes == m_nodes;
+        m_nodes = nodes;
         m_valid = true;
 
         for_each_cleanup_pointers(
             m_observers, [&](PathTreeObserver const &observer) {
                 observer.notifyEvent(PathTreeEvents::AfterUpdate, m_tree);
             });
+
+        m_previousTree.reset();
+        m_unchanged = false;
+    }
+
+    bool PathTreeOwner::hasResolutionChanged(std::string const &path) {
+        if (m_unchanged) {
+            return false;
+        }
+        auto before = common::resolveTreeNode(m_previousTree, path);
+        auto after = common::resolveTreeNode(m_tree, path);
+        if (before.is_initialized() != after.is_initialized()) {
+            return true;
+        }
+        return before.is_initialized() && *before != *after;
     }
 } // namespace common
 } // namespace osvr
@@ -35,7 +35,10 @@
 #include <json/value.h>
 
 // Standard includes
-// - none
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
 
 namespace osvr {
 namespace common {
@@ -101,5 +104,104 @@ namespace common {
             tree.getNodeByPath(node["path"].asString()).value() = elt;
         }
     }
+
+    namespace {
+        static const char OP_KEY[] = "op";
+        static const char OP_ADD[] = "add";
+        static const char OP_CHANGE[] = "change";
+        static const char OP_REMOVE[] = "remove";
+        static const char NODE_KEY[] = "node";
+        static const char PATH_KEY[] = "path";
+
+        typedef std::map<std::string, Json::ArrayIndex> NodeIndex;
+
+        /// @brief Map from path to index in an array of serialized nodes.
+        inline NodeIndex indexNodes(Json::Value const &nodes) {
+            NodeIndex ret;
+            for (Json::ArrayIndex i = 0, e = nodes.size(); i < e; ++i) {
+                ret[nodes[i][PATH_KEY].asString()] = i;
+            }
+            return ret;
+        }
+
+        inline Json::Value makeOp(const char *op, const char *key,
+                                  Json::Value const &val) {
+            Json::Value ret(Json::objectValue);
+            ret[OP_KEY] = op;
+            ret[key] = val;
+            return ret;
+        }
+    } // namespace
+
+    Json::Value diffPathTreeJson(Json::Value const &from,
+                                 Json::Value const &to) {
+        Json::Value ret(Json::arrayValue);
+        auto fromIndex = indexNodes(from);
+        auto toIndex = indexNodes(to);
+        for (auto const &entry : fromIndex) {
+            if (toIndex.find(entry.first) == toIndex.end()) {
+                ret.append(makeOp(OP_REMOVE, PATH_KEY, entry.first));
+            }
+        }
+        for (auto const &node : to) {
+            auto it = fromIndex.find(node[PATH_KEY].asString());
+            if (it == fromIndex.end()) {
+                ret.append(makeOp(OP_ADD, NODE_KEY, node));
+            } else if (from[it->second] != node) {
+                ret.append(makeOp(OP_CHANGE, NODE_KEY, node));
+            }
+        }
+        return ret;
+    }
+
+    bool applyPathTreeJsonDiff(Json::Value &nodes, Json::Value const &ops) {
+        if (!ops.isArray()) {
+            return false;
+        }
+        auto index = indexNodes(nodes);
+        std::vector<Json::Value> added;
+        std::set<Json::ArrayIndex> removed;
+        /// Check and gather everything first, so we don't leave a partial
+        /// update behind if something doesn't apply.
+        for (auto const &op : ops) {
+            if (!op.isObject()) {
+                return false;
+            }
+            auto type = op[OP_KEY].asString();
+            auto const &node = op[NODE_KEY];
+            std::string path;
+            if (type == OP_REMOVE) {
+                path = op[PATH_KEY].asString();
+            } else if (node.isObject()) {
+                path = node[PATH_KEY].asString();
+            }
+            auto it = index.find(path);
+            if (type == OP_ADD && it == index.end() && !path.empty()) {
+                added.push_back(node);
+            } else if (type == OP_CHANGE && it != index.end()) {
+                // Changes are applied below.
+            } else if (type == OP_REMOVE && it != index.end()) {
+                removed.insert(it->second);
+            } else {
+                return false;
+            }
+        }
+        for (auto const &op : ops) {
+            if (op[OP_KEY].asString() == OP_CHANGE) {
+                nodes[index[op[NODE_KEY][PATH_KEY].asString()]] = op[NODE_KEY];
+            }
+        }
+        Json::Value result(Json::arrayValue);
+        for (Json::ArrayIndex i = 0, e = nodes.size(); i < e; ++i) {
+            if (removed.find(i) == removed.end()) {
+                result.append(nodes[i]);
+            }
+        }
+        for (auto const &node : added) {
+            result.append(node);
+        }
+        nodes.swap(result);
+        return true;
+    }
 } // namespace common
 } // namespace osvr
\ No newline at end of file
@@ -28,6 +28,7 @@
 
 // Library/third-party includes
 #include <boost/algorithm/string.hpp>
+#include <boost/functional/hash.hpp>
 
 // Standard includes
 #include <iostream>
@@ -35,6 +36,12 @@
 namespace osvr {
 namespace common {
 
+    namespace detail {
+        std::size_t StringRefHash::operator()(boost::string_ref str) const {
+            return boost::hash_range(str.begin(), str.end());
+        }
+    } // namespace detail
+
     /// @brief helper function to print size and contents of the map
     void RegisteredStringMap::printCurrentMap() {
         auto n = m_regEntries.size();
@@ -47,16 +54,31 @@ namespace common {
     }
 
     util::StringID RegisteredStringMap::getStringID(std::string const &str) {
-        auto entry = std::find(begin(m_regEntries), end(m_regEntries), str);
-        if (end(m_regEntries) != entry) {
+        return m_getStringID(str);
+    }
+
+    util::StringID RegisteredStringMap::getStringID(const char *str) {
+        return m_getStringID(str);
+    }
+
+    void RegisteredStringMap::reserve(std::size_t n) {
+        m_regEntries.reserve(n);
+        m_index.reserve(n);
+    }
+
+    util::StringID RegisteredStringMap::m_getStringID(boost::string_ref str) {
+        auto entry =
+            m_index.find(str, detail::StringRefHash(), detail::StringRefEqual());
+        if (end(m_index) != entry) {
             // we found it.
-            return util::StringID(std::distance(begin(m_regEntries), entry));
+            return util::StringID(entry->second);
         }
 
         // we didn't find an entry in the registry so we'll add a new one
         auto ret = util::StringID(
             m_regEntries.size()); // will be the location of the next insert.
-        m_regEntries.push_back(str);
+        m_regEntries.push_back(str.to_string());
+        m_index.emplace(m_regEntries.back(), ret.value());
         m_modified = true;
         return ret;
     }
@@ -102,6 +124,8 @@ namespace common {
         std::vector<std::string> const &peerEntries) {
         m_remoteToLocal.clear();
         auto n = peerEntries.size();
+        m_remoteToLocal.reserve(n);
+        m_local.reserve(n);
         for (uint32_t i = 0; i < n; ++i) {
             m_remoteToLocal.push_back(
                 m_local.getStringID(peerEntries[i]).value());
@@ -0,0 +1,228 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include <osvr/Common/SharedReportChannel.h>
+#include <osvr/Util/Verbosity.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+namespace osvr {
+namespace common {
+
+    static IPCRingBuffer::Options makeOptions(std::string const &name) {
+        return IPCRingBuffer::Options(name)
+            .setEntries(SharedReportChannel::CAPACITY)
+            .setEntrySize(sizeof(SharedReportRecord))
+            .setSyncMode(IPCRingBuffer::SyncMode::Seqlock);
+    }
+
+    namespace {
+        /// @brief The channels created by servers in this process, by device
+        /// name. Devices may be created from several threads at once.
+        class InProcessChannels {
+          public:
+            static InProcessChannels &instance() {
+                static InProcessChannels channels;
+                return channels;
+            }
+            void add(std::string const &deviceName,
+                     SharedReportChannelPtr const &channel) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_channels[deviceName] = channel;
+            }
+            SharedReportChannelPtr find(std::string const &deviceName) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                auto it = m_channels.find(deviceName);
+                if (it == m_channels.end()) {
+                    return SharedReportChannelPtr();
+                }
+                auto ret = it->second.lock();
+                if (!ret) {
+                    m_channels.erase(it);
+                }
+                return ret;
+            }
+
+          private:
+            std::mutex m_mutex;
+            std::unordered_map<std::string, weak_ptr<SharedReportChannel> >
+                m_channels;
+        };
+    } // namespace
+
+    std::string SharedReportChannel::getName(std::string const &deviceName,
+                                             int port) {
+        return "com.osvr.reports/" + std::to_string(port) + "/" + deviceName;
+    }
+
+    SharedReportChannelPtr
+    SharedReportChannel::create(std::string const &deviceName, int port) {
+        IPCRingBufferPtr buf;
+        std::string name;
+        if (port != 0) {
+            name = getName(deviceName, port);
+            buf = IPCRingBuffer::create(makeOptions(name));
+            if (!buf) {
+                OSVR_DEV_VERBOSE("Couldn't create the shared memory report "
+                                 "channel for "
+                                 << deviceName
+                                 << ": reports will only be available in "
+                                    "process.");
+                name.clear();
+            }
+        }
+        SharedReportChannelPtr ret(new SharedReportChannel(buf, name));
+        InProcessChannels::instance().add(deviceName, ret);
+        return ret;
+    }
+
+    SharedReportChannelPtr
+    SharedReportChannel::findInProcess(std::string const &deviceName) {
+        return InProcessChannels::instance().find(deviceName);
+    }
+
+    SharedReportChannelPtr
+    SharedReportChannel::find(std::string const &name) {
+        SharedReportChannelPtr ret;
+        auto buf = IPCRingBuffer::find(makeOptions(name));
+        if (!buf ||
+            buf->getSyncMode() != IPCRingBuffer::SyncMode::Seqlock ||
+            buf->getEntrySize() < sizeof(SharedReportRecord)) {
+            return ret;
+        }
+        ret.reset(new SharedReportChannel(buf, name));
+        auto latest = buf->getLatest();
+        if (latest) {
+            ret->m_next = latest.getSequenceNumber() + 1;
+        }
+        return ret;
+    }
+
+    SharedReportChannel::SharedReportChannel(IPCRingBufferPtr const &buf,
+                                             std::string const &name)
+        : m_buf(buf), m_name(name), m_next(0), m_dropped(0),
+          m_publishing(0), m_needsCompacting(false) {}
+
+    void SharedReportChannel::publish(SharedReportRecord const &record) {
+        if (m_buf) {
+            m_buf->put(reinterpret_cast<IPCRingBuffer::pointer_to_const_type>(
+                           &record),
+                       sizeof(record));
+        }
+        // By index, as a subscriber may subscribe another (which gets called
+        // too). Those unsubscribed meanwhile are null until the outermost
+        // publish() is done.
+        ++m_publishing;
+        for (std::size_t i = 0; i < m_subscribers.size(); ++i) {
+            auto subscriber = m_subscribers[i];
+            if (subscriber.first) {
+                subscriber.first(subscriber.second, record);
+            }
+        }
+        --m_publishing;
+        if (m_publishing == 0 && m_needsCompacting) {
+            m_subscribers.erase(
+                std::remove_if(m_subscribers.begin(), m_subscribers.end(),
+                               [](std::pair<Subscriber, void *> const &sub) {
+                                   return !sub.first;
+                               }),
+                m_subscribers.end());
+            m_needsCompacting = false;
+        }
+    }
+
+    void SharedReportChannel::subscribe(Subscriber subscriber,
+                                        void *userdata) {
+        m_subscribers.emplace_back(subscriber, userdata);
+    }
+
+    void SharedReportChannel::unsubscribe(Subscriber subscriber,
+                                          void *userdata) {
+        auto removed = std::make_pair(subscriber, userdata);
+        if (m_publishing > 0) {
+            // Erasing would shift the rest down under publish()'s loop, which
+            // would then skip the next subscriber: mark it instead, to be
+            // compacted away once publish() is done.
+            for (auto &sub : m_subscribers) {
+                if (sub == removed) {
+                    sub.first = nullptr;
+                    m_needsCompacting = true;
+                }
+            }
+            return;
+        }
+        m_subscribers.erase(
+            std::remove(m_subscribers.begin(), m_subscribers.end(), removed),
+            m_subscribers.end());
+    }
+
+    std::size_t SharedReportChannel::poll(SharedReportRecord *out,
+                                          std::size_t maxRecords) {
+        std::size_t n = 0;
+        if (!m_buf) {
+            return n;
+        }
+        while (n < maxRecords) {
+            auto entry = m_buf->get(m_next);
+            if (entry) {
+                std::memcpy(&out[n], entry.get(), sizeof(SharedReportRecord));
+                ++n;
+                ++m_next;
+                continue;
+            }
+            // Either nothing new, or we fell behind and the entry was
+            // overwritten: in the latter case, skip ahead to the oldest
+            // entry that can still be there.
+            auto latest = m_buf->getLatest();
+            if (!latest) {
+                break;
+            }
+            IPCRingBuffer::sequence_type pending =
+                latest.getSequenceNumber() + 1 - m_next;
+            if (pending == 0 ||
+                pending > (IPCRingBuffer::sequence_type(-1) / 2)) {
+                // Caught up.
+                break;
+            }
+            if (pending > m_buf->getEntries()) {
+                auto skip = pending - m_buf->getEntries();
+                m_dropped += skip;
+                m_next += skip;
+            }
+            // Otherwise, it was published after we tried: try again.
+        }
+        return n;
+    }
+
+} // namespace common
+} // namespace osvr
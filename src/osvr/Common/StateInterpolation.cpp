@@ -0,0 +1,56 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include <osvr/Common/StateInterpolation.h>
+#include <osvr/Util/EigenInterop.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace common {
+    void interpolate(OSVR_Vec3 const &a, OSVR_Vec3 const &b, double alpha,
+                     OSVR_Vec3 &out) {
+        util::vecMap(out) =
+            util::vecMap(a) + alpha * (util::vecMap(b) - util::vecMap(a));
+    }
+
+    void interpolate(OSVR_Quaternion const &a, OSVR_Quaternion const &b,
+                     double alpha, OSVR_Quaternion &out) {
+        // Eigen's slerp takes the shorter arc.
+        util::toQuat(util::fromQuat(a).slerp(alpha, util::fromQuat(b)), out);
+    }
+
+    void interpolate(OSVR_Pose3 const &a, OSVR_Pose3 const &b, double alpha,
+                     OSVR_Pose3 &out) {
+        interpolate(a.translation, b.translation, alpha, out.translation);
+        interpolate(a.rotation, b.rotation, alpha, out.rotation);
+    }
+} // namespace common
+} // namespace osvr
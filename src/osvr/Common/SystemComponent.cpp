@@ -93,8 +93,63 @@ namespace common {
         const char *ReplacementTreeFromServer::identifier() {
             return "com.osvr.system.ReplacementTreeFromServer";
         }
+
+        namespace {
+            /// @brief Shared implementation of messages consisting of a JSON
+            /// object.
+            class JsonObjectMessageSerialization {
+              public:
+                JsonObjectMessageSerialization(Json::Value const &msg)
+                    : m_msg(msg) {}
+
+                template <typename T> void processMessage(T &p) {
+                    p(m_msg, serialization::JsonOnlyMessageTag());
+                }
+
+                Json::Value const &getValue() const { return m_msg; }
+
+              private:
+                Json::Value m_msg;
+            };
+        } // namespace
+
+        class TreeSnapshotFromServer::MessageSerialization
+            : public JsonObjectMessageSerialization {
+          public:
+            MessageSerialization(Json::Value const &msg = Json::objectValue)
+                : JsonObjectMessageSerialization(msg) {}
+        };
+        const char *TreeSnapshotFromServer::identifier() {
+            return "com.osvr.system.TreeSnapshotFromServer";
+        }
+
+        class TreeDeltaFromServer::MessageSerialization
+            : public JsonObjectMessageSerialization {
+          public:
+            MessageSerialization(Json::Value const &msg = Json::objectValue)
+                : JsonObjectMessageSerialization(msg) {}
+        };
+        const char *TreeDeltaFromServer::identifier() {
+            return "com.osvr.system.TreeDeltaFromServer";
+        }
+
+        class TreeAckToServer::MessageSerialization
+            : public JsonObjectMessageSerialization {
+          public:
+            MessageSerialization(Json::Value const &msg = Json::objectValue)
+                : JsonObjectMessageSerialization(msg) {}
+        };
+        const char *TreeAckToServer::identifier() {
+            return "com.osvr.system.TreeAckToServer";
+        }
     } // namespace messages
 
+    static const char VERSION_KEY[] = "version";
+    static const char BASE_KEY[] = "base";
+    static const char NODES_KEY[] = "nodes";
+    static const char OPS_KEY[] = "ops";
+    static const char RESYNC_KEY[] = "resync";
+
     const char *SystemComponent::deviceName() {
         return util::messagekeys::systemSender();
     }
@@ -144,15 +199,83 @@ namespace common {
         if (m_replaceTreeHandlers.empty()) {
             m_registerHandler(&SystemComponent::m_handleReplaceTree, this,
                               treeOut.getMessageType());
+            m_registerHandler(&SystemComponent::m_handleTreeSnapshot, this,
+                              treeSnapshotOut.getMessageType());
+            m_registerHandler(&SystemComponent::m_handleTreeDelta, this,
+                              treeDeltaOut.getMessageType());
         }
         m_replaceTreeHandlers.push_back(cb);
     }
 
+    void SystemComponent::sendTreeSnapshot(PathTree &tree) {
+        m_sentNodes = pathTreeToJson(tree);
+        ++m_sentVersion;
+        m_snapshotVersion = m_sentVersion;
+        Json::Value msg(Json::objectValue);
+        msg[VERSION_KEY] = Json::UInt(m_sentVersion);
+        msg[NODES_KEY] = m_sentNodes;
+        m_sendTreeMessage(msg, treeSnapshotOut.getMessageType());
+    }
+
+    bool SystemComponent::sendTreeDelta(PathTree &tree) {
+        auto nodes = pathTreeToJson(tree);
+        auto ops = diffPathTreeJson(m_sentNodes, nodes);
+        if (ops.empty()) {
+            return false;
+        }
+        m_sentNodes.swap(nodes);
+        Json::Value msg(Json::objectValue);
+        msg[BASE_KEY] = Json::UInt(m_sentVersion);
+        ++m_sentVersion;
+        msg[VERSION_KEY] = Json::UInt(m_sentVersion);
+        msg[OPS_KEY] = ops;
+        m_sendTreeMessage(msg, treeDeltaOut.getMessageType());
+        return true;
+    }
+
+    void SystemComponent::registerTreeAckHandler(TreeAckHandler cb) {
+        if (m_treeAckHandlers.empty()) {
+            m_registerHandler(&SystemComponent::m_handleTreeAck, this,
+                              treeAckIn.getMessageType());
+        }
+        m_treeAckHandlers.push_back(cb);
+    }
+
     void SystemComponent::m_parentSet() {
         m_getParent().registerMessageType(routesOut);
         m_getParent().registerMessageType(appStartup);
         m_getParent().registerMessageType(routeIn);
         m_getParent().registerMessageType(treeOut);
+        m_getParent().registerMessageType(treeSnapshotOut);
+        m_getParent().registerMessageType(treeDeltaOut);
+        m_getParent().registerMessageType(treeAckIn);
+    }
+
+    void SystemComponent::m_sendTreeMessage(Json::Value const &msg,
+                                            RawMessageType type) {
+        Buffer<> buf;
+        messages::JsonObjectMessageSerialization serialization(msg);
+        serialize(buf, serialization);
+        m_getParent().packMessage(buf, type);
+        m_getParent().sendPending(); // forcing this since it will cause
+                                     // shuffling of remotes on the client.
+    }
+
+    void SystemComponent::m_sendTreeAck(bool needSnapshot) {
+        Json::Value msg(Json::objectValue);
+        msg[VERSION_KEY] = Json::UInt(m_receivedVersion);
+        msg[RESYNC_KEY] = needSnapshot;
+        Buffer<> buf;
+        messages::TreeAckToServer::MessageSerialization serialization(msg);
+        serialize(buf, serialization);
+        m_getParent().packMessage(buf, treeAckIn.getMessageType());
+    }
+
+    void
+    SystemComponent::m_deliverTree(util::time::TimeValue const &timestamp) {
+        for (auto const &cb : m_replaceTreeHandlers) {
+            cb(m_receivedNodes, timestamp);
+        }
     }
 
     int SystemComponent::m_handleReplaceTree(void *userdata,
@@ -164,10 +287,72 @@ namespace common {
         auto timestamp = util::time::fromStructTimeval(p.msg_time);
         BOOST_ASSERT_MSG(msg.getValue().isArray(),
                          "replace tree message must be an array of nodes!");
+        if (self->m_haveSnapshot) {
+            // The server speaks the versioned protocol, and is only sending
+            // these for the benefit of older clients.
+            return 0;
+        }
         for (auto const &cb : self->m_replaceTreeHandlers) {
             cb(msg.getValue(), timestamp);
         }
         return 0;
     }
+
+    int SystemComponent::m_handleTreeSnapshot(void *userdata,
+                                              vrpn_HANDLERPARAM p) {
+        auto self = static_cast<SystemComponent *>(userdata);
+        auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
+        messages::TreeSnapshotFromServer::MessageSerialization msg;
+        deserialize(bufReader, msg);
+        auto const &val = msg.getValue();
+        if (!val.isObject() || !val[NODES_KEY].isArray()) {
+            return 0;
+        }
+        self->m_haveSnapshot = true;
+        self->m_receivedVersion = val[VERSION_KEY].asUInt();
+        self->m_receivedNodes = val[NODES_KEY];
+        self->m_sendTreeAck(false);
+        self->m_deliverTree(util::time::fromStructTimeval(p.msg_time));
+        return 0;
+    }
+
+    int SystemComponent::m_handleTreeDelta(void *userdata,
+                                           vrpn_HANDLERPARAM p) {
+        auto self = static_cast<SystemComponent *>(userdata);
+        if (!self->m_haveSnapshot) {
+            // Connected mid-update: a snapshot is on its way.
+            return 0;
+        }
+        auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
+        messages::TreeDeltaFromServer::MessageSerialization msg;
+        deserialize(bufReader, msg);
+        auto const &val = msg.getValue();
+        if (!val.isObject() ||
+            val[BASE_KEY].asUInt() != self->m_receivedVersion ||
+            !applyPathTreeJsonDiff(self->m_receivedNodes, val[OPS_KEY])) {
+            self->m_sendTreeAck(true);
+            return 0;
+        }
+        self->m_receivedVersion = val[VERSION_KEY].asUInt();
+        self->m_deliverTree(util::time::fromStructTimeval(p.msg_time));
+        return 0;
+    }
+
+    int SystemComponent::m_handleTreeAck(void *userdata, vrpn_HANDLERPARAM p) {
+        auto self = static_cast<SystemComponent *>(userdata);
+        auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
+        messages::TreeAckToServer::MessageSerialization msg;
+        deserialize(bufReader, msg);
+        auto const &val = msg.getValue();
+        if (!val.isObject()) {
+            return 0;
+        }
+        auto version = val[VERSION_KEY].asUInt();
+        auto needSnapshot = val[RESYNC_KEY].asBool();
+        for (auto const &cb : self->m_treeAckHandlers) {
+            cb(version, needSnapshot);
+        }
+        return 0;
+    }
 } // namespace common
 } // namespace osvr
@@ -0,0 +1,105 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/WaitableVrpnConnection.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstring>
+
+namespace osvr {
+namespace common {
+    namespace {
+        /// @brief Endpoint exposing its inbound UDP socket.
+        class WaitableEndpoint : public vrpn_Endpoint_IP {
+          public:
+            WaitableEndpoint(vrpn_TypeDispatcher *dispatcher,
+                             vrpn_int32 *connectedEndpointCounter)
+                : vrpn_Endpoint_IP(dispatcher, connectedEndpointCounter) {}
+            SOCKET getUdpInboundSocket() const { return d_udpInboundSocket; }
+        };
+
+        inline void addSocket(std::vector<SOCKET> &sockets, SOCKET sock) {
+            if (sock != INVALID_SOCKET) {
+                sockets.push_back(sock);
+            }
+        }
+    } // namespace
+
+    WaitableVrpnConnection *WaitableVrpnConnection::create(int port,
+                                                           const char NIC[]) {
+        auto ret = new WaitableVrpnConnection(
+            static_cast<unsigned short>(port), NIC);
+        ret->setAutoDeleteStatus(true);
+        return ret;
+    }
+
+    WaitableVrpnConnection *
+    WaitableVrpnConnection::createClient(const char name[]) {
+        auto afterAt = std::strrchr(name, '@');
+        if (afterAt) {
+            name = afterAt + 1;
+        }
+        auto ret =
+            new WaitableVrpnConnection(name, vrpn_get_port_number(name));
+        ret->setAutoDeleteStatus(true);
+        return ret;
+    }
+
+    WaitableVrpnConnection::WaitableVrpnConnection(unsigned short port,
+                                                   const char NIC[])
+        : vrpn_Connection_IP(port, nullptr, nullptr, NIC,
+                             &WaitableVrpnConnection::m_allocateEndpoint) {}
+
+    WaitableVrpnConnection::WaitableVrpnConnection(const char name[],
+                                                   int port)
+        : vrpn_Connection_IP(name, port, nullptr, nullptr, nullptr, nullptr,
+                             nullptr,
+                             &WaitableVrpnConnection::m_allocateEndpoint) {}
+
+    WaitableVrpnConnection::~WaitableVrpnConnection() {}
+
+    void WaitableVrpnConnection::appendSockets(std::vector<SOCKET> &sockets) {
+        addSocket(sockets, listen_udp_sock);
+        addSocket(sockets, listen_tcp_sock);
+        for (auto &endpoint : d_endpoints) {
+            addSocket(sockets, endpoint.d_tcpSocket);
+            // A client waits here for the server to connect back.
+            addSocket(sockets, endpoint.d_tcpListenSocket);
+            addSocket(
+                sockets,
+                static_cast<WaitableEndpoint &>(endpoint).getUdpInboundSocket());
+        }
+    }
+
+    vrpn_Endpoint_IP *
+    WaitableVrpnConnection::m_allocateEndpoint(vrpn_Connection *conn,
+                                               vrpn_int32 *connectedEC) {
+        return new WaitableEndpoint(conn->d_dispatcher, connectedEC);
+    }
+} // namespace common
+} // namespace osvr
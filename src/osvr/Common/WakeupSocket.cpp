@@ -0,0 +1,200 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/WakeupSocket.h>
+#include <osvr/Util/Verbosity.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <winsock2.h>
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace osvr {
+namespace common {
+#ifdef _WIN32
+    static inline void closeSocket(SOCKET sock) { closesocket(sock); }
+    static inline bool makeNonBlocking(SOCKET sock) {
+        u_long nonBlocking = 1;
+        return 0 == ioctlsocket(sock, FIONBIO, &nonBlocking);
+    }
+    typedef int socklen_type;
+#else
+    static inline void closeSocket(SOCKET sock) { close(sock); }
+    static inline bool makeNonBlocking(SOCKET sock) {
+        auto flags = fcntl(sock, F_GETFL, 0);
+        return flags != -1 && 0 == fcntl(sock, F_SETFL, flags | O_NONBLOCK);
+    }
+    typedef socklen_t socklen_type;
+
+    /// @brief Whether all the sockets have values that an fd_set has room
+    /// for.
+    static inline bool fitInFdSet(SOCKET self,
+                                  std::vector<SOCKET> const &sockets) {
+        if (self >= FD_SETSIZE) {
+            return false;
+        }
+        for (auto sock : sockets) {
+            if (sock >= FD_SETSIZE) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// @return whether self is readable.
+    static inline bool pollForReadable(SOCKET self,
+                                       std::vector<SOCKET> const &sockets,
+                                       int microseconds) {
+        std::vector<pollfd> fds;
+        fds.reserve(sockets.size() + 1);
+        pollfd fd;
+        fd.events = POLLIN;
+        fd.revents = 0;
+        fd.fd = self;
+        fds.push_back(fd);
+        for (auto sock : sockets) {
+            fd.fd = sock;
+            fds.push_back(fd);
+        }
+        // Round up, so that we don't turn a short wait into a busy loop.
+        auto ret = poll(fds.data(), fds.size(), (microseconds + 999) / 1000);
+        return ret > 0 && (fds.front().revents & POLLIN);
+    }
+#endif
+
+    /// @return whether self is readable.
+    ///
+    /// On Windows, FD_SET() ignores sockets past the FD_SETSIZE count, while
+    /// elsewhere, each socket value must be below FD_SETSIZE: see
+    /// fitInFdSet().
+    static inline bool selectForReadable(SOCKET self,
+                                         std::vector<SOCKET> const &sockets,
+                                         int microseconds) {
+        fd_set readfds;
+        FD_ZERO(&readfds);
+        FD_SET(self, &readfds);
+        SOCKET maxSocket = self;
+        for (auto sock : sockets) {
+            FD_SET(sock, &readfds);
+            if (sock > maxSocket) {
+                maxSocket = sock;
+            }
+        }
+        timeval timeout;
+        timeout.tv_sec = microseconds / 1000000;
+        timeout.tv_usec = microseconds % 1000000;
+        auto ret = select(static_cast<int>(maxSocket) + 1, &readfds, nullptr,
+                          nullptr, &timeout);
+        return ret > 0 && FD_ISSET(self, &readfds);
+    }
+
+    WakeupSocket::WakeupSocket()
+        : m_sock(INVALID_SOCKET), m_signalled(false) {
+        SOCKET sock = socket(AF_INET, SOCK_DGRAM, 0);
+        if (sock == INVALID_SOCKET) {
+            OSVR_DEV_VERBOSE("WakeupSocket: could not create socket");
+            return;
+        }
+        sockaddr_in addr;
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        socklen_type addrLen = sizeof(addr);
+        auto sockAddr = reinterpret_cast<sockaddr *>(&addr);
+        if (0 != bind(sock, sockAddr, sizeof(addr)) ||
+            0 != getsockname(sock, sockAddr, &addrLen) ||
+            0 != connect(sock, sockAddr, sizeof(addr)) ||
+            !makeNonBlocking(sock)) {
+            OSVR_DEV_VERBOSE("WakeupSocket: could not set up socket");
+            closeSocket(sock);
+            return;
+        }
+        m_sock = sock;
+    }
+
+    WakeupSocket::~WakeupSocket() {
+        if (isValid()) {
+            closeSocket(m_sock);
+        }
+    }
+
+    void WakeupSocket::signal() {
+        if (!isValid() || m_signalled.exchange(true)) {
+            return;
+        }
+        // Failure means the socket is already full, and thus readable.
+        char byte = 0;
+        send(m_sock, &byte, 1, 0);
+    }
+
+    void WakeupSocket::drain() {
+        if (!isValid()) {
+            return;
+        }
+        char buf[16];
+        while (recv(m_sock, buf, sizeof(buf), 0) > 0) {
+        }
+        // Clear the flag only once the socket is empty: a signal() before
+        // this finds it still set and sends nothing, which is fine as the
+        // caller is about to do the work anyway, while one after it sends a
+        // datagram that wakes the next wait. Clearing it first would let a
+        // signal() send a datagram that we then consume, leaving the flag
+        // set with nothing left to clear it.
+        m_signalled = false;
+    }
+
+    void WakeupSocket::wait(std::vector<SOCKET> const &sockets,
+                            int microseconds) {
+        bool signalled;
+#ifndef _WIN32
+        // poll() has no limit on socket values, but only takes milliseconds,
+        // so keep select() for its precision when it can be used.
+        if (!fitInFdSet(m_sock, sockets)) {
+            signalled = pollForReadable(m_sock, sockets, microseconds);
+        } else
+#endif
+        {
+            signalled = selectForReadable(m_sock, sockets, microseconds);
+        }
+        if (signalled) {
+            drain();
+        }
+    }
+} // namespace common
+} // namespace osvr
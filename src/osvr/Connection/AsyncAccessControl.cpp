@@ -80,6 +80,11 @@ namespace connection {
             m_sharedRts = true;
             m_sharedDone = false;
             m_calledRequest = true;
+            // Now that the main thread can see our request, make sure it's
+            // not waiting for something else before it gets to it.
+            if (m_control.m_requestCallback) {
+                m_control.m_requestCallback();
+            }
             /// Take the main thread "free to go" status lock.
             {
                 m_lockDone.lock();
@@ -134,6 +139,17 @@ namespace connection {
         return handled;
     }
 
+    bool AsyncAccessControl::currentThreadHasCTS() {
+        MainLockType lock(m_mut);
+        return m_rts &&
+               m_currentRequestThread == boost::this_thread::get_id();
+    }
+
+    void
+    AsyncAccessControl::setRequestCallback(std::function<void()> const &f) {
+        m_requestCallback = f;
+    }
+
     bool
     AsyncAccessControl::m_handleRTS(MainLockType &lock,
                                     MainThreadMessages response,
@@ -34,7 +34,7 @@
 #include <boost/optional/optional.hpp>
 
 // Standard includes
-// - none
+#include <functional>
 
 namespace osvr {
 namespace connection {
@@ -67,6 +67,15 @@ namespace connection {
         /// @returns true if there was a request to send.
         bool mainThreadDenyPermanently();
 
+        /// @brief Whether the calling thread is the one currently cleared to
+        /// send (that is, within a granted request).
+        bool currentThreadHasCTS();
+
+        /// @brief Sets a function that the async thread calls each time it
+        /// requests to send, to wake the main thread if it's waiting. Set
+        /// before any async thread starts requesting.
+        void setRequestCallback(std::function<void()> const &f);
+
       private:
         /// @brief Messages/status that may be set by the main thread for read
         /// by
@@ -104,6 +113,8 @@ namespace connection {
 
         boost::optional<boost::thread::id> m_currentRequestThread;
 
+        std::function<void()> m_requestCallback;
+
         /// @brief For the main thread sleep/wake awaiting completion of the
         /// async thread's work.
         boost::condition_variable m_condMainThread;
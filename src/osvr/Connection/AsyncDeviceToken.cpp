@@ -26,6 +26,7 @@
 
 // Internal Includes
 #include "AsyncDeviceToken.h"
+#include <osvr/Connection/Connection.h>
 #include <osvr/Connection/ConnectionDevice.h>
 #include <osvr/Util/Verbosity.h>
 
@@ -40,8 +41,18 @@ namespace connection {
     using boost::unique_lock;
     using boost::mutex;
 
-    AsyncDeviceToken::AsyncDeviceToken(std::string const &name)
-        : OSVR_DeviceTokenObject(name) {}
+    AsyncDeviceToken::AsyncDeviceToken(std::string const &name,
+                                       std::size_t queueCapacity,
+                                       OSVR_AsyncSendPolicy policy)
+        : OSVR_DeviceTokenObject(name),
+          m_queue(queueCapacity ? queueCapacity
+                                : std::size_t(AsyncSendQueue::DEFAULT_CAPACITY),
+                  policy) {
+        // Requests come from threads other than the main one, so wake it up
+        // in case it's waiting for activity.
+        m_accessControl.setRequestCallback(
+            [&] { m_getConnection()->wakeUp(); });
+    }
 
     AsyncDeviceToken::~AsyncDeviceToken() {
         OSVR_DEV_VERBOSE("AsyncDeviceToken\t"
@@ -54,6 +65,7 @@ namespace connection {
         OSVR_DEV_VERBOSE("AsyncDeviceToken\t"
                          "In signalShutdown");
         m_run.signalShutdown();
+        m_queue.close();
         m_accessControl.mainThreadDenyPermanently();
     }
 
@@ -61,7 +73,9 @@ namespace connection {
         OSVR_DEV_VERBOSE("AsyncDeviceToken\t"
                          "In signalAndWaitForShutdown");
         signalShutdown();
-        if (m_callbackThread) {
+        // May be called again (from the destructor) after the thread is
+        // joined.
+        if (m_callbackThread && m_callbackThread->joinable()) {
             m_run.signalAndWaitForShutdown();
             m_callbackThread->join();
         }
@@ -105,22 +119,26 @@ namespace connection {
     void AsyncDeviceToken::m_sendData(util::time::TimeValue const &timestamp,
                                       MessageType *type, const char *bytestream,
                                       size_t len) {
-        OSVR_DEV_VERBOSE("AsyncDeviceToken::m_sendData\t"
-                         "about to create RTS object");
-        RequestToSend rts(m_accessControl);
-
-        bool clear = rts.request();
-        if (!clear) {
+        if (m_accessControl.currentThreadHasCTS()) {
+            // Sending from within a send guard: the main thread is waiting
+            // on us, so it won't drain the queue - send directly instead.
             OSVR_DEV_VERBOSE("AsyncDeviceToken::m_sendData\t"
-                             "RTS request responded with not clear to send.");
+                             "Already have CTS, sending directly");
+            m_getConnectionDevice()->sendData(timestamp, type, bytestream,
+                                              len);
             return;
         }
-
-        OSVR_DEV_VERBOSE("AsyncDeviceToken::m_sendData\t"
-                         "Have CTS!");
-        m_getConnectionDevice()->sendData(timestamp, type, bytestream, len);
-        OSVR_DEV_VERBOSE("AsyncDeviceToken::m_sendData\t"
-                         "done!");
+        bool queued;
+        {
+            unique_lock<mutex> lock(m_producerMutex);
+            queued = m_queue.push(timestamp, type, bytestream, len);
+        }
+        if (!queued) {
+            OSVR_DEV_VERBOSE("AsyncDeviceToken::m_sendData\t"
+                             "Queue closed, discarding report.");
+            return;
+        }
+        m_getConnection()->wakeUp();
     }
 
     class AsyncSendGuard : public util::GuardInterface {
@@ -140,6 +158,11 @@ namespace connection {
 
     void AsyncDeviceToken::m_connectionInteract() {
         m_ensureThreadStarted();
+        auto dev = m_getConnectionDevice();
+        m_queue.drain([&](AsyncSendQueue::Report const &report) {
+            dev->sendData(report.timestamp, report.type, report.data.data(),
+                          report.data.size());
+        });
         OSVR_DEV_VERBOSE("AsyncDeviceToken::m_connectionInteract\t"
                          "Going to send a CTS if waiting");
         bool handled = m_accessControl.mainThreadCTS();
@@ -152,6 +175,12 @@ namespace connection {
         }
     }
 
+    bool AsyncDeviceToken::m_getAsyncSendQueueStats(
+        OSVR_AsyncSendQueueStats &stats) const {
+        stats = m_queue.getStats();
+        return true;
+    }
+
     void AsyncDeviceToken::m_stopThreads() { signalAndWaitForShutdown(); }
 
 } // namespace connection
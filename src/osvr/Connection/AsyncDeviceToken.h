@@ -29,19 +29,24 @@
 #include <osvr/Connection/DeviceToken.h>
 #include <osvr/Util/CallbackWrapper.h>
 #include "AsyncAccessControl.h"
+#include "AsyncSendQueue.h"
 
 // Library/third-party includes
 #include <boost/thread.hpp>
 #include <util/RunLoopManagerBoost.h>
 
 // Standard includes
+#include <cstddef>
 #include <string>
 
 namespace osvr {
 namespace connection {
     class AsyncDeviceToken : public OSVR_DeviceTokenObject {
       public:
-        AsyncDeviceToken(std::string const &name);
+        AsyncDeviceToken(
+            std::string const &name,
+            std::size_t queueCapacity = AsyncSendQueue::DEFAULT_CAPACITY,
+            OSVR_AsyncSendPolicy policy = OSVR_ASYNC_SEND_BACKPRESSURE);
         virtual ~AsyncDeviceToken();
 
         void signalShutdown();
@@ -52,17 +57,22 @@ namespace connection {
         /// The thread will be launched as soon as the first connection
         /// interaction occurs.
         void m_setUpdateCallback(DeviceUpdateCallback const &cb) override;
-        /// Called from the async thread - only permitted to actually
-        /// send data when m_connectionInteract says so.
+        /// Called from the async thread - queues the data for
+        /// m_connectionInteract to send, unless already cleared to send by a
+        /// send guard.
         void m_sendData(util::time::TimeValue const &timestamp,
                         MessageType *type, const char *bytestream,
                         size_t len) override;
         util::GuardPtr m_getSendGuard() override;
 
-        /// Called from the main thread - services requests to send from
-        /// the async thread.
+        /// Called from the main thread - sends the queued data, then
+        /// services requests to send (from send guards) from the async
+        /// thread.
         void m_connectionInteract() override;
 
+        bool m_getAsyncSendQueueStats(
+            OSVR_AsyncSendQueueStats &stats) const override;
+
         void m_stopThreads() override;
 
         void m_ensureThreadStarted();
@@ -71,6 +81,12 @@ namespace connection {
 
         AsyncAccessControl m_accessControl;
 
+        /// @brief Reports waiting for the main thread to send them.
+        AsyncSendQueue m_queue;
+        /// @brief The queue only takes a single producer, but nothing stops a
+        /// device from sending from more than one thread.
+        boost::mutex m_producerMutex;
+
         ::util::RunLoopManagerBoost m_run;
     };
 } // namespace connection
@@ -0,0 +1,125 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "AsyncSendQueue.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <chrono>
+#include <thread>
+
+namespace osvr {
+namespace connection {
+    /// @brief Number of times a blocked producer yields before it starts
+    /// sleeping between checks.
+    static const int BACKPRESSURE_SPINS = 64;
+    static const std::chrono::microseconds BACKPRESSURE_SLEEP(100);
+
+    static inline std::size_t roundUpToPowerOfTwo(std::size_t n) {
+        std::size_t ret = 2;
+        while (ret < n) {
+            ret <<= 1;
+        }
+        return ret;
+    }
+
+    AsyncSendQueue::AsyncSendQueue(std::size_t capacity,
+                                   OSVR_AsyncSendPolicy policy)
+        : m_capacity(roundUpToPowerOfTwo(capacity)), m_mask(m_capacity - 1),
+          m_policy(policy), m_slots(new Slot[m_capacity]), m_writePos(0),
+          m_readPos(0), m_closed(false), m_peakDepth(0), m_sent(0),
+          m_dropped(0) {
+        for (std::size_t i = 0; i < m_capacity; ++i) {
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    AsyncSendQueue::~AsyncSendQueue() {}
+
+    bool AsyncSendQueue::push(util::time::TimeValue const &timestamp,
+                              MessageType *type, const char *bytestream,
+                              std::size_t len) {
+        auto pos = m_writePos.load(std::memory_order_relaxed);
+        auto &slot = m_slots[pos & m_mask];
+        int spins = 0;
+        for (;;) {
+            if (m_closed) {
+                return false;
+            }
+            auto seq = slot.sequence.load(std::memory_order_acquire);
+            if (seq == pos) {
+                break; // Free.
+            }
+            // Full: the slot still holds the report from one lap ago, which
+            // is the oldest queued.
+            if (m_policy == OSVR_ASYNC_SEND_DROP_OLDEST) {
+                auto oldest = pos - m_capacity;
+                if (seq == oldest + 1 &&
+                    m_readPos.compare_exchange_strong(
+                        oldest, oldest + 1, std::memory_order_acq_rel)) {
+                    // Claimed it before the consumer did, so it's ours.
+                    ++m_dropped;
+                    break;
+                }
+                // The consumer has it, and will free the slot momentarily.
+                std::this_thread::yield();
+            } else if (spins < BACKPRESSURE_SPINS) {
+                ++spins;
+                std::this_thread::yield();
+            } else {
+                std::this_thread::sleep_for(BACKPRESSURE_SLEEP);
+            }
+        }
+
+        auto &report = slot.report;
+        report.timestamp = timestamp;
+        report.type = type;
+        report.data.assign(bytestream, bytestream + len);
+        slot.sequence.store(pos + 1, std::memory_order_release);
+        m_writePos.store(pos + 1, std::memory_order_relaxed);
+
+        auto depth = pos + 1 - m_readPos.load(std::memory_order_relaxed);
+        if (depth > m_peakDepth.load(std::memory_order_relaxed)) {
+            m_peakDepth.store(depth, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    void AsyncSendQueue::close() { m_closed = true; }
+
+    OSVR_AsyncSendQueueStats AsyncSendQueue::getStats() const {
+        OSVR_AsyncSendQueueStats ret;
+        auto readPos = m_readPos.load();
+        auto writePos = m_writePos.load();
+        ret.depth = writePos > readPos ? writePos - readPos : 0;
+        ret.peakDepth = m_peakDepth.load();
+        ret.sent = m_sent.load();
+        ret.dropped = m_dropped.load();
+        return ret;
+    }
+} // namespace connection
+} // namespace osvr
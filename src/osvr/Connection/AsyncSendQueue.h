@@ -0,0 +1,160 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_AsyncSendQueue_h_GUID_D402306F_81F8_49F3_ADA5_92D53B092D9A
+#define INCLUDED_AsyncSendQueue_h_GUID_D402306F_81F8_49F3_ADA5_92D53B092D9A
+
+// Internal Includes
+#include <osvr/Connection/MessageTypePtr.h>
+#include <osvr/Util/AsyncSendQueueC.h>
+#include <osvr/Util/TimeValue.h>
+#include <osvr/Util/UniquePtr.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace osvr {
+namespace connection {
+    /// @brief A bounded, single-producer, single-consumer queue of serialized
+    /// reports, for an async device thread to hand its reports to the server
+    /// thread without waiting for it.
+    ///
+    /// Neither side takes a lock. Each slot carries a sequence number that
+    /// says whether it's free for the producer or full for the consumer; the
+    /// read position is claimed by compare-and-swap, so that the producer can
+    /// also claim (and discard) the oldest report when full under the
+    /// drop-oldest policy.
+    ///
+    /// Slots keep their buffers, so once each has held a report of a given
+    /// size, queueing a report that size doesn't allocate.
+    class AsyncSendQueue : boost::noncopyable {
+      public:
+        enum { DEFAULT_CAPACITY = 32 };
+
+        struct Report {
+            util::time::TimeValue timestamp;
+            MessageType *type;
+            std::vector<char> data;
+        };
+
+        /// @brief Constructor
+        ///
+        /// @param capacity Number of reports that can be queued, rounded up
+        /// to a power of two (and to at least 2).
+        /// @param policy What push() does when the queue is full.
+        AsyncSendQueue(std::size_t capacity = DEFAULT_CAPACITY,
+                       OSVR_AsyncSendPolicy policy =
+                           OSVR_ASYNC_SEND_BACKPRESSURE);
+        ~AsyncSendQueue();
+
+        /// @brief Queues a copy of a report. Producer thread only.
+        ///
+        /// Under the backpressure policy, blocks while the queue is full.
+        ///
+        /// @returns false if the queue was closed, in which case the report
+        /// is discarded.
+        bool push(util::time::TimeValue const &timestamp, MessageType *type,
+                  const char *bytestream, std::size_t len);
+
+        /// @brief Calls the given function with each report queued (at most
+        /// one capacity's worth, so a fast producer can't keep the consumer
+        /// here forever), oldest first. Consumer thread only.
+        ///
+        /// @returns the number of reports handled.
+        template <typename F> std::size_t drain(F &&f) {
+            std::size_t n = 0;
+            while (n < m_capacity && m_pop(f)) {
+                ++n;
+            }
+            return n;
+        }
+
+        /// @brief Stops accepting reports, releasing any producer blocked by
+        /// backpressure. Any thread.
+        void close();
+
+        /// @brief Gets the counters. Any thread; the values are each
+        /// up-to-date but not necessarily consistent with each other.
+        OSVR_AsyncSendQueueStats getStats() const;
+
+        std::size_t getCapacity() const { return m_capacity; }
+        OSVR_AsyncSendPolicy getPolicy() const { return m_policy; }
+
+      private:
+        struct Slot {
+            std::atomic<std::size_t> sequence;
+            Report report;
+        };
+
+        /// @brief Takes the oldest report and passes it to f, if there is
+        /// one.
+        template <typename F> bool m_pop(F &f) {
+            for (;;) {
+                auto pos = m_readPos.load(std::memory_order_relaxed);
+                auto &slot = m_slots[pos & m_mask];
+                if (slot.sequence.load(std::memory_order_acquire) != pos + 1) {
+                    if (m_readPos.load(std::memory_order_relaxed) == pos) {
+                        return false; // Empty.
+                    }
+                    continue; // The producer dropped this one: try again.
+                }
+                if (!m_readPos.compare_exchange_weak(
+                        pos, pos + 1, std::memory_order_acq_rel)) {
+                    continue;
+                }
+                f(static_cast<Report const &>(slot.report));
+                slot.sequence.store(pos + m_capacity,
+                                    std::memory_order_release);
+                ++m_sent;
+                return true;
+            }
+        }
+
+        std::size_t const m_capacity;
+        std::size_t const m_mask;
+        OSVR_AsyncSendPolicy const m_policy;
+        unique_ptr<Slot[]> m_slots;
+
+        /// @brief Position of the next slot to write - written only by the
+        /// producer.
+        std::atomic<std::size_t> m_writePos;
+        /// @brief Position of the oldest queued report - claimed by the
+        /// consumer, or by the producer to drop it.
+        std::atomic<std::size_t> m_readPos;
+
+        std::atomic<bool> m_closed;
+        std::atomic<std::size_t> m_peakDepth;
+        std::atomic<std::uint64_t> m_sent;
+        std::atomic<std::uint64_t> m_dropped;
+    };
+} // namespace connection
+} // namespace osvr
+
+#endif // INCLUDED_AsyncSendQueue_h_GUID_D402306F_81F8_49F3_ADA5_92D53B092D9A
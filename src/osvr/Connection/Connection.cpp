@@ -30,6 +30,7 @@
 #include <osvr/Connection/MessageType.h>
 #include "VrpnBasedConnection.h"
 #include "GenericConnectionDevice.h"
+#include <osvr/Util/Microsleep.h>
 #include <osvr/Util/Verbosity.h>
 
 // Library/third-party includes
@@ -137,6 +138,8 @@ namespace connection {
             }
         }
         m_devices.push_back(device);
+        // Make sure a waiting main loop gets around to the new device.
+        wakeUp();
     }
 
     void Connection::process() {
@@ -148,6 +151,21 @@ namespace connection {
         }
     }
 
+    void Connection::waitForActivity(int microseconds) {
+        m_waitForActivity(microseconds);
+    }
+
+    void Connection::wakeUp() { m_wakeUp(); }
+
+    bool Connection::devicesRequirePolling() const {
+        for (auto const &dev : m_devices) {
+            if (dev->requiresPolling()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
     void Connection::registerConnectionHandler(std::function<void()> handler) {
         m_registerConnectionHandler(handler);
     }
@@ -169,5 +187,13 @@ namespace connection {
 
     const char *Connection::getConnectionKindID() { return nullptr; }
 
+    void Connection::m_waitForActivity(int microseconds) {
+        if (microseconds > 0) {
+            util::time::microsleep(microseconds);
+        }
+    }
+
+    void Connection::m_wakeUp() {}
+
 } // namespace connection
 } // namespace osvr
@@ -53,6 +53,10 @@ namespace connection {
 
     void ConnectionDevice::process() { m_process(); }
 
+    bool ConnectionDevice::requiresPolling() const {
+        return m_requiresPolling();
+    }
+
     void ConnectionDevice::sendData(util::time::TimeValue const &timestamp,
                                     MessageType *type, const char *bytestream,
                                     size_t len) {
@@ -74,6 +78,15 @@ namespace connection {
         return m_descriptor;
     }
 
+    std::string const &ConnectionDevice::getSharedReportChannel() const {
+        return m_sharedReportChannel;
+    }
+
+    void
+    ConnectionDevice::m_setSharedReportChannel(std::string const &name) {
+        m_sharedReportChannel = name;
+    }
+
     bool ConnectionDevice::m_hasDeviceToken() const {
         return m_token != nullptr;
     }
@@ -83,5 +96,9 @@ namespace connection {
         return *m_token;
     }
 
+    bool ConnectionDevice::m_requiresPolling() const {
+        return m_hasDeviceToken() && m_token->requiresPolling();
+    }
+
 } // namespace connection
 } // namespace osvr
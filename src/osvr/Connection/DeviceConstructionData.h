@@ -27,6 +27,7 @@
 
 // Internal Includes
 #include <osvr/Connection/DeviceInitObject.h>
+#include <osvr/Common/SharedReportChannel.h>
 
 // Library/third-party includes
 #include <vrpn_Connection.h>
@@ -47,6 +48,9 @@ namespace connection {
         DeviceInitObject &obj;
         vrpn_Connection *conn;
         vrpn_BaseFlexServer *flexServer;
+        /// @brief Shared-memory channel for same-host clients, if available:
+        /// servers for standard interfaces publish their reports there too.
+        common::SharedReportChannelPtr reports;
     };
 } // namespace connection
 } // namespace osvr
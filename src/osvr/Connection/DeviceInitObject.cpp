@@ -38,11 +38,15 @@ using osvr::connection::Connection;
 OSVR_DeviceInitObject::OSVR_DeviceInitObject(OSVR_PluginRegContext ctx)
     : m_context(&PluginSpecificRegistrationContext::get(ctx)),
       m_conn(Connection::retrieveConnection(m_context->getParent())),
-      m_analogIface(nullptr), m_buttonIface(nullptr), m_tracker(false) {}
+      m_analogIface(nullptr), m_buttonIface(nullptr), m_tracker(false),
+      m_asyncSendQueueCapacity(0),
+      m_asyncSendPolicy(OSVR_ASYNC_SEND_BACKPRESSURE) {}
 
 OSVR_DeviceInitObject::OSVR_DeviceInitObject(
     osvr::connection::ConnectionPtr conn)
-    : m_context(nullptr), m_conn(conn), m_tracker(false) {}
+    : m_context(nullptr), m_conn(conn), m_tracker(false),
+      m_asyncSendQueueCapacity(0),
+      m_asyncSendPolicy(OSVR_ASYNC_SEND_BACKPRESSURE) {}
 
 void OSVR_DeviceInitObject::setName(std::string const &n) {
     m_name = n;
@@ -110,6 +114,11 @@ void OSVR_DeviceInitObject::addComponent(
     osvr::common::DeviceComponentPtr const &comp) {
     m_components.push_back(comp);
 }
+void OSVR_DeviceInitObject::setAsyncSendQueue(std::size_t capacity,
+                                              OSVR_AsyncSendPolicy policy) {
+    m_asyncSendQueueCapacity = capacity;
+    m_asyncSendPolicy = policy;
+}
 void OSVR_DeviceInitObject::returnTrackerInterface(
     osvr::connection::TrackerServerInterface &iface) {
     *m_trackerIface = &iface;
@@ -49,7 +49,9 @@ using osvr::util::GuardPtr;
 
 DeviceTokenPtr
 OSVR_DeviceTokenObject::createAsyncDevice(DeviceInitObject &init) {
-    DeviceTokenPtr ret(new AsyncDeviceToken(init.getQualifiedName()));
+    DeviceTokenPtr ret(new AsyncDeviceToken(init.getQualifiedName(),
+                                            init.getAsyncSendQueueCapacity(),
+                                            init.getAsyncSendPolicy()));
     ret->m_sharedInit(init);
     return ret;
 }
@@ -108,8 +110,17 @@ void OSVR_DeviceTokenObject::connectionInteract() {
     m_connectionInteract();
 }
 
+bool OSVR_DeviceTokenObject::requiresPolling() const {
+    return bool(m_preConnectionInteract) || m_requiresPolling();
+}
+
 void OSVR_DeviceTokenObject::stopThreads() { m_stopThreads(); }
 
+bool OSVR_DeviceTokenObject::getAsyncSendQueueStats(
+    OSVR_AsyncSendQueueStats &stats) const {
+    return m_getAsyncSendQueueStats(stats);
+}
+
 bool OSVR_DeviceTokenObject::releaseObject(void *obj) {
     return m_ownedObjects.release(obj);
 }
@@ -128,6 +139,13 @@ ConnectionDevicePtr OSVR_DeviceTokenObject::m_getConnectionDevice() {
 
 void OSVR_DeviceTokenObject::m_stopThreads() {}
 
+bool OSVR_DeviceTokenObject::m_requiresPolling() const { return false; }
+
+bool OSVR_DeviceTokenObject::m_getAsyncSendQueueStats(
+    OSVR_AsyncSendQueueStats &) const {
+    return false;
+}
+
 void OSVR_DeviceTokenObject::m_sharedInit(DeviceInitObject &init) {
     m_conn = init.getConnection();
     m_dev = m_conn->createConnectionDevice(init);
@@ -51,6 +51,7 @@ namespace connection {
 
         virtual ~GenericConnectionDevice() {}
         virtual void m_process() { m_update(); }
+        virtual bool m_requiresPolling() const { return true; }
         virtual void m_sendData(util::time::TimeValue const &, MessageType *,
                                 const char *, size_t) {
             BOOST_ASSERT_MSG(false, "Never called!");
@@ -65,5 +65,7 @@ namespace connection {
         }
     }
 
+    bool SyncDeviceToken::m_requiresPolling() const { return bool(m_cb); }
+
 } // namespace connection
 } // namespace osvr
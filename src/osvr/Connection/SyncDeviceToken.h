@@ -48,6 +48,7 @@ namespace connection {
                         size_t len) override;
         util::GuardPtr m_getSendGuard() override;
         void m_connectionInteract() override;
+        bool m_requiresPolling() const override;
 
       private:
         DeviceUpdateCallback m_cb;
@@ -33,6 +33,7 @@
 #include <vrpn_Analog.h>
 
 // Standard includes
+#include <algorithm>
 #include <cmath>
 
 namespace osvr {
@@ -41,7 +42,8 @@ namespace connection {
       public:
         typedef vrpn_Analog Base;
         VrpnAnalogServer(DeviceConstructionData &init)
-            : Base(init.getQualifiedName().c_str(), init.conn) {
+            : Base(init.getQualifiedName().c_str(), init.conn),
+              m_reports(init.reports) {
             m_setNumChannels(std::min(*init.obj.getAnalogs(),
                                       OSVR_ChannelCount(vrpn_CHANNEL_MAX)));
             // Initialize data
@@ -84,8 +86,28 @@ namespace connection {
         void m_reportChanges(util::time::TimeValue const &timestamp) {
             struct timeval t;
             util::time::toStructTimeval(t, timestamp);
+            if (m_reports) {
+                m_publishIfChanged(timestamp);
+            }
             Base::report_changes(CLASS_OF_SERVICE, t);
         }
+        /// @brief Publishes all channels, if any changed: the same condition
+        /// under which report_changes() sends a VRPN message.
+        void m_publishIfChanged(util::time::TimeValue const &timestamp) {
+            auto n = m_getNumChannels();
+            if (std::equal(Base::channel, Base::channel + n, Base::last)) {
+                return;
+            }
+            common::SharedReportRecord record;
+            record.kind = common::SharedReportKind::Analog;
+            record.timestamp = timestamp;
+            for (OSVR_ChannelCount i = 0; i < n; ++i) {
+                record.sensor = i;
+                record.values[0] = Base::channel[i];
+                m_reports->publish(record);
+            }
+        }
+        common::SharedReportChannelPtr m_reports;
     };
 
 } // namespace connection
@@ -33,7 +33,7 @@
 // - none
 
 // Standard includes
-// - none
+#include <cstring>
 
 namespace osvr {
 namespace connection {
@@ -77,8 +77,14 @@ namespace connection {
         if (0 == port) {
             port = vrpn_DEFAULT_LISTEN_PORT_NO;
         }
-        m_vrpnConnection = vrpn_ConnectionPtr::create_server_connection(
-            port, nullptr, nullptr, iface);
+        if (iface && 0 == std::strcmp(iface, "loopback:")) {
+            m_vrpnConnection = vrpn_ConnectionPtr::create_server_connection(
+                port, nullptr, nullptr, iface);
+            return;
+        }
+        m_port = port;
+        m_waitable = common::WaitableVrpnConnection::create(port, iface);
+        m_vrpnConnection = vrpn_ConnectionPtr(m_waitable);
     }
 
     MessageTypePtr
@@ -90,7 +96,7 @@ namespace connection {
     ConnectionDevicePtr
     VrpnBasedConnection::m_createConnectionDevice(DeviceInitObject &init) {
         ConnectionDevicePtr ret =
-            make_shared<VrpnConnectionDevice>(init, m_vrpnConnection);
+            make_shared<VrpnConnectionDevice>(init, m_vrpnConnection, m_port);
         return ret;
     }
 
@@ -124,6 +130,23 @@ namespace connection {
     }
     void VrpnBasedConnection::m_process() { m_vrpnConnection->mainloop(); }
 
+    void VrpnBasedConnection::m_waitForActivity(int microseconds) {
+        // Device data gets packed after the mainloop in process(), so send it
+        // now rather than after waiting.
+        m_vrpnConnection->send_pending_reports();
+        if (!m_wakeup.isValid()) {
+            Connection::m_waitForActivity(microseconds);
+            return;
+        }
+        m_waitSockets.clear();
+        if (m_waitable) {
+            m_waitable->appendSockets(m_waitSockets);
+        }
+        m_wakeup.wait(m_waitSockets, microseconds);
+    }
+
+    void VrpnBasedConnection::m_wakeUp() { m_wakeup.signal(); }
+
     VrpnBasedConnection::~VrpnBasedConnection() {
         /// @todo wait until all async threads are done
     }
@@ -28,13 +28,15 @@
 // Internal Includes
 #include <osvr/Connection/Connection.h>
 #include <osvr/Common/NetworkingSupport.h>
+#include <osvr/Common/WaitableVrpnConnection.h>
+#include <osvr/Common/WakeupSocket.h>
 
 // Library/third-party includes
 #include <vrpn_Connection.h>
 #include <vrpn_ConnectionPtr.h>
 
 // Standard includes
-// - none
+#include <vector>
 
 namespace osvr {
 namespace connection {
@@ -73,13 +75,25 @@ namespace connection {
         m_createConnectionDevice(DeviceInitObject &init);
         virtual void m_registerConnectionHandler(std::function<void()> handler);
         virtual void m_process();
+        virtual void m_waitForActivity(int microseconds);
+        virtual void m_wakeUp();
 
         static int VRPN_CALLBACK m_connectionHandler(void *userdata,
                                                      vrpn_HANDLERPARAM);
 
         vrpn_ConnectionPtr m_vrpnConnection;
+        /// @brief Port the connection listens on, or 0 for a loopback
+        /// connection, which can't be reached from other processes.
+        int m_port = 0;
+        /// @brief Same object as m_vrpnConnection, if it's one whose sockets
+        /// we can wait on (that is, not a loopback connection).
+        common::WaitableVrpnConnection *m_waitable = nullptr;
         std::vector<std::function<void()> > m_connectionHandlers;
         common::NetworkingSupport m_network;
+        common::WakeupSocket m_wakeup;
+        /// @brief Sockets to wait on besides m_wakeup, kept to reuse its
+        /// storage.
+        std::vector<SOCKET> m_waitSockets;
     };
 
 } // namespace connection
@@ -42,7 +42,8 @@ namespace connection {
       public:
         typedef vrpn_Button_Filter Base;
         VrpnButtonServer(DeviceConstructionData &init)
-            : vrpn_Button_Filter(init.getQualifiedName().c_str(), init.conn) {
+            : vrpn_Button_Filter(init.getQualifiedName().c_str(), init.conn),
+              m_reports(init.reports) {
             m_setNumChannels(
                 std::min(*init.obj.getButtons(),
                          OSVR_ChannelCount(vrpn_BUTTON_MAX_BUTTONS)));
@@ -84,8 +85,26 @@ namespace connection {
         }
         void m_reportChanges(util::time::TimeValue const &timestamp) {
             util::time::toStructTimeval(Base::timestamp, timestamp);
+            if (m_reports) {
+                m_publishChanges(timestamp);
+            }
             Base::report_changes();
         }
+        /// @brief Publishes the buttons that changed, as report_changes()
+        /// does over VRPN.
+        void m_publishChanges(util::time::TimeValue const &timestamp) {
+            common::SharedReportRecord record;
+            record.kind = common::SharedReportKind::Button;
+            record.timestamp = timestamp;
+            for (OSVR_ChannelCount i = 0, n = m_getNumChannels(); i < n; ++i) {
+                if (Base::buttons[i] != Base::lastbuttons[i]) {
+                    record.sensor = i;
+                    record.values[0] = Base::buttons[i];
+                    m_reports->publish(record);
+                }
+            }
+        }
+        common::SharedReportChannelPtr m_reports;
     };
 
 } // namespace connection
@@ -43,10 +43,15 @@ namespace connection {
     /// @brief ConnectionDevice implementation for a VrpnBasedConnection
     class VrpnConnectionDevice : public ConnectionDevice {
       public:
+        /// @param port The port the connection listens on, or 0 for a
+        /// loopback connection.
         VrpnConnectionDevice(DeviceInitObject &init,
-                             vrpn_ConnectionPtr const &vrpnConn)
+                             vrpn_ConnectionPtr const &vrpnConn, int port)
             : ConnectionDevice(init.getQualifiedName()) {
             DeviceConstructionData data(init, vrpnConn.get());
+            data.reports = common::SharedReportChannel::create(
+                init.getQualifiedName(), port);
+            m_setSharedReportChannel(data.reports->getSharedMemoryName());
             m_server.reset(generateVrpnDynamicServer(data));
             m_baseobj = data.flexServer;
             for (auto const &component : init.getComponents()) {
@@ -28,6 +28,9 @@
 // Internal Includes
 #include "DeviceConstructionData.h"
 #include <osvr/Connection/TrackerServerInterface.h>
+#include <osvr/Common/Buffer.h>
+#include <osvr/Common/Serialization.h>
+#include <osvr/Common/TrackerPoseBatch.h>
 #include <osvr/Util/QuatlibInteropC.h>
 
 // Library/third-party includes
@@ -35,7 +38,7 @@
 #include <quat.h>
 
 // Standard includes
-// - none
+#include <vector>
 
 namespace osvr {
 namespace connection {
@@ -44,7 +47,8 @@ namespace connection {
       public:
         typedef vrpn_Tracker Base;
         VrpnTrackerServer(DeviceConstructionData &init)
-            : vrpn_Tracker(init.getQualifiedName().c_str(), init.conn) {
+            : vrpn_Tracker(init.getQualifiedName().c_str(), init.conn),
+              m_reports(init.reports) {
             // Initialize data
             m_resetPos();
             m_resetQuat();
@@ -52,6 +56,11 @@ namespace connection {
             m_resetVel();
             m_resetAccel();
 
+            m_poseBatchMsgId = d_connection->register_message_type(
+                common::messages::TrackerPoseBatch::identifier());
+            m_poseBatch.reserve(
+                common::messages::TrackerPoseBatch::MAX_POSES_PER_MESSAGE);
+
             // Report interface out.
             init.obj.returnTrackerInterface(*this);
         }
@@ -81,6 +90,29 @@ namespace connection {
             m_sendPose(sensor, timestamp);
         }
 
+        void sendPoseReports(OSVR_PoseState const *vals,
+                             OSVR_ChannelCount const *sensors,
+                             OSVR_ChannelCount count,
+                             util::time::TimeValue const &timestamp) override {
+            util::time::toStructTimeval(Base::timestamp, timestamp);
+            for (OSVR_ChannelCount i = 0; i < count; ++i) {
+                common::TrackerPoseBatchEntry entry;
+                entry.sensor = sensors ? sensors[i] : i;
+                entry.pose = vals[i];
+                m_poseBatch.push_back(entry);
+                if (m_reports) {
+                    m_publishPose(entry.sensor, timestamp, entry.pose);
+                }
+                if (m_poseBatch.size() == common::messages::TrackerPoseBatch::
+                                              MAX_POSES_PER_MESSAGE) {
+                    m_sendPoseBatch();
+                }
+            }
+            if (!m_poseBatch.empty()) {
+                m_sendPoseBatch();
+            }
+        }
+
         void sendVelReport(OSVR_VelocityState const &val,
                            OSVR_ChannelCount sensor,
                            util::time::TimeValue const &timestamp) override {
@@ -164,6 +196,12 @@ namespace connection {
 
         void m_sendPose(OSVR_ChannelCount sensor,
                         util::time::TimeValue const &ts) {
+            if (m_reports) {
+                OSVR_PoseState pose;
+                osvrVec3FromQuatlib(&(pose.translation), Base::pos);
+                osvrQuatFromQuatlib(&(pose.rotation), Base::d_quat);
+                m_publishPose(sensor, ts, pose);
+            }
 
             Base::d_sensor = sensor;
             util::time::toStructTimeval(Base::timestamp, ts);
@@ -174,6 +212,37 @@ namespace connection {
                                        msgbuf, CLASS_OF_SERVICE);
         }
 
+        void m_publishPose(OSVR_ChannelCount sensor,
+                           util::time::TimeValue const &ts,
+                           OSVR_PoseState const &pose) {
+            common::SharedReportRecord record;
+            record.kind = common::SharedReportKind::Pose;
+            record.sensor = sensor;
+            record.timestamp = ts;
+            for (int i = 0; i < 3; ++i) {
+                record.values[i] = pose.translation.data[i];
+            }
+            for (int i = 0; i < 4; ++i) {
+                record.values[3 + i] = pose.rotation.data[i];
+            }
+            m_reports->publish(record);
+        }
+
+        /// @brief Sends the accumulated batch of poses, with the timestamp
+        /// already in Base::timestamp, and clears it.
+        void m_sendPoseBatch() {
+            // Reusing the buffer saves an allocation per message.
+            m_poseBatchBuf.getContents().clear();
+            common::messages::TrackerPoseBatch::MessageSerialization msg(
+                m_poseBatch);
+            common::serialize(m_poseBatchBuf, msg);
+            d_connection->pack_message(
+                static_cast<vrpn_uint32>(m_poseBatchBuf.size()),
+                Base::timestamp, m_poseBatchMsgId, Base::d_sender_id,
+                m_poseBatchBuf.data(), CLASS_OF_SERVICE);
+            m_poseBatch.clear();
+        }
+
         void m_sendVelocity(OSVR_ChannelCount sensor,
                             util::time::TimeValue const &ts) {
 
@@ -197,6 +266,11 @@ namespace connection {
                                        Base::d_sender_id, msgbuf,
                                        CLASS_OF_SERVICE);
         }
+
+        vrpn_int32 m_poseBatchMsgId;
+        std::vector<common::TrackerPoseBatchEntry> m_poseBatch;
+        common::Buffer<> m_poseBatchBuf;
+        common::SharedReportChannelPtr m_reports;
     };
 
 } // namespace connection
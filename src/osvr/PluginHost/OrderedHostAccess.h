@@ -0,0 +1,101 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_OrderedHostAccess_h_GUID_A7E3F539_AA61_463D_B014_E3337EB4FDCE
+#define INCLUDED_OrderedHostAccess_h_GUID_A7E3F539_AA61_463D_B014_E3337EB4FDCE
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace osvr {
+namespace pluginhost {
+    /// @brief Lets several plugins' startup code run concurrently, while
+    /// keeping their access to the host exclusive and in the same order as if
+    /// they had run one after another.
+    ///
+    /// The plugin at a given index is let through to the host only once all
+    /// the plugins before it are finished: code that never reaches the host
+    /// (loading libraries, probing hardware) doesn't wait at all. Since
+    /// plugins are started in order of index, a plugin only ever waits on
+    /// plugins that are already running, so this can't deadlock.
+    class OrderedHostAccess : boost::noncopyable {
+      public:
+        explicit OrderedHostAccess(std::size_t n)
+            : m_next(0), m_finished(n, false), m_waited(n, 0.) {}
+
+        /// @brief Blocks until the plugin at index i may access the host.
+        void waitForTurn(std::size_t i) {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (m_next >= i) {
+                return;
+            }
+            auto start = std::chrono::steady_clock::now();
+            m_cond.wait(lock, [&] { return m_next >= i; });
+            m_waited[i] += std::chrono::duration<double>(
+                               std::chrono::steady_clock::now() - start)
+                               .count();
+        }
+
+        /// @brief Marks the plugin at index i as finished, letting the next
+        /// ones through if they were only waiting on it.
+        void finish(std::size_t i) {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_finished[i] = true;
+                while (m_next < m_finished.size() && m_finished[m_next]) {
+                    ++m_next;
+                }
+            }
+            m_cond.notify_all();
+        }
+
+        /// @brief Gets the time, in seconds, the plugin at index i spent
+        /// waiting for its turn.
+        double getSecondsWaited(std::size_t i) {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            return m_waited[i];
+        }
+
+      private:
+        std::mutex m_mutex;
+        std::condition_variable m_cond;
+        /// @brief Index of the first plugin not yet finished.
+        std::size_t m_next;
+        std::vector<bool> m_finished;
+        std::vector<double> m_waited;
+    };
+} // namespace pluginhost
+} // namespace osvr
+
+#endif // INCLUDED_OrderedHostAccess_h_GUID_A7E3F539_AA61_463D_B014_E3337EB4FDCE
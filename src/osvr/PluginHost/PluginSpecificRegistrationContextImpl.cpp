@@ -50,7 +50,14 @@ namespace pluginhost {
                          "Destroying plugin reg context for "
                          << getName());
 
-        // Delete the data in reverse order.
+        // Stop anything still using the data, then delete the data, each in
+        // reverse order.
+        for (auto const &callback :
+             m_unloadCallbacks | boost::adaptors::reversed) {
+            callback();
+        }
+        // Their code may live in a library unloaded with the plugin handle.
+        m_unloadCallbacks.clear();
         for (auto &ptr : m_dataList | boost::adaptors::reversed) {
             ptr.reset();
         }
@@ -71,7 +78,26 @@ namespace pluginhost {
         m_parent = &parent;
     }
 
+    void PluginSpecificRegistrationContextImpl::setHostAccessGate(
+        std::function<void()> const &gate) {
+        std::lock_guard<std::mutex> lock(m_hostAccessGateMutex);
+        m_hostAccessGate = gate;
+    }
+
+    void PluginSpecificRegistrationContextImpl::m_passHostAccessGate() const {
+        std::function<void()> gate;
+        {
+            std::lock_guard<std::mutex> lock(m_hostAccessGateMutex);
+            gate = m_hostAccessGate;
+        }
+        // Called unlocked, since it may block until the plugin's turn.
+        if (gate) {
+            gate();
+        }
+    }
+
     RegistrationContext &PluginSpecificRegistrationContextImpl::getParent() {
+        m_passHostAccessGate();
         if (m_parent == nullptr) {
             throw std::logic_error(
                 "Can't access the registration context parent - it is null!");
@@ -81,6 +107,7 @@ namespace pluginhost {
 
     RegistrationContext const &
     PluginSpecificRegistrationContextImpl::getParent() const {
+        m_passHostAccessGate();
         if (m_parent == nullptr) {
             throw std::logic_error(
                 "Can't access the registration context parent - it is null!");
@@ -125,6 +152,11 @@ namespace pluginhost {
                          << getName());
     }
 
+    void PluginSpecificRegistrationContextImpl::registerUnloadCallback(
+        std::function<void()> const &callback) {
+        m_unloadCallbacks.push_back(callback);
+    }
+
     void PluginSpecificRegistrationContextImpl::registerHardwareDetectCallback(
         OSVR_HardwareDetectCallback detectCallback, void *userData) {
         OSVR_DEV_VERBOSE("PluginSpecificRegistrationContext:\t"
@@ -38,6 +38,7 @@
 // Standard includes
 #include <vector>
 #include <functional>
+#include <mutex>
 
 namespace osvr {
 
@@ -53,7 +54,8 @@ namespace pluginhost {
 
         /// @brief Destructor
         ///
-        /// Responsible for destroying plugin data in reverse order.
+        /// Responsible for calling unload callbacks, then destroying plugin
+        /// data, each in reverse order.
         ~PluginSpecificRegistrationContextImpl();
 
         /// @brief Assume ownership of the plugin handle keeping the plugin
@@ -71,6 +73,16 @@ namespace pluginhost {
         /// set.
         void setParent(RegistrationContext &parent);
 
+        /// @brief Set a function to call before any access to the parent
+        /// registration context, or clear it by passing an empty function.
+        ///
+        /// Used by RegistrationContext to order plugins' access to the host
+        /// while running their startup code concurrently. Thread-safe, since
+        /// threads the plugin started may be accessing the host meanwhile: a
+        /// call already past the gate may still be running the old function
+        /// after this returns, so it should own whatever it uses.
+        void setHostAccessGate(std::function<void()> const &gate);
+
         /// @brief Get parent registration context
         ///
         /// @throws std::logic_error if called when no parent is yet set.
@@ -108,6 +120,9 @@ namespace pluginhost {
         virtual void registerDataWithDeleteCallback(
             OSVR_PluginDataDeleteCallback deleteCallback, void *pluginData);
 
+        virtual void
+        registerUnloadCallback(std::function<void()> const &callback);
+
         virtual void registerHardwareDetectCallback(
             OSVR_HardwareDetectCallback detectCallback, void *userData);
         virtual void registerDriverInstantiationCallback(
@@ -122,8 +137,13 @@ namespace pluginhost {
         typedef std::vector<PluginDataPtr> PluginDataList;
 
         PluginDataList m_dataList;
+        std::vector<std::function<void()> > m_unloadCallbacks;
         libfunc::PluginHandle m_handle;
         RegistrationContext *m_parent;
+        /// @brief Calls the host access gate, if any.
+        void m_passHostAccessGate() const;
+        mutable std::mutex m_hostAccessGateMutex;
+        std::function<void()> m_hostAccessGate;
 
         typedef util::CallbackWrapper<OSVR_HardwareDetectCallback>
             HardwareDetectCallback;
@@ -32,6 +32,8 @@
 #include <osvr/PluginHost/SearchPath.h>
 #include <osvr/PluginHost/PathConfig.h>
 #include "PluginSpecificRegistrationContextImpl.h"
+#include "OrderedHostAccess.h"
+#include <osvr/Util/SharedPtr.h>
 #include <osvr/Util/Verbosity.h>
 
 // Library/third-party includes
@@ -39,11 +41,18 @@
 #include <boost/filesystem.hpp>
 #include <boost/range/adaptor/map.hpp>
 #include <boost/range/adaptor/reversed.hpp>
+#include <boost/range/algorithm/copy.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 
 // Standard includes
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
 #include <iterator>
+#include <thread>
+#include <vector>
 
 namespace osvr {
 namespace pluginhost {
@@ -76,7 +85,12 @@ namespace pluginhost {
         }
     }
 
-    void RegistrationContext::loadPlugin(std::string const &pluginName) {
+    /// @brief Finds and loads a plugin into a new context of its own, without
+    /// adopting it.
+    static PluginRegPtr
+    loadPluginContext(RegistrationContext &host, std::string const &pluginName,
+                      std::function<void()> const &hostAccessGate =
+                          std::function<void()>()) {
         const std::string pluginPathName = pluginhost::findPlugin(pluginName);
         if (pluginPathName.empty()) {
             throw std::runtime_error("Could not find plugin named " +
@@ -88,7 +102,8 @@ namespace pluginhost {
              boost::filesystem::path(pluginPathName).stem()).generic_string();
         PluginRegPtr pluginReg(
             PluginSpecificRegistrationContext::create(pluginName));
-        pluginReg->setParent(*this);
+        pluginReg->setParent(host);
+        pluginReg->setHostAccessGate(hostAccessGate);
 
         libfunc::PluginHandle plugin;
         auto ctx = pluginReg->extractOpaquePointer();
@@ -102,6 +117,55 @@ namespace pluginhost {
         }
 
         pluginReg->takePluginHandle(plugin);
+        return pluginReg;
+    }
+
+    typedef std::chrono::steady_clock StartupClock;
+
+    static inline double secondsSince(StartupClock::time_point start) {
+        return std::chrono::duration<double>(StartupClock::now() - start)
+            .count();
+    }
+
+    /// @brief Fewest threads to use for plugin startup, since it's often
+    /// spent waiting on files and devices rather than computing.
+    static const std::size_t MIN_STARTUP_THREADS = 4;
+
+    /// @brief Calls f(i) for each i in [0, n) on a pool of threads (including
+    /// the calling one), starting them in increasing order of i, and returns
+    /// once they're all done. f must not throw.
+    template <typename F> static void runConcurrently(std::size_t n, F &&f) {
+        std::atomic<std::size_t> next(0);
+        auto work = [&] {
+            for (std::size_t i = next++; i < n; i = next++) {
+                f(i);
+            }
+        };
+        auto threads = std::min<std::size_t>(
+            n, std::max<std::size_t>(MIN_STARTUP_THREADS,
+                                     std::thread::hardware_concurrency()));
+        std::vector<std::thread> workers;
+        for (std::size_t i = 1; i < threads; ++i) {
+            workers.emplace_back(work);
+        }
+        work();
+        for (auto &worker : workers) {
+            worker.join();
+        }
+    }
+
+    void RegistrationContext::loadPlugin(std::string const &pluginName) {
+        auto &timing = m_timings[pluginName];
+        timing.name = pluginName;
+        auto start = StartupClock::now();
+        PluginRegPtr pluginReg;
+        try {
+            pluginReg = loadPluginContext(*this, pluginName);
+        } catch (...) {
+            timing.loadSeconds = secondsSince(start);
+            throw;
+        }
+        timing.loadSeconds = secondsSince(start);
         adoptPluginRegistrationContext(pluginReg);
     }
 
@@ -111,7 +175,8 @@ namespace pluginhost {
         auto pluginPathNames =
             pluginhost::getAllFilesWithExt(pluginPaths, OSVR_PLUGIN_EXTENSION);
 
-        // Load all of the non-.manualload plugins
+        // Keep all of the non-.manualload plugins, in order of name.
+        std::vector<std::string> pluginNames;
         for (const auto &plugin : pluginPathNames) {
             OSVR_DEV_VERBOSE("Examining plugin '" << plugin << "'...");
             const std::string pluginBaseName = boost::filesystem::path(plugin)
@@ -123,17 +188,56 @@ namespace pluginhost {
                     "Ignoring manual-load plugin: " << pluginBaseName);
                 continue;
             }
+            pluginNames.push_back(pluginBaseName);
+        }
+        std::sort(begin(pluginNames), end(pluginNames));
+        pluginNames.erase(std::unique(begin(pluginNames), end(pluginNames)),
+                          end(pluginNames));
 
+        // Load them concurrently, each into a context of its own...
+        struct LoadResult {
+            PluginRegPtr pluginReg;
+            std::string error;
+            double seconds;
+        };
+        std::vector<LoadResult> results(pluginNames.size());
+        // Shared with the gates, since a thread a plugin started may still
+        // be passing through one after we clear it below.
+        auto access = make_shared<OrderedHostAccess>(pluginNames.size());
+        runConcurrently(pluginNames.size(), [&](std::size_t i) {
+            auto &result = results[i];
+            auto start = StartupClock::now();
             try {
-                loadPlugin(pluginBaseName);
+                result.pluginReg = loadPluginContext(
+                    *this, pluginNames[i], [access, i] {
+                        access->waitForTurn(i);
+                    });
+            } catch (const std::exception &e) {
+                result.error = e.what();
+            } catch (...) {
+                result.error = "Unknown error.";
+            }
+            access->finish(i);
+            result.seconds =
+                secondsSince(start) - access->getSecondsWaited(i);
+        });
+
+        // ...then adopt them here, in order.
+        for (std::size_t i = 0; i < pluginNames.size(); ++i) {
+            auto const &pluginBaseName = pluginNames[i];
+            auto &result = results[i];
+            auto &timing = m_timings[pluginBaseName];
+            timing.name = pluginBaseName;
+            timing.loadSeconds = result.seconds;
+            if (result.pluginReg) {
+                result.pluginReg->setHostAccessGate(std::function<void()>());
+                adoptPluginRegistrationContext(result.pluginReg);
                 OSVR_DEV_VERBOSE(
                     "Successfully loaded plugin: " << pluginBaseName);
-            } catch (const std::exception &e) {
+            } else {
                 OSVR_DEV_VERBOSE("Failed to load plugin " << pluginBaseName
-                                                          << ": " << e.what());
-            } catch (...) {
-                OSVR_DEV_VERBOSE("Failed to load plugin "
-                                 << pluginBaseName << ": Unknown error.");
+                                                          << ": "
+                                                          << result.error);
             }
         }
     }
@@ -144,11 +248,43 @@ namespace pluginhost {
         ctx->setParent(*this);
 
         m_regMap.insert(std::make_pair(ctx->getName(), ctx));
+        auto &timing = m_timings[ctx->getName()];
+        timing.name = ctx->getName();
+        timing.loaded = true;
     }
 
     void RegistrationContext::triggerHardwareDetect() {
-        for (auto &pluginPtr : m_regMap | boost::adaptors::map_values) {
-            pluginPtr->triggerHardwareDetectCallbacks();
+        std::vector<PluginRegPtr> plugins;
+        boost::copy(m_regMap | boost::adaptors::map_values,
+                    std::back_inserter(plugins));
+        std::vector<double> seconds(plugins.size());
+        std::vector<std::exception_ptr> errors(plugins.size());
+        // Shared with the gates, as in loadPlugins().
+        auto access = make_shared<OrderedHostAccess>(plugins.size());
+        for (std::size_t i = 0; i < plugins.size(); ++i) {
+            plugins[i]->setHostAccessGate(
+                [access, i] { access->waitForTurn(i); });
+        }
+        runConcurrently(plugins.size(), [&](std::size_t i) {
+            auto start = StartupClock::now();
+            try {
+                plugins[i]->triggerHardwareDetectCallbacks();
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+            access->finish(i);
+            seconds[i] = secondsSince(start) - access->getSecondsWaited(i);
+        });
+
+        for (std::size_t i = 0; i < plugins.size(); ++i) {
+            plugins[i]->setHostAccessGate(std::function<void()>());
+            m_timings[plugins[i]->getName()].detectSeconds = seconds[i];
+        }
+        // Report failures as running the callbacks in order would have.
+        for (auto const &error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
         }
     }
 
@@ -164,6 +300,14 @@ namespace pluginhost {
         pluginIt->second->instantiateDriver(driverName, params);
     }
 
+    std::vector<PluginStartupTiming>
+    RegistrationContext::getStartupTimings() const {
+        std::vector<PluginStartupTiming> ret;
+        boost::copy(m_timings | boost::adaptors::map_values,
+                    std::back_inserter(ret));
+        return ret;
+    }
+
     util::AnyMap &RegistrationContext::data() { return m_data; }
 
     util::AnyMap const &RegistrationContext::data() const { return m_data; }
@@ -127,8 +127,13 @@ osvrDeviceGenericInit(OSVR_DeviceInitOptions options, OSVR_DeviceToken *device,
     }
     // Transfer ownership of the device token object to the plugin context.
     try {
-        *device =
+        OSVR_DeviceToken token =
             options->getContext()->registerDataWithGenericDelete(dev.release());
+        *device = token;
+        // Its threads may still be calling into data the plugin registers
+        // after it, which is deleted first.
+        options->getContext()->registerUnloadCallback(
+            [token] { token->stopThreads(); });
         /// @todo Is this too late to delete? Can we delete it earlier?
         options->getContext()->registerDataWithGenericDelete(options);
         options->notifyToken(*device);
@@ -210,6 +215,29 @@ osvrDeviceAsyncInitWithOptions(OSVR_IN_PTR OSVR_PluginRegContext,
                                  OSVR_DeviceTokenObject::createAsyncDevice);
 }
 
+OSVR_ReturnCode
+osvrDeviceAsyncSendQueueConfigure(OSVR_INOUT_PTR OSVR_DeviceInitOptions options,
+                                  OSVR_IN size_t capacity,
+                                  OSVR_IN OSVR_AsyncSendPolicy policy) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceAsyncSendQueueConfigure",
+                                    options);
+    options->setAsyncSendQueue(capacity, policy);
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode
+osvrDeviceGetAsyncSendQueueStats(OSVR_IN_PTR OSVR_DeviceToken device,
+                                 OSVR_OUT_PTR OSVR_AsyncSendQueueStats *stats) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceGetAsyncSendQueueStats",
+                                    device);
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceGetAsyncSendQueueStats stats",
+                                    stats);
+    if (!device->getAsyncSendQueueStats(*stats)) {
+        return OSVR_RETURN_FAILURE;
+    }
+    return OSVR_RETURN_SUCCESS;
+}
+
 OSVR_ReturnCode osvrDeviceMicrosleep(OSVR_IN uint64_t microseconds) {
     boost::this_thread::sleep(boost::posix_time::microseconds(microseconds));
     return OSVR_RETURN_SUCCESS;
@@ -112,3 +112,49 @@ osvrDeviceImagingReportFrame(OSVR_IN_PTR OSVR_DeviceToken,
 
     return OSVR_RETURN_FAILURE;
 }
+
+OSVR_ReturnCode osvrDeviceImagingAcquireFrameBuffer(
+    OSVR_IN_PTR OSVR_DeviceToken,
+    OSVR_IN_PTR OSVR_ImagingDeviceInterface iface,
+    OSVR_IN OSVR_ImagingMetadata metadata, OSVR_IN OSVR_ChannelCount sensor,
+    OSVR_OUT_PTR OSVR_ImageBufferElement **buffer) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceImagingAcquireFrameBuffer",
+                                    iface);
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceImagingAcquireFrameBuffer",
+                                    buffer);
+    /// Doesn't touch the connection, so no send guard needed here: the device
+    /// can fill the buffer without holding up the server.
+    *buffer = iface->imaging->acquireImageBuffer(metadata, sensor);
+    if (nullptr == *buffer) {
+        return OSVR_RETURN_FAILURE;
+    }
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode
+osvrDeviceImagingCommitFrame(OSVR_IN_PTR OSVR_DeviceToken,
+                             OSVR_IN_PTR OSVR_ImagingDeviceInterface iface,
+                             OSVR_IN OSVR_ChannelCount sensor,
+                             OSVR_IN_PTR OSVR_TimeValue const *timestamp) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceImagingCommitFrame", iface);
+    auto guard = iface->getSendGuard();
+    if (guard->lock()) {
+        if (iface->imaging->commitImageBuffer(sensor, *timestamp)) {
+            return OSVR_RETURN_SUCCESS;
+        }
+    }
+
+    return OSVR_RETURN_FAILURE;
+}
+
+OSVR_ReturnCode osvrDeviceImagingReleaseFrameBuffer(
+    OSVR_IN_PTR OSVR_DeviceToken,
+    OSVR_IN_PTR OSVR_ImagingDeviceInterface iface,
+    OSVR_IN OSVR_ChannelCount sensor) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceImagingReleaseFrameBuffer",
+                                    iface);
+    if (!iface->imaging->releaseImageBuffer(sensor)) {
+        return OSVR_RETURN_FAILURE;
+    }
+    return OSVR_RETURN_SUCCESS;
+}
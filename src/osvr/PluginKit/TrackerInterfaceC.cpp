@@ -114,6 +114,23 @@ OSVR_ReturnCode osvrDeviceTrackerSendPoseTimestamped(
                            val, sensor, timestamp);
 }
 
+OSVR_ReturnCode osvrDeviceTrackerSendPosesTimestamped(
+    OSVR_IN_PTR OSVR_DeviceToken, OSVR_IN_PTR OSVR_TrackerDeviceInterface iface,
+    OSVR_IN_PTR OSVR_PoseState const *poses,
+    OSVR_IN_PTR OSVR_ChannelCount const *sensors,
+    OSVR_IN OSVR_ChannelCount numPoses,
+    OSVR_IN_PTR OSVR_TimeValue const *timestamp) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceTrackerSendPosesTimestamped",
+                                    iface);
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceTrackerSendPosesTimestamped",
+                                    poses);
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceTrackerSendPosesTimestamped",
+                                    timestamp);
+    return useSendGuardVoid(iface, [&]() {
+        iface->tracker->sendPoseReports(poses, sensors, numPoses, *timestamp);
+    });
+}
+
 OSVR_ReturnCode
 osvrDeviceTrackerSendPosition(OSVR_IN_PTR OSVR_DeviceToken dev,
                               OSVR_IN_PTR OSVR_TrackerDeviceInterface iface,
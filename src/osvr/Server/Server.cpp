@@ -78,6 +78,8 @@ namespace server {
 
     void Server::triggerHardwareDetect() { m_impl->triggerHardwareDetect(); }
 
+    void Server::reportStartupTimings() { m_impl->reportStartupTimings(); }
+
     void Server::registerMainloopMethod(MainloopMethod f) {
         m_impl->registerMainloopMethod(f);
     }
@@ -31,12 +31,12 @@
 #include <osvr/Connection/MessageType.h>
 #include <osvr/Util/Verbosity.h>
 #include "../Connection/VrpnConnectionKind.h" /// @todo warning - cross-library internal header!
-#include <osvr/Util/Microsleep.h>
 #include <osvr/Common/SystemComponent.h>
 #include <osvr/Common/CommonComponent.h>
 #include <osvr/Common/PathTreeFull.h>
 #include <osvr/Common/PathElementTypes.h>
 #include <osvr/Common/ProcessDeviceDescriptor.h>
+#include <osvr/Common/RoutingConstants.h>
 #include <osvr/Common/AliasProcessor.h>
 #include <osvr/Util/StringLiteralFileToString.h>
 #include <osvr/Common/Tracing.h>
@@ -51,9 +51,29 @@
 // Standard includes
 #include <stdexcept>
 #include <functional>
+#include <iostream>
+
+#ifndef _WIN32
+#include <signal.h>
+#endif
 
 namespace osvr {
 namespace server {
+    /// @brief Keeps SIGPIPE raised by sends from the calling thread away from
+    /// the signal handler, which the server app uses to shut down.
+    ///
+    /// Waiting on activity rather than sleeping, the loop can send twice to a
+    /// client that has hung up before reading that it left. VRPN expects
+    /// SIGPIPE to be ignored, and drops the connection on the failed send.
+    static void blockSigPipe() {
+#ifndef _WIN32
+        sigset_t signals;
+        sigemptyset(&signals);
+        sigaddset(&signals, SIGPIPE);
+        pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+#endif
+    }
+
     static vrpn_ConnectionPtr
     getVRPNConnection(connection::ConnectionPtr const &conn) {
         vrpn_ConnectionPtr ret;
@@ -94,6 +114,18 @@ namespace server {
         m_commonComponent =
             m_systemDevice->addComponent(common::CommonComponent::create());
         m_commonComponent->registerPingHandler([&] { m_queueTreeSend(); });
+        m_systemComponent->registerTreeAckHandler(
+            [&](std::uint32_t version, bool needSnapshot) {
+                if (needSnapshot) {
+                    m_treeSnapshotNeeded = true;
+                    m_treeDirty.set();
+                } else if (version ==
+                           m_systemComponent->getTreeSnapshotVersion()) {
+                    // Acks of an earlier snapshot arriving late don't count
+                    // towards this one.
+                    ++m_deltaClients;
+                }
+            });
 
         // Set up the default display descriptor.
         m_tree.getNodeByPath("/display").value() =
@@ -111,6 +143,15 @@ namespace server {
         vrpnConn->register_handler(
             vrpnConn->register_message_type(vrpn_dropped_last_connection),
             &ServerImpl::m_enterIdle, this);
+
+        // Count connections, to know when every client understands tree
+        // deltas.
+        vrpnConn->register_handler(
+            vrpnConn->register_message_type(vrpn_got_connection),
+            &ServerImpl::m_handleGotConnection, this);
+        vrpnConn->register_handler(
+            vrpnConn->register_message_type(vrpn_dropped_connection),
+            &ServerImpl::m_handleDroppedConnection, this);
     }
 
     ServerImpl::~ServerImpl() {
@@ -133,6 +174,7 @@ namespace server {
         m_thread = boost::thread([&] {
             bool keepRunning = true;
             m_mainThreadId = m_thread.get_id();
+            blockSigPipe();
             ::util::LoopGuard guard(m_run);
             do {
                 keepRunning = this->m_loop();
@@ -153,6 +195,8 @@ namespace server {
     void ServerImpl::stop() {
         boost::unique_lock<boost::mutex> lock(m_runControl);
         if (m_everStarted) {
+            m_run.signalShutdown();
+            m_wakeUp();
             m_run.signalAndWaitForShutdown();
             m_thread.join();
             m_thread = boost::thread();
@@ -164,6 +208,7 @@ namespace server {
     void ServerImpl::signalStop() {
         boost::unique_lock<boost::mutex> lock(m_runControl);
         m_run.signalShutdown();
+        m_wakeUp();
     }
 
     void ServerImpl::loadPlugin(std::string const &pluginName) {
@@ -189,6 +234,30 @@ namespace server {
         m_callControlled([&] { m_triggeredDetect = true; });
     }
 
+    void ServerImpl::reportStartupTimings() {
+        m_callControlled([&] { m_reportStartupTimings = true; });
+    }
+
+    static void
+    printStartupTimings(std::vector<pluginhost::PluginStartupTiming> const &
+                            timings) {
+        static const char PREFIX[] = "[OSVR Server] ";
+        std::cout << PREFIX
+                  << "Plugin startup times (load / hardware detect, in ms):"
+                  << std::endl;
+        for (auto const &timing : timings) {
+            std::cout << PREFIX << " - " << timing.name << "\t";
+            if (timing.loaded) {
+                std::cout << timing.loadSeconds * 1000. << " / "
+                          << timing.detectSeconds * 1000.;
+            } else {
+                std::cout << "failed to load after "
+                          << timing.loadSeconds * 1000.;
+            }
+            std::cout << std::endl;
+        }
+    }
+
     void ServerImpl::registerMainloopMethod(MainloopMethod f) {
         if (f) {
             m_callControlled([&] { m_mainloopMethods.push_back(f); });
@@ -215,6 +284,10 @@ namespace server {
             common::tracing::markHardwareDetect();
             m_ctx->triggerHardwareDetect();
             m_triggeredDetect = false;
+            if (m_reportStartupTimings) {
+                printStartupTimings(m_ctx->getStartupTimings());
+                m_reportStartupTimings = false;
+            }
         }
         if (m_treeDirty) {
             OSVR_DEV_VERBOSE("Path tree updated or connection detected");
@@ -225,20 +298,40 @@ namespace server {
 
     bool ServerImpl::m_loop() {
         bool shouldContinue;
+        bool mustPoll;
         {
             /// @todo More elegant way of running queued things than grabbing a
             /// mutex each time through?
             boost::unique_lock<boost::mutex> lock(m_mainThreadMutex);
             m_update();
             shouldContinue = m_run.shouldContinue();
+            mustPoll =
+                !m_mainloopMethods.empty() || m_conn->devicesRequirePolling();
+        }
+        if (!shouldContinue) {
+            return false;
         }
 
-        if (m_currentSleepTime > 0) {
-            osvr::util::time::microsleep(m_currentSleepTime);
+        // Messages from clients, async device reports, and calls from other
+        // threads all wake us, so unless something needs calling every time
+        // through, we can wait for them rather than sleep.
+        auto waitTime = m_currentSleepTime;
+        if (!mustPoll && waitTime < MAX_EVENT_WAIT_TIME) {
+            waitTime = MAX_EVENT_WAIT_TIME;
+        }
+        if (waitTime > 0) {
+            m_conn->waitForActivity(waitTime);
         }
         return shouldContinue;
     }
 
+    void ServerImpl::m_wakeUp() const {
+        boost::unique_lock<boost::mutex> lock(m_wakeUpMutex);
+        if (m_conn) {
+            m_conn->wakeUp();
+        }
+    }
+
     bool ServerImpl::addRoute(std::string const &routingDirective) {
         bool wasNew;
         m_callControlled([&] { wasNew = m_addRoute(routingDirective); });
@@ -309,7 +402,11 @@ namespace server {
         m_ctx.reset();
         m_systemComponent = nullptr; // non-owning pointer
         m_systemDevice.reset();
-        m_conn.reset();
+        connection::ConnectionPtr conn;
+        {
+            boost::unique_lock<boost::mutex> lock(m_wakeUpMutex);
+            m_conn.swap(conn);
+        }
     }
 
     int ServerImpl::m_handleUpdatedRoute(void *userdata, vrpn_HANDLERPARAM p) {
@@ -349,12 +446,48 @@ namespace server {
         return change;
     }
     void ServerImpl::m_queueTreeSend() {
-        m_callControlled([&] { m_treeDirty += true; });
+        m_callControlled([&] {
+            m_treeSnapshotNeeded = true;
+            m_treeDirty += true;
+        });
     }
     void ServerImpl::m_sendTree() {
         OSVR_DEV_VERBOSE("Sending path tree to clients.");
         common::tracing::markPathTreeBroadcast();
-        m_systemComponent->sendReplacementTree(m_tree);
+        bool sent = true;
+        if (m_treeSnapshotNeeded) {
+            m_systemComponent->sendTreeSnapshot(m_tree);
+            // Clients understanding deltas will each acknowledge this.
+            m_deltaClients = 0;
+            m_treeSnapshotNeeded = false;
+        } else {
+            sent = m_systemComponent->sendTreeDelta(m_tree);
+        }
+        /// Until every client has acknowledged the latest snapshot, some may
+        /// only understand full replacement trees.
+        if (sent && m_deltaClients < m_clientConnections) {
+            m_systemComponent->sendReplacementTree(m_tree);
+        }
+    }
+
+    int ServerImpl::m_handleGotConnection(void *userdata, vrpn_HANDLERPARAM) {
+        auto self = static_cast<ServerImpl *>(userdata);
+        ++self->m_clientConnections;
+        return 0;
+    }
+
+    int ServerImpl::m_handleDroppedConnection(void *userdata,
+                                              vrpn_HANDLERPARAM) {
+        auto self = static_cast<ServerImpl *>(userdata);
+        if (self->m_clientConnections > 0) {
+            --self->m_clientConnections;
+        }
+        // We can't tell which client left, so get a fresh count of those
+        // understanding deltas. (Already in the server thread - or in
+        // m_orderedDestruction(), so not going through m_callControlled().)
+        self->m_treeSnapshotNeeded = true;
+        self->m_treeDirty.set();
+        return 0;
     }
 
     void ServerImpl::setSleepTime(int microseconds) {
@@ -372,10 +505,25 @@ namespace server {
             } else {
                 m_treeDirty += common::processDeviceDescriptorForPathTree(
                     m_tree, dev->getName(), descriptor);
+                m_advertiseSharedReports(*dev);
             }
         }
     }
 
+    void ServerImpl::m_advertiseSharedReports(
+        connection::ConnectionDevice const &dev) {
+        auto &node =
+            m_tree.getNodeByPath(common::getPathSeparator() + dev.getName());
+        auto devElt =
+            boost::get<common::elements::DeviceElement>(&node.value());
+        if (nullptr == devElt ||
+            devElt->getSharedReports() == dev.getSharedReportChannel()) {
+            return;
+        }
+        devElt->getSharedReports() = dev.getSharedReportChannel();
+        m_treeDirty.set();
+    }
+
     int ServerImpl::m_exitIdle(void *userdata, vrpn_HANDLERPARAM) {
         auto self = static_cast<ServerImpl *>(userdata);
         /// Conditional ensures that we don't "idle" faster than we run: Make
@@ -89,6 +89,9 @@ namespace server {
         /// @copydoc Server::triggerHardwareDetect()
         void triggerHardwareDetect();
 
+        /// @copydoc Server::reportStartupTimings()
+        void reportStartupTimings();
+
         /// @copydoc Server::registerMainloopMethod()
         void registerMainloopMethod(MainloopMethod f);
 
@@ -134,6 +137,10 @@ namespace server {
         /// @brief The actual guts of the update
         void m_update();
 
+        /// @brief Wakes the server thread if it's waiting for activity.
+        /// Callable from any thread.
+        void m_wakeUp() const;
+
         /// @brief Internal function to call a callable if the thread isn't
         /// running, or to queue up the callable if it is running.
         template <typename Callable> void m_callControlled(Callable f);
@@ -148,9 +155,17 @@ namespace server {
         /// @brief Queues up a tree transmission for next time around
         void m_queueTreeSend();
 
-        /// @brief sends full path tree contents
+        /// @brief sends path tree contents: a snapshot if one was queued,
+        /// otherwise the changes since the last send, as well as the full
+        /// tree for older clients if there may be any.
         void m_sendTree();
 
+        /// @brief Callbacks counting client connections.
+        static int VRPN_CALLBACK m_handleGotConnection(void *userdata,
+                                                       vrpn_HANDLERPARAM);
+        static int VRPN_CALLBACK m_handleDroppedConnection(void *userdata,
+                                                           vrpn_HANDLERPARAM);
+
         /// @brief handles updated route message from client
         static int VRPN_CALLBACK m_handleUpdatedRoute(void *userdata,
                                                       vrpn_HANDLERPARAM p);
@@ -172,6 +187,10 @@ namespace server {
         /// @brief Handle new or updated device descriptors.
         void m_handleDeviceDescriptors();
 
+        /// @brief Puts the name of a device's shared memory report channel
+        /// in its path tree node, for clients on this host.
+        void m_advertiseSharedReports(connection::ConnectionDevice const &dev);
+
         /// @brief Some things are only safe in the server thread. This is how
         /// to check if we're in the server thread. (Use m_callControlled with a
         /// lambda to perform operations guaranteed to be in the server thread
@@ -205,13 +224,32 @@ namespace server {
         /// detection.
         bool m_triggeredDetect = false;
 
+        /// @brief a flag to indicate whether we should print plugin startup
+        /// timings after the next hardware detection.
+        bool m_reportStartupTimings = false;
+
         /// @brief Path tree
         common::PathTree m_tree;
         util::Flag m_treeDirty;
 
+        /// @brief Whether the next tree send should be a full snapshot rather
+        /// than a delta: true until the first one.
+        bool m_treeSnapshotNeeded = true;
+
+        /// @brief Number of clients connected over the network.
+        std::size_t m_clientConnections = 0;
+
+        /// @brief Number of clients that acknowledged the latest snapshot, and
+        /// so don't need full replacement trees.
+        std::size_t m_deltaClients = 0;
+
         /// @brief Mutex held by anything executing in the main thread.
         mutable boost::mutex m_mainThreadMutex;
 
+        /// @brief Mutex protecting m_conn against being released while another
+        /// thread uses it to wake the server thread.
+        mutable boost::mutex m_wakeUpMutex;
+
         /// @brief Mutex controlling ability to check/change state of run loop
         /// @todo is mutable OK here?
         mutable boost::mutex m_runControl;
@@ -240,6 +278,11 @@ namespace server {
         /// @brief Number of microseconds to sleep after each loop iteration
         /// right now. 0 = no sleeping.
         int m_currentSleepTime = IDLE_SLEEP_TIME;
+
+        /// @brief Longest the server thread will wait for activity when
+        /// nothing needs to be polled - just a backstop, since everything
+        /// that should wake it does.
+        static const int MAX_EVENT_WAIT_TIME = 100000;
     };
 
     /// @brief Class to temporarily (in RAII style) change a thread ID variable
@@ -266,9 +309,13 @@ namespace server {
     inline void ServerImpl::m_callControlled(Callable f) {
         boost::unique_lock<boost::mutex> lock(m_runControl);
         if (m_running && boost::this_thread::get_id() != m_thread.get_id()) {
-            boost::unique_lock<boost::mutex> lock(m_mainThreadMutex);
-            TemporaryThreadIDChanger changer(m_mainThreadId);
-            f();
+            {
+                boost::unique_lock<boost::mutex> lock(m_mainThreadMutex);
+                TemporaryThreadIDChanger changer(m_mainThreadId);
+                f();
+            }
+            // Get the server thread to act on whatever we just did.
+            m_wakeUp();
         } else {
             f();
         }
@@ -278,9 +325,13 @@ namespace server {
     inline void ServerImpl::m_callControlled(Callable f) const {
         boost::unique_lock<boost::mutex> lock(m_runControl);
         if (m_running && boost::this_thread::get_id() != m_thread.get_id()) {
-            boost::unique_lock<boost::mutex> lock(m_mainThreadMutex);
-            TemporaryThreadIDChanger changer(m_mainThreadId);
-            f();
+            {
+                boost::unique_lock<boost::mutex> lock(m_mainThreadMutex);
+                TemporaryThreadIDChanger changer(m_mainThreadId);
+                f();
+            }
+            // Get the server thread to act on whatever we just did.
+            m_wakeUp();
         } else {
             f();
         }
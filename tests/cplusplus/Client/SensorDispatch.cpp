@@ -0,0 +1,193 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "../../../src/osvr/Client/SensorDispatchTable.h"
+#include "../../../src/osvr/Client/VRPNRemoteDispatchers.h"
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <vrpn_Connection.h>
+
+// Standard includes
+#include <vector>
+
+using osvr::client::AnalogRemoteDispatcher;
+using osvr::client::SensorDispatchTable;
+using osvr::client::TrackerPoseInfo;
+using osvr::client::TrackerRemoteDispatcher;
+
+static const char DEVICE_NAME[] = "com_osvr_test_SensorDispatch";
+
+namespace {
+struct Received {
+    std::vector<int> values;
+    static void handle(void *userdata, int const &value) {
+        static_cast<Received *>(userdata)->values.push_back(value);
+    }
+};
+} // namespace
+
+TEST(SensorDispatchTable, StartsEmpty) {
+    SensorDispatchTable<int> table;
+    ASSERT_TRUE(table.empty());
+    ASSERT_NO_THROW(table.dispatch(3, 42));
+}
+
+TEST(SensorDispatchTable, DispatchesOnlyToTheSensor) {
+    SensorDispatchTable<int> table;
+    Received zero, two;
+    table.registerHandler(&Received::handle, &zero, 0);
+    table.registerHandler(&Received::handle, &two, 2);
+    ASSERT_FALSE(table.empty());
+    table.dispatch(2, 20);
+    table.dispatch(1, 10);
+    table.dispatch(5, 50);
+    table.dispatch(0, 0);
+    ASSERT_EQ(std::vector<int>{0}, zero.values);
+    ASSERT_EQ(std::vector<int>{20}, two.values);
+}
+
+TEST(SensorDispatchTable, AllSensorsGetsEverything) {
+    SensorDispatchTable<int> table;
+    Received all, one;
+    table.registerHandler(&Received::handle, &all,
+                          SensorDispatchTable<int>::ALL_SENSORS);
+    table.registerHandler(&Received::handle, &one, 1);
+    table.dispatch(1, 10);
+    table.dispatch(7, 70);
+    ASSERT_EQ((std::vector<int>{10, 70}), all.values);
+    ASSERT_EQ(std::vector<int>{10}, one.values);
+}
+
+TEST(SensorDispatchTable, Unregister) {
+    SensorDispatchTable<int> table;
+    Received a, b;
+    table.registerHandler(&Received::handle, &a, 1);
+    table.registerHandler(&Received::handle, &b, 1);
+    table.dispatch(1, 10);
+    table.unregisterHandler(&Received::handle, &a, 1);
+    table.dispatch(1, 11);
+    table.unregisterHandler(&Received::handle, &b, 1);
+    ASSERT_TRUE(table.empty());
+    table.dispatch(1, 12);
+    ASSERT_EQ(std::vector<int>{10}, a.values);
+    ASSERT_EQ((std::vector<int>{10, 11}), b.values);
+}
+
+namespace {
+/// @brief Unregisters itself from the table when first called.
+struct OneShot {
+    SensorDispatchTable<int> *table;
+    int sensor;
+    std::vector<int> values;
+    static void handle(void *userdata, int const &value) {
+        auto self = static_cast<OneShot *>(userdata);
+        self->values.push_back(value);
+        self->table->unregisterHandler(&OneShot::handle, self, self->sensor);
+    }
+};
+} // namespace
+
+TEST(SensorDispatchTable, UnregisterFromHandler) {
+    SensorDispatchTable<int> table;
+    OneShot first{&table, 1, {}};
+    Received second;
+    OneShot all{&table, SensorDispatchTable<int>::ALL_SENSORS, {}};
+    table.registerHandler(&OneShot::handle, &first, 1);
+    table.registerHandler(&Received::handle, &second, 1);
+    table.registerHandler(&OneShot::handle, &all,
+                          SensorDispatchTable<int>::ALL_SENSORS);
+    table.dispatch(1, 10);
+    table.dispatch(1, 11);
+    // The handler after the one that unregistered wasn't skipped.
+    ASSERT_EQ(std::vector<int>{10}, first.values);
+    ASSERT_EQ((std::vector<int>{10, 11}), second.values);
+    ASSERT_EQ(std::vector<int>{10}, all.values);
+    table.unregisterHandler(&Received::handle, &second, 1);
+    ASSERT_TRUE(table.empty());
+}
+
+namespace {
+struct PoseCounter {
+    std::vector<OSVR_ChannelCount> sensors;
+    static void handle(void *userdata, TrackerPoseInfo const &info) {
+        static_cast<PoseCounter *>(userdata)->sensors.push_back(info.sensor);
+    }
+};
+struct AnalogCounter {
+    int calls = 0;
+    static void handle(void *userdata, vrpn_ANALOGCB const &) {
+        ++static_cast<AnalogCounter *>(userdata)->calls;
+    }
+};
+} // namespace
+
+TEST(TrackerRemoteDispatcher, OneRemoteForManySensors) {
+    vrpn_ConnectionPtr conn(vrpn_create_server_connection("loopback:"));
+    conn->removeReference(); // Remove extra reference.
+    TrackerRemoteDispatcher remote(conn, DEVICE_NAME);
+    std::vector<PoseCounter> counters(4);
+    for (int i = 0; i < 4; ++i) {
+        remote.poses().registerHandler(&PoseCounter::handle, &counters[i], i);
+    }
+    vrpn_Tracker_Server server(DEVICE_NAME, conn.get(), 4);
+    timeval now;
+    vrpn_gettimeofday(&now, nullptr);
+    vrpn_float64 pos[3] = {0, 0, 0};
+    vrpn_float64 quat[4] = {0, 0, 0, 1};
+    for (int i = 3; i >= 0; --i) {
+        server.report_pose(i, now, pos, quat);
+    }
+    server.mainloop();
+    remote.update();
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_EQ(std::vector<OSVR_ChannelCount>{OSVR_ChannelCount(i)},
+                  counters[i].sensors);
+        remote.poses().unregisterHandler(&PoseCounter::handle, &counters[i],
+                                         i);
+    }
+    ASSERT_TRUE(remote.poses().empty());
+}
+
+TEST(AnalogRemoteDispatcher, OnlyChannelsInTheReport) {
+    vrpn_ConnectionPtr conn(vrpn_create_server_connection("loopback:"));
+    conn->removeReference(); // Remove extra reference.
+    AnalogRemoteDispatcher remote(conn, DEVICE_NAME);
+    AnalogCounter all, first, beyond;
+    remote.reports().registerHandler(
+        &AnalogCounter::handle, &all,
+        SensorDispatchTable<vrpn_ANALOGCB>::ALL_SENSORS);
+    remote.reports().registerHandler(&AnalogCounter::handle, &first, 0);
+    remote.reports().registerHandler(&AnalogCounter::handle, &beyond, 5);
+    vrpn_Analog_Server server(DEVICE_NAME, conn.get(), 2);
+    server.channels()[0] = 1;
+    server.report();
+    server.mainloop();
+    remote.update();
+    ASSERT_EQ(1, all.calls);
+    ASSERT_EQ(1, first.calls);
+    ASSERT_EQ(0, beyond.calls);
+}
@@ -0,0 +1,148 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "../../../src/osvr/Client/SharedReportDispatcher.h"
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <vector>
+
+using osvr::client::SharedReportDispatcher;
+using osvr::client::SharedReportFilter;
+using osvr::common::SharedReportChannel;
+using osvr::common::SharedReportKind;
+using osvr::common::SharedReportRecord;
+
+static OSVR_TimeValue makeTime(OSVR_TimeValue_Seconds seconds) {
+    OSVR_TimeValue ret = {seconds, 0};
+    return ret;
+}
+
+TEST(SharedReportFilter, VRPNUntilSharedMemoryTakesOver) {
+    SharedReportFilter filter;
+    ASSERT_TRUE(filter.acceptFromVRPN(0, makeTime(1)));
+    ASSERT_TRUE(filter.acceptFromVRPN(0, makeTime(2)));
+    // Published before the channel was read, already delivered.
+    ASSERT_FALSE(filter.acceptFromSharedMemory(0, makeTime(2)));
+    ASSERT_TRUE(filter.acceptFromSharedMemory(0, makeTime(3)));
+    ASSERT_FALSE(filter.acceptFromVRPN(0, makeTime(3)));
+    OSVR_TimeValue soon = {3, SharedReportFilter::STALE_AFTER_US};
+    ASSERT_FALSE(filter.acceptFromVRPN(0, soon));
+}
+
+TEST(SharedReportFilter, VRPNTakesBackOverWhenSharedMemoryStops) {
+    SharedReportFilter filter;
+    ASSERT_TRUE(filter.acceptFromSharedMemory(0, makeTime(1)));
+    ASSERT_FALSE(filter.acceptFromVRPN(0, makeTime(1)));
+    // Shared memory has nothing past 1 s, while VRPN keeps going.
+    ASSERT_TRUE(filter.acceptFromVRPN(0, makeTime(2)));
+    ASSERT_TRUE(filter.acceptFromVRPN(0, makeTime(3)));
+    // Then a new channel gets read.
+    ASSERT_FALSE(filter.acceptFromSharedMemory(0, makeTime(3)));
+    ASSERT_TRUE(filter.acceptFromSharedMemory(0, makeTime(4)));
+    ASSERT_FALSE(filter.acceptFromVRPN(0, makeTime(4)));
+}
+
+TEST(SharedReportFilter, SensorsPastMaxLeftToVRPN) {
+    SharedReportFilter filter;
+    auto sensor = SharedReportFilter::MAX_SENSORS;
+    ASSERT_FALSE(filter.acceptFromSharedMemory(sensor, makeTime(1)));
+    ASSERT_TRUE(filter.acceptFromVRPN(sensor, makeTime(1)));
+    ASSERT_FALSE(filter.acceptFromSharedMemory(OSVR_ChannelCount(-1),
+                                               makeTime(2)));
+    ASSERT_TRUE(filter.acceptFromVRPN(OSVR_ChannelCount(-1), makeTime(2)));
+}
+
+namespace {
+struct Received {
+    std::vector<OSVR_ChannelCount> sensors;
+    static void handle(void *userdata, SharedReportRecord const &record) {
+        static_cast<Received *>(userdata)->sensors.push_back(record.sensor);
+    }
+};
+} // namespace
+
+static SharedReportRecord makeRecord(OSVR_ChannelCount sensor) {
+    SharedReportRecord record = {};
+    record.kind = SharedReportKind::Button;
+    record.sensor = sensor;
+    return record;
+}
+
+TEST(SharedReportDispatcher, ReopensRecreatedChannel) {
+    static const char DEVICE_NAME[] =
+        "com_osvr_test_SharedReportDispatcher/Device";
+    auto server = SharedReportChannel::create(DEVICE_NAME, 3883);
+    ASSERT_TRUE(bool(server));
+    auto dispatcher =
+        SharedReportDispatcher::find(server->getSharedMemoryName());
+    ASSERT_TRUE(bool(dispatcher));
+    Received received;
+    dispatcher->registerHandler(&Received::handle, &received);
+    server->publish(makeRecord(1));
+    dispatcher->update();
+    ASSERT_EQ(1, received.sensors.size());
+
+    // The server restarts, replacing the channel.
+    server.reset();
+    server = SharedReportChannel::create(DEVICE_NAME, 3883);
+    ASSERT_TRUE(bool(server));
+    server->publish(makeRecord(2));
+    dispatcher->update();
+    ASSERT_EQ(1, received.sensors.size()) << "Read the new channel already";
+
+    ASSERT_TRUE(dispatcher->reopen());
+    server->publish(makeRecord(3));
+    dispatcher->update();
+    ASSERT_EQ(2, received.sensors.size());
+    ASSERT_EQ(3, received.sensors.back());
+
+    server.reset();
+    dispatcher->unregisterHandler(&Received::handle, &received);
+}
+
+TEST(SharedReportFilter, KeepsReportsWithRepeatedTimestamps) {
+    SharedReportFilter filter;
+    ASSERT_TRUE(filter.acceptFromVRPN(0, makeTime(2)));
+    ASSERT_TRUE(filter.acceptFromVRPN(0, makeTime(2)));
+    ASSERT_TRUE(filter.acceptFromVRPN(0, makeTime(1)));
+
+    ASSERT_TRUE(filter.acceptFromSharedMemory(0, makeTime(3)));
+    ASSERT_TRUE(filter.acceptFromSharedMemory(0, makeTime(3)));
+    ASSERT_TRUE(filter.acceptFromSharedMemory(0, makeTime(2)))
+        << "Device clock went back";
+}
+
+TEST(SharedReportFilter, PerSensor) {
+    SharedReportFilter filter;
+    ASSERT_TRUE(filter.acceptFromSharedMemory(1, makeTime(1)));
+    ASSERT_FALSE(filter.acceptFromVRPN(1, makeTime(1)));
+    ASSERT_TRUE(filter.acceptFromVRPN(0, makeTime(1)))
+        << "Sensor 0 hasn't come through shared memory yet";
+    ASSERT_TRUE(filter.acceptFromVRPN(2, makeTime(1)));
+}
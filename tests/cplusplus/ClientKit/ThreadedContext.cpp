@@ -0,0 +1,76 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// Internal Includes
+#include <osvr/ClientKit/Context.h>
+#include <osvr/ClientKit/Interface.h>
+#include <osvr/ClientKit/InterfaceStateC.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include "gtest/gtest.h"
+
+namespace {
+void poseCallback(void *userdata, const OSVR_TimeValue *,
+                  const OSVR_PoseReport *) {
+    ++*static_cast<int *>(userdata);
+}
+
+void exerciseContext(std::uint32_t flags) {
+    osvr::clientkit::ClientContext ctx("com.osvr.test.threadedContext",
+                                       flags);
+    int calls = 0;
+    {
+        auto head = ctx.getInterface("/me/head");
+        head.registerCallback(&poseCallback, &calls);
+        OSVR_TimeValue timestamp;
+        OSVR_PoseState pose;
+        for (int i = 0; i < 10; ++i) {
+            ctx.update();
+            // No server, so no state.
+            ASSERT_EQ(OSVR_RETURN_FAILURE,
+                      osvrGetPoseState(head.get(), &timestamp, &pose));
+        }
+        head.free();
+    }
+    ctx.update();
+    ASSERT_EQ(0, calls);
+}
+} // namespace
+
+TEST(ThreadedContext, UpdateThread) {
+    exerciseContext(OSVR_CLIENT_INIT_THREADED);
+}
+
+TEST(ThreadedContext, DeferredCallbacks) {
+    exerciseContext(OSVR_CLIENT_INIT_THREADED |
+                    OSVR_CLIENT_INIT_DEFER_CALLBACKS);
+}
+
+TEST(ThreadedContext, DeferredCallbacksNeedThread) {
+    // Ignored without the update thread.
+    exerciseContext(OSVR_CLIENT_INIT_DEFER_CALLBACKS);
+}
@@ -0,0 +1,178 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/IPCRingBuffer.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <cstring>
+
+using osvr::common::IPCRingBuffer;
+using osvr::common::IPCRingBufferPtr;
+
+class IPCRingBufferModes
+    : public ::testing::TestWithParam<IPCRingBuffer::SyncMode> {
+  public:
+    IPCRingBufferModes()
+        : opts(IPCRingBuffer::Options("com.osvr.test.ipcringbuffer")
+                   .setEntries(4)
+                   .setEntrySize(4096)
+                   .setSyncMode(GetParam())) {}
+
+    void putByte(IPCRingBufferPtr const &buf, IPCRingBuffer::value_type val) {
+        IPCRingBuffer::value_type data[64];
+        std::memset(data, val, sizeof(data));
+        buf->put(data, sizeof(data));
+    }
+
+    IPCRingBuffer::Options opts;
+};
+
+TEST_P(IPCRingBufferModes, CreateAndFind) {
+    auto server = IPCRingBuffer::create(opts);
+    ASSERT_TRUE(bool(server));
+    ASSERT_EQ(GetParam(), server->getSyncMode());
+    auto client = IPCRingBuffer::find(opts);
+    ASSERT_TRUE(bool(client));
+    ASSERT_EQ(4, client->getEntries());
+    ASSERT_EQ(4096, client->getEntrySize());
+    ASSERT_FALSE(bool(client->getLatest()));
+}
+
+TEST_P(IPCRingBufferModes, ModeMismatchNotFound) {
+    auto server = IPCRingBuffer::create(opts);
+    ASSERT_TRUE(bool(server));
+    auto otherOpts = opts;
+    otherOpts.setSyncMode(GetParam() == IPCRingBuffer::SyncMode::Seqlock
+                              ? IPCRingBuffer::SyncMode::InterprocessMutex
+                              : IPCRingBuffer::SyncMode::Seqlock);
+    ASSERT_FALSE(bool(IPCRingBuffer::find(otherOpts)));
+}
+
+TEST_P(IPCRingBufferModes, PutAndGet) {
+    auto server = IPCRingBuffer::create(opts);
+    ASSERT_TRUE(bool(server));
+    auto client = IPCRingBuffer::find(opts);
+    ASSERT_TRUE(bool(client));
+    for (int i = 0; i < 3; ++i) {
+        putByte(server, IPCRingBuffer::value_type(i + 1));
+    }
+    for (IPCRingBuffer::sequence_type seq = 0; seq < 3; ++seq) {
+        auto res = client->get(seq);
+        ASSERT_TRUE(bool(res));
+        ASSERT_EQ(seq, res.getSequenceNumber());
+        ASSERT_EQ(seq + 1, res.get()[0]);
+        ASSERT_EQ(seq + 1, res.get()[63]);
+    }
+    ASSERT_FALSE(bool(client->get(3))) << "Not yet put";
+    auto latest = client->getLatest();
+    ASSERT_TRUE(bool(latest));
+    ASSERT_EQ(2, latest.getSequenceNumber());
+}
+
+TEST_P(IPCRingBufferModes, OverwrittenEntriesUnavailable) {
+    auto server = IPCRingBuffer::create(opts);
+    ASSERT_TRUE(bool(server));
+    auto client = IPCRingBuffer::find(opts);
+    ASSERT_TRUE(bool(client));
+    for (int i = 0; i < 6; ++i) {
+        putByte(server, IPCRingBuffer::value_type(i + 1));
+    }
+    ASSERT_FALSE(bool(client->get(0)));
+    ASSERT_FALSE(bool(client->get(1)));
+    auto res = client->get(5);
+    ASSERT_TRUE(bool(res));
+    ASSERT_EQ(6, res.get()[0]);
+}
+
+TEST(IPCRingBuffer, SeqlockWriteInProgressUnavailable) {
+    auto opts = IPCRingBuffer::Options("com.osvr.test.ipcringbuffer")
+                    .setEntries(4)
+                    .setEntrySize(4096)
+                    .setSyncMode(IPCRingBuffer::SyncMode::Seqlock);
+    auto server = IPCRingBuffer::create(opts);
+    ASSERT_TRUE(bool(server));
+    auto client = IPCRingBuffer::find(opts);
+    ASSERT_TRUE(bool(client));
+    {
+        auto proxy = server->put();
+        ASSERT_EQ(0, proxy.getSequenceNumber());
+        proxy.get()[0] = 42;
+        ASSERT_FALSE(bool(client->get(0))) << "Not yet published";
+        ASSERT_FALSE(bool(client->getLatest())) << "Not yet published";
+    }
+    auto res = client->get(0);
+    ASSERT_TRUE(bool(res));
+    ASSERT_EQ(42, res.get()[0]);
+}
+
+TEST(IPCRingBuffer, SeqlockAbandonedWriteUnpublished) {
+    auto opts = IPCRingBuffer::Options("com.osvr.test.ipcringbuffer")
+                    .setEntries(4)
+                    .setEntrySize(4096)
+                    .setSyncMode(IPCRingBuffer::SyncMode::Seqlock);
+    auto server = IPCRingBuffer::create(opts);
+    ASSERT_TRUE(bool(server));
+    auto client = IPCRingBuffer::find(opts);
+    ASSERT_TRUE(bool(client));
+    IPCRingBuffer::value_type data[64] = {1};
+    server->put(data, sizeof(data));
+    {
+        auto proxy = server->put();
+        ASSERT_EQ(1, proxy.getSequenceNumber());
+        proxy.get()[0] = 42;
+        proxy.abandon();
+        ASSERT_EQ(nullptr, proxy.get());
+    }
+    ASSERT_FALSE(bool(client->get(1))) << "Abandoned";
+    auto latest = client->getLatest();
+    ASSERT_TRUE(bool(latest));
+    ASSERT_EQ(0, latest.getSequenceNumber());
+
+    auto proxy = server->put();
+    ASSERT_EQ(1, proxy.getSequenceNumber()) << "Sequence number reused";
+}
+
+TEST(IPCRingBuffer, ABILevels) {
+    using SyncMode = IPCRingBuffer::SyncMode;
+    ASSERT_EQ(IPCRingBuffer::getABILevel(),
+              IPCRingBuffer::getABILevel(SyncMode::InterprocessMutex));
+    ASSERT_NE(IPCRingBuffer::getABILevel(SyncMode::InterprocessMutex),
+              IPCRingBuffer::getABILevel(SyncMode::Seqlock));
+    SyncMode mode;
+    ASSERT_TRUE(IPCRingBuffer::getSyncModeForABILevel(
+        IPCRingBuffer::getABILevel(SyncMode::Seqlock), mode));
+    ASSERT_EQ(SyncMode::Seqlock, mode);
+    ASSERT_TRUE(IPCRingBuffer::getSyncModeForABILevel(
+        IPCRingBuffer::getABILevel(SyncMode::InterprocessMutex), mode));
+    ASSERT_EQ(SyncMode::InterprocessMutex, mode);
+}
+
+INSTANTIATE_TEST_CASE_P(SyncModes, IPCRingBufferModes,
+                        ::testing::Values(
+                            IPCRingBuffer::SyncMode::InterprocessMutex,
+                            IPCRingBuffer::SyncMode::Seqlock));
@@ -0,0 +1,232 @@
+/** @file
+    @brief Test that receiving images, once warmed up, doesn't allocate from
+   the heap per frame.
+
+    Counts calls to the global operator new, which this executable replaces:
+   note that where that replacement doesn't reach into shared libraries (DLLs
+   on Windows), these tests can't see allocations made inside them.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/BaseDevice.h>
+#include <osvr/Common/CreateDevice.h>
+#include <osvr/Common/IPCRingBuffer.h>
+#include <osvr/Common/ImagingComponent.h>
+#include <osvr/Util/BlockPool.h>
+#include <osvr/Util/TimeValue.h>
+#include <vrpn_Connection.h>
+#include <vrpn_ConnectionPtr.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+
+static std::atomic<std::size_t> g_allocations(0);
+
+void *operator new(std::size_t size) {
+    ++g_allocations;
+    if (void *ret = std::malloc(size == 0 ? 1 : size)) {
+        return ret;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) throw() { std::free(p); }
+
+void *operator new[](std::size_t size) { return operator new(size); }
+
+void operator delete[](void *p) throw() { std::free(p); }
+
+using osvr::common::IPCRingBuffer;
+using osvr::common::ImagingComponent;
+using osvr::common::ImageData;
+using osvr::common::ImageBufferPtr;
+
+/// @brief Number of frames to warm up the pools with, and to count over.
+static const int WARMUP_FRAMES = 4;
+static const int COUNTED_FRAMES = 100;
+
+TEST(BlockPool, ReusesReleasedBlocks) {
+    auto pool = osvr::util::BlockPool::create(2);
+    {
+        auto a = osvr::util::makeSharedPooledImageBuffer(pool, 1000);
+        auto b = osvr::util::makePooledImageBuffer(pool, 1000);
+        ASSERT_EQ(0, reinterpret_cast<std::uintptr_t>(a.get()) %
+                         OSVR_DEFAULT_ALIGN_SIZE);
+        ASSERT_EQ(0, reinterpret_cast<std::uintptr_t>(b.get()) %
+                         OSVR_DEFAULT_ALIGN_SIZE);
+    }
+    // Two buffers and a shared_ptr control block.
+    ASSERT_EQ(3, pool->getBlocksAllocated());
+    auto before = g_allocations.load();
+    for (int i = 0; i < COUNTED_FRAMES; ++i) {
+        auto a = osvr::util::makeSharedPooledImageBuffer(pool, 1000);
+        auto b = osvr::util::makePooledImageBuffer(pool, 1000);
+    }
+    ASSERT_EQ(before, g_allocations.load());
+    ASSERT_EQ(3, pool->getBlocksAllocated());
+}
+
+class IPCRingBufferAllocations
+    : public ::testing::TestWithParam<IPCRingBuffer::SyncMode> {
+  public:
+    IPCRingBufferAllocations()
+        : opts(IPCRingBuffer::Options("com.osvr.test.imagingallocations")
+                   .setEntries(4)
+                   .setEntrySize(4096)
+                   .setSyncMode(GetParam())) {}
+    IPCRingBuffer::Options opts;
+};
+
+TEST_P(IPCRingBufferAllocations, SteadyStateGetDoesNotAllocate) {
+    auto server = IPCRingBuffer::create(opts);
+    ASSERT_TRUE(bool(server));
+    auto client = IPCRingBuffer::find(opts);
+    ASSERT_TRUE(bool(client));
+    std::vector<IPCRingBuffer::value_type> frame(4096, 42);
+    server->put(frame.data(), frame.size());
+
+    // Keep the previous frame alive while getting the next, as clients
+    // generally do.
+    IPCRingBuffer::smart_pointer_type held;
+    auto getFrames = [&](int n) {
+        for (int i = 0; i < n; ++i) {
+            auto res = (i % 2) ? client->get(0) : client->getLatest();
+            if (!res) {
+                return false;
+            }
+            held = res.getBufferSmartPointer();
+        }
+        return true;
+    };
+    ASSERT_TRUE(getFrames(WARMUP_FRAMES));
+    auto before = g_allocations.load();
+    auto gotFrames = getFrames(COUNTED_FRAMES);
+    auto allocations = g_allocations.load() - before;
+    ASSERT_TRUE(gotFrames);
+    ASSERT_EQ(42, held.get()[4095]);
+    ASSERT_EQ(0, allocations);
+}
+
+INSTANTIATE_TEST_CASE_P(SyncModes, IPCRingBufferAllocations,
+                        ::testing::Values(
+                            IPCRingBuffer::SyncMode::InterprocessMutex,
+                            IPCRingBuffer::SyncMode::Seqlock));
+
+/// @brief Records the first message of a type that it sees, so that it can be
+/// replayed without involving the sending side.
+class RecordedMessage {
+  public:
+    RecordedMessage(vrpn_ConnectionPtr const &conn, vrpn_int32 type,
+                    vrpn_int32 sender)
+        : m_conn(conn), m_type(type), m_sender(sender) {
+        m_conn->register_handler(m_type, &RecordedMessage::m_handle, this,
+                                 m_sender);
+    }
+    ~RecordedMessage() {
+        m_conn->unregister_handler(m_type, &RecordedMessage::m_handle, this,
+                                   m_sender);
+    }
+    bool recorded() const { return !m_buf.empty(); }
+    void replay() {
+        m_conn->pack_message(vrpn_uint32(m_buf.size()), m_time, m_type,
+                             m_sender, m_buf.data(),
+                             vrpn_CONNECTION_RELIABLE);
+    }
+
+  private:
+    static int VRPN_CALLBACK m_handle(void *userdata, vrpn_HANDLERPARAM p) {
+        auto self = static_cast<RecordedMessage *>(userdata);
+        if (!self->recorded()) {
+            self->m_buf.assign(p.buffer, p.buffer + p.payload_len);
+            self->m_time = p.msg_time;
+        }
+        return 0;
+    }
+    vrpn_ConnectionPtr m_conn;
+    vrpn_int32 m_type;
+    vrpn_int32 m_sender;
+    std::vector<char> m_buf;
+    timeval m_time;
+};
+
+TEST(ImagingComponentAllocations, SteadyStateDeliveryDoesNotAllocate) {
+    static const char DEVICE_NAME[] = "com_osvr_test_ImagingAllocations/Camera";
+    auto conn = vrpn_ConnectionPtr::create_server_connection("loopback:");
+    ASSERT_TRUE(nullptr != conn.get());
+
+    auto server = osvr::common::createServerDevice(DEVICE_NAME, conn);
+    auto serverImaging = server->addComponent(ImagingComponent::create(1));
+    auto client = osvr::common::createClientDevice(DEVICE_NAME, conn);
+    auto clientImaging = client->addComponent(ImagingComponent::create(1));
+
+    ImageBufferPtr held;
+    std::size_t images = 0;
+    clientImaging->registerImageHandler(
+        [&](ImageData const &data, osvr::util::time::TimeValue const &) {
+            held = data.buffer;
+            ++images;
+        });
+
+    auto sender = conn->register_sender(DEVICE_NAME);
+    RecordedMessage region(conn,
+                           serverImaging->imageRegion.getMessageType().get(),
+                           sender);
+    RecordedMessage shm(
+        conn, serverImaging->imagePlacedInSharedMemory.getMessageType().get(),
+        sender);
+
+    OSVR_ImagingMetadata meta;
+    meta.height = 48;
+    meta.width = 64;
+    meta.channels = 1;
+    meta.depth = 1;
+    meta.type = OSVR_IVT_UNSIGNED_INT;
+    std::vector<OSVR_ImageBufferElement> frame(64 * 48, 42);
+    OSVR_TimeValue now;
+    osvrTimeValueGetNow(&now);
+    serverImaging->sendImageData(meta, frame.data(), 0, now);
+    ASSERT_TRUE(region.recorded());
+    ASSERT_TRUE(shm.recorded());
+
+    auto deliver = [&](int n) {
+        for (int i = 0; i < n; ++i) {
+            region.replay();
+            shm.replay();
+        }
+    };
+    deliver(WARMUP_FRAMES);
+    auto imagesBefore = images;
+    auto before = g_allocations.load();
+    deliver(COUNTED_FRAMES);
+    auto allocations = g_allocations.load() - before;
+    ASSERT_EQ(imagesBefore + 2 * COUNTED_FRAMES, images);
+    ASSERT_EQ(42, held.get()[64 * 48 - 1]);
+    ASSERT_EQ(0, allocations);
+}
@@ -0,0 +1,209 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include "DummyTree.h"
+#include <osvr/Common/BaseDevice.h>
+#include <osvr/Common/CreateDevice.h>
+#include <osvr/Common/PathTreeSerialization.h>
+#include <osvr/Common/SystemComponent.h>
+#include <vrpn_ConnectionPtr.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <json/value.h>
+
+// Standard includes
+#include <string>
+
+namespace common = osvr::common;
+using osvr::common::PathTree;
+
+static void setString(PathTree &tree, std::string const &path,
+                      std::string const &value) {
+    tree.getNodeByPath(path).value() = common::elements::StringElement(value);
+}
+
+TEST(PathTreeJsonDiff, IdenticalTreesEmpty) {
+    PathTree tree;
+    setupDummyTree(tree);
+    auto nodes = common::pathTreeToJson(tree);
+    ASSERT_TRUE(common::diffPathTreeJson(nodes, nodes).empty());
+}
+
+TEST(PathTreeJsonDiff, RoundTrip) {
+    PathTree tree;
+    setupDummyTree(tree);
+    setString(tree, "/display", "a");
+    setString(tree, "/removed", "b");
+    auto from = common::pathTreeToJson(tree);
+
+    setString(tree, "/display", "c");
+    tree.getNodeByPath("/removed").value() = common::elements::NullElement();
+    setString(tree, "/added", "d");
+    auto to = common::pathTreeToJson(tree);
+
+    auto ops = common::diffPathTreeJson(from, to);
+    ASSERT_EQ(3, ops.size());
+
+    auto nodes = from;
+    ASSERT_TRUE(common::applyPathTreeJsonDiff(nodes, ops));
+    PathTree result;
+    common::jsonToPathTree(result, nodes);
+    ASSERT_EQ(common::pathTreeToJson(tree), common::pathTreeToJson(result));
+}
+
+TEST(PathTreeJsonDiff, MismatchedBaseRejected) {
+    PathTree tree;
+    setString(tree, "/a", "a");
+    auto from = common::pathTreeToJson(tree);
+    setString(tree, "/b", "b");
+    auto ops = common::diffPathTreeJson(from, common::pathTreeToJson(tree));
+
+    // Applying twice tries to add a node that's already there.
+    auto nodes = from;
+    ASSERT_TRUE(common::applyPathTreeJsonDiff(nodes, ops));
+    auto before = nodes;
+    ASSERT_FALSE(common::applyPathTreeJsonDiff(nodes, ops));
+    ASSERT_EQ(before, nodes) << "Left untouched on failure";
+    ASSERT_FALSE(common::applyPathTreeJsonDiff(nodes, Json::Value("bogus")));
+}
+
+class SystemComponentTree : public ::testing::Test {
+  public:
+    SystemComponentTree()
+        : conn(vrpn_ConnectionPtr::create_server_connection("loopback:")) {
+        server = common::createServerDevice(
+            common::SystemComponent::deviceName(), conn);
+        serverSystem = server->addComponent(common::SystemComponent::create());
+        client = common::createClientDevice(
+            common::SystemComponent::deviceName(), conn);
+        clientSystem = client->addComponent(common::SystemComponent::create());
+        serverSystem->registerTreeAckHandler(
+            [&](std::uint32_t version, bool needSnapshot) {
+                if (needSnapshot) {
+                    ++resyncs;
+                } else if (version == serverSystem->getTreeSnapshotVersion()) {
+                    ++acks;
+                } else {
+                    ++staleAcks;
+                }
+            });
+        clientSystem->registerReplaceTreeHandler(
+            [&](Json::Value const &nodes, osvr::util::time::TimeValue const &) {
+                ++trees;
+                received = nodes;
+            });
+        setupDummyTree(tree);
+    }
+
+    /// @brief Checks that what the client last received matches the tree.
+    void checkReceived() {
+        PathTree result;
+        common::jsonToPathTree(result, received);
+        ASSERT_EQ(common::pathTreeToJson(tree),
+                  common::pathTreeToJson(result));
+    }
+
+    vrpn_ConnectionPtr conn;
+    common::BaseDevicePtr server;
+    common::SystemComponent *serverSystem;
+    common::BaseDevicePtr client;
+    common::SystemComponent *clientSystem;
+    PathTree tree;
+    Json::Value received;
+    int trees = 0;
+    int acks = 0;
+    int staleAcks = 0;
+    int resyncs = 0;
+};
+
+TEST_F(SystemComponentTree, SnapshotThenDeltas) {
+    serverSystem->sendTreeSnapshot(tree);
+    ASSERT_EQ(1, trees);
+    ASSERT_EQ(1, acks);
+    checkReceived();
+
+    ASSERT_FALSE(serverSystem->sendTreeDelta(tree)) << "Nothing changed";
+    ASSERT_EQ(1, trees);
+
+    setString(tree, "/display", "new display");
+    ASSERT_TRUE(serverSystem->sendTreeDelta(tree));
+    ASSERT_EQ(2, trees);
+    checkReceived();
+
+    // Replacement trees for older clients are ignored once we have a
+    // snapshot.
+    serverSystem->sendReplacementTree(tree);
+    ASSERT_EQ(2, trees);
+    ASSERT_EQ(0, resyncs);
+}
+
+TEST_F(SystemComponentTree, StaleAckAfterNewSnapshot) {
+    serverSystem->sendTreeSnapshot(tree);
+    serverSystem->sendTreeSnapshot(tree);
+    ASSERT_EQ(2, acks);
+    ASSERT_EQ(0, staleAcks);
+
+    // A second system device starting its own versions from the beginning:
+    // the client's ack of its snapshot reaches our server component looking
+    // just like a late ack of our first snapshot.
+    auto otherServer = common::createServerDevice(
+        common::SystemComponent::deviceName(), conn);
+    auto otherSystem =
+        otherServer->addComponent(common::SystemComponent::create());
+    otherSystem->sendTreeSnapshot(tree);
+    ASSERT_EQ(3, trees);
+    ASSERT_EQ(2, acks);
+    ASSERT_EQ(1, staleAcks);
+    ASSERT_EQ(0, resyncs);
+}
+
+TEST_F(SystemComponentTree, ReplacementTreeWithoutSnapshot) {
+    serverSystem->sendReplacementTree(tree);
+    ASSERT_EQ(1, trees);
+    checkReceived();
+    ASSERT_EQ(0, acks);
+
+    setString(tree, "/display", "new display");
+    ASSERT_TRUE(serverSystem->sendTreeDelta(tree));
+    ASSERT_EQ(1, trees) << "Deltas need a snapshot to apply to";
+    ASSERT_EQ(0, resyncs);
+}
+
+TEST_F(SystemComponentTree, UnexpectedDeltaRequestsSnapshot) {
+    serverSystem->sendTreeSnapshot(tree);
+    ASSERT_EQ(1, trees);
+
+    // A second system device that never sent this client a snapshot, so its
+    // deltas don't start from the version the client has.
+    auto otherServer = common::createServerDevice(
+        common::SystemComponent::deviceName(), conn);
+    auto otherSystem =
+        otherServer->addComponent(common::SystemComponent::create());
+    ASSERT_TRUE(otherSystem->sendTreeDelta(tree));
+    ASSERT_EQ(1, trees);
+    ASSERT_EQ(1, resyncs);
+}
@@ -0,0 +1,130 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include "DummyTree.h"
+#include <osvr/Common/PathTreeObserver.h>
+#include <osvr/Common/PathTreeOwner.h>
+#include <osvr/Common/PathTreeSerialization.h>
+#include <osvr/Common/ResolveTreeNode.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <json/value.h>
+
+// Standard includes
+// - none
+
+namespace common = osvr::common;
+using osvr::common::PathTree;
+
+class PathTreeOwnerDiff : public ::testing::Test {
+  public:
+    PathTreeOwnerDiff() : observer(owner.makeObserver()) {
+        setupDummyTree(serverTree);
+        observer->setEventCallback(
+            common::PathTreeEvents::AfterUpdate, [&](PathTree &) {
+                changed = owner.hasResolutionChanged(dummy::getAlias());
+            });
+    }
+
+    /// @brief Sends the server tree to the owner, returning whether the alias
+    /// resolution was reported as changed.
+    bool sendTree() {
+        changed = false;
+        owner.replaceTree(common::pathTreeToJson(serverTree));
+        return changed;
+    }
+
+    void setAlias(std::string const &source) {
+        serverTree.getNodeByPath(dummy::getAlias()).value() =
+            common::elements::AliasElement(source);
+    }
+
+    std::string getOtherSensorPath() {
+        return dummy::getInterfacePath() + "/" +
+               boost::lexical_cast<std::string>(dummy::getSensor() + 1);
+    }
+
+    PathTree serverTree;
+    common::PathTreeOwner owner;
+    common::PathTreeObserverPtr observer;
+    bool changed = false;
+};
+
+TEST_F(PathTreeOwnerDiff, FirstTreeChanges) { ASSERT_TRUE(sendTree()); }
+
+TEST_F(PathTreeOwnerDiff, IdenticalTreeUnchanged) {
+    sendTree();
+    ASSERT_FALSE(sendTree());
+}
+
+TEST_F(PathTreeOwnerDiff, UnrelatedChangeUnchanged) {
+    sendTree();
+    serverTree.getNodeByPath("/me/head",
+                             common::elements::AliasElement(
+                                 dummy::getInterfacePath() + "/0"));
+    ASSERT_FALSE(sendTree());
+}
+
+TEST_F(PathTreeOwnerDiff, RetargetedAliasChanges) {
+    sendTree();
+    setAlias(getOtherSensorPath());
+    ASSERT_TRUE(sendTree());
+    ASSERT_FALSE(sendTree());
+}
+
+TEST_F(PathTreeOwnerDiff, AddedTransformChanges) {
+    sendTree();
+    Json::Value val(Json::objectValue);
+    val["child"] = getFullSourcePath();
+    val["translate"]["x"] = 1;
+    setAlias(val.toStyledString());
+    ASSERT_TRUE(sendTree());
+}
+
+TEST_F(PathTreeOwnerDiff, RemovedDeviceChanges) {
+    sendTree();
+    serverTree.reset();
+    ASSERT_TRUE(sendTree());
+}
+
+TEST(OriginalSource, ComparesAcrossTrees) {
+    PathTree a;
+    PathTree b;
+    setupDummyTree(a);
+    setupDummyTree(b);
+    auto sourceA = common::resolveTreeNode(a, dummy::getAlias());
+    auto sourceB = common::resolveTreeNode(b, dummy::getAlias());
+    ASSERT_TRUE(sourceA.is_initialized());
+    ASSERT_TRUE(sourceB.is_initialized());
+    ASSERT_TRUE(*sourceA == *sourceB);
+
+    b.getNodeByPath(dummy::getAlias()).value() =
+        common::elements::AliasElement(dummy::getInterfacePath() + "/2");
+    sourceB = common::resolveTreeNode(b, dummy::getAlias());
+    ASSERT_TRUE(sourceB.is_initialized());
+    ASSERT_TRUE(*sourceA != *sourceB);
+}
@@ -29,7 +29,9 @@
 #include "gtest/gtest.h"
 
 // Standard includes
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 using osvr::util::StringID;
 using osvr::util::PeerStringID;
@@ -150,3 +152,48 @@ TEST_F(RegisteredStringMapTest, checkSetupPeerMappings) {
     ASSERT_STREQ("RegVal1", corMap.getStringFromId(corID4).c_str());
     ASSERT_STREQ("RegVal2", corMap.getStringFromId(corID5).c_str());
 }
+
+TEST(RegisteredStringMap, manyEntries) {
+    RegisteredStringMap regMap;
+    static const uint32_t N = 5000;
+    for (uint32_t i = 0; i < N; ++i) {
+        ASSERT_EQ(i, regMap.getStringID("/name/" + std::to_string(i)).value());
+    }
+    regMap.clearModifiedFlag();
+    for (uint32_t i = 0; i < N; ++i) {
+        auto name = "/name/" + std::to_string(i);
+        ASSERT_EQ(i, regMap.getStringID(name).value());
+        ASSERT_EQ(i, regMap.getStringID(name.c_str()).value());
+        ASSERT_EQ(name, regMap.getStringFromId(StringID(i)));
+    }
+    ASSERT_FALSE(regMap.isModified());
+    ASSERT_EQ(N, regMap.getEntries().size());
+}
+
+TEST(RegisteredStringMap, distinguishesPrefixes) {
+    RegisteredStringMap regMap;
+    StringID a = regMap.getStringID("abc");
+    StringID b = regMap.getStringID("ab");
+    StringID c = regMap.getStringID(std::string("abc\0d", 5));
+    ASSERT_NE(a, b);
+    ASSERT_NE(a, c);
+    ASSERT_EQ(a, regMap.getStringID("abc"));
+    ASSERT_EQ(c, regMap.getStringID(std::string("abc\0d", 5)));
+    ASSERT_EQ(3, regMap.getEntries().size());
+}
+
+TEST_F(RegisteredStringMapTest, setupPeerMappingsReused) {
+    std::vector<std::string> entries{"CorVal2", "New0", "CorVal0", "New1"};
+    corMap.setupPeerMappings(entries);
+    ASSERT_EQ(corID2, corMap.convertPeerToLocalID(PeerStringID(0)));
+    ASSERT_EQ(corID0, corMap.convertPeerToLocalID(PeerStringID(2)));
+    ASSERT_EQ("New0", corMap.getStringFromId(
+                          corMap.convertPeerToLocalID(PeerStringID(1))));
+    ASSERT_EQ(4, corMap.convertPeerToLocalID(PeerStringID(3)).value());
+
+    // Setting up again replaces, rather than extends, the mappings.
+    corMap.setupPeerMappings(std::vector<std::string>{"New1"});
+    ASSERT_EQ(4, corMap.convertPeerToLocalID(PeerStringID(0)).value());
+    ASSERT_THROW(corMap.convertPeerToLocalID(PeerStringID(1)),
+                 std::out_of_range);
+}
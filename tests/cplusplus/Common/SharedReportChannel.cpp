@@ -0,0 +1,202 @@
+/** @file
+    @brief Test for the shared-memory report channel.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include <osvr/Common/SharedReportChannel.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <vector>
+
+using osvr::common::SharedReportChannel;
+using osvr::common::SharedReportKind;
+using osvr::common::SharedReportRecord;
+
+static const char DEVICE_NAME[] = "com_osvr_test_SharedReportChannel/Device";
+static const int PORT = 3883;
+
+static SharedReportRecord makeRecord(OSVR_ChannelCount sensor) {
+    SharedReportRecord record = {};
+    record.kind = SharedReportKind::Analog;
+    record.sensor = sensor;
+    record.timestamp.seconds = sensor;
+    record.values[0] = sensor * 0.5;
+    return record;
+}
+
+TEST(SharedReportChannel, FindWithoutCreate) {
+    ASSERT_FALSE(SharedReportChannel::find(
+        "com_osvr_test_SharedReportChannel/Missing"));
+}
+
+TEST(SharedReportChannel, PublishAndPoll) {
+    auto server = SharedReportChannel::create(DEVICE_NAME, PORT);
+    ASSERT_TRUE(bool(server));
+    server->publish(makeRecord(100));
+    // Only records published after opening are read.
+    auto client = SharedReportChannel::find(server->getSharedMemoryName());
+    ASSERT_TRUE(bool(client));
+    std::vector<SharedReportRecord> out(8);
+    ASSERT_EQ(0, client->poll(out.data(), out.size()));
+
+    for (OSVR_ChannelCount i = 0; i < 5; ++i) {
+        server->publish(makeRecord(i));
+    }
+    ASSERT_EQ(3, client->poll(out.data(), 3));
+    ASSERT_EQ(2, client->poll(out.data() + 3, out.size()));
+    for (OSVR_ChannelCount i = 0; i < 5; ++i) {
+        ASSERT_EQ(SharedReportKind::Analog, out[i].kind);
+        ASSERT_EQ(i, out[i].sensor);
+        ASSERT_EQ(i, out[i].timestamp.seconds);
+        ASSERT_EQ(i * 0.5, out[i].values[0]);
+    }
+    ASSERT_EQ(0, client->poll(out.data(), out.size()));
+    ASSERT_EQ(0, client->getDropped());
+}
+
+TEST(SharedReportChannel, NamedPerServerPort) {
+    auto server = SharedReportChannel::create(DEVICE_NAME, PORT);
+    ASSERT_TRUE(bool(server));
+    ASSERT_EQ(SharedReportChannel::getName(DEVICE_NAME, PORT),
+              server->getSharedMemoryName());
+    auto other = SharedReportChannel::create(DEVICE_NAME, PORT + 1);
+    ASSERT_TRUE(bool(other));
+    ASSERT_NE(server->getSharedMemoryName(), other->getSharedMemoryName());
+
+    auto client = SharedReportChannel::find(server->getSharedMemoryName());
+    ASSERT_TRUE(bool(client));
+    other->publish(makeRecord(1));
+    std::vector<SharedReportRecord> out(8);
+    ASSERT_EQ(0, client->poll(out.data(), out.size()))
+        << "Got a report from the server on the other port";
+    server->publish(makeRecord(2));
+    ASSERT_EQ(1, client->poll(out.data(), out.size()));
+    ASSERT_EQ(2, out[0].sensor);
+}
+
+TEST(SharedReportChannel, LoopbackIsInProcessOnly) {
+    auto server = SharedReportChannel::create(DEVICE_NAME, 0);
+    ASSERT_TRUE(bool(server));
+    ASSERT_TRUE(server->getSharedMemoryName().empty());
+    ASSERT_EQ(server, SharedReportChannel::findInProcess(DEVICE_NAME));
+}
+
+TEST(SharedReportChannel, CountsDroppedWhenBehind) {
+    auto server = SharedReportChannel::create(DEVICE_NAME, PORT);
+    ASSERT_TRUE(bool(server));
+    auto client = SharedReportChannel::find(server->getSharedMemoryName());
+    ASSERT_TRUE(bool(client));
+    const OSVR_ChannelCount total = SharedReportChannel::CAPACITY + 10;
+    for (OSVR_ChannelCount i = 0; i < total; ++i) {
+        server->publish(makeRecord(i));
+    }
+    std::vector<SharedReportRecord> out(total);
+    auto n = client->poll(out.data(), out.size());
+    ASSERT_EQ(total, n + client->getDropped());
+    ASSERT_LE(n, std::size_t(SharedReportChannel::CAPACITY));
+    ASSERT_GT(n, 0);
+    // What we did get is the most recent records, in order.
+    ASSERT_EQ(total - 1, out[n - 1].sensor);
+    for (std::size_t i = 1; i < n; ++i) {
+        ASSERT_EQ(out[i - 1].sensor + 1, out[i].sensor);
+    }
+}
+
+namespace {
+struct Subscriber {
+    std::vector<SharedReportRecord> records;
+    static void handle(void *userdata, SharedReportRecord const &record) {
+        static_cast<Subscriber *>(userdata)->records.push_back(record);
+    }
+};
+/// @brief Unsubscribes itself from the channel when first called.
+struct OneShotSubscriber {
+    SharedReportChannel *channel;
+    std::vector<SharedReportRecord> records;
+    static void handle(void *userdata, SharedReportRecord const &record) {
+        auto self = static_cast<OneShotSubscriber *>(userdata);
+        self->records.push_back(record);
+        self->channel->unsubscribe(&OneShotSubscriber::handle, self);
+    }
+};
+} // namespace
+
+TEST(SharedReportChannel, FindInProcessWithoutCreate) {
+    ASSERT_FALSE(SharedReportChannel::findInProcess(
+        "com_osvr_test_SharedReportChannel/Missing"));
+}
+
+TEST(SharedReportChannel, InProcessSubscribers) {
+    auto server = SharedReportChannel::create(DEVICE_NAME, PORT);
+    ASSERT_TRUE(bool(server));
+    auto inProcess = SharedReportChannel::findInProcess(DEVICE_NAME);
+    ASSERT_EQ(server, inProcess);
+
+    Subscriber a, b;
+    inProcess->subscribe(&Subscriber::handle, &a);
+    inProcess->subscribe(&Subscriber::handle, &b);
+    for (OSVR_ChannelCount i = 0; i < 3; ++i) {
+        server->publish(makeRecord(i));
+    }
+    inProcess->unsubscribe(&Subscriber::handle, &a);
+    server->publish(makeRecord(3));
+    inProcess->unsubscribe(&Subscriber::handle, &b);
+    server->publish(makeRecord(4));
+
+    // Everything published while subscribed, in order, as published.
+    ASSERT_EQ(3, a.records.size());
+    ASSERT_EQ(4, b.records.size());
+    for (OSVR_ChannelCount i = 0; i < 4; ++i) {
+        ASSERT_EQ(i, b.records[i].sensor);
+        ASSERT_EQ(i, b.records[i].timestamp.seconds);
+        ASSERT_EQ(i * 0.5, b.records[i].values[0]);
+    }
+}
+
+TEST(SharedReportChannel, UnsubscribeFromSubscriber) {
+    auto server = SharedReportChannel::create(DEVICE_NAME, PORT);
+    ASSERT_TRUE(bool(server));
+    OneShotSubscriber first{server.get(), {}};
+    Subscriber second;
+    server->subscribe(&OneShotSubscriber::handle, &first);
+    server->subscribe(&Subscriber::handle, &second);
+    server->publish(makeRecord(0));
+    server->publish(makeRecord(1));
+    // The subscriber after the one that unsubscribed wasn't skipped.
+    ASSERT_EQ(1, first.records.size());
+    ASSERT_EQ(2, second.records.size());
+    server->unsubscribe(&Subscriber::handle, &second);
+}
+
+TEST(SharedReportChannel, FindInProcessGetsLatest) {
+    auto first = SharedReportChannel::create(DEVICE_NAME, PORT);
+    auto second = SharedReportChannel::create(DEVICE_NAME, PORT);
+    ASSERT_EQ(second, SharedReportChannel::findInProcess(DEVICE_NAME));
+    second.reset();
+    // Not kept alive by being findable.
+    ASSERT_FALSE(SharedReportChannel::findInProcess(DEVICE_NAME));
+}
@@ -0,0 +1,194 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include <osvr/Common/InterfaceState.h>
+#include <osvr/Util/QuaternionC.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <cmath>
+
+using osvr::common::InterfaceState;
+using osvr::common::StateHistory;
+using osvr::util::time::TimeValue;
+
+/// @brief Times in these tests are in quarter seconds, to be exact.
+static TimeValue makeTime(double seconds) {
+    TimeValue ret;
+    ret.seconds = OSVR_TimeValue_Seconds(std::floor(seconds));
+    ret.microseconds =
+        OSVR_TimeValue_Microseconds((seconds - ret.seconds) * 1000000);
+    return ret;
+}
+
+static OSVR_PositionState makePosition(double x) {
+    OSVR_PositionState ret;
+    ret.data[0] = x;
+    ret.data[1] = 2 * x;
+    ret.data[2] = 0;
+    return ret;
+}
+
+static const double PI = 3.14159265358979323846;
+static OSVR_ButtonState const PRESSED = OSVR_BUTTON_PRESSED;
+static OSVR_ButtonState const NOT_PRESSED = OSVR_BUTTON_NOT_PRESSED;
+
+TEST(StateHistory, DefaultKeepsNothing) {
+    StateHistory<OSVR_PositionReport> history;
+    ASSERT_EQ(0, history.capacity());
+    history.push(makeTime(1), makePosition(1));
+    ASSERT_TRUE(history.empty());
+    TimeValue ts;
+    OSVR_PositionState state;
+    ASSERT_FALSE(history.getStateAtTime(makeTime(1), ts, state));
+}
+
+TEST(StateHistory, WrapsKeepingNewest) {
+    StateHistory<OSVR_ButtonReport> history;
+    history.setCapacity(4);
+    for (int i = 0; i < 10; ++i) {
+        history.push(makeTime(i), OSVR_ButtonState(i));
+    }
+    ASSERT_EQ(4, history.size());
+    for (std::size_t i = 0; i < history.size(); ++i) {
+        ASSERT_EQ(OSVR_ButtonState(6 + i), history[i].state);
+    }
+    ASSERT_EQ(0, history.upperBound(makeTime(5.5)));
+    ASSERT_EQ(1, history.upperBound(makeTime(6)));
+    ASSERT_EQ(3, history.upperBound(makeTime(8.5)));
+    ASSERT_EQ(4, history.upperBound(makeTime(20)));
+}
+
+TEST(StateHistory, SetCapacityKeepsNewest) {
+    StateHistory<OSVR_ButtonReport> history;
+    history.setCapacity(4);
+    for (int i = 0; i < 6; ++i) {
+        history.push(makeTime(i), OSVR_ButtonState(i));
+    }
+    history.setCapacity(2);
+    ASSERT_EQ(2, history.size());
+    ASSERT_EQ(4, history[0].state);
+    ASSERT_EQ(5, history[1].state);
+    history.setCapacity(8);
+    ASSERT_EQ(2, history.size());
+    history.push(makeTime(6), OSVR_ButtonState(6));
+    ASSERT_EQ(3, history.size());
+    ASSERT_EQ(6, history[2].state);
+}
+
+TEST(StateHistory, SampleAndHoldForButtons) {
+    StateHistory<OSVR_ButtonReport> history;
+    history.setCapacity(8);
+    history.push(makeTime(1), PRESSED);
+    history.push(makeTime(2), NOT_PRESSED);
+    TimeValue ts;
+    OSVR_ButtonState state;
+    ASSERT_FALSE(history.getStateAtTime(makeTime(0.5), ts, state))
+        << "Before the oldest state";
+    ASSERT_TRUE(history.getStateAtTime(makeTime(1.75), ts, state));
+    ASSERT_EQ(PRESSED, state);
+    ASSERT_EQ(makeTime(1), ts);
+    ASSERT_TRUE(history.getStateAtTime(makeTime(2), ts, state));
+    ASSERT_EQ(NOT_PRESSED, state);
+    ASSERT_TRUE(history.getStateAtTime(makeTime(10), ts, state));
+    ASSERT_EQ(NOT_PRESSED, state);
+    ASSERT_EQ(makeTime(2), ts);
+}
+
+TEST(StateHistory, InterpolatesPositions) {
+    StateHistory<OSVR_PositionReport> history;
+    history.setCapacity(8);
+    history.push(makeTime(1), makePosition(0));
+    history.push(makeTime(2), makePosition(1));
+    history.push(makeTime(3), makePosition(3));
+    TimeValue ts;
+    OSVR_PositionState state;
+    ASSERT_TRUE(history.getStateAtTime(makeTime(2.5), ts, state));
+    ASSERT_EQ(makeTime(2.5), ts);
+    ASSERT_DOUBLE_EQ(2, state.data[0]);
+    ASSERT_DOUBLE_EQ(4, state.data[1]);
+    ASSERT_TRUE(history.getStateAtTime(makeTime(1.25), ts, state));
+    ASSERT_DOUBLE_EQ(0.25, state.data[0]);
+    ASSERT_TRUE(history.getStateAtTime(makeTime(5), ts, state))
+        << "After the newest state gets the newest";
+    ASSERT_DOUBLE_EQ(3, state.data[0]);
+    ASSERT_EQ(makeTime(3), ts);
+}
+
+TEST(StateHistory, SlerpsOrientations) {
+    StateHistory<OSVR_OrientationReport> history;
+    history.setCapacity(2);
+    OSVR_OrientationState identity;
+    osvrQuatSetIdentity(&identity);
+    // 90 degrees about y
+    OSVR_OrientationState rotated;
+    osvrQuatSetW(&rotated, std::sqrt(0.5));
+    osvrQuatSetX(&rotated, 0);
+    osvrQuatSetY(&rotated, std::sqrt(0.5));
+    osvrQuatSetZ(&rotated, 0);
+    history.push(makeTime(1), identity);
+    history.push(makeTime(2), rotated);
+    TimeValue ts;
+    OSVR_OrientationState state;
+    ASSERT_TRUE(history.getStateAtTime(makeTime(1.5), ts, state));
+    // 45 degrees about y
+    ASSERT_NEAR(std::cos(PI / 8), osvrQuatGetW(&state), 1e-9);
+    ASSERT_NEAR(0, osvrQuatGetX(&state), 1e-9);
+    ASSERT_NEAR(std::sin(PI / 8), osvrQuatGetY(&state), 1e-9);
+    ASSERT_NEAR(0, osvrQuatGetZ(&state), 1e-9);
+}
+
+TEST(InterfaceState, KeepsHistoryOnlyWhenAsked) {
+    InterfaceState state;
+    OSVR_PoseReport report;
+    report.sensor = 0;
+    osvrPose3SetIdentity(&report.pose);
+    state.setStateFromReport(makeTime(1), report);
+    TimeValue ts;
+    OSVR_PoseState pose;
+    ASSERT_FALSE(state.getStateAtTime<OSVR_PoseReport>(makeTime(1), ts, pose));
+
+    state.setHistoryCapacity(4);
+    state.setStateFromReport(makeTime(2), report);
+    report.pose.translation.data[0] = 1;
+    state.setStateFromReport(makeTime(3), report);
+    ASSERT_TRUE(
+        state.getStateAtTime<OSVR_PoseReport>(makeTime(2.5), ts, pose));
+    ASSERT_DOUBLE_EQ(0.5, pose.translation.data[0]);
+
+    // Out-of-order reports are ignored for history as for the latest state.
+    report.pose.translation.data[0] = 5;
+    state.setStateFromReport(makeTime(2.75), report);
+    ASSERT_TRUE(
+        state.getStateAtTime<OSVR_PoseReport>(makeTime(2.5), ts, pose));
+    ASSERT_DOUBLE_EQ(0.5, pose.translation.data[0]);
+
+    state.setHistoryCapacity(0);
+    ASSERT_FALSE(
+        state.getStateAtTime<OSVR_PoseReport>(makeTime(2.5), ts, pose));
+}
@@ -0,0 +1,252 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/ClientContext.h>
+#include <osvr/Common/ClientInterface.h>
+#include <osvr/Common/PathTree.h>
+#include <osvr/Common/Transform.h>
+#include <osvr/Util/Pose3C.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+using osvr::common::ClientInterfacePtr;
+
+/// @brief A context with an update thread of its own, like the one
+/// PureClientContext runs, sending every interface a pose report per update.
+///
+/// Report n carries a timestamp of n seconds and a translation of (n, n, n),
+/// so a torn read or a callback out of order shows.
+class ReportingContext : public OSVR_ClientContextObject {
+  public:
+    ReportingContext(bool deferCallbacks,
+                     osvr::common::ClientContextDeleter del)
+        : OSVR_ClientContextObject("com.osvr.test.reportingContext", del) {
+        m_enableUpdateThread(deferCallbacks);
+        m_thread = std::thread([&] {
+            while (m_run) {
+                {
+                    auto lock = lockUpdates();
+                    m_runUpdate();
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+    }
+
+    ~ReportingContext() {
+        m_run = false;
+        m_thread.join();
+    }
+
+    /// @brief Number of updates that have sent their reports.
+    int getReportsSent() const { return m_reportsSent; }
+
+    /// @brief Waits for the update thread to send another count reports.
+    bool waitForReports(int count) {
+        auto target = m_reportsSent + count;
+        for (int i = 0; i < 5000 && m_reportsSent < target; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return m_reportsSent >= target;
+    }
+
+  private:
+    void m_update() override {
+        auto n = m_reportsSent + 1;
+        OSVR_TimeValue timestamp;
+        timestamp.seconds = n;
+        timestamp.microseconds = 0;
+        OSVR_PoseReport report;
+        report.sensor = 0;
+        osvrPose3SetIdentity(&report.pose);
+        for (auto &coord : report.pose.translation.data) {
+            coord = n;
+        }
+        for (auto const &iface : getInterfaces()) {
+            iface->setState(timestamp, report);
+            iface->triggerCallbacks(timestamp, report);
+        }
+        m_reportsSent = n;
+    }
+    void m_sendRoute(std::string const &) override {}
+    osvr::common::PathTree const &m_getPathTree() const override {
+        return m_pathTree;
+    }
+    osvr::common::Transform const &m_getRoomToWorldTransform() const override {
+        return m_roomToWorld;
+    }
+    void m_setRoomToWorldTransform(
+        osvr::common::Transform const &xform) override {
+        m_roomToWorld = xform;
+    }
+
+    osvr::common::PathTree m_pathTree;
+    osvr::common::Transform m_roomToWorld;
+    std::atomic<int> m_reportsSent{0};
+    std::atomic<bool> m_run{true};
+    std::thread m_thread;
+};
+
+typedef std::unique_ptr<ReportingContext,
+                        void (*)(osvr::common::ClientContext *)>
+    ReportingContextPtr;
+
+static ReportingContextPtr makeReportingContext(bool deferCallbacks) {
+    return ReportingContextPtr(
+        osvr::common::makeContext<ReportingContext>(deferCallbacks),
+        &osvr::common::deleteContext);
+}
+
+/// @brief What a pose callback saw.
+struct CallbackRecord {
+    std::thread::id appThread = std::this_thread::get_id();
+    std::atomic<int> calls{0};
+    std::atomic<int> callsOnAppThread{0};
+    std::atomic<int> callsOutOfOrder{0};
+    std::atomic<int> callsTorn{0};
+    std::atomic<int> last{0};
+};
+
+static void poseCallback(void *userdata, const OSVR_TimeValue *timestamp,
+                         const OSVR_PoseReport *report) {
+    auto &record = *static_cast<CallbackRecord *>(userdata);
+    auto n = static_cast<int>(timestamp->seconds);
+    auto const &xlate = report->pose.translation.data;
+    if (xlate[0] != n || xlate[1] != n || xlate[2] != n) {
+        ++record.callsTorn;
+    }
+    if (n <= record.last) {
+        ++record.callsOutOfOrder;
+    }
+    record.last = n;
+    if (std::this_thread::get_id() == record.appThread) {
+        ++record.callsOnAppThread;
+    }
+    ++record.calls;
+}
+
+TEST(ThreadedClientContext, PublishesWholeReports) {
+    auto ctx = makeReportingContext(false);
+    auto iface = ctx->getInterface("/me/head");
+    // Sent, then published.
+    ASSERT_TRUE(ctx->waitForReports(2));
+
+    int last = 0;
+    for (int i = 0; i < 200; ++i) {
+        ctx->update();
+        osvr::util::time::TimeValue timestamp;
+        OSVR_PoseState pose;
+        ASSERT_TRUE(iface->getState<OSVR_PoseReport>(timestamp, pose));
+        auto n = static_cast<int>(timestamp.seconds);
+        ASSERT_EQ(n, pose.translation.data[0]);
+        ASSERT_EQ(n, pose.translation.data[1]);
+        ASSERT_EQ(n, pose.translation.data[2]);
+        ASSERT_LE(last, n) << "State went back in time";
+        last = n;
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    ASSERT_TRUE(ctx->waitForReports(2));
+    osvr::util::time::TimeValue timestamp;
+    OSVR_PoseState pose;
+    ASSERT_TRUE(iface->getState<OSVR_PoseReport>(timestamp, pose));
+    ASSERT_LT(last, timestamp.seconds) << "Published state never refreshed";
+    ctx->releaseInterface(iface.get());
+}
+
+TEST(ThreadedClientContext, CallsCallbacksFromUpdateThread) {
+    CallbackRecord record;
+    auto ctx = makeReportingContext(false);
+    auto iface = ctx->getInterface("/me/head");
+    iface->registerCallback(&poseCallback, &record);
+    ASSERT_TRUE(ctx->waitForReports(10));
+    ctx->releaseInterface(iface.get());
+
+    ASSERT_LT(0, record.calls);
+    ASSERT_EQ(0, record.callsOnAppThread);
+    ASSERT_EQ(0, record.callsOutOfOrder);
+    ASSERT_EQ(0, record.callsTorn);
+}
+
+TEST(ThreadedClientContext, DefersCallbacksToUpdate) {
+    CallbackRecord record;
+    auto ctx = makeReportingContext(true);
+    auto iface = ctx->getInterface("/me/head");
+    iface->registerCallback(&poseCallback, &record);
+    ASSERT_TRUE(ctx->waitForReports(10));
+    ASSERT_EQ(0, record.calls) << "Called before update()";
+
+    ctx->update();
+    auto calls = record.calls.load();
+    ASSERT_LE(10, calls);
+    ASSERT_EQ(calls, record.callsOnAppThread);
+    ASSERT_EQ(0, record.callsOutOfOrder);
+    ASSERT_EQ(0, record.callsTorn);
+
+    ASSERT_TRUE(ctx->waitForReports(5));
+    ctx->update();
+    ASSERT_LT(calls, record.calls);
+    ASSERT_EQ(record.calls, record.callsOnAppThread);
+    ASSERT_EQ(0, record.callsOutOfOrder);
+    ctx->releaseInterface(iface.get());
+}
+
+TEST(ThreadedClientContext, DropsCallbacksQueuedForReleasedInterface) {
+    CallbackRecord record;
+    auto ctx = makeReportingContext(true);
+    auto iface = ctx->getInterface("/me/head");
+    iface->registerCallback(&poseCallback, &record);
+    // Reports sent after registering have queued calls.
+    ASSERT_TRUE(ctx->waitForReports(2));
+
+    ctx->releaseInterface(iface.get());
+    iface.reset();
+    ctx->update();
+    ASSERT_EQ(0, record.calls);
+}
+
+TEST(ThreadedClientContext, DropsOldestCallbacksPastLimit) {
+    CallbackRecord record;
+    auto ctx = makeReportingContext(true);
+    auto iface = ctx->getInterface("/me/head");
+    iface->registerCallback(&poseCallback, &record);
+    const int limit = static_cast<int>(
+        osvr::common::ClientContext::MAX_DEFERRED_CALLBACKS);
+    ASSERT_TRUE(ctx->waitForReports(limit + 50));
+
+    auto sent = ctx->getReportsSent();
+    ctx->update();
+    ASSERT_GE(limit, record.calls) << "Queue grew past its limit";
+    ASSERT_LT(limit, record.last) << "Kept the oldest rather than the latest";
+    ASSERT_LE(sent, record.last);
+    ASSERT_EQ(0, record.callsOutOfOrder);
+    ctx->releaseInterface(iface.get());
+}
@@ -0,0 +1,103 @@
+/** @file
+    @brief Test for the batched tracker pose message.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/Buffer.h>
+#include <osvr/Common/Serialization.h>
+#include <osvr/Common/TrackerPoseBatch.h>
+#include <vrpn_Connection.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <vector>
+
+using osvr::common::TrackerPoseBatchEntry;
+using osvr::common::messages::TrackerPoseBatch;
+
+static std::vector<TrackerPoseBatchEntry> makeEntries(std::size_t n) {
+    std::vector<TrackerPoseBatchEntry> ret;
+    for (std::size_t i = 0; i < n; ++i) {
+        TrackerPoseBatchEntry entry;
+        entry.sensor = OSVR_ChannelCount(i * 2 + 1);
+        for (int j = 0; j < 3; ++j) {
+            entry.pose.translation.data[j] = i + j * 0.5;
+        }
+        for (int j = 0; j < 4; ++j) {
+            entry.pose.rotation.data[j] = i - j * 0.25;
+        }
+        ret.push_back(entry);
+    }
+    return ret;
+}
+
+TEST(TrackerPoseBatch, RoundTrip) {
+    auto entries = makeEntries(5);
+    osvr::common::Buffer<> buf;
+    TrackerPoseBatch::MessageSerialization msg(entries);
+    osvr::common::serialize(buf, msg);
+
+    std::vector<TrackerPoseBatchEntry> received;
+    auto reader = osvr::common::readExternalBuffer(buf.data(), buf.size());
+    TrackerPoseBatch::MessageSerialization receivedMsg(received);
+    osvr::common::deserialize(reader, receivedMsg);
+
+    ASSERT_EQ(entries.size(), received.size());
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        ASSERT_EQ(entries[i].sensor, received[i].sensor);
+        for (int j = 0; j < 3; ++j) {
+            ASSERT_EQ(entries[i].pose.translation.data[j],
+                      received[i].pose.translation.data[j]);
+        }
+        for (int j = 0; j < 4; ++j) {
+            ASSERT_EQ(entries[i].pose.rotation.data[j],
+                      received[i].pose.rotation.data[j]);
+        }
+    }
+}
+
+TEST(TrackerPoseBatch, ReusesVector) {
+    auto entries = makeEntries(TrackerPoseBatch::MAX_POSES_PER_MESSAGE);
+    osvr::common::Buffer<> buf;
+    TrackerPoseBatch::MessageSerialization msg(entries);
+    osvr::common::serialize(buf, msg);
+
+    auto received = makeEntries(50);
+    auto reader = osvr::common::readExternalBuffer(buf.data(), buf.size());
+    TrackerPoseBatch::MessageSerialization receivedMsg(received);
+    osvr::common::deserialize(reader, receivedMsg);
+    ASSERT_EQ(TrackerPoseBatch::MAX_POSES_PER_MESSAGE, received.size());
+    ASSERT_EQ(entries.back().sensor, received.back().sensor);
+}
+
+TEST(TrackerPoseBatch, FullMessageFitsInDatagram) {
+    auto entries = makeEntries(TrackerPoseBatch::MAX_POSES_PER_MESSAGE);
+    osvr::common::Buffer<> buf;
+    TrackerPoseBatch::MessageSerialization msg(entries);
+    osvr::common::serialize(buf, msg);
+    // VRPN puts a header of five 32-bit values, padded to 8 bytes, in front
+    // of each message.
+    ASSERT_LE(buf.size() + 24, std::size_t(vrpn_CONNECTION_UDP_BUFLEN));
+}
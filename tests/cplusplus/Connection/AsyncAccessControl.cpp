@@ -33,6 +33,7 @@
 #include <boost/thread/thread.hpp>
 
 // Standard includes
+#include <atomic>
 #include <memory>
 
 using std::string;
@@ -159,3 +160,26 @@ TEST(AsyncAccessControl, recursive) {
     ASSERT_FALSE(control.mainThreadCTS())
         << "CTS should have no tasks waiting.";
 }
+
+TEST(AsyncAccessControl, requestCallback) {
+    AsyncAccessControl control;
+    std::atomic<int> requests(0);
+    control.setRequestCallback([&] { ++requests; });
+    volatile bool sent = false;
+
+    ScopedThread asyncThread(new boost::thread([&] {
+        RequestToSend rts(control);
+        ASSERT_TRUE(rts.request()) << "Request should be approved";
+        sent = true;
+    }));
+
+    while (requests == 0) {
+        pleaseYield();
+    }
+    ASSERT_FALSE(sent) << "Callback should come before permission to send.";
+    while (!control.mainThreadCTS()) {
+        pleaseYield();
+    }
+    ASSERT_TRUE(sent) << "Should have sent";
+    ASSERT_EQ(1, requests);
+}
@@ -0,0 +1,271 @@
+/** @file
+    @brief Test for the async device send queue.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// Internal Includes
+#include "../../../src/osvr/Connection/AsyncSendQueue.h"
+#include "../../../src/osvr/Connection/AsyncSendQueue.cpp"
+#include <osvr/Connection/Connection.h>
+#include <osvr/Connection/DeviceInitObject.h>
+#include <osvr/Connection/DeviceToken.h>
+#include <osvr/Connection/MessageType.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using osvr::connection::AsyncSendQueue;
+using osvr::util::time::TimeValue;
+
+/// @brief Queues a report whose contents are the given number.
+static bool pushNumber(AsyncSendQueue &queue, int n) {
+    TimeValue tv = {n, 0};
+    return queue.push(tv, nullptr, reinterpret_cast<const char *>(&n),
+                      sizeof(n));
+}
+
+/// @brief Drains the queue, returning the numbers from the reports.
+static std::vector<int> drainNumbers(AsyncSendQueue &queue) {
+    std::vector<int> ret;
+    queue.drain([&](AsyncSendQueue::Report const &report) {
+        int n;
+        std::memcpy(&n, report.data.data(), sizeof(n));
+        EXPECT_EQ(sizeof(n), report.data.size());
+        EXPECT_EQ(n, report.timestamp.seconds);
+        ret.push_back(n);
+    });
+    return ret;
+}
+
+TEST(AsyncSendQueue, CapacityRoundedToPowerOfTwo) {
+    ASSERT_EQ(2, AsyncSendQueue(0).getCapacity());
+    ASSERT_EQ(8, AsyncSendQueue(5).getCapacity());
+    ASSERT_EQ(8, AsyncSendQueue(8).getCapacity());
+    ASSERT_EQ(32, AsyncSendQueue().getCapacity());
+    ASSERT_EQ(OSVR_ASYNC_SEND_BACKPRESSURE, AsyncSendQueue().getPolicy());
+}
+
+TEST(AsyncSendQueue, FirstInFirstOut) {
+    AsyncSendQueue queue(4);
+    ASSERT_TRUE(drainNumbers(queue).empty());
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(pushNumber(queue, i));
+    }
+    ASSERT_EQ(3, queue.getStats().depth);
+    ASSERT_EQ((std::vector<int>{0, 1, 2}), drainNumbers(queue));
+    // Wrap around.
+    for (int i = 3; i < 7; ++i) {
+        ASSERT_TRUE(pushNumber(queue, i));
+    }
+    ASSERT_EQ((std::vector<int>{3, 4, 5, 6}), drainNumbers(queue));
+    auto stats = queue.getStats();
+    ASSERT_EQ(0, stats.depth);
+    ASSERT_EQ(4, stats.peakDepth);
+    ASSERT_EQ(7, stats.sent);
+    ASSERT_EQ(0, stats.dropped);
+}
+
+TEST(AsyncSendQueue, DropOldestWhenFull) {
+    AsyncSendQueue queue(4, OSVR_ASYNC_SEND_DROP_OLDEST);
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(pushNumber(queue, i));
+    }
+    ASSERT_EQ(4, queue.getStats().depth);
+    ASSERT_EQ((std::vector<int>{6, 7, 8, 9}), drainNumbers(queue));
+    auto stats = queue.getStats();
+    ASSERT_EQ(4, stats.peakDepth);
+    ASSERT_EQ(4, stats.sent);
+    ASSERT_EQ(6, stats.dropped);
+}
+
+TEST(AsyncSendQueue, BackpressureBlocksUntilDrained) {
+    AsyncSendQueue queue(2);
+    ASSERT_TRUE(pushNumber(queue, 0));
+    ASSERT_TRUE(pushNumber(queue, 1));
+    std::atomic<bool> pushed(false);
+    std::thread producer([&] {
+        pushNumber(queue, 2);
+        pushed = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_FALSE(pushed);
+    ASSERT_EQ((std::vector<int>{0, 1}), drainNumbers(queue));
+    producer.join();
+    ASSERT_TRUE(pushed);
+    ASSERT_EQ((std::vector<int>{2}), drainNumbers(queue));
+    ASSERT_EQ(0, queue.getStats().dropped);
+}
+
+TEST(AsyncSendQueue, CloseReleasesBlockedProducer) {
+    AsyncSendQueue queue(2);
+    ASSERT_TRUE(pushNumber(queue, 0));
+    ASSERT_TRUE(pushNumber(queue, 1));
+    std::atomic<bool> result(true);
+    std::thread producer([&] { result = pushNumber(queue, 2); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    queue.close();
+    producer.join();
+    ASSERT_FALSE(result);
+    ASSERT_FALSE(pushNumber(queue, 3));
+    ASSERT_EQ((std::vector<int>{0, 1}), drainNumbers(queue));
+}
+
+class AsyncSendQueueThreaded
+    : public ::testing::TestWithParam<OSVR_AsyncSendPolicy> {};
+
+TEST_P(AsyncSendQueueThreaded, InOrderAndAccountedFor) {
+    static const int REPORTS = 20000;
+    AsyncSendQueue queue(8, GetParam());
+    std::thread producer([&] {
+        for (int i = 0; i < REPORTS; ++i) {
+            pushNumber(queue, i);
+        }
+    });
+    std::vector<int> received;
+    received.reserve(REPORTS);
+    auto consume = [&] {
+        auto numbers = drainNumbers(queue);
+        if (numbers.empty()) {
+            // Don't hog the core if the producer doesn't have one of its own.
+            std::this_thread::yield();
+        }
+        for (auto n : numbers) {
+            received.push_back(n);
+        }
+    };
+    while (received.empty() || received.back() != REPORTS - 1) {
+        consume();
+    }
+    producer.join();
+    consume();
+
+    for (std::size_t i = 1; i < received.size(); ++i) {
+        ASSERT_LT(received[i - 1], received[i]);
+    }
+    auto stats = queue.getStats();
+    ASSERT_EQ(0, stats.depth);
+    ASSERT_EQ(received.size(), stats.sent);
+    ASSERT_EQ(REPORTS, stats.sent + stats.dropped);
+    if (GetParam() == OSVR_ASYNC_SEND_BACKPRESSURE) {
+        ASSERT_EQ(0, stats.dropped);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(Policies, AsyncSendQueueThreaded,
+                        ::testing::Values(OSVR_ASYNC_SEND_BACKPRESSURE,
+                                          OSVR_ASYNC_SEND_DROP_OLDEST));
+
+class AsyncDeviceSendQueue : public ::testing::Test {
+  public:
+    AsyncDeviceSendQueue()
+        : conn(std::get<1>(
+              osvr::connection::Connection::createLoopbackConnection())),
+          init(conn) {
+        init.setName("com_osvr_test_AsyncSendQueue/Device");
+        msgType = conn->registerMessageType("com_osvr_test_AsyncSendQueue");
+    }
+
+    /// @brief Runs the connection until the device has sent the given number
+    /// of reports, or gives up after a while.
+    OSVR_AsyncSendQueueStats processUntilSent(std::uint64_t reports) {
+        OSVR_AsyncSendQueueStats stats = {};
+        auto end = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (std::chrono::steady_clock::now() < end) {
+            conn->waitForActivity(10000);
+            conn->process();
+            EXPECT_TRUE(token->getAsyncSendQueueStats(stats));
+            if (stats.sent >= reports) {
+                break;
+            }
+        }
+        return stats;
+    }
+
+    osvr::connection::ConnectionPtr conn;
+    OSVR_DeviceInitObject init;
+    osvr::connection::MessageTypePtr msgType;
+    osvr::connection::DeviceTokenPtr token;
+    std::atomic<int> reportsToSend{0};
+};
+
+TEST_F(AsyncDeviceSendQueue, SendsQueuedReports) {
+    init.setAsyncSendQueue(4, OSVR_ASYNC_SEND_BACKPRESSURE);
+    token = OSVR_DeviceTokenObject::createAsyncDevice(init);
+    reportsToSend = 20;
+    token->setUpdateCallback([&] {
+        if (reportsToSend > 0) {
+            --reportsToSend;
+            const char payload[] = "data";
+            token->sendData(msgType.get(), payload, sizeof(payload));
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return OSVR_RETURN_SUCCESS;
+    });
+    auto stats = processUntilSent(20);
+    ASSERT_EQ(20, stats.sent);
+    ASSERT_EQ(0, stats.dropped);
+    ASSERT_LE(stats.peakDepth, 4);
+    token->stopThreads();
+}
+
+TEST_F(AsyncDeviceSendQueue, SendFromWithinGuardDoesNotQueue) {
+    token = OSVR_DeviceTokenObject::createAsyncDevice(init);
+    std::atomic<int> sentWithGuard(0);
+    token->setUpdateCallback([&] {
+        if (sentWithGuard < 5) {
+            auto guard = token->getSendGuard();
+            if (guard->lock()) {
+                const char payload[] = "data";
+                token->sendData(msgType.get(), payload, sizeof(payload));
+                ++sentWithGuard;
+            }
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return OSVR_RETURN_SUCCESS;
+    });
+    auto end = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (sentWithGuard < 5 && std::chrono::steady_clock::now() < end) {
+        conn->waitForActivity(10000);
+        conn->process();
+    }
+    ASSERT_EQ(5, sentWithGuard);
+    OSVR_AsyncSendQueueStats stats;
+    ASSERT_TRUE(token->getAsyncSendQueueStats(stats));
+    ASSERT_EQ(0, stats.sent);
+    token->stopThreads();
+}
+
+TEST_F(AsyncDeviceSendQueue, SyncDevicesHaveNoQueue) {
+    token = OSVR_DeviceTokenObject::createSyncDevice(init);
+    OSVR_AsyncSendQueueStats stats;
+    ASSERT_FALSE(token->getAsyncSendQueueStats(stats));
+}
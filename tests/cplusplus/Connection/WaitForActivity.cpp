@@ -0,0 +1,185 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Connection/Connection.h>
+#include <osvr/Connection/DeviceInitObject.h>
+#include <osvr/Connection/DeviceToken.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/select.h>
+#include <unistd.h>
+#endif
+
+using osvr::connection::Connection;
+using osvr::connection::ConnectionPtr;
+using std::chrono::steady_clock;
+
+/// @brief Long enough that a wait lasting this long means the wakeup was
+/// missed.
+static const int LONG_WAIT = 10000000;
+
+class WaitForActivity : public ::testing::Test {
+  public:
+    WaitForActivity()
+        : conn(std::get<1>(Connection::createLoopbackConnection())) {}
+    ConnectionPtr conn;
+};
+
+TEST_F(WaitForActivity, TimesOut) {
+    auto start = steady_clock::now();
+    conn->waitForActivity(20000);
+    ASSERT_GE(steady_clock::now() - start, std::chrono::milliseconds(15));
+}
+
+TEST_F(WaitForActivity, EarlierWakeUpNotMissed) {
+    conn->wakeUp();
+    auto start = steady_clock::now();
+    conn->waitForActivity(LONG_WAIT);
+    ASSERT_LT(steady_clock::now() - start, std::chrono::seconds(5));
+}
+
+TEST_F(WaitForActivity, WokenFromOtherThread) {
+    std::thread other([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        conn->wakeUp();
+    });
+    auto start = steady_clock::now();
+    conn->waitForActivity(LONG_WAIT);
+    auto elapsed = steady_clock::now() - start;
+    other.join();
+    ASSERT_LT(elapsed, std::chrono::seconds(5));
+}
+
+TEST_F(WaitForActivity, WakeUpConsumedByWait) {
+    conn->wakeUp();
+    conn->wakeUp();
+    conn->waitForActivity(LONG_WAIT);
+    auto start = steady_clock::now();
+    conn->waitForActivity(20000);
+    ASSERT_GE(steady_clock::now() - start, std::chrono::milliseconds(15));
+}
+
+TEST_F(WaitForActivity, WakeUpRacingWithDrainNotLost) {
+    // Drain (by waits that find the socket signalled) while another thread
+    // keeps signalling, so some signals land in the middle of a drain.
+    std::atomic<bool> racing(true);
+    std::thread other([&] {
+        while (racing) {
+            conn->wakeUp();
+        }
+    });
+    for (int i = 0; i < 200000; ++i) {
+        conn->waitForActivity(0);
+    }
+    racing = false;
+    other.join();
+    // Consume whatever the last signal left.
+    conn->waitForActivity(0);
+
+    std::thread waker([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        conn->wakeUp();
+    });
+    auto start = steady_clock::now();
+    conn->waitForActivity(LONG_WAIT);
+    auto elapsed = steady_clock::now() - start;
+    waker.join();
+    ASSERT_LT(elapsed, std::chrono::seconds(5));
+}
+
+TEST_F(WaitForActivity, OnlySyncDevicesRequirePolling) {
+    ASSERT_FALSE(conn->devicesRequirePolling());
+    auto update = [] { return OSVR_RETURN_SUCCESS; };
+    OSVR_DeviceInitObject asyncInit(conn);
+    asyncInit.setName("com_osvr_test_WaitForActivity/Async");
+    auto async = OSVR_DeviceTokenObject::createAsyncDevice(asyncInit);
+    async->setUpdateCallback(update);
+    ASSERT_FALSE(conn->devicesRequirePolling());
+
+    OSVR_DeviceInitObject syncInit(conn);
+    syncInit.setName("com_osvr_test_WaitForActivity/Sync");
+    auto sync = OSVR_DeviceTokenObject::createSyncDevice(syncInit);
+    ASSERT_FALSE(conn->devicesRequirePolling());
+    sync->setUpdateCallback(update);
+    ASSERT_TRUE(conn->devicesRequirePolling());
+}
+
+#ifndef _WIN32
+TEST(WaitForActivityHighDescriptors, WakesAndTimesOut) {
+    // Use up descriptors so that the connection's sockets get values that
+    // an fd_set has no room for.
+    rlimit limit;
+    ASSERT_EQ(0, getrlimit(RLIMIT_NOFILE, &limit));
+    auto const originalLimit = limit;
+    rlim_t const needed = FD_SETSIZE + 64;
+    if (limit.rlim_cur < needed &&
+        (limit.rlim_max == RLIM_INFINITY || limit.rlim_max >= needed)) {
+        limit.rlim_cur = needed;
+        setrlimit(RLIMIT_NOFILE, &limit);
+        getrlimit(RLIMIT_NOFILE, &limit);
+    }
+    if (limit.rlim_cur < needed) {
+        std::cout << "Not enough file descriptors allowed to run this test"
+                  << std::endl;
+        return;
+    }
+    std::vector<int> fillers;
+    while (fillers.empty() || fillers.back() < FD_SETSIZE) {
+        auto fd = open("/dev/null", O_RDONLY);
+        ASSERT_NE(-1, fd);
+        fillers.push_back(fd);
+    }
+    {
+        auto conn = std::get<1>(Connection::createLoopbackConnection());
+        auto start = steady_clock::now();
+        conn->waitForActivity(20000);
+        ASSERT_GE(steady_clock::now() - start, std::chrono::milliseconds(15));
+
+        conn->wakeUp();
+        start = steady_clock::now();
+        conn->waitForActivity(LONG_WAIT);
+        ASSERT_LT(steady_clock::now() - start, std::chrono::seconds(5));
+    }
+    for (auto fd : fillers) {
+        close(fd);
+    }
+    setrlimit(RLIMIT_NOFILE, &originalLimit);
+}
+#endif
+
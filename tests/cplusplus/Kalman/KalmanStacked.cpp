@@ -0,0 +1,203 @@
+/** @file
+    @brief Test that correcting with a stacked block of measurements matches
+   correcting with each in turn.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Kalman/FlexibleKalmanFilter.h>
+#include <osvr/Kalman/ConstantProcess.h>
+#include <osvr/Kalman/PureVectorState.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <vector>
+
+using State = osvr::kalman::PureVectorState<4>;
+using ProcessModel = osvr::kalman::ConstantProcess<State>;
+using Stacked = osvr::kalman::StackedMeasurement<State>;
+namespace types = osvr::kalman::types;
+
+/// A measurement of two linear combinations of the state.
+class LinearMeasurement {
+  public:
+    static const types::DimensionType DIMENSION = 2;
+    using Vector = types::Vector<DIMENSION>;
+    using SquareMatrix = types::SquareMatrix<DIMENSION>;
+    using Jacobian = types::Matrix<DIMENSION, 4>;
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+    LinearMeasurement(Jacobian const &H, Vector const &z,
+                      SquareMatrix const &R)
+        : m_H(H), m_z(z), m_R(R) {}
+    Jacobian getJacobian(State const &) const { return m_H; }
+    SquareMatrix getCovariance(State const &) const { return m_R; }
+    Vector getResidual(State const &state) const {
+        return m_z - m_H * state.stateVector();
+    }
+    bool appendTo(Stacked &stacked, State const &state) const {
+        return stacked.append(getResidual(state), getJacobian(state),
+                              getCovariance(state));
+    }
+
+  private:
+    Jacobian m_H;
+    Vector m_z;
+    SquareMatrix m_R;
+};
+
+static State makeState() {
+    types::SquareMatrix<4> P;
+    P << 4, 1, 0, 0.5, //
+        1, 3, 0.2, 0,  //
+        0, 0.2, 2, 0,  //
+        0.5, 0, 0, 1;
+    return State(types::Vector<4>(1, 2, 3, 4), P);
+}
+
+/// A state with one element known exactly, so with a singular covariance.
+static State makeStateWithFixedElement() {
+    types::SquareMatrix<4> P;
+    P << 4, 1, 0, 0, //
+        1, 3, 0.2, 0, //
+        0, 0.2, 2, 0, //
+        0, 0, 0, 0;
+    return State(types::Vector<4>(1, 2, 3, 4), P);
+}
+
+using MeasurementVector =
+    std::vector<LinearMeasurement,
+                Eigen::aligned_allocator<LinearMeasurement>>;
+
+static MeasurementVector makeMeasurements() {
+    MeasurementVector ret;
+    LinearMeasurement::Jacobian H;
+    LinearMeasurement::SquareMatrix R;
+    H << 1, 0, 0, 0, //
+        0, 1, 0, 0;
+    R << 0.5, 0.1, //
+        0.1, 0.4;
+    ret.emplace_back(H, LinearMeasurement::Vector(1.5, 1.5), R);
+    H << 0, 0, 1, 1, //
+        1, -1, 0, 0;
+    R << 0.2, 0, //
+        0, 0.3;
+    ret.emplace_back(H, LinearMeasurement::Vector(6.5, -1.2), R);
+    H << 0.5, 0.5, 0.5, 0.5, //
+        0, 0, 2, 0;
+    R << 1, 0, //
+        0, 2;
+    ret.emplace_back(H, LinearMeasurement::Vector(5, 5.5), R);
+    return ret;
+}
+
+TEST(KalmanStackedCorrection, EmptyIsNoOp) {
+    auto state = makeState();
+    ProcessModel process;
+    Stacked stacked;
+    ASSERT_TRUE(osvr::kalman::correctStacked(state, process, stacked));
+    ASSERT_TRUE(state.stateVector().isApprox(makeState().stateVector()));
+    ASSERT_TRUE(
+        state.errorCovariance().isApprox(makeState().errorCovariance()));
+}
+
+/// Corrects copies of the initial state with the given measurements in turn
+/// and all at once, and checks the results match.
+static void checkMatchesSequential(State const &initial,
+                                   MeasurementVector &measurements) {
+    ProcessModel process;
+    auto sequential = initial;
+    for (auto &meas : measurements) {
+        osvr::kalman::correct(sequential, process, meas);
+    }
+
+    auto batched = initial;
+    Stacked stacked;
+    for (auto const &meas : measurements) {
+        ASSERT_TRUE(meas.appendTo(stacked, batched));
+    }
+    ASSERT_EQ(2 * types::DimensionType(measurements.size()), stacked.rows());
+    ASSERT_TRUE(osvr::kalman::correctStacked(batched, process, stacked));
+
+    ASSERT_TRUE(batched.stateVector().isApprox(sequential.stateVector(), 1e-9))
+        << "Batched: " << batched.stateVector().transpose()
+        << "\nSequential: " << sequential.stateVector().transpose();
+    ASSERT_TRUE(batched.errorCovariance().isApprox(
+        sequential.errorCovariance(), 1e-9))
+        << "Batched:\n" << batched.errorCovariance() << "\nSequential:\n"
+        << sequential.errorCovariance();
+}
+
+TEST(KalmanStackedCorrection, MatchesSequentialInInformationForm) {
+    // More measurement rows than state dimensions.
+    auto measurements = makeMeasurements();
+    checkMatchesSequential(makeState(), measurements);
+}
+
+TEST(KalmanStackedCorrection, MatchesSequentialInCovarianceForm) {
+    // No more measurement rows than state dimensions.
+    auto measurements = makeMeasurements();
+    measurements.pop_back();
+    checkMatchesSequential(makeState(), measurements);
+}
+
+TEST(KalmanStackedCorrection, MatchesSequentialWithSingularCovariance) {
+    // Can't use the information form, so falls back to the covariance form.
+    auto measurements = makeMeasurements();
+    checkMatchesSequential(makeStateWithFixedElement(), measurements);
+}
+
+TEST(KalmanStackedCorrection, ReusableAfterClear) {
+    auto measurements = makeMeasurements();
+    ProcessModel process;
+    Stacked stacked;
+    stacked.reserve(2);
+
+    auto first = makeState();
+    for (auto const &meas : measurements) {
+        ASSERT_TRUE(meas.appendTo(stacked, first));
+    }
+    ASSERT_TRUE(osvr::kalman::correctStacked(first, process, stacked));
+
+    // Refill with the same measurements in another order: same result.
+    stacked.clear();
+    ASSERT_TRUE(stacked.empty());
+    auto second = makeState();
+    for (auto it = measurements.rbegin(); it != measurements.rend(); ++it) {
+        ASSERT_TRUE(it->appendTo(stacked, second));
+    }
+    ASSERT_TRUE(osvr::kalman::correctStacked(second, process, stacked));
+    ASSERT_TRUE(first.stateVector().isApprox(second.stateVector(), 1e-9));
+    ASSERT_TRUE(
+        first.errorCovariance().isApprox(second.errorCovariance(), 1e-9));
+}
+
+TEST(KalmanStackedCorrection, RejectsIndefiniteMeasurementCovariance) {
+    Stacked stacked;
+    LinearMeasurement::Jacobian H = LinearMeasurement::Jacobian::Identity();
+    ASSERT_FALSE(stacked.append(
+        LinearMeasurement::Vector(1, 1), H,
+        LinearMeasurement::SquareMatrix(
+            LinearMeasurement::Vector(-1, 1).asDiagonal())));
+    ASSERT_TRUE(stacked.empty());
+}
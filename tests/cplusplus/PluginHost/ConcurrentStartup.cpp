@@ -0,0 +1,142 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/PluginHost/RegistrationContext.h>
+#include <osvr/PluginHost/PluginSpecificRegistrationContext.h>
+#include "../../../src/osvr/PluginHost/PluginSpecificRegistrationContextImpl.h"
+#include "../../../src/osvr/PluginHost/OrderedHostAccess.h"
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using osvr::pluginhost::OrderedHostAccess;
+using osvr::pluginhost::PluginSpecificRegistrationContext;
+using osvr::pluginhost::RegistrationContext;
+
+static const auto DETECT_TIME = std::chrono::milliseconds(50);
+static const int PLUGINS = 8;
+
+TEST(OrderedHostAccess, FirstNeverWaits) {
+    OrderedHostAccess access(3);
+    access.waitForTurn(0);
+    ASSERT_EQ(0., access.getSecondsWaited(0));
+}
+
+TEST(OrderedHostAccess, WaitsForAllBefore) {
+    OrderedHostAccess access(3);
+    std::mutex mut;
+    std::vector<int> order;
+    std::thread last([&] {
+        access.waitForTurn(2);
+        std::lock_guard<std::mutex> lock(mut);
+        order.push_back(2);
+    });
+    // Finishing out of order doesn't let the last one through early.
+    std::this_thread::sleep_for(DETECT_TIME);
+    {
+        std::lock_guard<std::mutex> lock(mut);
+        order.push_back(1);
+    }
+    access.finish(1);
+    std::this_thread::sleep_for(DETECT_TIME);
+    {
+        std::lock_guard<std::mutex> lock(mut);
+        order.push_back(0);
+    }
+    access.finish(0);
+    last.join();
+    ASSERT_EQ((std::vector<int>{1, 0, 2}), order);
+    ASSERT_GT(access.getSecondsWaited(2), 0.);
+    // Once finished, access is no longer restricted.
+    access.finish(2);
+    access.waitForTurn(1);
+}
+
+namespace {
+/// @brief Records the order in which the detect callbacks reach the host.
+struct HostAccessLog {
+    std::mutex mut;
+    std::vector<std::string> names;
+};
+
+OSVR_ReturnCode detectAndReachHost(OSVR_PluginRegContext ctx,
+                                   void *userData) {
+    // Stand-in for probing hardware, without involving the host.
+    std::this_thread::sleep_for(DETECT_TIME);
+    auto &plugin = PluginSpecificRegistrationContext::get(ctx);
+    plugin.getParent();
+    auto log = static_cast<HostAccessLog *>(userData);
+    std::lock_guard<std::mutex> lock(log->mut);
+    log->names.push_back(plugin.getName());
+    return OSVR_RETURN_SUCCESS;
+}
+} // namespace
+
+TEST(RegistrationContext, ConcurrentHardwareDetectKeepsHostAccessOrdered) {
+    RegistrationContext host;
+    HostAccessLog log;
+    std::vector<std::string> expected;
+    // Adopt in reverse order, to make sure the order is that of the names.
+    for (int i = PLUGINS - 1; i >= 0; --i) {
+        auto name = "com_osvr_test_Plugin" + std::to_string(i);
+        auto pluginReg = PluginSpecificRegistrationContext::create(name);
+        PluginSpecificRegistrationContext &plugin = *pluginReg;
+        plugin.registerHardwareDetectCallback(&detectAndReachHost, &log);
+        host.adoptPluginRegistrationContext(pluginReg);
+        expected.insert(begin(expected), name);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    host.triggerHardwareDetect();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    ASSERT_EQ(expected, log.names);
+    // At least some of the probing overlapped.
+    ASSERT_LT(elapsed, DETECT_TIME * PLUGINS * 3 / 4);
+
+    auto timings = host.getStartupTimings();
+    ASSERT_EQ(std::size_t(PLUGINS), timings.size());
+    for (std::size_t i = 0; i < timings.size(); ++i) {
+        ASSERT_EQ(expected[i], timings[i].name);
+        ASSERT_TRUE(timings[i].loaded);
+        // Time spent waiting for the host doesn't count.
+        ASSERT_GE(timings[i].detectSeconds, 0.04);
+        ASSERT_LT(timings[i].detectSeconds, 0.04 * PLUGINS / 2);
+    }
+}
+
+TEST(RegistrationContext, HardwareDetectWithNoPlugins) {
+    RegistrationContext host;
+    host.triggerHardwareDetect();
+    ASSERT_TRUE(host.getStartupTimings().empty());
+}
@@ -0,0 +1,176 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "RecordingFormat.h"
+#include "RecordingWriter.h"
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <boost/filesystem/operations.hpp>
+
+// Standard includes
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace fs = boost::filesystem;
+
+/// @brief Record n: a button report for path n % 2, with a timestamp of n
+/// seconds and a state of n % 2.
+static Record makeRecord(int n) {
+    Record record;
+    std::memset(&record, 0, sizeof(record));
+    record.pathId = n % 2;
+    record.type = RecordType::Button;
+    record.payloadSize = sizeof(OSVR_ButtonReport);
+    record.seconds = n;
+    record.microseconds = 0;
+    OSVR_ButtonReport report;
+    report.sensor = 0;
+    report.state = static_cast<OSVR_ButtonState>(n % 2);
+    std::memcpy(record.payload, &report, sizeof(report));
+    return record;
+}
+
+static void expectRecord(int n, Record const &record) {
+    EXPECT_EQ(uint32_t(n % 2), record.pathId);
+    EXPECT_EQ(RecordType::Button, record.type);
+    EXPECT_EQ(sizeof(OSVR_ButtonReport), record.payloadSize);
+    EXPECT_EQ(n, record.seconds);
+    OSVR_ButtonReport report;
+    std::memcpy(&report, record.payload, sizeof(report));
+    EXPECT_EQ(n % 2, report.state);
+}
+
+static std::vector<std::string> getTestPaths() {
+    return {"/controller/left/1", "/controller/right/1"};
+}
+
+/// @brief A recording as the writer lays it out: preamble, then records.
+static std::vector<char> makeRecording(int count) {
+    auto ret = makeRecordingPreamble(getTestPaths());
+    for (int i = 0; i < count; ++i) {
+        auto record = makeRecord(i);
+        auto bytes = reinterpret_cast<const char *>(&record);
+        ret.insert(ret.end(), bytes, bytes + sizeof(record));
+    }
+    return ret;
+}
+
+static RecordingHeader getHeader(std::vector<char> const &recording) {
+    RecordingHeader header;
+    std::memcpy(&header, recording.data(), sizeof(header));
+    return header;
+}
+
+static void setHeader(std::vector<char> &recording,
+                      RecordingHeader const &header) {
+    std::memcpy(recording.data(), &header, sizeof(header));
+}
+
+TEST(RecordingFormat, WriterRoundTrip) {
+    auto filename =
+        (fs::temp_directory_path() / fs::unique_path("%%%%-%%%%.osvrrec"))
+            .string();
+    static const int COUNT = 1000;
+    {
+        RecordingWriter writer(filename, getTestPaths());
+        for (int i = 0; i < COUNT; ++i) {
+            ASSERT_TRUE(writer.push(makeRecord(i)));
+        }
+        writer.stop();
+        ASSERT_EQ(std::size_t(COUNT), writer.getWritten());
+        ASSERT_EQ(0u, writer.getDropped());
+    }
+    std::vector<char> contents;
+    {
+        std::ifstream file(filename, std::ios::in | std::ios::binary);
+        contents.assign(std::istreambuf_iterator<char>(file),
+                        std::istreambuf_iterator<char>());
+    }
+    fs::remove(filename);
+
+    RecordingView view(contents.data(), contents.size());
+    ASSERT_EQ(getTestPaths(), view.getPaths());
+    ASSERT_EQ(std::size_t(COUNT), view.size());
+    for (int i = 0; i < COUNT; ++i) {
+        expectRecord(i, view[i]);
+    }
+}
+
+TEST(RecordingFormat, TruncatedTail) {
+    auto recording = makeRecording(3);
+    // Cut partway through a fourth record.
+    auto partial = makeRecording(4);
+    partial.resize(partial.size() - sizeof(Record) / 2);
+    {
+        RecordingView view(partial.data(), partial.size());
+        ASSERT_EQ(3u, view.size());
+    }
+    // The unwritten, zeroed tail of the chunk a writer had mapped.
+    recording.resize(recording.size() + 10 * sizeof(Record), '\0');
+    {
+        RecordingView view(recording.data(), recording.size());
+        ASSERT_EQ(getTestPaths(), view.getPaths());
+        ASSERT_EQ(3u, view.size());
+        for (int i = 0; i < 3; ++i) {
+            expectRecord(i, view[i]);
+        }
+    }
+}
+
+TEST(RecordingFormat, RejectsTruncatedPreamble) {
+    auto recording = makeRecording(0);
+    ASSERT_THROW(RecordingView(recording.data(), sizeof(RecordingHeader) - 1),
+                 std::runtime_error);
+    ASSERT_THROW(RecordingView(recording.data(), sizeof(RecordingHeader) + 4),
+                 std::runtime_error);
+}
+
+TEST(RecordingFormat, RejectsInvalidRecordsOffset) {
+    auto recording = makeRecording(2);
+    auto header = getHeader(recording);
+    auto const goodOffset = header.recordsOffset;
+
+    header.recordsOffset = 0;
+    setHeader(recording, header);
+    ASSERT_THROW(RecordingView(recording.data(), recording.size()),
+                 std::runtime_error);
+
+    header.recordsOffset = sizeof(RecordingHeader) - 1;
+    setHeader(recording, header);
+    ASSERT_THROW(RecordingView(recording.data(), recording.size()),
+                 std::runtime_error);
+
+    header.recordsOffset = goodOffset + 1;
+    setHeader(recording, header);
+    ASSERT_THROW(RecordingView(recording.data(), recording.size()),
+                 std::runtime_error);
+
+    header.recordsOffset = goodOffset;
+    setHeader(recording, header);
+    ASSERT_NO_THROW(RecordingView(recording.data(), recording.size()));
+}
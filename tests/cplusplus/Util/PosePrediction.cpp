@@ -0,0 +1,107 @@
+/** @file
+    @brief Test implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Util/PosePrediction.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <cmath>
+
+namespace pred = osvr::util::prediction;
+using Eigen::AngleAxisd;
+using Eigen::Quaterniond;
+using Eigen::Vector3d;
+
+static const double PI = 3.14159265358979323846;
+static const double EPSILON = 1.0e-9;
+
+TEST(PosePrediction, RotationVectorRoundTrip) {
+    Vector3d rot(0.3, -0.2, 0.1);
+    auto back = pred::toRotationVector(pred::fromRotationVector(rot));
+    ASSERT_NEAR(0, (rot - back).norm(), EPSILON);
+    ASSERT_NEAR(0, pred::toRotationVector(Quaterniond::Identity()).norm(),
+                EPSILON);
+}
+
+TEST(PosePrediction, RotationVectorTakesShorterRotation) {
+    // The same rotation as a quarter turn, with the quaternion negated.
+    Quaterniond q(AngleAxisd(PI / 2, Vector3d::UnitY()));
+    q.coeffs() *= -1;
+    auto rot = pred::toRotationVector(q);
+    ASSERT_NEAR(0, (rot - Vector3d(0, PI / 2, 0)).norm(), EPSILON);
+}
+
+TEST(PosePrediction, AngularVelocityFromIncrementalRotation) {
+    // A quarter turn about Z every half second: pi rad/s.
+    Quaterniond inc(AngleAxisd(PI / 2, Vector3d::UnitZ()));
+    auto angVel = pred::angularVelocityFromIncrementalRotation(inc, 0.5);
+    ASSERT_NEAR(0, (angVel - Vector3d(0, 0, PI)).norm(), EPSILON);
+    ASSERT_TRUE(
+        pred::angularVelocityFromIncrementalRotation(inc, 0).isZero());
+}
+
+TEST(PosePrediction, FiniteDifferencesMatchConstantMotion) {
+    Vector3d linVel(1, 2, -0.5);
+    Vector3d angVel(0.5, -1.0, 2.0);
+    Quaterniond q0(AngleAxisd(0.4, Vector3d(1, 1, 0).normalized()));
+    Vector3d p0(0.1, 1.5, -0.3);
+    double dt = 0.01;
+    auto q1 = pred::applyAngularVelocity(q0, angVel, dt);
+    Vector3d p1 = p0 + linVel * dt;
+    ASSERT_NEAR(0, (pred::angularVelocityFromOrientations(q0, q1, dt) -
+                    angVel).norm(),
+                1.0e-6);
+    ASSERT_NEAR(0, (pred::linearVelocityFromPositions(p0, p1, dt) -
+                    linVel).norm(),
+                1.0e-6);
+}
+
+TEST(PosePrediction, PredictPoseAppliesVelocityInParentSpace) {
+    Eigen::Isometry3d pose;
+    pose.fromPositionOrientationScale(
+        Vector3d(1, 0, 0), Quaterniond(AngleAxisd(PI / 2, Vector3d::UnitX())),
+        Vector3d::Ones());
+    // Half a turn per second about room Y, and moving along room Z.
+    auto predicted = pred::predictPose(pose, Vector3d(0, 0, 2),
+                                       Vector3d(0, PI, 0), 0.5);
+    ASSERT_NEAR(0, (predicted.translation() - Vector3d(1, 0, 1)).norm(),
+                EPSILON);
+    Quaterniond expected = Quaterniond(AngleAxisd(PI / 2, Vector3d::UnitY())) *
+                           Quaterniond(AngleAxisd(PI / 2, Vector3d::UnitX()));
+    ASSERT_NEAR(1, std::abs(Quaterniond(predicted.rotation()).dot(expected)),
+                EPSILON);
+}
+
+TEST(PosePrediction, ZeroIntervalLeavesPoseUnchanged) {
+    Eigen::Isometry3d pose;
+    pose.fromPositionOrientationScale(
+        Vector3d(1, 2, 3), Quaterniond(AngleAxisd(0.3, Vector3d::UnitZ())),
+        Vector3d::Ones());
+    auto predicted =
+        pred::predictPose(pose, Vector3d(5, 5, 5), Vector3d(1, 1, 1), 0);
+    ASSERT_TRUE(predicted.isApprox(pose));
+}
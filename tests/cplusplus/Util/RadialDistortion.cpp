@@ -0,0 +1,159 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Util/RadialDistortion.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <cstddef>
+#include <stdexcept>
+
+using osvr::util::ColorChannel;
+using osvr::util::GridSampling;
+using osvr::util::RadialDistortionGrid;
+using osvr::util::applyRadialDistortion;
+
+static const ColorChannel CHANNELS[] = {ColorChannel::Red, ColorChannel::Green,
+                                        ColorChannel::Blue};
+
+namespace {
+OSVR_RadialDistortionParameters makeParams(double kr, double kg, double kb,
+                                           double cx, double cy) {
+    OSVR_RadialDistortionParameters params;
+    params.k1.data[0] = kr;
+    params.k1.data[1] = kg;
+    params.k1.data[2] = kb;
+    params.centerOfProjection.data[0] = cx;
+    params.centerOfProjection.data[1] = cy;
+    return params;
+}
+
+/// @brief Checks every point of the grid against the scalar reference.
+void expectMatchesReference(RadialDistortionGrid const &grid) {
+    auto const &params = grid.parameters();
+    ASSERT_EQ(grid.columns() * grid.rows(), grid.size());
+    ASSERT_EQ(grid.size(), std::size_t(grid.x().size()));
+    for (std::size_t row = 0; row < grid.rows(); ++row) {
+        for (std::size_t col = 0; col < grid.columns(); ++col) {
+            auto i = row * grid.columns() + col;
+            Eigen::Vector2d point(
+                osvr::util::gridCoordinate(col, grid.columns(),
+                                           grid.sampling()),
+                osvr::util::gridCoordinate(row, grid.rows(), grid.sampling()));
+            ASSERT_DOUBLE_EQ(point.x(), grid.x()[i]);
+            ASSERT_DOUBLE_EQ(point.y(), grid.y()[i]);
+            for (auto channel : CHANNELS) {
+                auto expected = applyRadialDistortion(params, channel, point);
+                ASSERT_NEAR(expected.x(), grid.u(channel)[i], 1e-12);
+                ASSERT_NEAR(expected.y(), grid.v(channel)[i], 1e-12);
+            }
+        }
+    }
+}
+} // namespace
+
+TEST(RadialDistortion, ZeroCoefficientsAreIdentity) {
+    auto params = makeParams(0, 0, 0, 0.4, 0.5);
+    Eigen::Vector2d point(0.9, 0.1);
+    for (auto channel : CHANNELS) {
+        ASSERT_TRUE(point.isApprox(
+            applyRadialDistortion(params, channel, point)));
+    }
+}
+
+TEST(RadialDistortion, CenterIsFixed) {
+    auto params = makeParams(0.1, 0.2, 0.3, 0.4, 0.5);
+    Eigen::Vector2d center(0.4, 0.5);
+    for (auto channel : CHANNELS) {
+        ASSERT_TRUE(center.isApprox(
+            applyRadialDistortion(params, channel, center)));
+    }
+}
+
+TEST(RadialDistortion, PerChannelCoefficients) {
+    auto params = makeParams(0.1, 0.2, 0.3, 0.5, 0.5);
+    Eigen::Vector2d point(1, 0.5);
+    // r = 0.5, so offsets scale by 1 + k1 / 4
+    ASSERT_DOUBLE_EQ(0.5 + 0.5 * 1.025,
+                     applyRadialDistortion(params, ColorChannel::Red, point).x());
+    ASSERT_DOUBLE_EQ(
+        0.5 + 0.5 * 1.05,
+        applyRadialDistortion(params, ColorChannel::Green, point).x());
+    ASSERT_DOUBLE_EQ(
+        0.5 + 0.5 * 1.075,
+        applyRadialDistortion(params, ColorChannel::Blue, point).x());
+}
+
+TEST(RadialDistortionGrid, CornersSpanTheSurface) {
+    RadialDistortionGrid grid(makeParams(0.1, 0.2, 0.3, 0.5, 0.5), 3, 2,
+                              GridSampling::Corners);
+    ASSERT_DOUBLE_EQ(0, grid.x()[0]);
+    ASSERT_DOUBLE_EQ(0.5, grid.x()[1]);
+    ASSERT_DOUBLE_EQ(1, grid.x()[2]);
+    ASSERT_DOUBLE_EQ(0, grid.y()[0]);
+    ASSERT_DOUBLE_EQ(1, grid.y()[5]);
+}
+
+TEST(RadialDistortionGrid, TexelCentersAreInset) {
+    RadialDistortionGrid grid(makeParams(0.1, 0.2, 0.3, 0.5, 0.5), 4, 2,
+                              GridSampling::TexelCenters);
+    ASSERT_DOUBLE_EQ(0.125, grid.x()[0]);
+    ASSERT_DOUBLE_EQ(0.875, grid.x()[3]);
+    ASSERT_DOUBLE_EQ(0.25, grid.y()[0]);
+    ASSERT_DOUBLE_EQ(0.75, grid.y()[4]);
+}
+
+TEST(RadialDistortionGrid, SinglePoint) {
+    RadialDistortionGrid grid(makeParams(0.1, 0.2, 0.3, 0.4, 0.6), 1, 1,
+                              GridSampling::Corners);
+    ASSERT_DOUBLE_EQ(0.5, grid.x()[0]);
+    ASSERT_DOUBLE_EQ(0.5, grid.y()[0]);
+    expectMatchesReference(grid);
+}
+
+TEST(RadialDistortionGrid, EmptyThrows) {
+    auto params = makeParams(0.1, 0.2, 0.3, 0.5, 0.5);
+    ASSERT_THROW(RadialDistortionGrid(params, 0, 4, GridSampling::Corners),
+                 std::invalid_argument);
+    ASSERT_THROW(RadialDistortionGrid(params, 4, 0, GridSampling::Corners),
+                 std::invalid_argument);
+}
+
+TEST(RadialDistortionGrid, MeshMatchesReference) {
+    // Odd sizes, so the vectorized loops have remainders to handle.
+    expectMatchesReference(RadialDistortionGrid(
+        makeParams(0.05, 0.1, 0.15, 0.45, 0.55), 33, 17,
+        GridSampling::Corners));
+}
+
+TEST(RadialDistortionGrid, LookupTableMatchesReference) {
+    // Strong distortion, at a typical per-eye lookup table size.
+    expectMatchesReference(RadialDistortionGrid(
+        makeParams(0.85, 0.87, 0.9, 0.5, 0.5), 960, 1080,
+        GridSampling::TexelCenters));
+}
@@ -0,0 +1,84 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// Internal Includes
+#include <osvr/Util/TripleBuffer.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <thread>
+
+using osvr::util::TripleBuffer;
+
+TEST(TripleBuffer, NothingPublished) {
+    TripleBuffer<int> buf;
+    ASSERT_FALSE(buf.refresh());
+}
+
+TEST(TripleBuffer, ReaderGetsLatest) {
+    TripleBuffer<int> buf;
+    buf.back() = 1;
+    buf.publish();
+    buf.back() = 2;
+    buf.publish();
+    ASSERT_TRUE(buf.refresh());
+    ASSERT_EQ(2, buf.front());
+    ASSERT_FALSE(buf.refresh());
+    ASSERT_EQ(2, buf.front());
+    buf.back() = 3;
+    buf.publish();
+    ASSERT_TRUE(buf.refresh());
+    ASSERT_EQ(3, buf.front());
+}
+
+namespace {
+struct Pair {
+    int a = 0;
+    int b = 0;
+};
+} // namespace
+
+TEST(TripleBuffer, ConsistentAcrossThreads) {
+    TripleBuffer<Pair> buf;
+    static const int COUNT = 200000;
+    std::thread writer([&] {
+        for (int i = 1; i <= COUNT; ++i) {
+            buf.back().a = i;
+            buf.back().b = -i;
+            buf.publish();
+        }
+    });
+    int last = 0;
+    while (last < COUNT) {
+        if (buf.refresh()) {
+            auto const &value = buf.front();
+            ASSERT_EQ(value.a, -value.b);
+            ASSERT_GT(value.a, last);
+            last = value.a;
+        }
+    }
+    writer.join();
+}